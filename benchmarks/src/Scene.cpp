@@ -0,0 +1,294 @@
+#include <celero/Celero.h>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "fs/FileSystem.hpp"
+#include "utilities/Properties.hpp"
+#include "logger/Logger.hpp"
+
+#include "GameEngine.hpp"
+#include "Scene.hpp"
+#include "PluginManager.hpp"
+
+#include "ecs/PositionComponent.hpp"
+#include "ecs/OrientationComponent.hpp"
+#include "ecs/GraphicsComponent.hpp"
+#include "ecs/ParentComponent.hpp"
+#include "ecs/ScriptObjectComponent.hpp"
+
+CELERO_MAIN
+
+namespace ice_engine
+{
+
+class SceneBenchmarkAccess
+{
+public:
+	static void handleParentComponentChanges(Scene* scene)
+	{
+		scene->handleParentComponentChanges();
+	}
+
+	static void applyChangesToEntities(Scene* scene)
+	{
+		scene->applyChangesToEntities();
+	}
+};
+
+}
+
+using namespace ice_engine;
+
+class Fixture : public celero::TestFixture
+{
+public:
+	std::vector<celero::TestFixture::ExperimentValue> getExperimentValues() const override
+	{
+		return {
+			celero::TestFixture::ExperimentValue(1000),
+			celero::TestFixture::ExperimentValue(10000),
+			celero::TestFixture::ExperimentValue(100000)
+		};
+	}
+
+	void setUp(const celero::TestFixture::ExperimentValue& experimentValue) override
+	{
+		numberOfEntities = static_cast<uint32>(experimentValue.Value);
+
+		auto engineProperties = std::make_unique<utilities::Properties>(settings);
+		auto engineFileSystem = std::make_unique<fs::FileSystem>();
+		auto engineLogger = std::make_unique<ice_engine::logger::Logger>();
+		auto pluginManager = std::make_unique<PluginManager>(engineProperties.get(), engineFileSystem.get(), engineLogger.get());
+
+		gameEngine = std::make_unique<GameEngine>(std::move(engineProperties), std::move(engineFileSystem), std::move(pluginManager), std::move(engineLogger));
+
+		scene = gameEngine->createScene("benchmark", {source});
+	}
+
+	void tearDown() override
+	{
+		entities.clear();
+		positions.clear();
+
+		gameEngine->destroyScene(scene);
+		scene = nullptr;
+
+		gameEngine.reset();
+	}
+
+	ecs::Entity createEntity(const glm::vec3& position)
+	{
+		auto entity = scene->createEntity();
+		entity.assign<ecs::PositionComponent>(position);
+		entity.assign<ecs::OrientationComponent>(glm::quat());
+
+		return entity;
+	}
+
+	void createEntities()
+	{
+		entities.reserve(numberOfEntities);
+		positions.reserve(numberOfEntities);
+
+		for (uint32 i = 0; i < numberOfEntities; ++i)
+		{
+			const glm::vec3 position(static_cast<float32>(i % 100), 0.0f, static_cast<float32>(i / 100));
+
+			entities.push_back(createEntity(position));
+			positions.push_back(position + glm::vec3(0.0f, 1.0f, 0.0f));
+		}
+	}
+
+	const std::string settings = R"END(
+[plugins]
+graphicsplugin=null
+audioplugin=null
+pathfindingplugin=null
+physicsplugin=null
+networkingplugin=null
+)END";
+
+	const std::string source = R"END(
+class Ticker
+{
+	float elapsed;
+
+	void tick(const float delta)
+	{
+		elapsed += delta;
+	}
+}
+)END";
+
+	uint32 numberOfEntities = 0;
+
+	std::unique_ptr<GameEngine> gameEngine;
+	Scene* scene = nullptr;
+
+	std::vector<ecs::Entity> entities;
+	std::vector<glm::vec3> positions;
+};
+
+class FixturePositionOnly : public Fixture
+{
+public:
+	void setUp(const celero::TestFixture::ExperimentValue& experimentValue) override
+	{
+		Fixture::setUp(experimentValue);
+
+		createEntities();
+	}
+};
+
+class FixtureGraphics : public Fixture
+{
+public:
+	void setUp(const celero::TestFixture::ExperimentValue& experimentValue) override
+	{
+		Fixture::setUp(experimentValue);
+
+		createEntities();
+
+		for (auto& entity : entities)
+		{
+			entity.assign<ecs::GraphicsComponent>(graphics::MeshHandle(1, 1));
+		}
+
+		scene->setActive(false);
+	}
+};
+
+class FixtureParent : public Fixture
+{
+public:
+	void setUp(const celero::TestFixture::ExperimentValue& experimentValue) override
+	{
+		Fixture::setUp(experimentValue);
+
+		parent = createEntity(parentPosition);
+
+		createEntities();
+
+		// The parent pass only touches children that have a renderable
+		const graphics::MeshHandle meshHandle(1, 1);
+
+		for (uint32 i = 0; i < numberOfEntities; ++i)
+		{
+			const auto renderableHandle = scene->createRenderable(meshHandle, graphics::TextureHandle(), positions[i], glm::quat(), glm::vec3(1.0f));
+
+			entities[i].assign<ecs::GraphicsComponent>(meshHandle, graphics::TextureHandle(), glm::vec3(1.0f), renderableHandle);
+			entities[i].assign<ecs::ParentComponent>(parent);
+		}
+
+		scene->setActive(false);
+	}
+
+	/**
+	 * Moves the parent so every iteration has a change to propagate to the children.
+	 */
+	void moveParent()
+	{
+		parentPosition.y = parentPosition.y > 2.0f ? 2.0f : 3.0f;
+
+		scene->setPositions(ArrayView<ecs::Entity>(&parent, 1), ArrayView<glm::vec3>(&parentPosition, 1));
+	}
+
+	ecs::Entity parent;
+	glm::vec3 parentPosition = glm::vec3(1.0f, 2.0f, 3.0f);
+};
+
+class FixtureScriptObject : public Fixture
+{
+public:
+	void setUp(const celero::TestFixture::ExperimentValue& experimentValue) override
+	{
+		Fixture::setUp(experimentValue);
+
+		createEntities();
+
+		auto scriptingEngine = gameEngine->scriptingEngine();
+		const auto moduleHandle = scriptingEngine->createModule("benchmark_ticker", {source});
+
+		for (auto& entity : entities)
+		{
+			const auto scriptObjectHandle = scriptingEngine->createUninitializedScriptObject(moduleHandle, "Ticker");
+			entity.assign<ecs::ScriptObjectComponent>(scriptObjectHandle.get());
+		}
+	}
+};
+
+BASELINE_F(SceneTick, PositionOnly, FixturePositionOnly, 10, 10)
+{
+	scene->tick(0.016f);
+}
+
+BENCHMARK_F(SceneTick, ScriptObjects, FixtureScriptObject, 10, 10)
+{
+	scene->tick(0.016f);
+}
+
+BASELINE_F(SceneIteration, EntitiesWithComponents, FixturePositionOnly, 10, 10)
+{
+	float32 sum = 0.0f;
+	for (const auto& entity : scene->entitiesWithComponentsView<ecs::PositionComponent>())
+	{
+		sum += entity.component<ecs::PositionComponent>()->position.x;
+	}
+
+	celero::DoNotOptimizeAway(sum);
+}
+
+BENCHMARK_F(SceneIteration, Positions, FixturePositionOnly, 10, 10)
+{
+	float32 sum = 0.0f;
+	for (const auto& position : scene->positions(scene->entitiesWithComponentsView<ecs::PositionComponent>()))
+	{
+		sum += position.x;
+	}
+
+	celero::DoNotOptimizeAway(sum);
+}
+
+BASELINE_F(SceneDirtyPropagation, SetPositions, FixtureGraphics, 10, 10)
+{
+	scene->setPositions(ArrayView<ecs::Entity>(entities), positions);
+	scene->tick(0.016f);
+}
+
+BENCHMARK_F(SceneDirtyPropagation, ParentChanges, FixtureParent, 10, 10)
+{
+	moveParent();
+	scene->tick(0.016f);
+}
+
+// The parent pass on its own; the children stay dirty between iterations, so this is the cost of copying the parent
+// transforms and flagging the children
+BENCHMARK_F(SceneDirtyPropagation, ParentChangesParentPass, FixtureParent, 10, 10)
+{
+	moveParent();
+	SceneBenchmarkAccess::handleParentComponentChanges(scene);
+}
+
+// The parent pass followed by pushing the dirtied transforms out; subtract ParentChangesParentPass for the cost of
+// applying the changes
+BENCHMARK_F(SceneDirtyPropagation, ParentChangesPropagation, FixtureParent, 10, 10)
+{
+	moveParent();
+	SceneBenchmarkAccess::handleParentComponentChanges(scene);
+	SceneBenchmarkAccess::applyChangesToEntities(scene);
+}
+
+BASELINE_F(SceneEntityLifetime, CreateDestroy, Fixture, 10, 10)
+{
+	createEntities();
+
+	for (auto& entity : entities)
+	{
+		scene->destroy(entity);
+	}
+
+	entities.clear();
+	positions.clear();
+}
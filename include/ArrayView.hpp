@@ -0,0 +1,117 @@
+#ifndef ARRAYVIEW_H_
+#define ARRAYVIEW_H_
+
+#include <vector>
+#include <stdexcept>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Non-owning view over contiguous engine data.
+ *
+ * A view is only valid as long as the underlying storage is not modified or destroyed.  Views handed out by
+ * a Scene are backed by scene owned buffers and are valid until the next call that refills the same buffer.
+ *
+ * Storage that is refilled in place can give its views a generation counter, which its owner increments every time it
+ * refills or clears the storage.  A view made with an older generation is stale, and at() and requireCurrent() throw
+ * for it rather than reading storage that may have been freed.  The counter itself has to outlive the view.
+ */
+template<typename T>
+class ArrayView
+{
+public:
+	ArrayView() = default;
+
+	ArrayView(T* data, const size_t size) : data_(data), size_(size)
+	{
+	}
+
+	ArrayView(std::vector<T>& v) : data_(v.data()), size_(v.size())
+	{
+	}
+
+	ArrayView(std::vector<T>& v, const uint32* generation) : data_(v.data()), size_(v.size()), generation_(generation), expectedGeneration_(*generation)
+	{
+	}
+
+	T* data() const
+	{
+		return data_;
+	}
+
+	size_t size() const
+	{
+		return size_;
+	}
+
+	bool empty() const
+	{
+		return size_ == 0;
+	}
+
+	T& operator[](const size_t i) const
+	{
+		return data_[i];
+	}
+
+	/**
+	 * Returns true if the storage has been refilled since this view was made.
+	 */
+	bool stale() const
+	{
+		return generation_ && *generation_ != expectedGeneration_;
+	}
+
+	void requireCurrent() const
+	{
+		if (stale())
+		{
+			throw std::logic_error("ArrayView is stale, the storage it views has been refilled since it was made.");
+		}
+	}
+
+	T& at(const size_t i) const
+	{
+		requireCurrent();
+
+		if (i >= size_)
+		{
+			throw std::out_of_range("ArrayView index out of range.");
+		}
+
+		return data_[i];
+	}
+
+	T& front() const
+	{
+		return data_[0];
+	}
+
+	T& back() const
+	{
+		return data_[size_ - 1];
+	}
+
+	T* begin() const
+	{
+		return data_;
+	}
+
+	T* end() const
+	{
+		return data_ + size_;
+	}
+
+private:
+	T* data_ = nullptr;
+	size_t size_ = 0;
+	const uint32* generation_ = nullptr;
+	uint32 expectedGeneration_ = 0;
+};
+
+}
+
+#endif /* ARRAYVIEW_H_ */
@@ -0,0 +1,126 @@
+#ifndef ASSETLOADER_H_
+#define ASSETLOADER_H_
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <mutex>
+#include <exception>
+
+#include "Types.hpp"
+
+#include "IThreadPool.hpp"
+#include "IOpenGlLoader.hpp"
+
+#include "logger/ILogger.hpp"
+
+namespace ice_engine
+{
+
+enum class AssetLoadState
+{
+	UNKNOWN = 0,
+	WAITING,
+	DECODING,
+	UPLOADING,
+	LOADED,
+	FAILED
+};
+
+/**
+ * Called once an asset is loaded, or failed to load (in which case error is set).  Always called on the main thread.
+ */
+typedef std::function<void(const std::string& name, const std::exception_ptr& error)> AssetLoadCallback;
+
+struct AssetLoadRequest
+{
+	std::string name;
+
+	/**
+	 * Assets that must be loaded before this one is decoded.  They don't need to be requested yet, but the asset won't
+	 * load until they are.
+	 */
+	std::vector<std::string> dependencies;
+
+	/**
+	 * Reads and decodes the asset.  Run on a background thread, in parallel with other assets.
+	 */
+	std::function<void()> decode;
+
+	/**
+	 * Creates the asset's GPU resources.  Run on the main thread, inside the per frame upload budget.
+	 */
+	std::function<void()> upload;
+};
+
+/**
+ * Loads assets as a dependency graph.
+ *
+ * Each asset is decoded on the background thread pool once everything it depends on is loaded, then uploaded on the
+ * main thread through the OpenGL loader, so independent assets decode in parallel and GPU work is done in batches
+ * rather than as a single task per frame.  When an asset finishes its callbacks are run, and any asset that was
+ * waiting on it moves on.  If an asset fails, everything that depends on it fails with the same error.
+ *
+ * Assets are identified by name, and requesting an asset that was already requested only adds the callback.
+ * Dependencies must not be cyclic.
+ */
+class AssetLoader
+{
+public:
+	AssetLoader(IThreadPool* threadPool, IOpenGlLoader* openGlLoader, logger::ILogger* logger);
+
+	AssetLoader(const AssetLoader& other) = delete;
+	AssetLoader& operator=(const AssetLoader& other) = delete;
+
+	void load(AssetLoadRequest request, AssetLoadCallback callback = AssetLoadCallback());
+
+	/**
+	 * Calls callback when the named asset is loaded (or on the next frame, if it already is).
+	 */
+	void onLoaded(const std::string& name, AssetLoadCallback callback);
+
+	AssetLoadState state(const std::string& name) const;
+
+	/**
+	 * Forgets a loaded or failed asset, so it can be requested again.
+	 */
+	void forget(const std::string& name);
+
+	/**
+	 * Number of requested assets that haven't finished loading.
+	 */
+	uint32 pendingCount() const;
+
+private:
+	struct Node
+	{
+		AssetLoadState state = AssetLoadState::WAITING;
+		bool requested = false;
+		uint32 remainingDependencies = 0;
+
+		AssetLoadRequest request;
+		std::exception_ptr error;
+
+		std::vector<std::string> dependents;
+		std::vector<AssetLoadCallback> callbacks;
+	};
+
+	IThreadPool* threadPool_;
+	IOpenGlLoader* openGlLoader_;
+	logger::ILogger* logger_;
+
+	mutable std::mutex nodesMutex_;
+	std::unordered_map<std::string, Node> nodes_;
+	uint32 pendingCount_ = 0;
+
+	void decode(const std::string& name);
+	void upload(const std::string& name);
+	void finish(const std::string& name, const std::exception_ptr& error);
+	void addCallback(Node& node, const std::string& name, AssetLoadCallback callback, std::unique_lock<std::mutex>& lock);
+	void postCallback(const std::string& name, const std::exception_ptr& error, AssetLoadCallback callback);
+};
+
+}
+
+#endif /* ASSETLOADER_H_ */
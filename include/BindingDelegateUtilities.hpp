@@ -16,6 +16,7 @@
 
 #include "Platform.hpp"
 #include "Types.hpp"
+#include "ArrayView.hpp"
 
 #include "scripting/IScriptingEngine.hpp"
 
@@ -131,6 +132,70 @@ void registerVectorBindings(scripting::IScriptingEngine* scriptingEngine, const
 	scriptingEngine->registerObjectMethod(name.c_str(), "uint64 capacity() const", asFUNCTION(VectorBase::capacity), asCALL_CDECL_OBJLAST);
 }
 
+template<typename T, typename V>
+class ArrayViewRegisterHelper
+{
+public:
+	static void DefaultConstructor(T* memory) { new(memory) T(); }
+	static void CopyConstructor(const T& other, T* memory) { new(memory) T(other); }
+
+	// Exceptions thrown here become script exceptions
+	static uint64 size(T* v) { v->requireCurrent(); return static_cast<uint64>(v->size()); }
+	static bool empty(T* v) { v->requireCurrent(); return v->empty(); }
+	static V& at(uint64 i, T* v) { return v->at(static_cast<size_t>(i)); }
+	static V& index(uint64 i, T* v) { return v->at(static_cast<size_t>(i)); }
+	static V& front(T* v) { requireNotEmpty(v); return v->front(); }
+	static V& back(T* v) { requireNotEmpty(v); return v->back(); }
+
+private:
+	static void requireNotEmpty(T* v)
+	{
+		v->requireCurrent();
+
+		if (v->empty())
+		{
+			throw std::out_of_range("ArrayView is empty.");
+		}
+	}
+};
+
+/**
+ * Register our array view bindings.
+ *
+ * Array views are registered as POD value types, so passing them to and from scripts does not copy the
+ * underlying data.  Every accessor is bounds checked, and throws a script exception for a stale view.
+ */
+template<typename V>
+void registerArrayViewBindings(scripting::IScriptingEngine* scriptingEngine, const std::string& name, const std::string& type)
+{
+	typedef ArrayViewRegisterHelper<ArrayView<V>, V> ArrayViewBase;
+
+	scriptingEngine->registerObjectType(name.c_str(), sizeof(ArrayView<V>), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLINTS | asGetTypeTraits<ArrayView<V>>());
+
+	scriptingEngine->registerObjectBehaviour(name.c_str(), asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(ArrayViewBase::DefaultConstructor), asCALL_CDECL_OBJLAST);
+	auto copyConstructorString = std::string("void f(const ") + name + "& in)";
+	scriptingEngine->registerObjectBehaviour(name.c_str(), asBEHAVE_CONSTRUCT, copyConstructorString.c_str(), asFUNCTION(ArrayViewBase::CopyConstructor), asCALL_CDECL_OBJLAST);
+
+	scriptingEngine->registerObjectMethod(name.c_str(), "uint64 size() const", asFUNCTION(ArrayViewBase::size), asCALL_CDECL_OBJLAST);
+	scriptingEngine->registerObjectMethod(name.c_str(), "bool empty() const", asFUNCTION(ArrayViewBase::empty), asCALL_CDECL_OBJLAST);
+	// Views over const data (network payloads, for example) only get const accessors, so scripts can't write through them
+	if (!std::is_const<V>::value)
+	{
+		auto atFunctionString = type + "& at(uint64)";
+		scriptingEngine->registerObjectMethod(name.c_str(), atFunctionString.c_str(), asFUNCTION(ArrayViewBase::at), asCALL_CDECL_OBJLAST);
+		auto indexFunctionString = type + "& opIndex(uint64)";
+		scriptingEngine->registerObjectMethod(name.c_str(), indexFunctionString.c_str(), asFUNCTION(ArrayViewBase::index), asCALL_CDECL_OBJLAST);
+	}
+	auto atConstFunctionString = std::string("const ") + type + "& at(uint64) const";
+	scriptingEngine->registerObjectMethod(name.c_str(), atConstFunctionString.c_str(), asFUNCTION(ArrayViewBase::at), asCALL_CDECL_OBJLAST);
+	auto indexConstFunctionString = std::string("const ") + type + "& opIndex(uint64) const";
+	scriptingEngine->registerObjectMethod(name.c_str(), indexConstFunctionString.c_str(), asFUNCTION(ArrayViewBase::index), asCALL_CDECL_OBJLAST);
+	auto frontConstFunctionString = std::string("const ") + type + "& front() const";
+	scriptingEngine->registerObjectMethod(name.c_str(), frontConstFunctionString.c_str(), asFUNCTION(ArrayViewBase::front), asCALL_CDECL_OBJLAST);
+	auto backConstFunctionString = std::string("const ") + type + "& back() const";
+	scriptingEngine->registerObjectMethod(name.c_str(), backConstFunctionString.c_str(), asFUNCTION(ArrayViewBase::back), asCALL_CDECL_OBJLAST);
+}
+
 template<typename T, typename K, typename V>
 class UnorderedMapRegisterHelper
 {
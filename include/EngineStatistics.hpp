@@ -10,8 +10,16 @@ namespace ice_engine
 
 struct EngineStatistics
 {
-	float32 fps;
-    std::chrono::duration<float32> renderTime;
+	float32 fps = 0.0f;
+    std::chrono::duration<float32> renderTime{0.0f};
+	std::chrono::duration<float32> tickTime{0.0f};
+	std::chrono::duration<float32> frameTime{0.0f};
+	uint32 ticksPerFrame = 0;
+	uint64 droppedTicks = 0;
+	float32 interpolationAlpha = 0.0f;
+	uint64 allocationsPerFrame = 0;
+	std::chrono::duration<float32> scriptGarbageCollectionTime{0.0f};
+	uint32 scriptObjectsCollected = 0;
 };
 
 }
@@ -0,0 +1,102 @@
+#ifndef FIXEDSTEPSCHEDULER_H_
+#define FIXEDSTEPSCHEDULER_H_
+
+#include <chrono>
+#include <string>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+enum class CatchUpPolicy
+{
+	// Run up to the maximum number of ticks per frame to catch up with real time
+	CATCH_UP,
+
+	// Run at most one tick per frame and drop the rest, letting the simulation fall behind real time
+	SKIP
+};
+
+/**
+ * Decides how many fixed length simulation ticks to run each frame.
+ *
+ * Time is accumulated in integer nanoseconds so the number of ticks run for a given sequence of frame times is exact,
+ * and every tick advances the simulation by the same step.  The time left over after the ticks of a frame is available
+ * as alpha(), the fraction of a step between the last two simulated states, for interpolating what gets rendered.
+ *
+ * To keep a slow frame from causing even slower frames, frame times are clamped to maximumFrameTime and no more than
+ * maximumTicksPerFrame ticks are run per frame.  Time that is thrown away is counted in droppedTicks() and
+ * droppedTime().
+ */
+class FixedStepScheduler
+{
+public:
+	FixedStepScheduler(
+		const float64 tickRate = 60.0,
+		const uint32 maximumTicksPerFrame = 5,
+		const std::chrono::nanoseconds maximumFrameTime = std::chrono::milliseconds(250),
+		const CatchUpPolicy catchUpPolicy = CatchUpPolicy::CATCH_UP
+	);
+
+	/**
+	 * Adds the real time that passed since the last frame and returns the number of ticks to run this frame.
+	 */
+	uint32 advance(const std::chrono::nanoseconds elapsed);
+
+	/**
+	 * Fraction of a step accumulated since the last tick, in [0, 1).
+	 */
+	float32 alpha() const;
+
+	/**
+	 * Time until enough has accumulated for the next tick.
+	 */
+	std::chrono::nanoseconds timeUntilNextTick() const;
+
+	std::chrono::nanoseconds step() const;
+	float32 stepSeconds() const;
+	float64 tickRate() const;
+
+	uint32 maximumTicksPerFrame() const;
+	std::chrono::nanoseconds maximumFrameTime() const;
+	CatchUpPolicy catchUpPolicy() const;
+
+	uint64 ticks() const;
+	uint64 droppedTicks() const;
+	std::chrono::nanoseconds droppedTime() const;
+
+	/**
+	 * Discards any accumulated time, e.g. after loading a level.
+	 */
+	void reset();
+
+	static CatchUpPolicy catchUpPolicyFromString(const std::string& catchUpPolicy);
+
+private:
+	std::chrono::nanoseconds step_;
+	uint32 maximumTicksPerFrame_;
+	std::chrono::nanoseconds maximumFrameTime_;
+	CatchUpPolicy catchUpPolicy_;
+
+	std::chrono::nanoseconds accumulator_{0};
+
+	uint64 ticks_ = 0;
+	uint64 droppedTicks_ = 0;
+	std::chrono::nanoseconds droppedTime_{0};
+};
+
+/**
+ * Sleeps until deadline, more precisely than std::this_thread::sleep_until.
+ *
+ * The thread sleeps through most of the wait and yields for the last spinThreshold, so the wake up isn't at the mercy
+ * of the scheduler's timer granularity while only a sliver of the wait is spent awake.
+ */
+void sleepPrecisely(
+	const std::chrono::steady_clock::time_point& deadline,
+	const std::chrono::nanoseconds spinThreshold = std::chrono::milliseconds(1)
+);
+
+}
+
+#endif /* FIXEDSTEPSCHEDULER_H_ */
@@ -24,7 +24,10 @@
 #include "Types.hpp"
 
 #include "EngineStatistics.hpp"
+#include "Profiler.hpp"
+#include "FixedStepScheduler.hpp"
 #include "IThreadPool.hpp"
+#include "AssetLoader.hpp"
 #include "IOpenGlLoader.hpp"
 #include "ModelHandle.hpp"
 #include "IDebugRenderer.hpp"
@@ -78,6 +81,7 @@
 
 #include "networking/INetworkingEngineFactory.hpp"
 #include "networking/INetworkingEngine.hpp"
+#include "networking/MessageBufferBuilder.hpp"
 #include "networking/IEventListener.hpp"
 
 #include "pathfinding/IPathfindingEngineFactory.hpp"
@@ -126,6 +130,11 @@ public:
 
 	const EngineStatistics& getEngineStatistics() const;
 
+	/**
+	 * Returns true if the engine is running as a dedicated server, without graphics, audio, gui or input.
+	 */
+	bool headless() const;
+
 	void setIGameInstance(void* object);
 
 	/**
@@ -139,6 +148,7 @@ public:
 	scripting::IScriptingEngine* scriptingEngine() const;
 	IDebugRenderer* debugRenderer() const;
 	pathfinding::IPathfindingEngine* pathfindingEngine() const;
+	networking::INetworkingEngine* networkingEngine() const;
 	IThreadPool* backgroundThreadPool() const;
 	IThreadPool* foregroundThreadPool() const;
 	IOpenGlLoader* openGlLoader() const;
@@ -148,6 +158,20 @@ public:
 	}
 	logger::ILogger* logger() const;
 	fs::IFileSystem* fileSystem() const;
+	Profiler* profiler() const;
+
+	networking::MessageBufferPool& messageBufferPool();
+
+	/**
+	 * Returns a builder that writes into buffers from the engine message buffer pool.
+	 */
+	networking::MessageBufferBuilder createMessageBufferBuilder(const uint64 capacity = 0);
+
+	/**
+	 * Writes the profiler history to filename in the Chrome trace event format.
+	 */
+	void exportProfilerTrace(const std::string& filename) const;
+
 	ResourceCache& resourceCache()
 	{
 		return resourceCache_;
@@ -239,6 +263,25 @@ public:
 	std::shared_future<Model*> loadModelAsync(const std::string& name, const std::string& filename);
 	Model* importModel(const std::string& name, const std::string& filename);
 	std::shared_future<Model*> importModelAsync(const std::string& name, const std::string& filename);
+	HeightMap loadHeightMap(const std::string& filename);
+
+	AssetLoader* assetLoader() const;
+
+	/**
+	 * Loads an image (cooked or not) and creates a texture named name from it, through the asset loader.  callback is
+	 * called on the main thread once the texture exists.
+	 */
+	void requestTexture(const std::string& name, const std::string& filename, AssetLoadCallback callback = AssetLoadCallback());
+	void requestTexture(const std::string& name, const std::string& filename, void* object);
+
+	/**
+	 * Loads a cooked model and creates a static mesh for each of its meshes (named '<name>/<index>'), through the asset
+	 * loader.  The model's textures are requested first, named 'cooked:<image filename>', and decode in parallel.  The
+	 * model's Texture objects only keep their images if engine.releasetextureimages is off; either way the textures
+	 * themselves are found with getTexture.
+	 */
+	void requestModel(const std::string& name, const std::string& filename, AssetLoadCallback callback = AssetLoadCallback());
+	void requestModel(const std::string& name, const std::string& filename, void* object);
 
 	void unloadAudio(const std::string& name);
 	void unloadImage(const std::string& name);
@@ -372,9 +415,11 @@ public:
 	void addConnectEventListener(void* connectEventListener);
 	void addDisconnectEventListener(void* disconnectEventListener);
 	void addMessageEventListener(void* messageEventListener);
+	void addMessageEventBatchListener(void* messageEventBatchListener);
 	void removeConnectEventListener(void* connectEventListener);
 	void removeDisconnectEventListener(void* disconnectEventListener);
 	void removeMessageEventListener(void* messageEventListener);
+	void removeMessageEventBatchListener(void* messageEventBatchListener);
 
 	void addScriptingEngineDebugHandler(IScriptingEngineDebugHandler* handler);
 	void removeScriptingEngineDebugHandler(const IScriptingEngineDebugHandler* handler);
@@ -393,6 +438,7 @@ public:
 	bool processEvent(const networking::ConnectEvent& event) override;
 	bool processEvent(const networking::DisconnectEvent& event) override;
 	bool processEvent(const networking::MessageEvent& event) override;
+	bool processEvent(const networking::MessageEventBatch& messageEventBatch) override;
 
 	physics::CollisionShapeHandle createStaticBoxShape(const std::string& name, const glm::vec3& dimensions)
 	{
@@ -681,6 +727,16 @@ public:
         return 0;
     }
 
+    /**
+     * Number of levels of detail renderables of the mesh are created with, including the mesh itself.
+     */
+    uint32 levelOfDetailCount(const graphics::MeshHandle& meshHandle) const
+    {
+        auto it = levelsOfDetail_.find(meshHandle);
+
+        return (it != levelsOfDetail_.end() ? static_cast<uint32>(it->second.size()) + 1 : 1);
+    }
+
     graphics::TextureHandle createTexture(const std::string& name, const Texture& texture)
     {
         auto handle = graphicsEngine_->createTexture2d(texture);
@@ -913,6 +969,7 @@ private:
 
 	std::unique_ptr<networking::INetworkingEngineFactory> networkingEngineFactory_;
 	std::unique_ptr< networking::INetworkingEngine > networkingEngine_;
+	networking::MessageBufferPool messageBufferPool_;
 
 	std::unique_ptr<physics::IPhysicsEngineFactory> physicsEngineFactory_;
 	std::unique_ptr< physics::IPhysicsEngine > physicsEngine_;
@@ -939,11 +996,14 @@ private:
 	std::vector<std::pair<scripting::ScriptObjectHandle, scripting::ScriptObjectFunctionHandle>> scriptConnectEventListeners_;
 	std::vector<std::pair<scripting::ScriptObjectHandle, scripting::ScriptObjectFunctionHandle>> scriptDisconnectEventListeners_;
 	std::vector<std::pair<scripting::ScriptObjectHandle, scripting::ScriptObjectFunctionHandle>> scriptMessageEventListeners_;
+	std::vector<std::pair<scripting::ScriptObjectHandle, scripting::ScriptObjectFunctionHandle>> scriptMessageEventBatchListeners_;
 
     std::vector<IScriptingEngineDebugHandler*> scriptingEngineDebugHandlers_;
     std::vector<std::pair<scripting::ScriptObjectHandle, scripting::ScriptObjectFunctionHandle>> scriptScriptingEngineDebugHandlers_;
 
 	std::unordered_map<graphics::MeshHandle, Mesh> meshes_;
+	// The lower levels of detail of meshes that have them
+	std::unordered_map<graphics::MeshHandle, std::vector<graphics::MeshHandle>> levelsOfDetail_;
 	handles::HandleVector<Skeleton, SkeletonHandle> skeletons_;
 	handles::HandleVector<Animation, AnimationHandle> animations_;
 
@@ -964,13 +1024,20 @@ private:
 	bool running_;
 	EngineStatistics engineStatistics_;
 
+	std::unique_ptr<FixedStepScheduler> fixedStepScheduler_;
+	bool sleepUntilNextTick_ = false;
+	bool headless_ = false;
+
 	void tick(const float32 delta);
-    void render();
+	void uploadGraphicsAssets();
+    void render(const float32 alpha);
 	void initialize();
 	void destroy();
 	void exit();
 
 	void handleEvents();
+	bool dispatchMessageEventBatchToScripts(const networking::MessageEventBatch& messageEventBatch);
+	bool dispatchMessageEventToScripts(const networking::MessageEvent& messageEvent);
 
     void internalDestroyGui(const graphics::gui::IGui* gui);
 
@@ -995,6 +1062,8 @@ private:
 	void initializeInputSubSystem();
 	void initializeScriptingSubSystem();
 	void initializeThreadingSubSystem();
+	void initializeProfilingSubSystem();
+	void initializeTimingSubSystem();
 	void initializeTerrainSubSystem();
 	void initializeDataStoreSubSystem();
 	void initializeEntitySubSystem();
@@ -1041,12 +1110,25 @@ private:
 	>>
 	postDeserializeCallbacks_;
 
+	std::unique_ptr<Profiler> profiler_;
+
 	// testing
 	std::unique_ptr<ThreadPool> backgroundThreadPool_;
 	std::unique_ptr<ThreadPool> foregroundThreadPool_;
 	std::unique_ptr<OpenGlLoader> openGlLoader_;
 	std::unique_ptr<OpenGlLoader> forgroundGraphicsThreadPool_;
 
+	std::unique_ptr<AssetLoader> assetLoader_;
+	std::chrono::nanoseconds gpuUploadBudget_ = std::chrono::milliseconds(4);
+
+	// Format requested textures are converted to (with a mip chain) before upload, or FORMAT_UNKNOWN to upload as loaded
+	IImage::Format textureFormat_ = IImage::Format::FORMAT_UNKNOWN;
+	bool releaseTextureImages_ = false;
+
+	AssetLoadCallback scriptAssetLoadCallback(void* object);
+
+	Model* loadModel(const std::string& name, const std::string& filename, const std::function<IImage*(const std::string&)>& resolveImage);
+
 	//std::unique_ptr<pyliteserializer::SqliteDataStore> dataStore_;
 };
 
@@ -6,14 +6,22 @@
 #include <iostream>
 #include <vector>
 #include <memory>
+#include <utility>
 
 #define GLM_FORCE_RADIANS
 #include <glm/glm.hpp>
 
 #include "graphics/IHeightMap.hpp"
 
+#include "IThreadPool.hpp"
 #include "Image.hpp"
 
+#include "image/ImageProcessing.hpp"
+
+#include "detail/Format.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
 namespace ice_engine
 {
 
@@ -23,16 +31,34 @@ public:
 
 	HeightMap() = default;
 
-	HeightMap(const std::vector<byte>& data, const uint32 width, const uint32 height)
+	/**
+	 * Builds a height map from an RGB image, using the average of each pixel's channels as its height.  The normals are
+	 * worked out on threadPool if one is given.
+	 */
+	HeightMap(const std::vector<byte>& data, const uint32 width, const uint32 height, IThreadPool* threadPool = nullptr)
+	{
+		image_ = generateFormattedHeightmap(data, width, height, threadPool);
+	}
+
+	/**
+	 * Builds a height map from an RGB or RGBA image.  Throws InvalidArgumentException for any other format, such as a
+	 * block compressed texture.
+	 */
+	HeightMap(const IImage& image, IThreadPool* threadPool = nullptr)
 	{
-		image_ = generateFormattedHeightmap(data, width, height);
+		image_ = generateFormattedHeightmap(image, threadPool);
 	}
 
-	HeightMap(const IImage& image)
+	/**
+	 * Takes an image that is already formatted as a height map (RGBA with the normal in RGB and the height in A), such
+	 * as one loaded from a cooked height map.
+	 */
+	explicit HeightMap(std::unique_ptr<IImage> formattedImage) : image_(std::move(formattedImage))
 	{
-		image_ = generateFormattedHeightmap(image);
 	}
 
+	HeightMap(HeightMap&& other) = default;
+
 	HeightMap(const HeightMap& other)
 	{
         if (other.image_)
@@ -53,6 +79,8 @@ public:
 		return *this;
 	}
 
+	HeightMap& operator=(HeightMap&& other) = default;
+
 	byte height(uint32 x, uint32 z) const
 	{
 		if (x >= image_->width())  x %= image_->width();
@@ -92,105 +120,48 @@ private:
         }
     }
 
-	// Source:
-	// https://stackoverflow.com/questions/2368728/can-normal-maps-be-generated-from-a-texture
-	// and
-	// http://www.catalinzima.com/2008/01/converting-displacement-maps-into-normal-maps/
-	float32 height(const std::vector<byte>& data, const uint32 width, const uint32 height, uint32 x, uint32 z)
-	{
-		if (x >= width)  x %= width;
-		while (x < 0)    x += width;
-		if (z >= height) z %= height;
-		while (z < 0)    z += height;
-
-		return static_cast<float32>(data[z*width*4 + x*4 + 3]) / 255.0f;
-	}
-
-	byte textureCoordinateToRgb(const float32 value)
+	std::unique_ptr<Image> generateFormattedHeightmap(const IImage& image, IThreadPool* threadPool)
 	{
-	    return static_cast<byte>((value + 1.0f) * (255.0f / 2.0f));
+		return generateFormattedHeightmap(image.data(), image.width(), image.height(), threadPool, image.format());
 	}
 
-	glm::vec3 calculateNormal(const std::vector<byte>& data, const uint32 width, const uint32 height, const uint32 x, const uint32 z)
+	std::unique_ptr<Image> generateFormattedHeightmap(
+		const std::vector<byte>& imageData,
+		const uint32 width,
+		const uint32 height,
+		IThreadPool* threadPool,
+		const int32 format = IImage::Format::FORMAT_RGB
+	)
 	{
-		const float32 strength = 8.0f;
-
-		// surrounding pixels
-		float32 tl = this->height(data, width, height, x-1, z+1); // top left
-		float32  l = this->height(data, width, height, x-1, z);   // left
-		float32 bl = this->height(data, width, height, x-1, z-1); // bottom left
-		float32  t = this->height(data, width, height, x, z+1);   // top
-		float32  b = this->height(data, width, height, x, z-1);   // bottom
-		float32 tr = this->height(data, width, height, x+1, z+1); // top right
-		float32  r = this->height(data, width, height, x+1, z);   // right
-		float32 br = this->height(data, width, height, x+1, z-1); // bottom right
-
-		// sobel filter
-		const float32 dX = (tr + 2.0f * r + br) - (tl + 2.0f * l + bl);
-		const float32 dY = (bl + 2.0f * b + br) - (tl + 2.0f * t + tr);
-		const float32 dZ = 1.0f / strength;
-
-		glm::vec3 n(dX, dY, dZ);
-		n = glm::normalize(n);
-
-		return n;
-	}
+		if (format != IImage::Format::FORMAT_RGB && format != IImage::Format::FORMAT_RGBA)
+		{
+			throw InvalidArgumentException(detail::format("Height map images must be RGB or RGBA, not format %s.", format));
+		}
 
-	void calculateNormals(std::vector<byte>& data, const uint32 width, const uint32 height)
-	{
-	    for (uint32 i = 0; i < width; ++i)
-	    {
-	        for (uint32 j = 0; j < height; ++j)
-	        {
-	           const glm::vec3 n = calculateNormal(data, width, height, i, j);
-
-	            // convert to rgb
-	            data[j*width*4 + i*4 + 0] = textureCoordinateToRgb(n.x);
-	            data[j*width*4 + i*4 + 1] = textureCoordinateToRgb(n.y);
-	            data[j*width*4 + i*4 + 2] = textureCoordinateToRgb(n.z);
-	        }
-	    }
-	}
+		const size_t pixelCount = static_cast<size_t>(width) * height;
+		const size_t channels = (format == IImage::Format::FORMAT_RGBA ? 4 : 3);
 
-	std::unique_ptr<Image> generateFormattedHeightmap(const IImage& image)
-    {
-        return generateFormattedHeightmap(image.data(), image.width(), image.height(), image.format());
-    }
+		if (imageData.size() < pixelCount * channels)
+		{
+			throw InvalidArgumentException(detail::format("Height map image data (%s bytes) is too small for a %sx%s image.", imageData.size(), width, height));
+		}
 
-	std::unique_ptr<Image> generateFormattedHeightmap(const std::vector<byte>& imageData, const uint32 width, const uint32 height, const int32 format = IImage::Format::FORMAT_RGB)
-	{
 		std::vector<byte> data;
-		data.resize(width*height*4);
-
-		std::unique_ptr<Image> newImage;
 
 		if (format == IImage::Format::FORMAT_RGB)
 		{
-			int j=0;
-			for (int i=0; i < data.size(); i+=4)
-			{
-				data[i] = imageData[j];
-				data[i+1] = imageData[j+1];
-				data[i+2] = imageData[j+2];
-				data[i+3] = (imageData[j] + imageData[j+1] + imageData[j+2]) / 3;
-
-				j+=3;
-			}
+			data.resize(pixelCount * 4);
+			image::rgbToRgba(imageData.data(), data.data(), pixelCount, threadPool);
 		}
-		else if (format == IImage::Format::FORMAT_RGBA)
+		else
 		{
-			for (int i=0; i < imageData.size(); i+=4)
-			{
-				data[i] = imageData[i];
-				data[i+1] = imageData[i+1];
-				data[i+2] = imageData[i+2];
-				data[i+3] = (imageData[i] + imageData[i+1] + imageData[i+2]) / 3;
-			}
+			data.assign(imageData.begin(), imageData.begin() + pixelCount * 4);
 		}
 
-		calculateNormals(data, width, height);
+		image::luminanceToAlpha(data.data(), pixelCount, threadPool);
+		image::sobelNormals(data.data(), width, height, 8.0f, threadPool);
 
-		return std::make_unique<Image>(data, width, height, IImage::Format::FORMAT_RGBA);
+		return std::make_unique<Image>(std::move(data), width, height, IImage::Format::FORMAT_RGBA);
 	}
 };
 
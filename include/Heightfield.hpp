@@ -2,11 +2,16 @@
 #define HEIGHTFIELD_H_
 
 #include <vector>
+#include <utility>
 
 #include "physics/IHeightfield.hpp"
 
 #include "Image.hpp"
 
+#include "detail/Format.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
 namespace ice_engine
 {
 
@@ -16,11 +21,22 @@ public:
 
 	Heightfield() = default;
 
+	/**
+	 * Takes the heights from an RGBA image's alpha channel (such as a height map's image), or from the average of an RGB
+	 * image's channels.  Throws InvalidArgumentException for any other format, such as a block compressed texture.
+	 */
 	Heightfield(const IImage& image)
 	{
 		generateHeightfield(image);
 	}
 
+	/**
+	 * Takes width * length heights, one byte each, row by row.
+	 */
+	Heightfield(std::vector<byte> data, const uint32 width, const uint32 length) : data_(std::move(data)), width_(width), length_(length)
+	{
+	}
+
 	virtual ~Heightfield() override = default;
 
 	virtual const std::vector<byte>& data() const override
@@ -52,19 +68,36 @@ private:
 
 	void generateHeightfield(const IImage& image)
 	{
-		const int32 dataSize = (image.format() == IImage::Format::FORMAT_RGBA ? 4 : 3);
+		if (image.format() != IImage::Format::FORMAT_RGB && image.format() != IImage::Format::FORMAT_RGBA)
+		{
+			throw InvalidArgumentException(detail::format("Heightfield images must be RGB or RGBA, not format %s.", image.format()));
+		}
+
+		const size_t dataSize = (image.format() == IImage::Format::FORMAT_RGBA ? 4 : 3);
+		const size_t pixelCount = static_cast<size_t>(image.width()) * image.height();
+
+		if (image.data().size() < pixelCount * dataSize)
+		{
+			throw InvalidArgumentException(detail::format("Heightfield image data (%s bytes) is too small for a %sx%s image.", image.data().size(), image.width(), image.height()));
+		}
 
 		width_ = image.width();
 		length_ = image.height();
 
-		data_.resize(image.width() * image.height());
+		data_.resize(pixelCount);
 
-		int j=0;
-		for (int i=0; i < data_.size(); ++i)
-		{
-			data_[i] = image.data()[j+3];
+		const auto& imageData = image.data();
 
-			j+=dataSize;
+		for (size_t i = 0, j = 0; i < data_.size(); ++i, j += dataSize)
+		{
+			if (dataSize == 4)
+			{
+				data_[i] = imageData[j + 3];
+			}
+			else
+			{
+				data_[i] = static_cast<byte>((imageData[j] + imageData[j + 1] + imageData[j + 2]) / 3);
+			}
 		}
 	}
 };
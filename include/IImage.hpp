@@ -16,7 +16,10 @@ public:
     {
         FORMAT_UNKNOWN = -1,
         FORMAT_RGB,
-        FORMAT_RGBA
+        FORMAT_RGBA,
+        FORMAT_BC1,
+        FORMAT_BC3,
+        FORMAT_BC5
     };
 
     ~IImage() override = default;
@@ -27,6 +30,9 @@ public:
     uint32 height() const override = 0;
 
     int32 format() const override = 0;
+
+    uint32 mipLevelCount() const override = 0;
+    const std::vector<byte>& mipLevel(const uint32 level) const override = 0;
 };
 
 }
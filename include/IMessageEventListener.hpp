@@ -15,6 +15,24 @@ public:
 	;
 	
 	virtual bool processEvent(const networking::MessageEvent& event) = 0;
+
+	/**
+	 * Process all of the messages received in one call to INetworkingEngine::processEvents.
+	 *
+	 * By default each message is copied into a MessageEvent and passed to processEvent(const MessageEvent&).  Override
+	 * this to read the payloads in place.
+	 */
+	virtual bool processEvent(const networking::MessageEventBatch& messageEventBatch)
+	{
+		bool processed = false;
+
+		for (const auto& messageEventView : messageEventBatch)
+		{
+			processed = processEvent(networking::copyMessageEvent(messageEventView)) || processed;
+		}
+
+		return processed;
+	}
 };
 
 }
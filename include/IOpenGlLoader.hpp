@@ -3,12 +3,24 @@
 
 #include <functional>
 #include <future>
+#include <chrono>
 
 #include "Types.hpp"
 
 namespace ice_engine
 {
 
+/**
+ * HIGH priority work (such as animation bone uploads) always runs on the next tick.  NORMAL and then LOW priority work
+ * (such as background texture uploads) runs within the tick's time budget.
+ */
+enum class WorkPriority
+{
+	HIGH = 0,
+	NORMAL,
+	LOW
+};
+
 class IOpenGlLoader
 {
 public:
@@ -19,11 +31,18 @@ public:
 	
 	virtual std::future<void> postWork(const std::function<void()>& work) = 0;
 	virtual std::future<void> postWork(std::function<void()>&& work) = 0;
+	virtual std::future<void> postWork(std::function<void()>&& work, const WorkPriority priority) = 0;
 	virtual void waitAll() = 0;
 	
 	virtual uint32 getWorkQueueCount() const = 0;
 	
 	virtual void tick() = 0;
+
+	/**
+	 * Runs all HIGH priority work, then NORMAL and LOW priority work until budget is used up.  At least one task always
+	 * runs, so work can't be starved by a small budget.  Returns the number of tasks run.
+	 */
+	virtual uint32 tick(const std::chrono::nanoseconds budget) = 0;
 	
 	virtual void block() = 0;
 	virtual void unblock() = 0;
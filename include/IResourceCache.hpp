@@ -3,6 +3,7 @@
 
 #include <string>
 #include <memory>
+#include <functional>
 
 #include "Model.hpp"
 #include "Image.hpp"
@@ -28,6 +29,19 @@ public:
 	virtual Image* getImage(const std::string& name) const = 0;
 	virtual Model* getModel(const std::string& name) const = 0;
 
+	/**
+	 * Returns the image with the given name, adding the one returned by create if there isn't one yet.  create runs
+	 * without the cache locked, so two threads asking for the same missing image may both create it; only the first
+	 * one added is kept and returned to both.
+	 */
+	virtual Image* getOrAddImage(const std::string& name, const std::function<std::unique_ptr<Image>()>& create) = 0;
+
+	/**
+	 * Adds image under name, or swaps it in for the image already there, under one lock so that lookups never find the
+	 * name missing in between.  Pointers to a replaced image are left dangling, as with removeImage.
+	 */
+	virtual Image* replaceImage(const std::string& name, std::unique_ptr<Image> image) = 0;
+
 };
 
 }
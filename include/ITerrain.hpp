@@ -5,6 +5,8 @@
 
 #include "pathfinding/CrowdHandle.hpp"
 
+#include "ecs/Entity.hpp"
+
 #include "Types.hpp"
 
 namespace ice_engine
@@ -20,6 +22,13 @@ public:
 	
 	virtual void tick(const float32 delta) = 0;
 	virtual const std::vector<pathfinding::CrowdHandle>& crowds() const = 0;
+
+	/**
+	 * Viewers are the entities, such as the camera or the players, that terrain is streamed in around.  They need a
+	 * PositionComponent, and are dropped once they are no longer valid.
+	 */
+	virtual void addViewer(const ecs::Entity& entity) = 0;
+	virtual void removeViewer(const ecs::Entity& entity) = 0;
 };
 
 }
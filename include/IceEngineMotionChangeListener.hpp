@@ -8,19 +8,34 @@
 namespace ice_engine
 {
 
-class Scene;
+namespace ecs
+{
+class EntityComponentSystem;
+}
 
+/**
+ * Writes a rigid body's new transform to the entity with the given id and marks it dirty with physics as the source.
+ *
+ * Returns false, leaving the entity untouched, if id is not a valid entity with a PositionComponent and an
+ * OrientationComponent.
+ */
+bool applyMotionChange(ecs::EntityComponentSystem& entityComponentSystem, const entityx::Entity::Id id, const glm::vec3& position, const glm::quat& orientation);
+
+/**
+ * Applies the motion changes reported for one rigid body, for physics plugins that don't publish
+ * IPhysicsEngine::motionChanges().
+ */
 class IceEngineMotionChangeListener : public physics::IMotionChangeListener
 {
 public:
-	IceEngineMotionChangeListener(ecs::Entity entity, Scene* scene);
+	IceEngineMotionChangeListener(ecs::Entity entity, ecs::EntityComponentSystem* entityComponentSystem);
 	virtual ~IceEngineMotionChangeListener();
 	
 	virtual void update(const glm::vec3& position, const glm::quat& orientation) override;
 
 private:
 	ecs::Entity entity_;
-	Scene* scene_;
+	ecs::EntityComponentSystem* entityComponentSystem_;
 };
 
 }
@@ -10,6 +10,10 @@
 
 #include "fs/IFile.hpp"
 
+#include "detail/Format.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
 namespace ice_engine
 {
 
@@ -32,6 +36,18 @@ public:
 		format_ = format;
 	}
 
+	/**
+	 * Creates an image that carries its own mip levels.
+	 *
+	 * @param mipLevels Levels 1 and up, each half the size of the one before (see graphics::IImage::mipLevel).
+	 */
+	Image(std::vector<byte> data, int width, int height, IImage::Format format, std::vector<std::vector<byte>> mipLevels)
+	:
+		Image(std::move(data), width, height, format)
+	{
+		mipLevels_ = std::move(mipLevels);
+	}
+
 	/**
 	 * Will load the provided image data into a proper image.
 	 *
@@ -69,6 +85,7 @@ public:
 		width_ = image.width_;
 		height_ = image.height_;
 		format_ = image.format_;
+		mipLevels_ = image.mipLevels_;
 	}
 
 	~Image() override = default;
@@ -99,12 +116,38 @@ public:
 			case Format::FORMAT_RGBA:
 				return graphics::IImage::Format::FORMAT_RGBA;
 
+			case Format::FORMAT_BC1:
+				return graphics::IImage::Format::FORMAT_BC1;
+
+			case Format::FORMAT_BC3:
+				return graphics::IImage::Format::FORMAT_BC3;
+
+			case Format::FORMAT_BC5:
+				return graphics::IImage::Format::FORMAT_BC5;
+
 			case Format::FORMAT_UNKNOWN:
 			default:
 				return graphics::IImage::Format::FORMAT_UNKNOWN;
 		}
 	}
 
+	uint32 mipLevelCount() const override
+	{
+		return static_cast<uint32>(mipLevels_.size()) + 1;
+	}
+
+	const std::vector<byte>& mipLevel(const uint32 level) const override
+	{
+		if (level == 0) return data_;
+
+		if (level > mipLevels_.size())
+		{
+			throw InvalidArgumentException(detail::format("Image has %s mip levels, level %s does not exist.", mipLevelCount(), level));
+		}
+
+		return mipLevels_[level - 1];
+	}
+
 //	std::vector<byte> data_;
 //	int width_ = 0;
 //	int height_ = 0;
@@ -118,6 +161,7 @@ private:
     int width_ = 0;
     int height_ = 0;
     IImage::Format format_ = IImage::Format::FORMAT_UNKNOWN;
+    std::vector<std::vector<byte>> mipLevels_;
 
 	void importImage(const std::vector<byte>& data, bool hasAlpha = true);
 };
@@ -106,7 +106,10 @@ public:
 		std::vector< glm::vec3 > normals,
 		std::vector< glm::vec2 > textureCoordinates,
 		VertexBoneData vertexBoneData = VertexBoneData(),
-		BoneData boneData = BoneData()
+		BoneData boneData = BoneData(),
+		graphics::VertexLayout vertexLayout = graphics::VertexLayout(),
+		std::vector< std::vector<byte> > vertexStreams = std::vector< std::vector<byte> >(),
+		std::vector< byte > indexData = std::vector< byte >()
 	)
 	:
 		name_(std::move(name)),
@@ -116,7 +119,10 @@ public:
 		normals_(std::move(normals)),
 		textureCoordinates_(std::move(textureCoordinates)),
 		vertexBoneData_(std::move(vertexBoneData)),
-		boneData_(std::move(boneData))
+		boneData_(std::move(boneData)),
+		vertexLayout_(std::move(vertexLayout)),
+		vertexStreams_(std::move(vertexStreams)),
+		indexData_(std::move(indexData))
 	{
 	}
 
@@ -167,6 +173,21 @@ public:
 		return textureCoordinates_;
 	}
 
+	const graphics::VertexLayout& vertexLayout() const override
+	{
+		return vertexLayout_;
+	}
+
+	const std::vector< std::vector<byte> >& vertexStreams() const override
+	{
+		return vertexStreams_;
+	}
+
+	const std::vector< byte >& indexData() const override
+	{
+		return indexData_;
+	}
+
 private:
 	std::string name_;
 	std::vector< glm::vec3 > vertices_;
@@ -176,6 +197,9 @@ private:
 	std::vector< glm::vec2 > textureCoordinates_;
 	VertexBoneData vertexBoneData_;
 	BoneData boneData_;
+	graphics::VertexLayout vertexLayout_;
+	std::vector< std::vector<byte> > vertexStreams_;
+	std::vector< byte > indexData_;
 
 	void importBones(const std::string& name, const std::string& filename, uint32 index, const aiMesh* mesh, logger::ILogger* logger, fs::IFileSystem* fileSystem);
 
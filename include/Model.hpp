@@ -30,14 +30,16 @@ public:
 	//	std::vector<Material> materials,
 		std::vector<Texture> textures,
 		Skeleton skeleton,
-		std::unordered_map<std::string, Animation> animations
+		std::unordered_map<std::string, Animation> animations,
+		std::vector<std::vector<Mesh>> levelsOfDetail = std::vector<std::vector<Mesh>>()
 	)
 	:
 		name_(std::move(name)),
 		meshes_(std::move(meshes)),
 		textures_(std::move(textures)),
 		skeleton_(std::move(skeleton)),
-		animations_(std::move(animations))
+		animations_(std::move(animations)),
+		levelsOfDetail_(std::move(levelsOfDetail))
 	{
 	}
 
@@ -71,6 +73,15 @@ public:
 		return animations_;
 	}
 
+	/**
+	 * levelsOfDetail()[i] holds the lower detail versions of meshes()[i], each simpler than the one before.  Meshes
+	 * without any (including every mesh of a model that wasn't cooked) may have no entry.
+	 */
+	const std::vector<std::vector<Mesh>>& levelsOfDetail() const
+	{
+		return levelsOfDetail_;
+	}
+
 private:
 	std::string name_;
 	std::vector<Mesh> meshes_;
@@ -78,6 +89,7 @@ private:
 	std::vector<Texture> textures_;
 	Skeleton skeleton_;
 	std::unordered_map<std::string, Animation> animations_;
+	std::vector<std::vector<Mesh>> levelsOfDetail_;
 
 /*
 	Material importMaterial(const std::string& name, const std::string& filename, uint32 index, const aiMaterial* material, logger::ILogger* logger, fs::IFileSystem* fileSystem)
@@ -0,0 +1,35 @@
+#ifndef NULLAUDIOPLUGIN_H_
+#define NULLAUDIOPLUGIN_H_
+
+#include <memory>
+#include <string>
+
+#include "IAudioPlugin.hpp"
+
+#include "audio/NullAudioEngineFactory.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Built in audio plugin, selected with 'audioplugin=null' in the [plugins] section of settings.ini.
+ */
+class NullAudioPlugin : public IAudioPlugin
+{
+public:
+	~NullAudioPlugin() override = default;
+
+	std::string getName() const override
+	{
+		return std::string("null");
+	}
+
+	std::unique_ptr<audio::IAudioEngineFactory> createFactory() const override
+	{
+		return std::make_unique<audio::NullAudioEngineFactory>();
+	}
+};
+
+}
+
+#endif /* NULLAUDIOPLUGIN_H_ */
@@ -0,0 +1,35 @@
+#ifndef NULLGRAPHICSPLUGIN_H_
+#define NULLGRAPHICSPLUGIN_H_
+
+#include <memory>
+#include <string>
+
+#include "IGraphicsPlugin.hpp"
+
+#include "graphics/NullGraphicsEngineFactory.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Built in graphics plugin, selected with 'graphicsplugin=null' in the [plugins] section of settings.ini.
+ */
+class NullGraphicsPlugin : public IGraphicsPlugin
+{
+public:
+	~NullGraphicsPlugin() override = default;
+
+	std::string getName() const override
+	{
+		return std::string("null");
+	}
+
+	std::unique_ptr<graphics::IGraphicsEngineFactory> createFactory() const override
+	{
+		return std::make_unique<graphics::NullGraphicsEngineFactory>();
+	}
+};
+
+}
+
+#endif /* NULLGRAPHICSPLUGIN_H_ */
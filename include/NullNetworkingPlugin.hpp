@@ -0,0 +1,35 @@
+#ifndef NULLNETWORKINGPLUGIN_H_
+#define NULLNETWORKINGPLUGIN_H_
+
+#include <memory>
+#include <string>
+
+#include "INetworkingPlugin.hpp"
+
+#include "networking/NullNetworkingEngineFactory.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Built in networking plugin, selected with 'networkingplugin=null' in the [plugins] section of settings.ini.
+ */
+class NullNetworkingPlugin : public INetworkingPlugin
+{
+public:
+	~NullNetworkingPlugin() override = default;
+
+	std::string getName() const override
+	{
+		return std::string("null");
+	}
+
+	std::unique_ptr<networking::INetworkingEngineFactory> createFactory() const override
+	{
+		return std::make_unique<networking::NullNetworkingEngineFactory>();
+	}
+};
+
+}
+
+#endif /* NULLNETWORKINGPLUGIN_H_ */
@@ -0,0 +1,35 @@
+#ifndef NULLPATHFINDINGPLUGIN_H_
+#define NULLPATHFINDINGPLUGIN_H_
+
+#include <memory>
+#include <string>
+
+#include "IPathfindingPlugin.hpp"
+
+#include "pathfinding/NullPathfindingEngineFactory.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Built in pathfinding plugin, selected with 'pathfindingplugin=null' in the [plugins] section of settings.ini.
+ */
+class NullPathfindingPlugin : public IPathfindingPlugin
+{
+public:
+	~NullPathfindingPlugin() override = default;
+
+	std::string getName() const override
+	{
+		return std::string("null");
+	}
+
+	std::unique_ptr<pathfinding::IPathfindingEngineFactory> createFactory() const override
+	{
+		return std::make_unique<pathfinding::NullPathfindingEngineFactory>();
+	}
+};
+
+}
+
+#endif /* NULLPATHFINDINGPLUGIN_H_ */
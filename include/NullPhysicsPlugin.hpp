@@ -0,0 +1,35 @@
+#ifndef NULLPHYSICSPLUGIN_H_
+#define NULLPHYSICSPLUGIN_H_
+
+#include <memory>
+#include <string>
+
+#include "IPhysicsPlugin.hpp"
+
+#include "physics/NullPhysicsEngineFactory.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Built in physics plugin, selected with 'physicsplugin=null' in the [plugins] section of settings.ini.
+ */
+class NullPhysicsPlugin : public IPhysicsPlugin
+{
+public:
+	~NullPhysicsPlugin() override = default;
+
+	std::string getName() const override
+	{
+		return std::string("null");
+	}
+
+	std::unique_ptr<physics::IPhysicsEngineFactory> createFactory() const override
+	{
+		return std::make_unique<physics::NullPhysicsEngineFactory>();
+	}
+};
+
+}
+
+#endif /* NULLPHYSICSPLUGIN_H_ */
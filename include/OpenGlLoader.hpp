@@ -1,7 +1,8 @@
 #ifndef OPENGLLOADER_H_
 #define OPENGLLOADER_H_
 
-#include <mutex>
+#include <atomic>
+#include <array>
 #include <deque>
 #include <memory>
 
@@ -10,6 +11,25 @@
 namespace ice_engine
 {
 
+struct OpenGlLoaderStatistics
+{
+	uint32 tasksRun = 0;
+	uint32 tasksRemaining = 0;
+	std::chrono::nanoseconds executionTime = std::chrono::nanoseconds::zero();
+	std::chrono::nanoseconds averageQueueLatency = std::chrono::nanoseconds::zero();
+	std::chrono::nanoseconds maximumQueueLatency = std::chrono::nanoseconds::zero();
+};
+
+/**
+ * Runs work on the thread that calls tick() (the main thread, which owns the OpenGL context).
+ *
+ * Work can be posted from any thread without taking a lock: it's pushed onto a lock free list, which tick() takes in
+ * one exchange and sorts into a queue per priority that only the ticking thread touches.  Tasks run outside of any
+ * lock, so they can post more work.
+ *
+ * tick() runs work until its budget is used up, then runs the rest of the high priority work that was queued when the
+ * budget ran out.  High priority work posted after that runs on the next tick.
+ */
 class OpenGlLoader : public IOpenGlLoader
 {
 public:
@@ -18,20 +38,43 @@ public:
 	
 	virtual std::future<void> postWork(const std::function<void()>& work) override;
 	virtual std::future<void> postWork(std::function<void()>&& work) override;
+	virtual std::future<void> postWork(std::function<void()>&& work, const WorkPriority priority) override;
 	virtual void waitAll() override;
 	
 	virtual uint32 getWorkQueueCount() const override;
 	
 	virtual void tick() override;
+	virtual uint32 tick(const std::chrono::nanoseconds budget) override;
 	
 	virtual void block() override;
 	virtual void unblock() override;
+
+	/**
+	 * Statistics for the last call to tick().
+	 */
+	const OpenGlLoaderStatistics& statistics() const;
 	
 private:
-	mutable std::mutex enqueuedWorkMutex_;
-	std::deque< std::shared_ptr<std::packaged_task<void()>> > enqueuedWork_;
+	struct Task
+	{
+		std::packaged_task<void()> work;
+		WorkPriority priority;
+		std::chrono::steady_clock::time_point enqueuedTime;
+		Task* next = nullptr;
+	};
+
+	std::atomic<Task*> incomingWork_;
+	std::atomic<uint32> workQueueCount_;
+	std::atomic<bool> blocked_;
+
+	// Only touched by the thread calling tick()
+	std::array<std::deque<std::unique_ptr<Task>>, 3> enqueuedWork_;
+	OpenGlLoaderStatistics statistics_;
 
 	void initialize();
+	std::future<void> push(std::unique_ptr<Task> task);
+	void takeIncomingWork();
+	void run(Task& task);
 };
 
 }
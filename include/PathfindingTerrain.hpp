@@ -1,6 +1,8 @@
 #ifndef PATHFINDINGTERRAIN_H_
 #define PATHFINDINGTERRAIN_H_
 
+#include <utility>
+
 #include "pathfinding/ITerrain.hpp"
 
 #include "HeightMap.hpp"
@@ -18,6 +20,10 @@ public:
 	{
 		generatePathfindingTerrain(heightMap);
 	}
+
+	PathfindingTerrain(std::vector<glm::vec3> vertices, std::vector<uint32> indices) : vertices_(std::move(vertices)), indices_(std::move(indices))
+	{
+	}
 	
 	~PathfindingTerrain() override = default;
 
@@ -0,0 +1,146 @@
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+struct ProfilerMarker
+{
+	const char* name = nullptr;
+	std::string detail;
+	uint32 threadId = 0;
+	uint32 depth = 0;
+	std::chrono::nanoseconds start{0};
+	std::chrono::nanoseconds duration{0};
+};
+
+struct ProfilerCounter
+{
+	const char* name = nullptr;
+	int64 value = 0;
+};
+
+struct ProfilerFrame
+{
+	uint64 frameNumber = 0;
+	std::chrono::nanoseconds start{0};
+	std::chrono::nanoseconds duration{0};
+	uint64 allocations = 0;
+	std::vector<ProfilerMarker> markers;
+	std::vector<ProfilerCounter> counters;
+};
+
+/**
+ * Lightweight hierarchical frame profiler.
+ *
+ * Timing markers and counters are recorded into the current frame, and the last historySize frames are kept in
+ * a ring buffer.  Markers can be recorded from any thread; nesting is tracked per thread.  Marker and counter names
+ * must be string literals (or otherwise outlive the profiler history).
+ *
+ * Allocation counts are only available when the engine is built with ICEENGINE_ENABLE_ALLOCATION_PROFILING,
+ * otherwise they are always 0.
+ */
+class Profiler
+{
+public:
+	Profiler(const uint32 historySize = 300);
+	~Profiler() = default;
+
+	Profiler(const Profiler& other) = delete;
+	Profiler& operator=(const Profiler& other) = delete;
+
+	void setEnabled(const bool enabled);
+	bool enabled() const;
+
+	void beginFrame();
+	void endFrame();
+
+	void record(const char* name, const std::chrono::high_resolution_clock::time_point& start, const std::chrono::high_resolution_clock::time_point& end, const uint32 depth, std::string detail = std::string());
+	void counter(const char* name, const int64 value);
+
+	uint64 frameNumber() const;
+
+	/**
+	 * Returns the recorded frames in order from oldest to newest.
+	 */
+	std::vector<ProfilerFrame> history() const;
+
+	/**
+	 * Writes the recorded history in the Chrome trace event format (viewable in chrome://tracing or Perfetto).
+	 */
+	void exportChromeTrace(std::ostream& outputStream) const;
+
+	static uint64 allocationCount();
+
+private:
+	std::atomic<bool> enabled_{true};
+
+	mutable std::mutex mutex_;
+	std::vector<ProfilerFrame> history_;
+	uint64 frameNumber_ = 0;
+	bool frameInProgress_ = false;
+	uint64 frameAllocationsStart_ = 0;
+
+	std::chrono::high_resolution_clock::time_point epoch_;
+
+	ProfilerFrame& currentFrame();
+};
+
+/**
+ * Records a marker covering the lifetime of this object.
+ */
+class ProfilerScope
+{
+public:
+	ProfilerScope(Profiler* profiler, const char* name);
+	ProfilerScope(Profiler* profiler, const char* name, std::string detail);
+
+	/**
+	 * Only invokes detail (which must return something convertible to std::string) if the profiler is enabled, so
+	 * that building the detail string costs nothing when profiling is off.
+	 */
+	template<typename DetailFunction, typename = decltype(std::string(std::declval<DetailFunction&>()()))>
+	ProfilerScope(Profiler* profiler, const char* name, DetailFunction&& detail) : ProfilerScope(profiler, name)
+	{
+		if (profiler_) detail_ = detail();
+	}
+	~ProfilerScope();
+
+	ProfilerScope(const ProfilerScope& other) = delete;
+	ProfilerScope& operator=(const ProfilerScope& other) = delete;
+
+private:
+	Profiler* profiler_;
+	const char* name_;
+	std::string detail_;
+	uint32 depth_ = 0;
+	std::chrono::high_resolution_clock::time_point start_;
+};
+
+}
+
+#define ICEENGINE_PROFILER_CONCATENATE_DETAIL(x, y) x##y
+#define ICEENGINE_PROFILER_CONCATENATE(x, y) ICEENGINE_PROFILER_CONCATENATE_DETAIL(x, y)
+#define ICEENGINE_PROFILER_EXPAND(x) x
+#define ICEENGINE_PROFILER_SELECT(_1, _2, _3, NAME, ...) NAME
+#define ICEENGINE_PROFILER_SCOPE_NAME(profiler, name) ice_engine::ProfilerScope ICEENGINE_PROFILER_CONCATENATE(profilerScope, __LINE__)(profiler, name)
+#define ICEENGINE_PROFILER_SCOPE_DETAIL(profiler, name, detail) ice_engine::ProfilerScope ICEENGINE_PROFILER_CONCATENATE(profilerScope, __LINE__)(profiler, name, [&]() -> std::string { return detail; })
+
+/**
+ * PROFILER_SCOPE(profiler, name) or PROFILER_SCOPE(profiler, name, detail).
+ *
+ * The detail expression is only evaluated when the profiler is enabled.
+ */
+#define PROFILER_SCOPE(...) ICEENGINE_PROFILER_EXPAND(ICEENGINE_PROFILER_SELECT(__VA_ARGS__, ICEENGINE_PROFILER_SCOPE_DETAIL, ICEENGINE_PROFILER_SCOPE_NAME)(__VA_ARGS__))
+
+#endif /* PROFILER_H_ */
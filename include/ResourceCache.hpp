@@ -26,6 +26,9 @@ public:
 	Image* getImage(const std::string& name) const override;
 	Model* getModel(const std::string& name) const override;
 
+	Image* getOrAddImage(const std::string& name, const std::function<std::unique_ptr<Image>()>& create) override;
+	Image* replaceImage(const std::string& name, std::unique_ptr<Image> image) override;
+
 private:
 	std::unordered_map<std::string, std::unique_ptr<Model>> models_;
 	std::unordered_map<std::string, std::unique_ptr<Audio>> audios_;
@@ -12,6 +12,7 @@
 #include <boost/type_index.hpp>
 
 #include "Types.hpp"
+#include "ArrayView.hpp"
 
 #include "exceptions/Exception.hpp"
 
@@ -20,6 +21,8 @@
 #include "ModelHandle.hpp"
 
 #include "Raycast.hpp"
+#include "SpatialIndex.hpp"
+#include "ray/Sphere.hpp"
 
 #include "ScriptFunctionHandleWrapper.hpp"
 
@@ -33,6 +36,7 @@
 #include "ecs/PositionComponent.hpp"
 #include "ecs/OrientationComponent.hpp"
 #include "ecs/PointLightComponent.hpp"
+#include "ecs/LevelOfDetailComponent.hpp"
 
 #include "scripting/ScriptObjectHandle.hpp"
 
@@ -43,6 +47,7 @@
 #include "graphics/TextureHandle.hpp"
 #include "graphics/ShaderProgramHandle.hpp"
 #include "graphics/PointLightHandle.hpp"
+#include "graphics/CameraHandle.hpp"
 #include "physics/CollisionShapeHandle.hpp"
 #include "physics/RigidBodyObjectHandle.hpp"
 #include "physics/GhostObjectHandle.hpp"
@@ -68,6 +73,9 @@
 #include "IThreadPool.hpp"
 #include "IOpenGlLoader.hpp"
 
+#include "replication/ReplicationServer.hpp"
+#include "replication/ReplicationClient.hpp"
+
 namespace ice_engine
 {
 
@@ -78,6 +86,7 @@ namespace ice_engine
 //}
 
 class EntityComponentSystemEventListener;
+class SceneBenchmarkAccess;
 
 class Scene : serialization::ISerializable
 {
@@ -105,7 +114,12 @@ public:
 	~Scene();
 
 	void tick(const float32 delta);
-	void render();
+
+	/**
+	 * Renders the scene.  Entities moved in the last tick are drawn alpha of the way between their previous and current
+	 * transforms, where alpha is the fraction of a fixed step that has passed since the last tick.
+	 */
+	void render(const float32 alpha = 1.0f);
 
 	void setSceneThingyInstance(void* object);
 
@@ -179,6 +193,13 @@ public:
 	);
 	void destroy(const graphics::RenderableHandle& renderableHandle);
 
+	/**
+	 * Each frame, entities with a GraphicsComponent and LevelOfDetailComponent have the level of detail of their
+	 * renderable chosen by how much of the screen they cover from this camera, measured from where they are drawn (their
+	 * transform root's position).  Until a camera is set every renderable draws its most detailed level.
+	 */
+	void setLevelOfDetailCamera(const graphics::CameraHandle& cameraHandle);
+
 	audio::SoundSourceHandle play(const audio::SoundHandle& soundHandle, const glm::vec3& position);
 
 	graphics::PointLightHandle createPointLight(const glm::vec3& position);
@@ -301,6 +322,30 @@ public:
 		}
 	}
 
+	/**
+	 * The views returned here, by positions, orientations and queryView are backed by scene owned buffers.  Each is
+	 * valid until the next call that refills the same buffer, after which using it throws.
+	 */
+	template <typename ... C>
+	ArrayView<ecs::Entity> entitiesWithComponentsView()
+	{
+		entityViewBuffer_.clear();
+		++entityViewGeneration_;
+
+		for (auto entity : entityComponentSystem_->template entitiesWithComponents<C ...>())
+		{
+			entityViewBuffer_.push_back(entity);
+		}
+
+		return ArrayView<ecs::Entity>(entityViewBuffer_, &entityViewGeneration_);
+	}
+
+	ArrayView<glm::vec3> positions(const ArrayView<ecs::Entity>& entities);
+	ArrayView<glm::quat> orientations(const ArrayView<ecs::Entity>& entities);
+	void setPositions(const ArrayView<ecs::Entity>& entities, const ArrayView<glm::vec3>& positions);
+	void setPositions(const ArrayView<ecs::Entity>& entities, const std::vector<glm::vec3>& positions);
+	void setOrientations(const ArrayView<ecs::Entity>& entities, const ArrayView<glm::quat>& orientations);
+
 	void serialize(const std::string& filename) override;
 	void deserialize(const std::string& filename) override;
 
@@ -398,11 +443,77 @@ public:
 
 	Raycast raycast(const ray::Ray& ray);
 
+	/**
+	 * Casts every ray, in parallel on the foreground thread pool, and writes the result for rays[i] into results[i].
+	 * It is safe to call from a scene tick, which runs on that pool - the calling thread casts whatever the workers don't.
+	 *
+	 * results is resized to match rays; keep passing the same vector to avoid reallocating it every tick.
+	 */
+	void raycastMany(const std::vector<ray::Ray>& rays, std::vector<Raycast>& results);
+
 	std::vector<ecs::Entity> query(const glm::vec3& origin, const std::vector<glm::vec3>& points);
 	std::vector<ecs::Entity> query(const glm::vec3& origin, const float32 radius);
+	ArrayView<ecs::Entity> queryView(const glm::vec3& origin, const float32 radius);
+
+	/**
+	 * Finds the entities overlapping each sphere, in parallel on the foreground thread pool.  Like raycastMany, it is safe
+	 * to call from a scene tick.
+	 *
+	 * The entities found are written to entities in sphere order, and counts[i] is set to the number found for
+	 * spheres[i].  Both vectors are resized; reusing them across calls avoids reallocating them.
+	 */
+	void queryMany(const std::vector<ray::Sphere>& spheres, std::vector<ecs::Entity>& entities, std::vector<uint32>& counts);
+
+	/**
+	 * Spatial index over the position of every entity with a PositionComponent, keyed by entity id.  It is updated
+	 * as positions change, so unlike query it also finds entities without a physics object.
+	 */
+	SpatialIndex& spatialIndex();
+
+	IThreadPool* backgroundThreadPool() const;
+	IOpenGlLoader* openGlLoader() const;
+
+	void entitiesInRadius(const glm::vec3& center, const float32 radius, std::vector<ecs::Entity>& entities);
+	void entitiesInBox(const glm::vec3& minimum, const glm::vec3& maximum, std::vector<ecs::Entity>& entities);
+	void entitiesInFrustum(const glm::mat4& viewProjection, std::vector<ecs::Entity>& entities);
+
+	/**
+	 * Finds the count entities nearest position, nearest first.
+	 */
+	void nearestEntities(const glm::vec3& position, const uint32 count, std::vector<ecs::Entity>& entities);
+
+	/**
+	 * Starts replicating the entities in this scene that have a ReplicatedComponent to clients of the given server.
+	 */
+	void startReplicationServer(const networking::ServerHandle& serverHandle);
+	void addReplicationClient(const networking::RemoteConnectionHandle& remoteConnectionHandle);
+	void removeReplicationClient(const networking::RemoteConnectionHandle& remoteConnectionHandle);
+
+	/**
+	 * Only replicate the entities within radius of position (or of entity) to the client, updating distant entities
+	 * less often.
+	 */
+	void setReplicationInterest(const networking::RemoteConnectionHandle& remoteConnectionHandle, const glm::vec3& position, const float32 radius);
+	void setReplicationInterest(const networking::RemoteConnectionHandle& remoteConnectionHandle, const ecs::Entity& entity, const float32 radius);
+	void clearReplicationInterest(const networking::RemoteConnectionHandle& remoteConnectionHandle);
+
+	/**
+	 * Starts applying the snapshots received by the given client to this scene.
+	 */
+	void startReplicationClient(const networking::ClientHandle& clientHandle);
+	void stopReplication();
+
+	/**
+	 * Returns the entity replicating the server entity with the given network id, or an invalid entity if this scene
+	 * is not a replication client or has no such entity.
+	 */
+	ecs::Entity replicatedEntity(const uint32 networkId) const;
 
 private:
 	friend class boost::serialization::access;
+	friend class EntityComponentSystemEventListener;
+	// Lets the benchmarks time the individual steps of a tick
+	friend class SceneBenchmarkAccess;
 
 	std::string name_;
 	bool visible_ = true;
@@ -420,6 +531,7 @@ private:
 	logger::ILogger* logger_;
 	IThreadPool* threadPool_;
 	IOpenGlLoader* openGlLoader_;
+	Profiler* profiler_;
 
 	bool debugRendering_ = false;
 
@@ -440,8 +552,55 @@ private:
 	std::vector<std::unique_ptr<std::promise<ecs::Entity>>> asyncCreateEntities_;
 	std::vector<ecs::Entity> asyncDestroyEntities_;
 
+	// Scene owned storage backing the views we hand out to scripts.  Each buffer's generation goes up whenever it is
+	// refilled, so views of what was there before are stale.
+	std::vector<ecs::Entity> entityViewBuffer_;
+	std::vector<ecs::Entity> queryViewBuffer_;
+	std::vector<glm::vec3> positionViewBuffer_;
+	std::vector<glm::quat> orientationViewBuffer_;
+	uint32 entityViewGeneration_ = 0;
+	uint32 queryViewGeneration_ = 0;
+	uint32 positionViewGeneration_ = 0;
+	uint32 orientationViewGeneration_ = 0;
+
+	// Per chunk scratch space for queryMany
+	struct BatchQueryBuffer
+	{
+		std::vector<boost::variant<physics::RigidBodyObjectHandle, physics::GhostObjectHandle>> physicsResults;
+		std::vector<ecs::Entity> entities;
+	};
+
+	std::vector<BatchQueryBuffer> batchQueryBuffers_;
+
+	SpatialIndex spatialIndex_;
+	std::vector<uint64> spatialIndexResults_;
+
 	std::vector<std::unique_ptr<ITerrain>> terrain_;
 
+	std::unique_ptr<replication::ReplicationServer> replicationServer_;
+	std::unique_ptr<replication::ReplicationClient> replicationClient_;
+
+	struct RenderInterpolation
+	{
+		ecs::Entity entity;
+
+		glm::vec3 previousPosition = glm::vec3(0.0f);
+		glm::vec3 currentPosition = glm::vec3(0.0f);
+		glm::quat previousOrientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+		glm::quat currentOrientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+
+		bool changed = false;
+	};
+
+	// Entities that moved in the last tick, keyed by entity id
+	bool renderInterpolation_ = true;
+	std::unordered_map<uint64, RenderInterpolation> renderInterpolations_;
+
+	graphics::CameraHandle levelOfDetailCamera_;
+	std::vector<float32> levelOfDetailScreenSizes_;
+	float32 levelOfDetailFieldOfView_ = 1.0f;
+	float32 levelOfDetailHysteresis_ = 0.1f;
+
     boost::optional<std::vector<std::string>> scriptData_;
 	std::string initializationFunctionName_;
 
@@ -475,17 +634,26 @@ private:
 	void initialize();
 	void destroy();
 
+    void tickTerrain(const float32 delta);
     void tickPhysics(const float32 delta);
     void tickAudio(const float32 delta);
     void tickPathfinding(const float32 delta);
     void tickScriptObjects(const float32 delta);
     void tickAnimations(const float32 delta);
+    void tickEntityChanges();
+    void tickReplicationClient();
+    void tickReplicationServer();
+    void tickRenderInterpolations();
+    void selectLevelsOfDetail();
 
     void handleAsyncEntityCreation();
     void handleAsyncEntityDeletion();
     void handleParentComponentChanges();
 
 	void applyChangesToEntities();
+	void applyMotionChanges();
+	void recordRenderInterpolations(const std::vector<ecs::Entity>& dirtyEntities);
+	ecs::Entity transformRoot(ecs::Entity entity) const;
 
 	void addMotionChangeListener(const ecs::Entity& entity);
 	void addPathfindingAgentMotionChangeListener(const ecs::Entity& entity);
@@ -494,6 +662,10 @@ private:
 	void removePathfindingAgentMotionChangeListener(const ecs::Entity& entity);
 	void removePathfindingMovementRequestStateChangeListener(const ecs::Entity& entity);
 
+	void rebuildSpatialIndex();
+	void updateSpatialIndex(const ecs::Entity& entity, const glm::vec3& position);
+	void toEntities(const std::vector<uint64>& ids, std::vector<ecs::Entity>& entities);
+
 	void addUserData(const ecs::Entity& entity, const ecs::RigidBodyObjectComponent& rigidBodyObjectComponent);
 	void addUserData(const ecs::Entity& entity, const ecs::GhostObjectComponent& ghostObjectComponent);
 	void addUserData(const ecs::Entity& entity, const ecs::PathfindingAgentComponent& pathfindingAgentComponent);
@@ -687,6 +859,8 @@ private:
 
 		ar & *entityComponentSystem_;
 
+		rebuildSpatialIndex();
+
 		auto normalizedCollisionShapeHandleMap = generateNormalizedMap(collisionShapeHandleMap, gameEngine_->resourceHandleCache().collisionShapeHandleMap(), logger_);
 		auto normalizedModelHandleMap = generateNormalizedMap(modelHandleMap, gameEngine_->resourceHandleCache().modelHandleMap(), logger_);
 		auto normalizedMeshHandleMap = generateNormalizedMap(meshHandleMap, gameEngine_->resourceHandleCache().meshHandleMap(), logger_);
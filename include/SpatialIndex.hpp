@@ -0,0 +1,101 @@
+#ifndef SPATIALINDEX_H_
+#define SPATIALINDEX_H_
+
+#include <array>
+#include <vector>
+#include <unordered_map>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * Octree over points, each identified by a 64 bit id.
+ *
+ * The tree grows to fit whatever is put in it.  Leaves split once they hold more than maximumNodeItems points, until
+ * they reach minimumNodeSize, and empty leaves are pruned.  Moving a point within its leaf only updates it in place.
+ *
+ * Queries clear results and then fill it with the ids found.
+ */
+class SpatialIndex
+{
+public:
+	SpatialIndex(const float32 minimumNodeSize = 1.0f, const uint32 maximumNodeItems = 16);
+
+	/**
+	 * Adds the point with the given id, or moves it if it is already in the index.
+	 *
+	 * Throws InvalidArgumentException if position is not finite.
+	 */
+	void set(const uint64 id, const glm::vec3& position);
+	void remove(const uint64 id);
+	bool contains(const uint64 id) const;
+	void clear();
+
+	size_t size() const;
+
+	void queryRadius(const glm::vec3& center, const float32 radius, std::vector<uint64>& results) const;
+	void queryBox(const glm::vec3& minimum, const glm::vec3& maximum, std::vector<uint64>& results) const;
+
+	/**
+	 * Finds the points inside the view frustum of the given (OpenGL style) view projection matrix.
+	 */
+	void queryFrustum(const glm::mat4& viewProjection, std::vector<uint64>& results) const;
+
+	/**
+	 * Finds the count points nearest position, nearest first.
+	 */
+	void queryNearest(const glm::vec3& position, const uint32 count, std::vector<uint64>& results) const;
+
+private:
+	static constexpr uint32 INVALID_NODE = static_cast<uint32>(-1);
+
+	struct Item
+	{
+		uint64 id;
+		glm::vec3 position;
+	};
+
+	struct Node
+	{
+		glm::vec3 center;
+		float32 halfSize = 0.0f;
+		uint32 parent = INVALID_NODE;
+		uint32 childCount = 0;
+		std::array<uint32, 8> children;
+		std::vector<Item> items;
+	};
+
+	float32 minimumNodeSize_;
+	uint32 maximumNodeItems_;
+
+	std::vector<Node> nodes_;
+	std::vector<uint32> freeNodes_;
+	uint32 root_ = INVALID_NODE;
+
+	// The leaf each id is in
+	std::unordered_map<uint64, uint32> leaves_;
+
+	uint32 createNode(const glm::vec3& center, const float32 halfSize, const uint32 parent);
+	void destroyNode(const uint32 node);
+
+	bool containsPoint(const Node& node, const glm::vec3& position) const;
+	uint32 childIndex(const Node& node, const glm::vec3& position) const;
+	glm::vec3 childCenter(const Node& node, const uint32 index) const;
+
+	void growToFit(const glm::vec3& position);
+	void insert(const uint64 id, const glm::vec3& position);
+	void split(const uint32 node);
+	void prune(uint32 node);
+
+	template<typename NodeTest, typename ItemTest>
+	void query(const NodeTest& nodeTest, const ItemTest& itemTest, std::vector<uint64>& results) const;
+};
+
+}
+
+#endif /* SPATIALINDEX_H_ */
@@ -0,0 +1,150 @@
+#ifndef STREAMINGTERRAIN_H_
+#define STREAMINGTERRAIN_H_
+
+#include <vector>
+#include <memory>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+
+#include "ITerrain.hpp"
+#include "IThreadPool.hpp"
+#include "IOpenGlLoader.hpp"
+
+#include "graphics/IGraphicsEngine.hpp"
+#include "pathfinding/IPathfindingEngine.hpp"
+#include "physics/IPhysicsEngine.hpp"
+
+#include "ecs/Entity.hpp"
+
+#include "HeightMap.hpp"
+#include "TerrainTile.hpp"
+#include "TerrainTileStreamer.hpp"
+
+#include "utilities/Properties.hpp"
+#include "logger/ILogger.hpp"
+
+namespace ice_engine
+{
+
+class Scene;
+
+/**
+ * Terrain made of fixed size tiles that are generated on the background thread pool as the viewers move, and unloaded
+ * once they are far away and the memory budget is used up.
+ *
+ * Each tile gets its own entity with a render mesh at its level of detail, created through the OpenGL loader.  Tiles
+ * within the collision radius of a viewer also get a static heightfield rigid body and their own navigation mesh,
+ * whatever their level of detail.  A tile that fails to generate, upload or install is retried with a backoff (see
+ * TerrainTileStreamer::failed).
+ *
+ * Properties:
+ *   terrain.tilesamples - height map samples along each side of a tile, a power of 2 (default 64)
+ *   terrain.loadradius - distance from a viewer within which tiles are loaded (default 384)
+ *   terrain.lodcount - number of levels of detail (default 4)
+ *   terrain.loddistance - distance at which level of detail 1 starts, each level after that starts twice as far (default 64)
+ *   terrain.collisionradius - distance from a viewer within which tiles get collision and navigation meshes (defaults to terrain.loddistance)
+ *   terrain.memorybudget - megabytes of tiles to keep loaded before unloading distant ones (default 256)
+ *   terrain.tileinstallspertick - most generated tiles to add to the scene each tick (default 2)
+ */
+class StreamingTerrain : public ITerrain
+{
+public:
+	StreamingTerrain(
+		utilities::Properties* properties,
+		logger::ILogger* logger,
+		Scene* scene,
+		HeightMap heightMap,
+		graphics::IGraphicsEngine* graphicsEngine,
+		pathfinding::IPathfindingEngine* pathfindingEngine,
+		physics::IPhysicsEngine* physicsEngine,
+		IThreadPool* threadPool,
+		IOpenGlLoader* openGlLoader
+	);
+	virtual ~StreamingTerrain();
+
+	virtual void tick(const float32 delta) override;
+
+	/**
+	 * Tiles each have their own navigation mesh, and there is no single crowd that spans them, so this is empty.
+	 */
+	virtual const std::vector<pathfinding::CrowdHandle>& crowds() const override;
+
+	virtual void addViewer(const ecs::Entity& entity) override;
+	virtual void removeViewer(const ecs::Entity& entity) override;
+
+	const TerrainTileStreamer& streamer() const;
+
+private:
+	/**
+	 * A tile's render mesh being created on the OpenGL loader.  The upload work shares this with the terrain, so a mesh
+	 * that finishes uploading after the terrain is gone is destroyed rather than leaked.
+	 */
+	struct MeshUpload
+	{
+		std::mutex mutex;
+		bool abandoned = false;
+		graphics::MeshHandle meshHandle;
+	};
+
+	struct PendingTile
+	{
+		TerrainTileCoordinate coordinate;
+		uint32 lod = 0;
+		bool collision = false;
+		std::shared_ptr<TerrainTile> tile;
+		std::future<void> future;
+
+		// Set once the tile is generated and its mesh is posted to the OpenGL loader
+		std::shared_ptr<MeshUpload> meshUpload;
+		std::future<void> meshUploadFuture;
+	};
+
+	struct ResidentTile
+	{
+		ecs::Entity entity;
+		graphics::MeshHandle meshHandle;
+		physics::CollisionShapeHandle collisionShapeHandle;
+		pathfinding::PolygonMeshHandle polygonMeshHandle;
+		pathfinding::NavigationMeshHandle navigationMeshHandle;
+	};
+
+	graphics::IGraphicsEngine* graphicsEngine_;
+	physics::IPhysicsEngine* physicsEngine_;
+	pathfinding::IPathfindingEngine* pathfindingEngine_;
+	utilities::Properties* properties_;
+	logger::ILogger* logger_;
+	IThreadPool* threadPool_;
+	IOpenGlLoader* openGlLoader_;
+
+	Scene* scene_;
+
+	// Shared with the tile generation work, which only reads it
+	HeightMap heightMap_;
+
+	uint32 tileSamples_ = 64;
+	uint32 tileInstallsPerTick_ = 2;
+
+	std::unique_ptr<TerrainTileStreamer> streamer_;
+
+	std::vector<ecs::Entity> viewers_;
+	std::vector<glm::vec3> viewerPositions_;
+	std::vector<TerrainTileRequest> requests_;
+	std::vector<TerrainTileCoordinate> unloads_;
+
+	std::vector<std::unique_ptr<PendingTile>> pendingTiles_;
+	std::unordered_map<TerrainTileCoordinate, ResidentTile, TerrainTileCoordinateHash> residentTiles_;
+
+	std::vector<pathfinding::CrowdHandle> crowdHandles_;
+
+	void generate(const TerrainTileRequest& request);
+	void installGeneratedTiles();
+	void uploadMesh(PendingTile& pendingTile);
+	void install(const TerrainTile& tile, const graphics::MeshHandle& meshHandle);
+	void uninstall(const TerrainTileCoordinate& coordinate);
+	void destroyResources(const ResidentTile& residentTile);
+};
+
+}
+
+#endif /* STREAMINGTERRAIN_H_ */
@@ -50,6 +50,8 @@ public:
 	
 	virtual void tick(const float32 delta) override;
 	virtual const std::vector<pathfinding::CrowdHandle>& crowds() const override;
+	virtual void addViewer(const ecs::Entity& entity) override;
+	virtual void removeViewer(const ecs::Entity& entity) override;
 
 private:
 	audio::IAudioEngine* audioEngine_;
@@ -0,0 +1,97 @@
+#ifndef TERRAINTILE_H_
+#define TERRAINTILE_H_
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "TerrainTileStreamer.hpp"
+#include "HeightMap.hpp"
+#include "Heightfield.hpp"
+#include "PathfindingTerrain.hpp"
+#include "Mesh.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+/**
+ * One square tile of a streamed terrain, sampled out of a height map.
+ *
+ * The tile covers tileSamples by tileSamples height map samples, one world unit apart, and shares its edge samples with
+ * its neighbours.  The height map repeats, with its centre at the world origin like the single piece terrain.  At level
+ * of detail n only every 2^n-th sample is used for the render mesh.
+ *
+ * Tiles made with collision also get a collision heightfield and pathfinding geometry.  These always use every sample,
+ * whatever the level of detail of the render mesh, since the physics heightfield shape assumes samples one unit apart.
+ */
+class TerrainTile
+{
+public:
+	TerrainTile() = default;
+
+	TerrainTile(const HeightMap& heightMap, const TerrainTileCoordinate& coordinate, const uint32 tileSamples, const uint32 lod, const bool collision)
+		:
+		coordinate_(coordinate),
+		lod_(lod),
+		collision_(collision)
+	{
+		generateTerrainTile(heightMap, tileSamples);
+	}
+
+	const TerrainTileCoordinate& coordinate() const
+	{
+		return coordinate_;
+	}
+
+	uint32 lod() const
+	{
+		return lod_;
+	}
+
+	/**
+	 * Where the tile goes in the world.  The mesh and heightfield are centred on it.
+	 */
+	const glm::vec3& position() const
+	{
+		return position_;
+	}
+
+	const Mesh& mesh() const
+	{
+		return mesh_;
+	}
+
+	bool hasCollision() const
+	{
+		return collision_;
+	}
+
+	const Heightfield& heightfield() const
+	{
+		return heightfield_;
+	}
+
+	const PathfindingTerrain& pathfindingTerrain() const
+	{
+		return pathfindingTerrain_;
+	}
+
+	uint64 memorySize() const;
+
+private:
+	TerrainTileCoordinate coordinate_;
+	uint32 lod_ = 0;
+	bool collision_ = false;
+	glm::vec3 position_;
+
+	Mesh mesh_;
+	Heightfield heightfield_;
+	PathfindingTerrain pathfindingTerrain_;
+
+	void generateTerrainTile(const HeightMap& heightMap, const uint32 tileSamples);
+};
+
+}
+
+#endif /* TERRAINTILE_H_ */
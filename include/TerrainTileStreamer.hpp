@@ -0,0 +1,147 @@
+#ifndef TERRAINTILESTREAMER_H_
+#define TERRAINTILESTREAMER_H_
+
+#include <vector>
+#include <functional>
+#include <unordered_map>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+
+struct TerrainTileCoordinate
+{
+	TerrainTileCoordinate() = default;
+
+	TerrainTileCoordinate(const int32 x, const int32 z) : x(x), z(z)
+	{
+	}
+
+	bool operator==(const TerrainTileCoordinate& other) const
+	{
+		return x == other.x && z == other.z;
+	}
+
+	bool operator!=(const TerrainTileCoordinate& other) const
+	{
+		return !(*this == other);
+	}
+
+	int32 x = 0;
+	int32 z = 0;
+};
+
+struct TerrainTileCoordinateHash
+{
+	size_t operator()(const TerrainTileCoordinate& coordinate) const
+	{
+		return std::hash<uint64>()((static_cast<uint64>(static_cast<uint32>(coordinate.x)) << 32) | static_cast<uint32>(coordinate.z));
+	}
+};
+
+struct TerrainTileRequest
+{
+	TerrainTileCoordinate coordinate;
+	uint32 lod = 0;
+
+	// Whether the tile should have collision and pathfinding geometry
+	bool collision = false;
+
+	// Distance from the nearest viewer to the tile, requests are handed out nearest first
+	float32 distance = 0.0f;
+};
+
+/**
+ * Decides which terrain tiles should be resident, and at which level of detail, given the positions of the viewers.
+ *
+ * Tiles are square and tileSize wide on the xz plane, tile (0, 0) covering [0, tileSize) on both axes.  A tile is wanted
+ * if any part of it is within loadRadius of a viewer.  Its level of detail is the number of lodDistances that its
+ * distance is at or beyond, so lodDistances must be increasing.  Tiles within collisionRadius of a viewer also get
+ * collision, whatever their level of detail; a negative collisionRadius gives no tile collision.
+ *
+ * Tiles that are no longer wanted stay resident, so that turning around doesn't reload them, until the resident tiles
+ * use more than memoryBudget bytes.  Then the ones that have gone unwanted the longest are unloaded first.  Wanted tiles
+ * are never unloaded, so the budget can be overrun if loadRadius is too large for it.
+ *
+ * The streamer only does the bookkeeping, the caller loads the requested tiles and reports back with loaded() or
+ * failed().
+ */
+class TerrainTileStreamer
+{
+public:
+	TerrainTileStreamer(const float32 tileSize, const float32 loadRadius, std::vector<float32> lodDistances, const uint64 memoryBudget, const float32 collisionRadius = -1.0f);
+
+	/**
+	 * Clears requests and unloads and then fills them.  Each wanted tile that isn't resident at the level of detail and
+	 * with the collision it should have, and isn't already being loaded, is requested once.
+	 */
+	void update(const std::vector<glm::vec3>& viewers, std::vector<TerrainTileRequest>& requests, std::vector<TerrainTileCoordinate>& unloads);
+
+	/**
+	 * Marks a requested tile as resident at the given level of detail, and with or without collision, replacing whatever
+	 * was resident.
+	 */
+	void loaded(const TerrainTileCoordinate& coordinate, const uint32 lod, const uint64 memorySize, const bool collision = false);
+
+	/**
+	 * Gives up on a requested tile.  If it is still wanted it is requested again, on the next update after its first
+	 * failure and then backing off, doubling the number of updates between attempts up to MAX_RETRY_DELAY, until it
+	 * loads.
+	 */
+	void failed(const TerrainTileCoordinate& coordinate);
+
+	bool resident(const TerrainTileCoordinate& coordinate) const;
+	bool pending(const TerrainTileCoordinate& coordinate) const;
+
+	size_t residentCount() const;
+	size_t pendingCount() const;
+	uint64 memoryUsed() const;
+
+	float32 tileSize() const;
+	uint32 lodCount() const;
+
+	TerrainTileCoordinate tileCoordinate(const glm::vec3& position) const;
+	uint32 lod(const float32 distance) const;
+	bool collision(const float32 distance) const;
+
+	static constexpr uint32 MAX_RETRY_DELAY = 256;
+
+private:
+	static constexpr uint32 INVALID_LOD = static_cast<uint32>(-1);
+
+	struct Tile
+	{
+		uint32 lod = INVALID_LOD;
+		bool collision = false;
+		bool pending = false;
+		uint64 memorySize = 0;
+		uint64 lastWanted = 0;
+		float32 distance = 0.0f;
+
+		// Consecutive failed loads, and the update before which the tile isn't requested again
+		uint32 failures = 0;
+		uint64 retryAt = 0;
+	};
+
+	float32 tileSize_;
+	float32 loadRadius_;
+	std::vector<float32> lodDistances_;
+	uint64 memoryBudget_;
+	float32 collisionRadius_;
+
+	std::unordered_map<TerrainTileCoordinate, Tile, TerrainTileCoordinateHash> tiles_;
+	uint64 memoryUsed_ = 0;
+	size_t pendingCount_ = 0;
+	uint64 updateCount_ = 0;
+
+	float32 distance(const TerrainTileCoordinate& coordinate, const glm::vec3& position) const;
+	void evict(std::vector<TerrainTileCoordinate>& unloads);
+};
+
+}
+
+#endif /* TERRAINTILESTREAMER_H_ */
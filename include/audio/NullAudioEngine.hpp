@@ -0,0 +1,115 @@
+#ifndef NULLAUDIOENGINE_H_
+#define NULLAUDIOENGINE_H_
+
+#include <atomic>
+
+#include "audio/IAudioEngine.hpp"
+
+#include "utilities/Properties.hpp"
+#include "fs/IFileSystem.hpp"
+#include "logger/ILogger.hpp"
+
+namespace ice_engine
+{
+namespace audio
+{
+
+/**
+ * Counts of the calls made on a NullAudioEngine.
+ */
+struct NullAudioEngineStatistics
+{
+	std::atomic<uint64> ticks{0};
+	std::atomic<uint64> soundsCreated{0};
+	std::atomic<uint64> soundsPlayed{0};
+	std::atomic<uint64> soundsStopped{0};
+	std::atomic<uint64> positionUpdates{0};
+
+	void reset()
+	{
+		ticks = 0;
+		soundsCreated = 0;
+		soundsPlayed = 0;
+		soundsStopped = 0;
+		positionUpdates = 0;
+	}
+};
+
+/**
+ * Audio engine that does no work.
+ *
+ * Handles returned are unique and valid, but no sound is played.  Calls are counted in statistics().
+ */
+class NullAudioEngine : public IAudioEngine
+{
+public:
+	NullAudioEngine(utilities::Properties* properties, fs::IFileSystem* fileSystem, logger::ILogger* logger)
+		:
+		properties_(properties),
+		fileSystem_(fileSystem),
+		logger_(logger)
+	{
+	}
+
+	~NullAudioEngine() override = default;
+
+	AudioSceneHandle createAudioScene() override { return AudioSceneHandle(++nextIndex_, 1); }
+	void destroyAudioScene(const AudioSceneHandle& audioSceneHandle) override {}
+
+	void tick(const AudioSceneHandle audioSceneHandle, const float32 delta) override { ++statistics_.ticks; }
+
+	void beginRender() override {}
+	void render(const AudioSceneHandle& audioSceneHandle) override {}
+	void endRender() override {}
+
+	SoundSourceHandle play(const AudioSceneHandle& audioSceneHandle, const SoundHandle& soundHandle, const glm::vec3& position) override
+	{
+		++statistics_.soundsPlayed;
+
+		return SoundSourceHandle(++nextIndex_, 1);
+	}
+
+	void stop(const AudioSceneHandle& audioSceneHandle, const SoundSourceHandle& soundSourceHandle) override { ++statistics_.soundsStopped; }
+	void stopAll(const AudioSceneHandle& audioSceneHandle) override {}
+
+	SoundHandle createSound(const IAudio& audio) override
+	{
+		++statistics_.soundsCreated;
+
+		return SoundHandle(++nextIndex_, 1);
+	}
+	void destroy(const SoundHandle soundHandle) override {}
+
+	ListenerHandle createListener(const AudioSceneHandle& audioSceneHandle, const glm::vec3& position) override { return ListenerHandle(++nextIndex_, 1); }
+
+	void setPosition(const AudioSceneHandle& audioSceneHandle, const SoundSourceHandle& soundSourceHandle, const float32 x, const float32 y, const float32 z) override { ++statistics_.positionUpdates; }
+	void setPosition(const AudioSceneHandle& audioSceneHandle, const SoundSourceHandle& soundSourceHandle, const glm::vec3& position) override { ++statistics_.positionUpdates; }
+	glm::vec3 position(const AudioSceneHandle& audioSceneHandle, const SoundSourceHandle& soundSourceHandle) const override { return glm::vec3(); }
+
+	void setPosition(const AudioSceneHandle& audioSceneHandle, const ListenerHandle& listenerHandle, const float32 x, const float32 y, const float32 z) override { ++statistics_.positionUpdates; }
+	void setPosition(const AudioSceneHandle& audioSceneHandle, const ListenerHandle& listenerHandle, const glm::vec3& position) override { ++statistics_.positionUpdates; }
+	glm::vec3 position(const AudioSceneHandle& audioSceneHandle, const ListenerHandle& listenerHandle) const override { return glm::vec3(); }
+
+	const NullAudioEngineStatistics& statistics() const
+	{
+		return statistics_;
+	}
+
+	void resetStatistics()
+	{
+		statistics_.reset();
+	}
+
+private:
+	utilities::Properties* properties_;
+	fs::IFileSystem* fileSystem_;
+	logger::ILogger* logger_;
+
+	std::atomic<uint32> nextIndex_{0};
+	NullAudioEngineStatistics statistics_;
+};
+
+}
+}
+
+#endif /* NULLAUDIOENGINE_H_ */
@@ -0,0 +1,32 @@
+#ifndef NULLAUDIOENGINEFACTORY_H_
+#define NULLAUDIOENGINEFACTORY_H_
+
+#include <memory>
+
+#include "audio/IAudioEngineFactory.hpp"
+#include "audio/NullAudioEngine.hpp"
+
+namespace ice_engine
+{
+namespace audio
+{
+
+class NullAudioEngineFactory : public IAudioEngineFactory
+{
+public:
+	~NullAudioEngineFactory() override = default;
+
+	std::unique_ptr<IAudioEngine> create(
+		utilities::Properties* properties,
+		fs::IFileSystem* fileSystem,
+		logger::ILogger* logger
+	) override
+	{
+		return std::make_unique<NullAudioEngine>(properties, fileSystem, logger);
+	}
+};
+
+}
+}
+
+#endif /* NULLAUDIOENGINEFACTORY_H_ */
@@ -0,0 +1,74 @@
+#ifndef COOKEDASSET_H_
+#define COOKEDASSET_H_
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+
+#include "Types.hpp"
+
+#include "Image.hpp"
+#include "HeightMap.hpp"
+#include "Model.hpp"
+
+namespace ice_engine
+{
+namespace cooking
+{
+
+const uint32 COOKED_ASSET_MAGIC = 0x4B4F4F43; // "COOK"
+const uint32 COOKED_ASSET_VERSION = 4;
+
+enum class CookedAssetType : uint32
+{
+	UNKNOWN = 0,
+	IMAGE = 1,
+	HEIGHT_MAP = 2,
+	MODEL = 3
+};
+
+/**
+ * Cooked assets are engine-native binary blobs produced offline by the cooker tool from models, images and height
+ * maps.  They hold data in the layout the engine uses at runtime, so loading one is a handful of copies out of a
+ * mapped file rather than an import: images are already in their texture format (block compressed by default) with
+ * their mip levels, height maps already have their normals baked in, meshes are already optimized and packed into
+ * their vertex layout (as are the levels of detail generated for them) and skeletons and animations need no conversion
+ * from assimp.
+ *
+ * Cooked assets are written in the byte order of the machine that cooked them and are rejected if the magic doesn't
+ * match, which includes being read on a machine with the other byte order.
+ */
+CookedAssetType cookedAssetType(const byte* data, const size_t size);
+
+std::vector<byte> cookImage(const graphics::IImage& image);
+
+/**
+ * heightMap must already be formatted, i.e. constructed from the source image.
+ */
+std::vector<byte> cookHeightMap(const HeightMap& heightMap);
+
+/**
+ * texturePaths holds the path of the cooked image to use for each of the model's textures, relative to the cooked
+ * model, or an empty string if the texture has no image.
+ */
+std::vector<byte> cookModel(const Model& model, const std::vector<std::string>& texturePaths);
+
+/**
+ * Returns the texture paths a model was cooked with, without loading the model - used to start loading a model's
+ * images before the model itself.
+ */
+std::vector<std::string> cookedModelTexturePaths(const byte* data, const size_t size);
+
+std::unique_ptr<Image> loadImage(const byte* data, const size_t size);
+HeightMap loadHeightMap(const byte* data, const size_t size);
+
+/**
+ * resolveImage is given the texture paths the model was cooked with and returns the image to use for each, or nullptr.
+ */
+std::unique_ptr<Model> loadModel(const byte* data, const size_t size, const std::function<IImage*(const std::string&)>& resolveImage);
+
+}
+}
+
+#endif /* COOKEDASSET_H_ */
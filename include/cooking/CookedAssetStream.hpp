@@ -0,0 +1,208 @@
+#ifndef COOKEDASSETSTREAM_H_
+#define COOKEDASSETSTREAM_H_
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <utility>
+
+#include "Types.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+namespace ice_engine
+{
+namespace cooking
+{
+
+/**
+ * Arrays in a cooked asset start on this boundary so they can be used straight from a mapped file.
+ */
+const size_t COOKED_ASSET_ARRAY_ALIGNMENT = 16;
+
+/**
+ * Writes values in native byte order, with arrays written as one block in their in-memory layout.
+ *
+ * Only trivially copyable types (scalars, glm vectors and matrices, and structs of them) may be written with write() and
+ * writeArray().
+ */
+class CookedAssetWriter
+{
+public:
+	template<typename T>
+	void write(const T& value)
+	{
+		const auto offset = data_.size();
+		data_.resize(offset + sizeof(T));
+		std::memcpy(&data_[offset], &value, sizeof(T));
+	}
+
+	void writeString(const std::string& value)
+	{
+		write(static_cast<uint32>(value.size()));
+		data_.insert(data_.end(), value.begin(), value.end());
+	}
+
+	template<typename T>
+	void writeArray(const std::vector<T>& values)
+	{
+		write(static_cast<uint64>(values.size()));
+		align();
+
+		if (values.empty()) return;
+
+		const auto offset = data_.size();
+		data_.resize(offset + values.size() * sizeof(T));
+		std::memcpy(&data_[offset], values.data(), values.size() * sizeof(T));
+	}
+
+	void align(const size_t alignment = COOKED_ASSET_ARRAY_ALIGNMENT)
+	{
+		data_.resize((data_.size() + alignment - 1) / alignment * alignment, 0);
+	}
+
+	const std::vector<byte>& data() const
+	{
+		return data_;
+	}
+
+	std::vector<byte> release()
+	{
+		return std::move(data_);
+	}
+
+private:
+	std::vector<byte> data_;
+};
+
+/**
+ * Reads values written by a CookedAssetWriter from memory it does not own, such as a mapped file.
+ *
+ * Reading past the end of the data throws a RuntimeException.
+ */
+class CookedAssetReader
+{
+public:
+	CookedAssetReader(const byte* data, const size_t size) : data_(data), size_(size)
+	{
+	}
+
+	template<typename T>
+	T read()
+	{
+		require(sizeof(T));
+
+		T value;
+		std::memcpy(&value, data_ + position_, sizeof(T));
+		position_ += sizeof(T);
+
+		return value;
+	}
+
+	std::string readString()
+	{
+		const auto length = read<uint32>();
+		require(length);
+
+		std::string value(reinterpret_cast<const char*>(data_ + position_), length);
+		position_ += length;
+
+		return value;
+	}
+
+	template<typename T>
+	void readArray(std::vector<T>& values)
+	{
+		const auto count = read<uint64>();
+		align();
+
+		if (count > (size_ - position_) / sizeof(T))
+		{
+			throw RuntimeException("Cooked asset is truncated.");
+		}
+
+		values.resize(static_cast<size_t>(count));
+
+		if (count == 0) return;
+
+		std::memcpy(values.data(), data_ + position_, values.size() * sizeof(T));
+		position_ += values.size() * sizeof(T);
+	}
+
+	/**
+	 * Reads an element count, throwing if the data left is too short to hold that many elements of at least
+	 * minimumElementSize bytes each - so a corrupt count fails before anything is allocated for it.
+	 */
+	uint32 readCount(const size_t minimumElementSize)
+	{
+		const auto count = read<uint32>();
+
+		if (minimumElementSize != 0 && count > remaining() / minimumElementSize)
+		{
+			throw RuntimeException("Cooked asset is truncated.");
+		}
+
+		return count;
+	}
+
+	void skipString()
+	{
+		const auto length = read<uint32>();
+		require(length);
+		position_ += length;
+	}
+
+	template<typename T>
+	void skipArray()
+	{
+		const auto count = read<uint64>();
+		align();
+
+		if (count > (size_ - position_) / sizeof(T))
+		{
+			throw RuntimeException("Cooked asset is truncated.");
+		}
+
+		position_ += static_cast<size_t>(count) * sizeof(T);
+	}
+
+	void align(const size_t alignment = COOKED_ASSET_ARRAY_ALIGNMENT)
+	{
+		const auto position = (position_ + alignment - 1) / alignment * alignment;
+		require(position - position_);
+		position_ = position;
+	}
+
+	size_t position() const
+	{
+		return position_;
+	}
+
+	size_t remaining() const
+	{
+		return size_ - position_;
+	}
+
+	bool eof() const
+	{
+		return position_ == size_;
+	}
+
+private:
+	const byte* data_;
+	size_t size_;
+	size_t position_ = 0;
+
+	void require(const size_t size) const
+	{
+		if (size > size_ - position_)
+		{
+			throw RuntimeException("Cooked asset is truncated.");
+		}
+	}
+};
+
+}
+}
+
+#endif /* COOKEDASSETSTREAM_H_ */
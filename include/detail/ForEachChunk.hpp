@@ -0,0 +1,95 @@
+#ifndef DETAIL_FOREACHCHUNK_H_
+#define DETAIL_FOREACHCHUNK_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "IThreadPool.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace detail
+{
+
+/**
+ * Calls work(chunk, begin, end) for each chunkSize sized chunk of [0, size), on the calling thread and the thread pool's
+ * workers, or only on the calling thread if there is no thread pool.  This returns once all of them are done, and
+ * rethrows the first exception any of them threw.
+ *
+ * The calling thread claims chunks alongside the workers and only waits for chunks that were claimed, so this can't
+ * deadlock when called from one of the thread pool's own workers - if they're all busy, it runs every chunk itself.
+ */
+template<typename Function>
+void forEachChunk(IThreadPool* threadPool, const size_t size, const size_t chunkSize, const Function& work)
+{
+	const size_t chunks = (size + chunkSize - 1) / chunkSize;
+
+	if (chunks == 0) return;
+
+	if (!threadPool || chunks == 1)
+	{
+		for (size_t chunk = 0; chunk < chunks; ++chunk)
+		{
+			work(chunk, chunk * chunkSize, std::min(size, (chunk + 1) * chunkSize));
+		}
+
+		return;
+	}
+
+	struct State
+	{
+		std::atomic<size_t> nextChunk{0};
+		std::atomic<size_t> chunksDone{0};
+		std::mutex mutex;
+		std::condition_variable allChunksDone;
+		std::exception_ptr exception;
+	};
+
+	auto state = std::make_shared<State>();
+
+	// Workers that start after every chunk is claimed return without touching work, which may be gone by then
+	const auto runChunks = [state, &work, chunks, chunkSize, size]() {
+		for (auto chunk = state->nextChunk++; chunk < chunks; chunk = state->nextChunk++)
+		{
+			try
+			{
+				work(chunk, chunk * chunkSize, std::min(size, (chunk + 1) * chunkSize));
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(state->mutex);
+				if (!state->exception) state->exception = std::current_exception();
+			}
+
+			if (++state->chunksDone == chunks)
+			{
+				std::lock_guard<std::mutex> lock(state->mutex);
+				state->allChunksDone.notify_all();
+			}
+		}
+	};
+
+	for (size_t i = 1; i < chunks; ++i)
+	{
+		threadPool->postWork(std::function<void()>(runChunks));
+	}
+
+	runChunks();
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->allChunksDone.wait(lock, [&state, chunks]() { return state->chunksDone == chunks; });
+
+	if (state->exception) std::rethrow_exception(state->exception);
+}
+
+}
+}
+
+#endif /* DETAIL_FOREACHCHUNK_H_ */
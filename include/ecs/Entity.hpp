@@ -27,6 +27,8 @@
 #include "ecs/DirtyComponent.hpp"
 #include "ecs/ParentBoneAttachmentComponent.hpp"
 #include "ecs/PropertiesComponent.hpp"
+#include "ecs/ReplicatedComponent.hpp"
+#include "ecs/LevelOfDetailComponent.hpp"
 
 #include "ModelHandle.hpp"
 
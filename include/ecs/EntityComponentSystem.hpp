@@ -244,6 +244,8 @@ private:
 		if (entity.hasComponent<ice_engine::ecs::ChildrenComponent>())				mask.set(ice_engine::ecs::ChildrenComponent::id());
 		if (entity.hasComponent<ice_engine::ecs::ParentBoneAttachmentComponent>())	mask.set(ice_engine::ecs::ParentBoneAttachmentComponent::id());
 		if (entity.hasComponent<ice_engine::ecs::PropertiesComponent>())	        mask.set(ice_engine::ecs::PropertiesComponent::id());
+		if (entity.hasComponent<ice_engine::ecs::ReplicatedComponent>())			mask.set(ice_engine::ecs::ReplicatedComponent::id());
+		if (entity.hasComponent<ice_engine::ecs::LevelOfDetailComponent>())		mask.set(ice_engine::ecs::LevelOfDetailComponent::id());
 
 		return mask;
 	}
@@ -281,6 +283,8 @@ private:
 		if (entity.hasComponent<ice_engine::ecs::ChildrenComponent>()) saveComponent<Archive, ice_engine::ecs::ChildrenComponent>(ar, entity, version);
 		if (entity.hasComponent<ice_engine::ecs::ParentBoneAttachmentComponent>()) saveComponent<Archive, ice_engine::ecs::ParentBoneAttachmentComponent>(ar, entity, version);
 		if (entity.hasComponent<ice_engine::ecs::PropertiesComponent>()) saveComponent<Archive, ice_engine::ecs::PropertiesComponent>(ar, entity, version);
+		if (entity.hasComponent<ice_engine::ecs::ReplicatedComponent>()) saveComponent<Archive, ice_engine::ecs::ReplicatedComponent>(ar, entity, version);
+		if (entity.hasComponent<ice_engine::ecs::LevelOfDetailComponent>()) saveComponent<Archive, ice_engine::ecs::LevelOfDetailComponent>(ar, entity, version);
 	}
 
 	template<class Archive>
@@ -323,6 +327,8 @@ private:
 		if (mask.test(ice_engine::ecs::ChildrenComponent::id())) loadComponent<Archive, ice_engine::ecs::ChildrenComponent>(ar, entity, version);
 		if (mask.test(ice_engine::ecs::ParentBoneAttachmentComponent::id())) loadComponent<Archive, ice_engine::ecs::ParentBoneAttachmentComponent>(ar, entity, version);
 		if (mask.test(ice_engine::ecs::PropertiesComponent::id())) loadComponent<Archive, ice_engine::ecs::PropertiesComponent>(ar, entity, version);
+		if (mask.test(ice_engine::ecs::ReplicatedComponent::id())) loadComponent<Archive, ice_engine::ecs::ReplicatedComponent>(ar, entity, version);
+		if (mask.test(ice_engine::ecs::LevelOfDetailComponent::id())) loadComponent<Archive, ice_engine::ecs::LevelOfDetailComponent>(ar, entity, version);
 
 		entity.assign<ice_engine::ecs::PersistableComponent>();
 	}
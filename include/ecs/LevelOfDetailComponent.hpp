@@ -0,0 +1,58 @@
+#ifndef LEVELOFDETAILCOMPONENT_H_
+#define LEVELOFDETAILCOMPONENT_H_
+
+#include "serialization/Serialization.hpp"
+
+#include "graphics/RenderableHandle.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace ecs
+{
+
+/**
+ * Lets the scene choose which level of detail an entity's renderable draws, each frame, from how much of the screen
+ * it covers (see Scene::setLevelOfDetailCamera).
+ *
+ * radius is the radius of a sphere around the entity's position that bounds its mesh, before the GraphicsComponent's
+ * scale.  The screen size is multiplied by bias, so a bias above 1 keeps more detail and one below 1 drops it sooner.
+ * levelOfDetail is the level currently drawn by renderableHandle, the renderable it was chosen for, and is read only
+ * to scripts.  Neither is saved, since renderables are created drawing their most detailed level.  When the entity's
+ * renderable changes, the scene starts again from its most detailed level.
+ */
+struct LevelOfDetailComponent
+{
+	LevelOfDetailComponent() = default;
+
+	LevelOfDetailComponent(float32 radius, float32 bias = 1.0f) : radius(radius), bias(bias)
+	{
+	};
+
+	static uint8 id()  { return 19; }
+
+	float32 radius = 1.0f;
+	float32 bias = 1.0f;
+	uint32 levelOfDetail = 0;
+	graphics::RenderableHandle renderableHandle;
+};
+
+}
+}
+
+namespace boost
+{
+namespace serialization
+{
+
+template<class Archive>
+void serialize(Archive& ar, ice_engine::ecs::LevelOfDetailComponent& c, const unsigned int version)
+{
+	ar & c.radius & c.bias;
+}
+
+}
+}
+
+#endif /* LEVELOFDETAILCOMPONENT_H_ */
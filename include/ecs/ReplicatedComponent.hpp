@@ -0,0 +1,56 @@
+#ifndef REPLICATEDCOMPONENT_H_
+#define REPLICATEDCOMPONENT_H_
+
+#include "serialization/Serialization.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace ecs
+{
+
+/**
+ * Marks an entity for replication.
+ *
+ * The network id is assigned by the replication server the first time the entity is replicated, and is the id the
+ * entity is known by on the clients.  It is saved with the scene, and a server keeps the ids it assigns above any
+ * loaded one.  If scriptState is set, the entity's script object is asked to write and read
+ * its own replicated fields (see replication::ReplicationServer).
+ *
+ * Clients with an area of interest receive distant entities less often; priority promotes the entity that many update
+ * rate tiers.
+ */
+struct ReplicatedComponent
+{
+	ReplicatedComponent() = default;
+
+	ReplicatedComponent(uint32 networkId, bool scriptState, uint8 priority = 0) : networkId(networkId), scriptState(scriptState), priority(priority)
+	{
+	};
+
+	static uint8 id()  { return 18; }
+
+	uint32 networkId = 0;
+	bool scriptState = false;
+	uint8 priority = 0;
+};
+
+}
+}
+
+namespace boost
+{
+namespace serialization
+{
+
+template<class Archive>
+void serialize(Archive& ar, ice_engine::ecs::ReplicatedComponent& c, const unsigned int version)
+{
+	ar & c.networkId & c.scriptState & c.priority;
+}
+
+}
+}
+
+#endif /* REPLICATEDCOMPONENT_H_ */
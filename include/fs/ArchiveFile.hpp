@@ -0,0 +1,52 @@
+#ifndef ARCHIVEFILE_H_
+#define ARCHIVEFILE_H_
+
+#include <memory>
+
+#include <boost/iostreams/stream.hpp>
+#include <boost/iostreams/device/array.hpp>
+
+#include "IFile.hpp"
+#include "IMappedFile.hpp"
+
+namespace ice_engine
+{
+namespace fs
+{
+
+/**
+ * A file inside a mounted archive.  Archive files can only be opened for reading; the input stream reads straight
+ * from the file's mapped contents.
+ */
+class ArchiveFile : public IFile
+{
+public:
+	ArchiveFile(std::unique_ptr<IMappedFile> mappedFile, int32 flags);
+	~ArchiveFile() override = default;
+
+	bool isOpen() const override;
+	uint64 size() const override;
+	bool eof() const override;
+
+	std::string path() const override;
+
+	void close() override;
+
+	void write(const char* data) override;
+	void write(const std::string& data) override;
+	std::string read(const uint32 length = 256) override;
+	std::string readAll() override;
+
+	std::istream& getInputStream() override;
+	std::ostream& getOutputStream() override;
+
+private:
+	std::unique_ptr<IMappedFile> mappedFile_;
+
+	boost::iostreams::stream<boost::iostreams::array_source> inputStream_;
+};
+
+}
+}
+
+#endif /* ARCHIVEFILE_H_ */
@@ -4,6 +4,7 @@
 #include <unordered_map>
 
 #include "IFileSystem.hpp"
+#include "PackArchive.hpp"
 
 #include <boost/filesystem.hpp>
 
@@ -37,6 +38,18 @@ public:
 	void mountFile(const std::string& path, const std::string& mountPoint);
 	void unmountFile(const std::string& mountPoint);
 
+    /**
+     * Mounts a pack archive, so the files in it can be accessed as if they were in a directory at mountPoint (or at the
+     * root, if mountPoint is empty).
+     *
+     * Archives are searched before mounted files and directories, most recently mounted first, so a patch archive
+     * mounted after the archive it patches overrides its files.  Files in an archive are read only.
+     * @param path
+     * @param mountPoint
+     */
+	void mountArchive(const std::string& path, const std::string& mountPoint = std::string());
+	void unmountArchive(const std::string& path);
+
 	bool exists(const std::string& file) const override;
 	bool isDirectory(const std::string& file) const override;
 	std::vector<std::string> list(const std::string& directoryName) const override;
@@ -56,12 +69,28 @@ public:
 
 	std::unique_ptr<IFile> open(const std::string& file, int32 flags) const override;
 
+	std::unique_ptr<IMappedFile> map(const std::string& file) const override;
+
 	std::string generateTempFilename() const override;
 
 private:
     std::vector<std::string> mountedDirectories_;
     std::unordered_map<std::string, std::string> mountedFiles_;
 
+    struct MountedArchive
+    {
+        std::string path;
+        std::string mountPoint;
+        std::unique_ptr<PackArchive> archive;
+    };
+
+    std::vector<MountedArchive> mountedArchives_;
+
+    /**
+     * Returns the archive that file is in and file's path within it, or nullptr if it isn't in a mounted archive.
+     */
+    const PackArchive* findArchive(const std::string& file, std::string& archivePath) const;
+
     boost::filesystem::path findPath(const std::string& file) const;
 };
 
@@ -6,6 +6,7 @@
 #include <memory>
 
 #include "IFile.hpp"
+#include "IMappedFile.hpp"
 
 namespace ice_engine
 {
@@ -36,6 +37,11 @@ public:
 
 	virtual std::unique_ptr<IFile> open(const std::string& file, int32 flags) const = 0;
 
+	/**
+	 * Maps the contents of file into memory, read only.
+	 */
+	virtual std::unique_ptr<IMappedFile> map(const std::string& file) const = 0;
+
 	virtual std::string generateTempFilename() const = 0;
 };
 
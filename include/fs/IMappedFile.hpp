@@ -0,0 +1,30 @@
+#ifndef IMAPPEDFILE_H_
+#define IMAPPEDFILE_H_
+
+#include <string>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace fs
+{
+
+/**
+ * Read only view of the contents of a file that is mapped into memory.  The data stays valid for the lifetime of the
+ * mapping.
+ */
+class IMappedFile
+{
+public:
+	virtual ~IMappedFile() = default;
+
+	virtual const byte* data() const = 0;
+	virtual uint64 size() const = 0;
+	virtual std::string path() const = 0;
+};
+
+}
+}
+
+#endif /* IMAPPEDFILE_H_ */
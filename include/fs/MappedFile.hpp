@@ -0,0 +1,37 @@
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "IMappedFile.hpp"
+
+namespace ice_engine
+{
+namespace fs
+{
+
+class MappedFile : public IMappedFile
+{
+public:
+	MappedFile(const std::string& file);
+	~MappedFile() override = default;
+
+	MappedFile(const MappedFile& other) = delete;
+	MappedFile& operator=(const MappedFile& other) = delete;
+
+	const byte* data() const override;
+	uint64 size() const override;
+	std::string path() const override;
+
+private:
+	std::string file_;
+
+	boost::interprocess::file_mapping fileMapping_;
+	boost::interprocess::mapped_region mappedRegion_;
+};
+
+}
+}
+
+#endif /* MAPPEDFILE_H_ */
@@ -0,0 +1,155 @@
+#ifndef PACKARCHIVE_H_
+#define PACKARCHIVE_H_
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_set>
+
+#include "Types.hpp"
+
+#include "IMappedFile.hpp"
+
+namespace ice_engine
+{
+namespace fs
+{
+
+class MappedFile;
+
+const uint32 PACK_ARCHIVE_MAGIC = 0x4B434150; // "PACK"
+const uint32 PACK_ARCHIVE_VERSION = 1;
+
+/**
+ * Entry data starts on this boundary, so cooked assets keep their array alignment when mapped out of an archive.
+ */
+const uint64 PACK_ARCHIVE_ALIGNMENT = 16;
+
+enum class PackArchiveCompression : uint32
+{
+	NONE = 0,
+	ZLIB = 1
+};
+
+struct PackArchiveHeader
+{
+	uint32 magic = PACK_ARCHIVE_MAGIC;
+	uint32 version = PACK_ARCHIVE_VERSION;
+	uint32 numberOfEntries = 0;
+	uint32 numberOfSlots = 0;
+	uint64 entriesOffset = 0;
+	uint64 slotsOffset = 0;
+	uint64 pathsOffset = 0;
+	uint64 pathsSize = 0;
+};
+
+struct PackArchiveEntry
+{
+	uint64 hash = 0;
+	uint64 offset = 0;
+	uint64 size = 0;
+	uint64 storedSize = 0;
+	uint32 pathOffset = 0;
+	uint32 pathLength = 0;
+	PackArchiveCompression compression = PackArchiveCompression::NONE;
+	uint32 reserved = 0;
+};
+
+/**
+ * Normalizes a path for lookup in an archive: separators become '/', and leading '/' and './' are removed.
+ */
+std::string normalizePackArchivePath(const std::string& path);
+
+/**
+ * FNV-1a hash of a normalized path.
+ */
+uint64 packArchivePathHash(const std::string& path);
+
+/**
+ * A read only archive of files, mapped into memory.
+ *
+ * The archive is laid out as a header, the (optionally compressed) file data, and an index made of the entries, an
+ * open addressing hash table of entry indices keyed by path hash, and the paths themselves.  The hash table is
+ * used straight from the mapping, so looking up a file is a hash and usually one probe - no directory walking and no
+ * per-file stat or open calls.
+ */
+class PackArchive
+{
+public:
+	PackArchive(const std::string& filename);
+	~PackArchive();
+
+	PackArchive(const PackArchive& other) = delete;
+	PackArchive& operator=(const PackArchive& other) = delete;
+
+	/**
+	 * Returns true if the archive contains path (which is normalized first).
+	 */
+	bool contains(const std::string& path) const;
+
+	/**
+	 * Returns the entry for path, or nullptr if the archive doesn't contain it.
+	 */
+	const PackArchiveEntry* find(const std::string& path) const;
+
+	/**
+	 * Returns the contents of the file at path.  Uncompressed files are a view into the archive's mapping, compressed
+	 * files are decompressed into memory.
+	 *
+	 * Throws FileNotFoundException if the archive doesn't contain path.
+	 */
+	std::unique_ptr<IMappedFile> map(const std::string& path) const;
+
+	/**
+	 * Returns the paths of all files in the archive, in the order they were added.
+	 */
+	std::vector<std::string> paths() const;
+
+	const std::string& filename() const;
+	uint32 size() const;
+
+private:
+	std::string filename_;
+	std::shared_ptr<MappedFile> mappedFile_;
+
+	PackArchiveHeader header_;
+	std::vector<PackArchiveEntry> entries_;
+	const uint32* slots_ = nullptr;
+	const char* paths_ = nullptr;
+
+	std::string entryPath(const PackArchiveEntry& entry) const;
+};
+
+/**
+ * Builds a pack archive.  Files are added in memory and written out in the order they were added.
+ */
+class PackArchiveWriter
+{
+public:
+	/**
+	 * Adds the file at path (which is normalized first).  If compress is true the data is stored compressed, unless
+	 * compressing doesn't make it smaller.
+	 *
+	 * Throws InvalidArgumentException if path is empty or already in the archive.
+	 */
+	void add(const std::string& path, std::vector<byte> data, const bool compress = false);
+
+	void write(const std::string& filename) const;
+
+private:
+	struct PendingEntry
+	{
+		std::string path;
+		std::vector<byte> data;
+		uint64 size;
+		PackArchiveCompression compression;
+	};
+
+	std::vector<PendingEntry> entries_;
+	std::unordered_set<std::string> paths_;
+};
+
+}
+}
+
+#endif /* PACKARCHIVE_H_ */
@@ -165,6 +165,21 @@ public:
 		const glm::quat& orientation,
 		const glm::vec3& scale = glm::vec3(1.0f)
 	) = 0;
+
+	/**
+	 * Creates a renderable that draws one of levelsOfDetail at a time, most detailed first, starting with the first.
+	 * levelOfDetail() chooses which is drawn; levels past the last draw the last.
+	 */
+	virtual RenderableHandle createRenderable(
+		const RenderSceneHandle& renderSceneHandle,
+		const std::vector<MeshHandle>& levelsOfDetail,
+		const TextureHandle& textureHandle,
+		const glm::vec3& position,
+		const glm::quat& orientation,
+		const glm::vec3& scale = glm::vec3(1.0f),
+		const ShaderProgramHandle& shaderProgramHandle = ShaderProgramHandle()
+	) = 0;
+	virtual void levelOfDetail(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const uint32 levelOfDetail) = 0;
     virtual bool valid(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) const = 0;
 	virtual void destroy(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) = 0;
 
@@ -13,19 +13,36 @@ namespace graphics
 class IImage
 {
 public:
+	/**
+	 * The BC formats are block compressed in 4x4 pixel blocks: BC1 is RGB at 8 bytes per block, BC3 is RGBA at 16 bytes
+	 * per block and BC5 is two channels (red and green, e.g. a normal map's x and y) at 16 bytes per block.
+	 */
 	enum Format
 	{
 		FORMAT_UNKNOWN = -1,
 		FORMAT_RGB,
-		FORMAT_RGBA
+		FORMAT_RGBA,
+		FORMAT_BC1,
+		FORMAT_BC3,
+		FORMAT_BC5
 	};
 
 	virtual ~IImage() = default;
 
+	/**
+	 * The pixels of the full size image, the same as mipLevel(0).
+	 */
 	virtual const std::vector<byte>& data() const = 0;
 	virtual uint32 width() const = 0;
 	virtual uint32 height() const = 0;
 	virtual int32 format() const = 0;
+
+	/**
+	 * Number of mip levels the image carries, at least 1.  Level n is max(1, width >> n) by max(1, height >> n) pixels,
+	 * in the same format as the full size image.  An image with only 1 level leaves making mips to the graphics engine.
+	 */
+	virtual uint32 mipLevelCount() const = 0;
+	virtual const std::vector<byte>& mipLevel(const uint32 level) const = 0;
 };
 
 }
@@ -7,6 +7,8 @@
 #define GLM_FORCE_RADIANS
 #include <glm/glm.hpp>
 
+#include "graphics/VertexLayout.hpp"
+
 #include "Types.hpp"
 
 namespace ice_engine
@@ -25,6 +27,15 @@ public:
 	virtual const std::vector< glm::vec4 >& colors() const = 0;
 	virtual const std::vector< glm::vec3 >& normals() const = 0;
 	virtual const std::vector< glm::vec2 >& textureCoordinates() const = 0;
+
+	/**
+	 * Packed vertex and index data, laid out as vertexLayout() describes.  When a mesh has packed data it is what should
+	 * be uploaded, and the float streams above may be empty.  Meshes that haven't been packed have a layout with no
+	 * attributes and no packed data.
+	 */
+	virtual const VertexLayout& vertexLayout() const = 0;
+	virtual const std::vector< std::vector<byte> >& vertexStreams() const = 0;
+	virtual const std::vector< byte >& indexData() const = 0;
 };
 
 }
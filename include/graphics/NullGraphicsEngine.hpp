@@ -0,0 +1,337 @@
+#ifndef NULLGRAPHICSENGINE_H_
+#define NULLGRAPHICSENGINE_H_
+
+#include <atomic>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include "graphics/IGraphicsEngine.hpp"
+
+#include "utilities/Properties.hpp"
+#include "fs/IFileSystem.hpp"
+#include "logger/ILogger.hpp"
+
+namespace ice_engine
+{
+namespace graphics
+{
+
+/**
+ * Counts of the calls made on a NullGraphicsEngine and the amount of data passed to it.
+ *
+ * Counters are updated atomically, since scenes tick concurrently.
+ */
+struct NullGraphicsEngineStatistics
+{
+	std::atomic<uint64> frames{0};
+	std::atomic<uint64> renderSceneCalls{0};
+	std::atomic<uint64> linesRendered{0};
+	std::atomic<uint64> meshesCreated{0};
+	std::atomic<uint64> verticesUploaded{0};
+	std::atomic<uint64> indicesUploaded{0};
+	std::atomic<uint64> texturesCreated{0};
+	std::atomic<uint64> textureBytesUploaded{0};
+	std::atomic<uint64> renderablesCreated{0};
+	std::atomic<uint64> renderablesDestroyed{0};
+	std::atomic<uint64> transformUpdates{0};
+	std::atomic<uint64> levelOfDetailChanges{0};
+	std::atomic<uint64> boneTransformsUploaded{0};
+
+	void reset()
+	{
+		frames = 0;
+		renderSceneCalls = 0;
+		linesRendered = 0;
+		meshesCreated = 0;
+		verticesUploaded = 0;
+		indicesUploaded = 0;
+		texturesCreated = 0;
+		textureBytesUploaded = 0;
+		renderablesCreated = 0;
+		renderablesDestroyed = 0;
+		transformUpdates = 0;
+		levelOfDetailChanges = 0;
+		boneTransformsUploaded = 0;
+	}
+};
+
+/**
+ * Graphics engine that does no work.
+ *
+ * Handles returned are unique and valid, but nothing is rendered and no state is kept.  Calls that would do work
+ * are counted in statistics(), which makes it suitable for headless benchmarks and tests.
+ */
+class NullGraphicsEngine : public IGraphicsEngine
+{
+public:
+	NullGraphicsEngine(utilities::Properties* properties, fs::IFileSystem* fileSystem, logger::ILogger* logger)
+		:
+		properties_(properties),
+		fileSystem_(fileSystem),
+		logger_(logger)
+	{
+		viewport_ = glm::uvec2(
+			static_cast<uint32>(properties_->getIntValue(std::string("window.width"), 1024)),
+			static_cast<uint32>(properties_->getIntValue(std::string("window.height"), 768))
+		);
+	}
+
+	~NullGraphicsEngine() override = default;
+
+	void setViewport(const uint32 width, const uint32 height) override { viewport_ = glm::uvec2(width, height); }
+	glm::uvec2 getViewport() const override { return viewport_; }
+
+	glm::mat4 getModelMatrix() const override { return glm::mat4(1.0f); }
+	glm::mat4 getViewMatrix() const override { return glm::mat4(1.0f); }
+	glm::mat4 getProjectionMatrix() const override { return glm::mat4(1.0f); }
+
+	void beginRender() override { ++statistics_.frames; }
+	void render(const RenderSceneHandle& renderSceneHandle) override { ++statistics_.renderSceneCalls; }
+	void renderLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color) override { ++statistics_.linesRendered; }
+	void renderLines(const std::vector<std::tuple<glm::vec3, glm::vec3, glm::vec3>>& lineData) override { statistics_.linesRendered += lineData.size(); }
+	void endRender() override {}
+
+	RenderSceneHandle createRenderScene() override { return nextHandle<RenderSceneHandle>(); }
+	bool valid(const RenderSceneHandle& renderSceneHandle) const override { return renderSceneHandle.valid(); }
+	void destroy(const RenderSceneHandle& renderSceneHandle) override {}
+
+	CameraHandle createCamera(const glm::vec3& position, const glm::vec3& lookAt) override { return nextHandle<CameraHandle>(); }
+	bool valid(const CameraHandle& cameraHandle) const override { return cameraHandle.valid(); }
+	void destroy(const CameraHandle& cameraHandle) override {}
+
+	PointLightHandle createPointLight(const RenderSceneHandle& renderSceneHandle, const glm::vec3& position) override { return nextHandle<PointLightHandle>(); }
+	bool valid(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle) const override { return pointLightHandle.valid(); }
+	void destroy(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle) override {}
+
+	MeshHandle createStaticMesh(const IMesh& mesh) override { return createMesh(mesh); }
+	MeshHandle createDynamicMesh(const IMesh& mesh) override { return createMesh(mesh); }
+	bool valid(const MeshHandle& meshHandle) const override { return meshHandle.valid(); }
+	void destroy(const MeshHandle& meshHandle) override {}
+
+	SkeletonHandle createSkeleton(const MeshHandle& meshHandle, const ISkeleton& skeleton) override { return nextHandle<SkeletonHandle>(); }
+	bool valid(const SkeletonHandle& skeletonHandle) const override { return skeletonHandle.valid(); }
+	void destroy(const SkeletonHandle& skeletonHandle) override {}
+
+	BonesHandle createBones(const uint32 maxNumberOfBones) override { return nextHandle<BonesHandle>(); }
+	bool valid(const BonesHandle& bonesHandle) const override { return bonesHandle.valid(); }
+	void destroy(const BonesHandle& bonesHandle) override {}
+
+	void attach(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const BonesHandle& bonesHandle) override {}
+	void detach(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const BonesHandle& bonesHandle) override {}
+
+	void attachBoneAttachment(
+		const RenderSceneHandle& renderSceneHandle,
+		const RenderableHandle& renderableHandle,
+		const BonesHandle& bonesHandle,
+		const glm::ivec4& boneIds,
+		const glm::vec4& boneWeights
+	) override {}
+	void detachBoneAttachment(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) override {}
+
+	TextureHandle createTexture2d(const ITexture& texture) override
+	{
+		++statistics_.texturesCreated;
+		if (texture.image()) statistics_.textureBytesUploaded += texture.image()->data().size();
+
+		return nextHandle<TextureHandle>();
+	}
+	bool valid(const TextureHandle& textureHandle) const override { return textureHandle.valid(); }
+	void destroy(const TextureHandle& textureHandle) override {}
+
+	MaterialHandle createMaterial(const IPbrMaterial& pbrMaterial) override { return nextHandle<MaterialHandle>(); }
+	bool valid(const MaterialHandle& materialHandle) const override { return materialHandle.valid(); }
+	void destroy(const MaterialHandle& materialHandle) override {}
+
+	TerrainHandle createStaticTerrain(const IHeightMap& heightMap, const ISplatMap& splatMap, const IDisplacementMap& displacementMap) override { return nextHandle<TerrainHandle>(); }
+	bool valid(const TerrainHandle& terrainHandle) const override { return terrainHandle.valid(); }
+	void destroy(const TerrainHandle& terrainHandle) override {}
+
+	SkyboxHandle createStaticSkybox(const IImage& back, const IImage& down, const IImage& front, const IImage& left, const IImage& right, const IImage& up) override { return nextHandle<SkyboxHandle>(); }
+	bool valid(const SkyboxHandle& skyboxHandle) const override { return skyboxHandle.valid(); }
+	void destroy(const SkyboxHandle& skyboxHandle) override {}
+
+	VertexShaderHandle createVertexShader(const std::string& data) override { return nextHandle<VertexShaderHandle>(); }
+	FragmentShaderHandle createFragmentShader(const std::string& data) override { return nextHandle<FragmentShaderHandle>(); }
+	TessellationControlShaderHandle createTessellationControlShader(const std::string& data) override { return nextHandle<TessellationControlShaderHandle>(); }
+	TessellationEvaluationShaderHandle createTessellationEvaluationShader(const std::string& data) override { return nextHandle<TessellationEvaluationShaderHandle>(); }
+	bool valid(const VertexShaderHandle& shaderHandle) const override { return shaderHandle.valid(); }
+	bool valid(const FragmentShaderHandle& shaderHandle) const override { return shaderHandle.valid(); }
+	bool valid(const TessellationControlShaderHandle& shaderHandle) const override { return shaderHandle.valid(); }
+	bool valid(const TessellationEvaluationShaderHandle& shaderHandle) const override { return shaderHandle.valid(); }
+	void destroy(const VertexShaderHandle& shaderHandle) override {}
+	void destroy(const FragmentShaderHandle& shaderHandle) override {}
+	void destroy(const TessellationControlShaderHandle& shaderHandle) override {}
+	void destroy(const TessellationEvaluationShaderHandle& shaderHandle) override {}
+	ShaderProgramHandle createShaderProgram(const VertexShaderHandle& vertexShaderHandle, const FragmentShaderHandle& fragmentShaderHandle) override { return nextHandle<ShaderProgramHandle>(); }
+	ShaderProgramHandle createShaderProgram(
+		const VertexShaderHandle& vertexShaderHandle,
+		const TessellationControlShaderHandle& tessellationControlShaderHandle,
+		const TessellationEvaluationShaderHandle& tessellationEvaluationShaderHandle,
+		const FragmentShaderHandle& fragmentShaderHandle
+	) override { return nextHandle<ShaderProgramHandle>(); }
+	bool valid(const ShaderProgramHandle& shaderProgramHandle) const override { return shaderProgramHandle.valid(); }
+	void destroy(const ShaderProgramHandle& shaderProgramHandle) override {}
+
+	RenderableHandle createRenderable(
+		const RenderSceneHandle& renderSceneHandle,
+		const MeshHandle& meshHandle,
+		const TextureHandle& textureHandle,
+		const glm::vec3& position,
+		const glm::quat& orientation,
+		const glm::vec3& scale,
+		const ShaderProgramHandle& shaderProgramHandle
+	) override
+	{
+		++statistics_.renderablesCreated;
+
+		return nextHandle<RenderableHandle>();
+	}
+	RenderableHandle createRenderable(
+		const RenderSceneHandle& renderSceneHandle,
+		const MeshHandle& meshHandle,
+		const MaterialHandle& materialHandle,
+		const glm::vec3& position,
+		const glm::quat& orientation,
+		const glm::vec3& scale
+	) override
+	{
+		++statistics_.renderablesCreated;
+
+		return nextHandle<RenderableHandle>();
+	}
+	RenderableHandle createRenderable(
+		const RenderSceneHandle& renderSceneHandle,
+		const std::vector<MeshHandle>& levelsOfDetail,
+		const TextureHandle& textureHandle,
+		const glm::vec3& position,
+		const glm::quat& orientation,
+		const glm::vec3& scale,
+		const ShaderProgramHandle& shaderProgramHandle
+	) override
+	{
+		++statistics_.renderablesCreated;
+
+		return nextHandle<RenderableHandle>();
+	}
+	void levelOfDetail(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const uint32 levelOfDetail) override { ++statistics_.levelOfDetailChanges; }
+	bool valid(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) const override { return renderableHandle.valid(); }
+	void destroy(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) override { ++statistics_.renderablesDestroyed; }
+
+	TerrainRenderableHandle createTerrainRenderable(const RenderSceneHandle& renderSceneHandle, const TerrainHandle& terrainHandle) override { return nextHandle<TerrainRenderableHandle>(); }
+	bool valid(const RenderSceneHandle& renderSceneHandle, const TerrainRenderableHandle& terrainRenderableHandle) const override { return terrainRenderableHandle.valid(); }
+	void destroy(const RenderSceneHandle& renderSceneHandle, const TerrainRenderableHandle& terrainRenderableHandle) override {}
+
+	SkyboxRenderableHandle createSkyboxRenderable(const RenderSceneHandle& renderSceneHandle, const SkyboxHandle& skyboxHandle) override { return nextHandle<SkyboxRenderableHandle>(); }
+	bool valid(const RenderSceneHandle& renderSceneHandle, const SkyboxRenderableHandle& skyboxRenderableHandle) const override { return skyboxRenderableHandle.valid(); }
+	void destroy(const RenderSceneHandle& renderSceneHandle, const SkyboxRenderableHandle& skyboxRenderableHandle) override {}
+
+	void rotate(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::quat& quaternion, const TransformSpace& relativeTo) override { ++statistics_.transformUpdates; }
+	void rotate(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 degrees, const glm::vec3& axis, const TransformSpace& relativeTo) override { ++statistics_.transformUpdates; }
+	void rotate(const CameraHandle& cameraHandle, const glm::quat& quaternion, const TransformSpace& relativeTo) override { ++statistics_.transformUpdates; }
+	void rotate(const CameraHandle& cameraHandle, const float32 degrees, const glm::vec3& axis, const TransformSpace& relativeTo) override { ++statistics_.transformUpdates; }
+
+	void rotation(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::quat& quaternion) override { ++statistics_.transformUpdates; }
+	void rotation(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 degrees, const glm::vec3& axis) override { ++statistics_.transformUpdates; }
+	glm::quat rotation(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) const override { return glm::quat(); }
+	void rotation(const CameraHandle& cameraHandle, const glm::quat& quaternion) override { ++statistics_.transformUpdates; }
+	void rotation(const CameraHandle& cameraHandle, const float32 degrees, const glm::vec3& axis) override { ++statistics_.transformUpdates; }
+	glm::quat rotation(const CameraHandle& cameraHandle) const override { return glm::quat(); }
+
+	void translate(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 x, const float32 y, const float32 z) override { ++statistics_.transformUpdates; }
+	void translate(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::vec3& trans) override { ++statistics_.transformUpdates; }
+	void translate(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle, const float32 x, const float32 y, const float32 z) override { ++statistics_.transformUpdates; }
+	void translate(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle, const glm::vec3& trans) override { ++statistics_.transformUpdates; }
+	void translate(const CameraHandle& cameraHandle, const float32 x, const float32 y, const float32 z) override { ++statistics_.transformUpdates; }
+	void translate(const CameraHandle& cameraHandle, const glm::vec3& trans) override { ++statistics_.transformUpdates; }
+
+	void scale(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 x, const float32 y, const float32 z) override { ++statistics_.transformUpdates; }
+	void scale(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::vec3& scale) override { ++statistics_.transformUpdates; }
+	void scale(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 scale) override { ++statistics_.transformUpdates; }
+	glm::vec3 scale(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) const override { return glm::vec3(1.0f); }
+
+	void position(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const float32 x, const float32 y, const float32 z) override { ++statistics_.transformUpdates; }
+	void position(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::vec3& position) override { ++statistics_.transformUpdates; }
+	glm::vec3 position(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle) const override { return glm::vec3(); }
+	void position(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle, const float32 x, const float32 y, const float32 z) override { ++statistics_.transformUpdates; }
+	void position(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle, const glm::vec3& position) override { ++statistics_.transformUpdates; }
+	glm::vec3 position(const RenderSceneHandle& renderSceneHandle, const PointLightHandle& pointLightHandle) const override { return glm::vec3(); }
+	void position(const CameraHandle& cameraHandle, const float32 x, const float32 y, const float32 z) override { ++statistics_.transformUpdates; }
+	void position(const CameraHandle& cameraHandle, const glm::vec3& position) override { ++statistics_.transformUpdates; }
+	glm::vec3 position(const CameraHandle& cameraHandle) const override { return glm::vec3(); }
+
+	void lookAt(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const glm::vec3& lookAt) override { ++statistics_.transformUpdates; }
+	void lookAt(const CameraHandle& cameraHandle, const glm::vec3& lookAt) override { ++statistics_.transformUpdates; }
+
+	void assign(const RenderSceneHandle& renderSceneHandle, const RenderableHandle& renderableHandle, const SkeletonHandle& skeletonHandle) override {}
+
+	void update(
+		const RenderSceneHandle& renderSceneHandle,
+		const RenderableHandle& renderableHandle,
+		const BonesHandle& bonesHandle,
+		const std::vector<glm::mat4>& transformations
+	) override
+	{
+		statistics_.boneTransformsUploaded += transformations.size();
+	}
+
+	void setMouseRelativeMode(const bool enabled) override {}
+	void setWindowGrab(const bool enabled) override {}
+	bool cursorVisible() const override { return cursorVisible_; }
+	void setCursorVisible(const bool visible) override { cursorVisible_ = visible; }
+
+	void processEvents() override {}
+	void addEventListener(IEventListener* eventListener) override {}
+	void removeEventListener(IEventListener* eventListener) override {}
+
+	const NullGraphicsEngineStatistics& statistics() const
+	{
+		return statistics_;
+	}
+
+	void resetStatistics()
+	{
+		statistics_.reset();
+	}
+
+private:
+	utilities::Properties* properties_;
+	fs::IFileSystem* fileSystem_;
+	logger::ILogger* logger_;
+
+	glm::uvec2 viewport_;
+	bool cursorVisible_ = true;
+
+	std::atomic<uint32> nextIndex_{0};
+	NullGraphicsEngineStatistics statistics_;
+
+	template<typename T>
+	T nextHandle()
+	{
+		return T(++nextIndex_, 1);
+	}
+
+	MeshHandle createMesh(const IMesh& mesh)
+	{
+		++statistics_.meshesCreated;
+
+		const auto& vertexLayout = mesh.vertexLayout();
+
+		if (vertexLayout.attributes.empty())
+		{
+			statistics_.verticesUploaded += mesh.vertices().size();
+			statistics_.indicesUploaded += mesh.indices().size();
+		}
+		else
+		{
+			statistics_.verticesUploaded += mesh.vertexStreams()[0].size() / vertexLayout.strides[0];
+			statistics_.indicesUploaded += mesh.indexData().size() / (vertexLayout.indexFormat == IndexFormat::UINT16 ? sizeof(uint16) : sizeof(uint32));
+		}
+
+		return nextHandle<MeshHandle>();
+	}
+};
+
+}
+}
+
+#endif /* NULLGRAPHICSENGINE_H_ */
@@ -0,0 +1,32 @@
+#ifndef NULLGRAPHICSENGINEFACTORY_H_
+#define NULLGRAPHICSENGINEFACTORY_H_
+
+#include <memory>
+
+#include "graphics/IGraphicsEngineFactory.hpp"
+#include "graphics/NullGraphicsEngine.hpp"
+
+namespace ice_engine
+{
+namespace graphics
+{
+
+class NullGraphicsEngineFactory : public IGraphicsEngineFactory
+{
+public:
+	~NullGraphicsEngineFactory() override = default;
+
+	std::unique_ptr<IGraphicsEngine> create(
+		utilities::Properties* properties,
+		fs::IFileSystem* fileSystem,
+		logger::ILogger* logger
+	) override
+	{
+		return std::make_unique<NullGraphicsEngine>(properties, fileSystem, logger);
+	}
+};
+
+}
+}
+
+#endif /* NULLGRAPHICSENGINEFACTORY_H_ */
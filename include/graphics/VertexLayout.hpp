@@ -0,0 +1,70 @@
+#ifndef VERTEXLAYOUT_H_
+#define VERTEXLAYOUT_H_
+
+#include <vector>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace graphics
+{
+
+enum struct VertexAttribute : uint32
+{
+	POSITION = 0,
+	NORMAL,
+	TEXTURE_COORDINATE,
+	COLOR,
+	BONE_IDS,
+	BONE_WEIGHTS
+};
+
+/**
+ * How a vertex attribute is stored.  SNORM and UNORM values are normalized integers, expanded to [-1, 1] and [0, 1]
+ * when the GPU fetches them, FLOAT16 values are half floats and UINT values are plain integers.
+ */
+enum struct VertexAttributeFormat : uint32
+{
+	FLOAT32_3 = 0,
+	FLOAT16_2,
+	SNORM8_4,
+	UNORM8_4,
+	UINT8_4,
+	UINT16_4
+};
+
+enum struct IndexFormat : uint32
+{
+	UINT16 = 0,
+	UINT32
+};
+
+struct VertexAttributeLayout
+{
+	VertexAttribute attribute;
+	VertexAttributeFormat format;
+
+	uint32 stream = 0;
+
+	/**
+	 * Offset in bytes of the attribute from the start of each vertex in its stream.
+	 */
+	uint32 offset = 0;
+};
+
+/**
+ * Describes packed mesh data: the attributes each vertex has, which stream each of them is in and where, the stride of
+ * each stream and the size of the indices.
+ */
+struct VertexLayout
+{
+	std::vector<VertexAttributeLayout> attributes;
+	std::vector<uint32> strides;
+	IndexFormat indexFormat = IndexFormat::UINT32;
+};
+
+}
+}
+
+#endif /* VERTEXLAYOUT_H_ */
@@ -0,0 +1,55 @@
+#ifndef BLOCKCOMPRESSION_H_
+#define BLOCKCOMPRESSION_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Image.hpp"
+#include "IThreadPool.hpp"
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace image
+{
+
+/**
+ * Parses "rgb", "rgba", "bc1", "bc3" or "bc5" into an image format.
+ */
+IImage::Format formatFromString(const std::string& format);
+
+bool isBlockCompressed(const IImage::Format format);
+
+/**
+ * Size in bytes of a width x height image in format.  Block compressed images are rounded up to whole 4x4 blocks.
+ */
+size_t imageSize(const IImage::Format format, const uint32 width, const uint32 height);
+
+/**
+ * Block compresses RGBA pixels into format (BC1, BC3 or BC5).  BC1 drops alpha and BC5 keeps only red and green.
+ * Blocks that hang over the right or bottom edge repeat the edge pixels.  Rows of blocks are shared out across
+ * threadPool if there is one.
+ *
+ * The encoder fits each block's endpoints along the principal axis of its colours, which is fast enough to run at load
+ * time and close to what offline encoders give for most textures.
+ */
+void compress(
+	const byte* rgba,
+	const uint32 width,
+	const uint32 height,
+	const IImage::Format format,
+	std::vector<byte>& result,
+	IThreadPool* threadPool = nullptr
+);
+
+/**
+ * Builds the image a texture should be created from: a full mip chain, down to 1x1, in format.  image must be RGB or
+ * RGBA.
+ */
+std::unique_ptr<Image> createTextureImage(const graphics::IImage& image, const IImage::Format format, IThreadPool* threadPool = nullptr);
+
+}
+}
+
+#endif /* BLOCKCOMPRESSION_H_ */
@@ -0,0 +1,71 @@
+#ifndef IMAGEPROCESSING_H_
+#define IMAGEPROCESSING_H_
+
+#include <vector>
+
+#include "IThreadPool.hpp"
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace image
+{
+
+/**
+ * Bulk pixel operations for image loading and height map generation.
+ *
+ * Each one works on whole rows of tightly packed 8 bit pixels, with loops kept free of branches and per pixel index
+ * math so the compiler can vectorise them.  Given a thread pool, the rows are shared out across it and the call returns
+ * once they are all done.
+ */
+
+/**
+ * Swaps the first and third channel of each pixel in place, turning BGR into RGB (or BGRA into RGBA) and back.
+ *
+ * @param pixelSize 3 or 4.
+ */
+void swapRedAndBlue(byte* pixels, const size_t pixelCount, const uint32 pixelSize, IThreadPool* threadPool = nullptr);
+
+/**
+ * Copies RGB pixels into RGBA pixels, with alpha set to 255.
+ */
+void rgbToRgba(const byte* rgb, byte* rgba, const size_t pixelCount, IThreadPool* threadPool = nullptr);
+
+/**
+ * Copies RGBA pixels into RGB pixels, dropping alpha.
+ */
+void rgbaToRgb(const byte* rgba, byte* rgb, const size_t pixelCount, IThreadPool* threadPool = nullptr);
+
+/**
+ * Sets the alpha of each RGBA pixel to the average of its red, green and blue.
+ */
+void luminanceToAlpha(byte* rgba, const size_t pixelCount, IThreadPool* threadPool = nullptr);
+
+/**
+ * Treats the alpha of each RGBA pixel as a height and writes the normal at that pixel, found with a Sobel filter, into
+ * red, green and blue (mapped from [-1, 1] to [0, 255]).  The image wraps around at its edges.  Alpha is left as it is.
+ *
+ * @param strength How steep the normals are; higher values give steeper normals.
+ */
+void sobelNormals(byte* rgba, const uint32 width, const uint32 height, const float32 strength, IThreadPool* threadPool = nullptr);
+
+/**
+ * Halves the size of an image with a 2x2 box filter, the way each mip level is made from the one before it.  Sizes are
+ * rounded down (the last row or column of an odd sized image is dropped) but never go below 1.
+ *
+ * @param pixelSize Number of 8 bit channels per pixel.
+ * @param result Filled with the max(1, width / 2) * max(1, height / 2) pixels of the smaller image.
+ */
+void downsample(
+	const byte* pixels,
+	const uint32 width,
+	const uint32 height,
+	const uint32 pixelSize,
+	std::vector<byte>& result,
+	IThreadPool* threadPool = nullptr
+);
+
+}
+}
+
+#endif /* IMAGEPROCESSING_H_ */
@@ -0,0 +1,70 @@
+#ifndef LEVELOFDETAIL_H_
+#define LEVELOFDETAIL_H_
+
+#include <vector>
+
+#include "Mesh.hpp"
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace mesh
+{
+
+/**
+ * Most levels of detail a renderable can have, including the full detail mesh.
+ */
+const uint32 MAXIMUM_LEVELS_OF_DETAIL = 8;
+
+struct LevelOfDetailOptions
+{
+	/**
+	 * How many levels to generate below the mesh itself.
+	 */
+	uint32 levelCount = 3;
+
+	/**
+	 * The fraction of the previous level's triangles each level is simplified to.
+	 */
+	float32 reduction = 0.5f;
+
+	/**
+	 * How far a level may move the surface, relative to the size of the mesh's bounds.  Levels that can't get within
+	 * half of their reduction without moving it further aren't generated, nor are the levels after them.
+	 */
+	float32 maximumError = 0.05f;
+};
+
+/**
+ * Generates the lower levels of detail of mesh, each simplified from the one before.
+ *
+ * Each level has the same vertices as mesh and its own indices, so they should be optimized (which drops the vertices
+ * they don't use) before they are packed or uploaded.  mesh must still have its float vertex streams.
+ */
+std::vector<Mesh> generateLevelsOfDetail(const Mesh& mesh, const LevelOfDetailOptions& options = LevelOfDetailOptions());
+
+/**
+ * The height of a sphere of radius at distance from a camera with a vertical field of view (in radians), as a fraction
+ * of the height of the viewport.
+ */
+float32 screenSize(const float32 radius, const float32 distance, const float32 fieldOfView);
+
+/**
+ * Chooses the level of detail to draw at screenSize, out of levelCount levels.  screenSizes[i] is the size below which
+ * level i + 1 is drawn instead of level i, so it should be decreasing.
+ *
+ * The level only changes once screenSize is past a threshold by more than hysteresis (a fraction of the threshold),
+ * so something sitting near a threshold doesn't switch back and forth every frame.
+ */
+uint32 selectLevelOfDetail(
+	const std::vector<float32>& screenSizes,
+	const uint32 levelCount,
+	const float32 screenSize,
+	const uint32 levelOfDetail,
+	const float32 hysteresis
+);
+
+}
+}
+
+#endif /* LEVELOFDETAIL_H_ */
@@ -0,0 +1,107 @@
+#ifndef MESHOPTIMIZATION_H_
+#define MESHOPTIMIZATION_H_
+
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "Mesh.hpp"
+#include "Types.hpp"
+
+#include "graphics/VertexLayout.hpp"
+
+namespace ice_engine
+{
+namespace mesh
+{
+
+const uint32 INVALID_VERTEX = ~0u;
+
+/**
+ * Which of the float vertex streams optimize keeps next to the packed data.  The packed data is all drawing needs; the
+ * float streams are for whatever reads the mesh on the CPU, and keeping all of them roughly doubles the size of a mesh.
+ */
+enum class VertexStreams
+{
+	// Only the packed data, for meshes that are only ever drawn
+	NONE,
+
+	// Positions and indices, which is all collision shapes and navigation meshes are built from
+	POSITIONS,
+
+	// Every float stream, for meshes otherwise read on the CPU
+	ALL
+};
+
+struct MeshOptimizationOptions
+{
+	/**
+	 * Put positions in a stream of their own, ahead of the rest of the attributes, so depth and shadow passes only
+	 * fetch positions.  Otherwise every attribute is interleaved in one stream.
+	 */
+	bool splitPositions = false;
+
+	/**
+	 * The float vertex streams to keep next to the packed data.  Pick the least that the mesh's users need: NONE for
+	 * meshes that are only drawn, POSITIONS for ones also used for physics or pathfinding.
+	 */
+	VertexStreams keepVertexStreams = VertexStreams::ALL;
+
+	/**
+	 * How many more vertex cache misses overdraw optimization may cost, as a ratio - 1.05 allows 5% more.
+	 */
+	float32 overdrawThreshold = 1.05f;
+};
+
+/**
+ * Average number of vertices transformed per triangle when drawing indices through a FIFO post transform cache of
+ * cacheSize vertices.  Between 0.5 for a perfect regular grid and 3 when no vertex is ever reused.
+ */
+float32 averageCacheMissRatio(const std::vector<uint32>& indices, const uint32 vertexCount, const uint32 cacheSize = 16);
+
+/**
+ * Reorders triangles so that vertices are reused while they are still in the post transform cache (Forsyth's linear
+ * speed vertex cache optimization).  Triangles keep their winding.
+ */
+void optimizeVertexCache(std::vector<uint32>& indices, const uint32 vertexCount);
+
+/**
+ * Reorders clusters of triangles, so that the ones facing out from the middle of the mesh are drawn first and hide
+ * more of the ones behind them.  Clusters are split from the existing order wherever that costs at most threshold
+ * times the vertex cache misses, so this should run after optimizeVertexCache.
+ */
+void optimizeOverdraw(std::vector<uint32>& indices, const std::vector<glm::vec3>& vertices, const float32 threshold = 1.05f);
+
+/**
+ * Renumbers vertices in the order indices first use them, so vertex fetches walk memory forward, and drops vertices no
+ * index uses.  indices are rewritten in place.  Returns the new index of each old vertex, or INVALID_VERTEX for
+ * vertices that were dropped.
+ */
+std::vector<uint32> optimizeVertexFetch(std::vector<uint32>& indices, const uint32 vertexCount);
+
+/**
+ * Chooses the packed layout for mesh: float32 positions, normals in 8 bit signed normalized, texture coordinates in
+ * half floats, colors and bone weights in 8 bit unsigned normalized and bone ids in 8 bits, or 16 if there are more
+ * than 256 bones.  Attributes the mesh doesn't have are left out, and indices are 16 bit if there are few enough
+ * vertices.
+ */
+graphics::VertexLayout createVertexLayout(const Mesh& mesh, const bool splitPositions = false);
+
+/**
+ * Packs the vertex streams of mesh into the streams layout describes.
+ */
+void packVertices(const Mesh& mesh, const graphics::VertexLayout& layout, std::vector< std::vector<byte> >& result);
+
+void packIndices(const std::vector<uint32>& indices, const graphics::IndexFormat indexFormat, std::vector<byte>& result);
+
+/**
+ * Optimizes mesh for drawing and returns it packed: triangles reordered for the vertex cache and then for overdraw,
+ * vertices reordered for fetching and then quantized into the layout from createVertexLayout.
+ */
+Mesh optimize(const Mesh& mesh, const MeshOptimizationOptions& options = MeshOptimizationOptions());
+
+}
+}
+
+#endif /* MESHOPTIMIZATION_H_ */
@@ -0,0 +1,40 @@
+#ifndef MESHSIMPLIFICATION_H_
+#define MESHSIMPLIFICATION_H_
+
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace mesh
+{
+
+/**
+ * Simplifies the triangles in indices down to targetIndexCount indices or fewer, by collapsing edges in order of their
+ * quadric error (Garland and Heckbert's "Surface Simplification Using Quadric Error Metrics").
+ *
+ * Edges collapse onto one of their existing vertices, so the result indexes the same vertices and every other vertex
+ * stream of the mesh still applies - vertices that are no longer used can be dropped with optimizeVertexFetch.
+ * Vertices on an edge that isn't shared by exactly two triangles are never moved, which keeps open borders and the
+ * seams where the importer split vertices for their texture coordinates or normals from tearing.
+ *
+ * No collapse moves the surface further than targetError, relative to the size of the mesh's bounds, so the result
+ * can have more than targetIndexCount indices.  If resultError isn't null it is set to the largest error of the
+ * collapses made, relative to the same size.
+ */
+std::vector<uint32> simplify(
+	const std::vector<uint32>& indices,
+	const std::vector<glm::vec3>& vertices,
+	const size_t targetIndexCount,
+	const float32 targetError = 0.01f,
+	float32* resultError = nullptr
+);
+
+}
+}
+
+#endif /* MESHSIMPLIFICATION_H_ */
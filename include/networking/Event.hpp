@@ -2,8 +2,11 @@
 #define NETWORK_EVENT_H_
 
 #include <vector>
+#include <memory>
 
 #include "Types.hpp"
+#include "ArrayView.hpp"
+#include "MessageBuffer.hpp"
 
 #include "ClientHandle.hpp"
 #include "ServerHandle.hpp"
@@ -48,9 +51,36 @@ struct DisconnectEvent : public GenericEvent
 
 struct MessageEvent : public GenericEvent
 {
-	std::vector<uint8> message;
+	MessageBuffer message;
 };
 
+/**
+ * A received message that refers to its payload instead of owning it.
+ *
+ * The payload is only valid for the duration of the processEvent call it is delivered in.
+ */
+struct MessageEventView : public GenericEvent
+{
+	ArrayView<const uint8> message;
+};
+
+/**
+ * All of the messages received in one call to INetworkingEngine::processEvents.
+ */
+typedef ArrayView<const MessageEventView> MessageEventBatch;
+
+/**
+ * Copy a received message into a MessageEvent that owns its payload.
+ */
+inline MessageEvent copyMessageEvent(const MessageEventView& messageEventView)
+{
+	MessageEvent messageEvent;
+	static_cast<GenericEvent&>(messageEvent) = messageEventView;
+	messageEvent.message = MessageBuffer(std::make_shared<const std::vector<uint8>>(messageEventView.message.begin(), messageEventView.message.end()));
+
+	return messageEvent;
+}
+
 }
 }
 
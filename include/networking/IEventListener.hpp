@@ -19,6 +19,11 @@ public:
 	virtual bool processEvent(const ConnectEvent& event) = 0;
 	virtual bool processEvent(const DisconnectEvent& event) = 0;
 	virtual bool processEvent(const MessageEvent& event) = 0;
+
+	/**
+	 * Process all of the messages received in a single call to INetworkingEngine::processEvents.
+	 */
+	virtual bool processEvent(const MessageEventBatch& messageEventBatch) = 0;
 };
 
 }
@@ -6,6 +6,7 @@
 #include "IEventListener.hpp"
 
 #include "Event.hpp"
+#include "MessageBuffer.hpp"
 
 #include "ServerHandle.hpp"
 #include "ClientHandle.hpp"
@@ -36,7 +37,42 @@ public:
 	virtual void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, const std::vector<uint8>& data) = 0;
 	
 	virtual void send(const ClientHandle& clientHandle, const std::vector<uint8>& data) = 0;
+
+	/**
+	 * Send a pooled message buffer.  Implementations should hold on to the buffer (not copy it) until it has been
+	 * written to the connection.  The defaults copy it and forward to the std::vector<uint8> overloads, so existing
+	 * engines keep working until they override them.
+	 */
+	virtual void send(const ServerHandle& serverHandle, const MessageBuffer& messageBuffer)
+	{
+		send(serverHandle, std::vector<uint8>(messageBuffer.data(), messageBuffer.data() + messageBuffer.size()));
+	}
+
+	virtual void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, const MessageBuffer& messageBuffer)
+	{
+		send(serverHandle, remoteConnectionHandle, std::vector<uint8>(messageBuffer.data(), messageBuffer.data() + messageBuffer.size()));
+	}
+
+	virtual void send(const ClientHandle& clientHandle, const MessageBuffer& messageBuffer)
+	{
+		send(clientHandle, std::vector<uint8>(messageBuffer.data(), messageBuffer.data() + messageBuffer.size()));
+	}
+
+	/**
+	 * Send the same message buffer to each of the given remote connections.  The default sends it to each one in turn.
+	 */
+	virtual void send(const ServerHandle& serverHandle, const std::vector<RemoteConnectionHandle>& remoteConnectionHandles, const MessageBuffer& messageBuffer)
+	{
+		for (const auto& remoteConnectionHandle : remoteConnectionHandles)
+		{
+			send(serverHandle, remoteConnectionHandle, messageBuffer);
+		}
+	}
 	
+	/**
+	 * Delivers pending events to the event listeners.  Messages received since the last call should be delivered
+	 * together as one MessageEventBatch (see MessageEventBuffer) rather than one MessageEvent at a time.
+	 */
 	virtual void processEvents() = 0;
 	virtual void addEventListener(IEventListener* eventListener) = 0;
 	virtual void removeEventListener(IEventListener* eventListener) = 0;
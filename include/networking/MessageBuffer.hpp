@@ -0,0 +1,179 @@
+#ifndef MESSAGEBUFFER_H_
+#define MESSAGEBUFFER_H_
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+#include "Types.hpp"
+#include "ArrayView.hpp"
+
+namespace ice_engine
+{
+namespace networking
+{
+
+/**
+ * Immutable, reference counted message payload.
+ *
+ * Copying a MessageBuffer only copies a reference, so the same payload can be queued for any number of connections
+ * without copying the data.  Buffers created by a MessageBufferPool return their storage to the pool once the last
+ * reference is released.
+ */
+class MessageBuffer
+{
+public:
+	MessageBuffer() = default;
+
+	explicit MessageBuffer(std::shared_ptr<const std::vector<uint8>> data) : data_(std::move(data))
+	{
+	}
+
+	const uint8* data() const
+	{
+		return data_ ? data_->data() : nullptr;
+	}
+
+	size_t size() const
+	{
+		return data_ ? data_->size() : 0;
+	}
+
+	/**
+	 * Same as size, so scripts written against the old vectorUInt8 message keep working.
+	 */
+	size_t length() const
+	{
+		return size();
+	}
+
+	uint8 at(const size_t i) const
+	{
+		if (i >= size())
+		{
+			throw std::out_of_range("MessageBuffer index out of range.");
+		}
+
+		return (*data_)[i];
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+	ArrayView<const uint8> view() const
+	{
+		return ArrayView<const uint8>(data(), size());
+	}
+
+	long useCount() const
+	{
+		return data_.use_count();
+	}
+
+private:
+	std::shared_ptr<const std::vector<uint8>> data_;
+};
+
+/**
+ * Pool of message storage.
+ *
+ * The pool may be destroyed while buffers created from it are still alive; their storage is then freed instead of
+ * being returned.
+ */
+class MessageBufferPool
+{
+public:
+	MessageBufferPool(const size_t maximumPooledBuffers = 256) : state_(std::make_shared<State>())
+	{
+		state_->maximumPooledBuffers = maximumPooledBuffers;
+	}
+
+	MessageBufferPool(const MessageBufferPool& other) = delete;
+	MessageBufferPool& operator=(const MessageBufferPool& other) = delete;
+
+	/**
+	 * Returns empty writable storage with at least the given capacity.  The storage goes back to the pool when the
+	 * last reference to it is released.
+	 */
+	std::shared_ptr<std::vector<uint8>> acquire(const size_t capacity = 0)
+	{
+		std::unique_ptr<std::vector<uint8>> storage;
+
+		{
+			std::lock_guard<std::mutex> lock(state_->mutex);
+
+			if (!state_->freeBuffers.empty())
+			{
+				storage = std::move(state_->freeBuffers.back());
+				state_->freeBuffers.pop_back();
+			}
+		}
+
+		if (!storage) storage = std::make_unique<std::vector<uint8>>();
+
+		storage->reserve(capacity);
+
+		std::weak_ptr<State> state = state_;
+		return std::shared_ptr<std::vector<uint8>>(storage.release(), [state](std::vector<uint8>* storage) {
+			release(state, storage);
+		});
+	}
+
+	/**
+	 * Copies data into a pooled buffer.
+	 */
+	MessageBuffer create(const uint8* data, const size_t size)
+	{
+		auto storage = acquire(size);
+		storage->assign(data, data + size);
+
+		return MessageBuffer(std::move(storage));
+	}
+
+	MessageBuffer create(const std::vector<uint8>& data)
+	{
+		return create(data.data(), data.size());
+	}
+
+	size_t numberOfPooledBuffers() const
+	{
+		std::lock_guard<std::mutex> lock(state_->mutex);
+
+		return state_->freeBuffers.size();
+	}
+
+private:
+	struct State
+	{
+		std::mutex mutex;
+		std::vector<std::unique_ptr<std::vector<uint8>>> freeBuffers;
+		size_t maximumPooledBuffers = 0;
+	};
+
+	std::shared_ptr<State> state_;
+
+	static void release(const std::weak_ptr<State>& weakState, std::vector<uint8>* storage)
+	{
+		std::unique_ptr<std::vector<uint8>> pointer(storage);
+
+		auto state = weakState.lock();
+		if (!state) return;
+
+		pointer->clear();
+
+		std::lock_guard<std::mutex> lock(state->mutex);
+
+		if (state->freeBuffers.size() < state->maximumPooledBuffers)
+		{
+			state->freeBuffers.push_back(std::move(pointer));
+		}
+	}
+};
+
+}
+}
+
+#endif /* MESSAGEBUFFER_H_ */
@@ -0,0 +1,278 @@
+#ifndef MESSAGEBUFFERBUILDER_H_
+#define MESSAGEBUFFERBUILDER_H_
+
+#include <cstring>
+#include <string>
+#include <memory>
+#include <stdexcept>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "networking/MessageBuffer.hpp"
+
+namespace ice_engine
+{
+namespace networking
+{
+
+/**
+ * Writes a message directly into pooled storage.
+ *
+ * Values are written in host byte order (all of our supported platforms are little endian).  Calling build()
+ * hands the storage over to a MessageBuffer and leaves the builder empty and ready for the next message.
+ */
+class MessageBufferBuilder
+{
+public:
+	MessageBufferBuilder() = default;
+
+	MessageBufferBuilder(MessageBufferPool* messageBufferPool, const size_t capacity = 0) : messageBufferPool_(messageBufferPool), capacity_(capacity)
+	{
+	}
+
+	MessageBufferBuilder(const MessageBufferBuilder& other) : messageBufferPool_(other.messageBufferPool_), capacity_(other.capacity_)
+	{
+		if (other.data_) writeBytes(other.data_->data(), other.data_->size());
+	}
+
+	MessageBufferBuilder& operator=(const MessageBufferBuilder& other)
+	{
+		if (this != &other)
+		{
+			messageBufferPool_ = other.messageBufferPool_;
+			capacity_ = other.capacity_;
+			data_.reset();
+
+			if (other.data_) writeBytes(other.data_->data(), other.data_->size());
+		}
+
+		return *this;
+	}
+
+	void writeUInt8(const uint8 value) { write(value); }
+	void writeUInt16(const uint16 value) { write(value); }
+	void writeUInt32(const uint32 value) { write(value); }
+	void writeUInt64(const uint64 value) { write(value); }
+	void writeInt32(const int32 value) { write(value); }
+	void writeInt64(const int64 value) { write(value); }
+	void writeFloat(const float32 value) { write(value); }
+	void writeBool(const bool value) { write(static_cast<uint8>(value ? 1 : 0)); }
+
+	void writeVec3(const glm::vec3& value)
+	{
+		write(value.x);
+		write(value.y);
+		write(value.z);
+	}
+
+	void writeQuat(const glm::quat& value)
+	{
+		write(value.x);
+		write(value.y);
+		write(value.z);
+		write(value.w);
+	}
+
+	/**
+	 * Writes the length of the string as a uint32 followed by its characters.
+	 */
+	void writeString(const std::string& value)
+	{
+		write(static_cast<uint32>(value.size()));
+		writeBytes(reinterpret_cast<const uint8*>(value.data()), value.size());
+	}
+
+	void writeBytes(const uint8* data, const size_t size)
+	{
+		auto& storage = this->storage();
+		storage.insert(storage.end(), data, data + size);
+	}
+
+	size_t size() const
+	{
+		return data_ ? data_->size() : 0;
+	}
+
+	void clear()
+	{
+		if (data_) data_->clear();
+	}
+
+	MessageBuffer build()
+	{
+		if (!data_) return MessageBuffer();
+
+		return MessageBuffer(std::move(data_));
+	}
+
+private:
+	MessageBufferPool* messageBufferPool_ = nullptr;
+	size_t capacity_ = 0;
+	std::shared_ptr<std::vector<uint8>> data_;
+
+	std::vector<uint8>& storage()
+	{
+		if (!data_)
+		{
+			if (messageBufferPool_)
+			{
+				data_ = messageBufferPool_->acquire(capacity_);
+			}
+			else
+			{
+				data_ = std::make_shared<std::vector<uint8>>();
+				data_->reserve(capacity_);
+			}
+		}
+
+		return *data_;
+	}
+
+	template<typename T>
+	void write(const T value)
+	{
+		auto& storage = this->storage();
+
+		const size_t offset = storage.size();
+		storage.resize(offset + sizeof(T));
+		std::memcpy(storage.data() + offset, &value, sizeof(T));
+	}
+};
+
+/**
+ * Reads values written by a MessageBufferBuilder.
+ *
+ * Reading past the end of the message throws a std::out_of_range exception.
+ */
+class MessageBufferReader
+{
+public:
+	MessageBufferReader() = default;
+
+	explicit MessageBufferReader(const ArrayView<const uint8>& data) : data_(data)
+	{
+	}
+
+	uint8 readUInt8() { return read<uint8>(); }
+	uint16 readUInt16() { return read<uint16>(); }
+	uint32 readUInt32() { return read<uint32>(); }
+	uint64 readUInt64() { return read<uint64>(); }
+	int32 readInt32() { return read<int32>(); }
+	int64 readInt64() { return read<int64>(); }
+	float32 readFloat() { return read<float32>(); }
+	bool readBool() { return read<uint8>() != 0; }
+
+	glm::vec3 readVec3()
+	{
+		glm::vec3 value;
+		value.x = read<float32>();
+		value.y = read<float32>();
+		value.z = read<float32>();
+
+		return value;
+	}
+
+	glm::quat readQuat()
+	{
+		glm::quat value;
+		value.x = read<float32>();
+		value.y = read<float32>();
+		value.z = read<float32>();
+		value.w = read<float32>();
+
+		return value;
+	}
+
+	std::string readString()
+	{
+		const uint32 size = read<uint32>();
+		require(size);
+
+		std::string value(reinterpret_cast<const char*>(data_.data() + position_), size);
+		position_ += size;
+
+		return value;
+	}
+
+	void readBytes(uint8* data, const size_t size)
+	{
+		require(size);
+
+		std::memcpy(data, data_.data() + position_, size);
+		position_ += size;
+	}
+
+	size_t position() const
+	{
+		return position_;
+	}
+
+	size_t remaining() const
+	{
+		return data_.size() - position_;
+	}
+
+	bool eof() const
+	{
+		return position_ >= data_.size();
+	}
+
+private:
+	ArrayView<const uint8> data_;
+	size_t position_ = 0;
+
+	void require(const size_t size) const
+	{
+		if (size > remaining())
+		{
+			throw std::out_of_range("Attempted to read past the end of the message.");
+		}
+	}
+
+	template<typename T>
+	T read()
+	{
+		require(sizeof(T));
+
+		T value;
+		std::memcpy(&value, data_.data() + position_, sizeof(T));
+		position_ += sizeof(T);
+
+		return value;
+	}
+};
+
+/**
+ * A MessageBufferReader that holds a reference to the message it reads, so the data stays valid for as long as the
+ * reader does.
+ *
+ * Scripts get this as their MessageBufferReader, since they can keep a reader after the buffer it was made from is
+ * released back to its pool.
+ */
+class SharedMessageBufferReader : public MessageBufferReader
+{
+public:
+	SharedMessageBufferReader() = default;
+
+	explicit SharedMessageBufferReader(MessageBuffer messageBuffer)
+		: MessageBufferReader(messageBuffer.view()), messageBuffer_(std::move(messageBuffer))
+	{
+	}
+
+	/**
+	 * Reads a copy of the given data.
+	 */
+	explicit SharedMessageBufferReader(const ArrayView<const uint8>& data)
+		: SharedMessageBufferReader(MessageBuffer(std::make_shared<const std::vector<uint8>>(data.begin(), data.end())))
+	{
+	}
+
+private:
+	MessageBuffer messageBuffer_;
+};
+
+}
+}
+
+#endif /* MESSAGEBUFFERBUILDER_H_ */
@@ -0,0 +1,90 @@
+#ifndef MESSAGEEVENTBUFFER_H_
+#define MESSAGEEVENTBUFFER_H_
+
+#include <vector>
+
+#include "Event.hpp"
+
+namespace ice_engine
+{
+namespace networking
+{
+
+/**
+ * Collects a frame's worth of received messages so they can be delivered as a single MessageEventBatch.
+ *
+ * Payloads are copied back to back into one buffer.  Clearing the buffer keeps its capacity, so a buffer that is
+ * re-used every frame stops allocating once it has grown to the largest frame seen.
+ */
+class MessageEventBuffer
+{
+public:
+	MessageEventBuffer() = default;
+
+	void reserve(const size_t numberOfMessages, const size_t numberOfBytes)
+	{
+		messages_.reserve(numberOfMessages);
+		offsets_.reserve(numberOfMessages);
+		data_.reserve(numberOfBytes);
+	}
+
+	void add(const GenericEvent& event, const uint8* data, const size_t size)
+	{
+		const uint8* previousData = data_.data();
+
+		offsets_.push_back(data_.size());
+		data_.insert(data_.end(), data, data + size);
+
+		MessageEventView messageEventView;
+		static_cast<GenericEvent&>(messageEventView) = event;
+		messageEventView.message = ArrayView<const uint8>(data_.data() + offsets_.back(), size);
+
+		messages_.push_back(messageEventView);
+
+		// The payload buffer moved, so point the existing views at the new storage
+		if (data_.data() != previousData)
+		{
+			for (size_t i = 0; i < messages_.size() - 1; ++i)
+			{
+				messages_[i].message = ArrayView<const uint8>(data_.data() + offsets_[i], messages_[i].message.size());
+			}
+		}
+	}
+
+	void clear()
+	{
+		messages_.clear();
+		offsets_.clear();
+		data_.clear();
+	}
+
+	bool empty() const
+	{
+		return messages_.empty();
+	}
+
+	size_t size() const
+	{
+		return messages_.size();
+	}
+
+	size_t numberOfBytes() const
+	{
+		return data_.size();
+	}
+
+	MessageEventBatch batch() const
+	{
+		return MessageEventBatch(messages_.data(), messages_.size());
+	}
+
+private:
+	std::vector<MessageEventView> messages_;
+	std::vector<size_t> offsets_;
+	std::vector<uint8> data_;
+};
+
+}
+}
+
+#endif /* MESSAGEEVENTBUFFER_H_ */
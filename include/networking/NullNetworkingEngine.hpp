@@ -0,0 +1,115 @@
+#ifndef NULLNETWORKINGENGINE_H_
+#define NULLNETWORKINGENGINE_H_
+
+#include <atomic>
+
+#include "networking/INetworkingEngine.hpp"
+
+#include "utilities/Properties.hpp"
+#include "fs/IFileSystem.hpp"
+#include "logger/ILogger.hpp"
+
+namespace ice_engine
+{
+namespace networking
+{
+
+/**
+ * Counts of the calls made on a NullNetworkingEngine and the amount of data passed to it.
+ */
+struct NullNetworkingEngineStatistics
+{
+	std::atomic<uint64> ticks{0};
+	std::atomic<uint64> messagesSent{0};
+	std::atomic<uint64> bytesSent{0};
+
+	void reset()
+	{
+		ticks = 0;
+		messagesSent = 0;
+		bytesSent = 0;
+	}
+};
+
+/**
+ * Networking engine that does no work.
+ *
+ * Servers and clients can be created, but no connections are made, data sent is dropped and no events are raised.
+ * Calls are counted in statistics().
+ */
+class NullNetworkingEngine : public INetworkingEngine
+{
+public:
+	NullNetworkingEngine(utilities::Properties* properties, fs::IFileSystem* fileSystem, logger::ILogger* logger)
+		:
+		properties_(properties),
+		fileSystem_(fileSystem),
+		logger_(logger)
+	{
+	}
+
+	~NullNetworkingEngine() override = default;
+
+	ServerHandle createServer() override { return ServerHandle(++nextIndex_, 1); }
+	ClientHandle createClient() override { return ClientHandle(++nextIndex_, 1); }
+
+	void destroyServer(const ServerHandle& serverHandle) override {}
+	void destroyClient(const ClientHandle& clientHandle) override {}
+
+	void tick(const float32 delta) override { ++statistics_.ticks; }
+
+	void send(const ServerHandle& serverHandle, const std::vector<uint8>& data) override { record(data); }
+	void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, const std::vector<uint8>& data) override { record(data); }
+
+	void send(const ClientHandle& clientHandle, const std::vector<uint8>& data) override { record(data); }
+
+	void send(const ServerHandle& serverHandle, const MessageBuffer& messageBuffer) override { record(messageBuffer.size()); }
+	void send(const ServerHandle& serverHandle, const RemoteConnectionHandle& remoteConnectionHandle, const MessageBuffer& messageBuffer) override { record(messageBuffer.size()); }
+	void send(const ClientHandle& clientHandle, const MessageBuffer& messageBuffer) override { record(messageBuffer.size()); }
+
+	void send(const ServerHandle& serverHandle, const std::vector<RemoteConnectionHandle>& remoteConnectionHandles, const MessageBuffer& messageBuffer) override
+	{
+		for (size_t i = 0; i < remoteConnectionHandles.size(); ++i)
+		{
+			record(messageBuffer.size());
+		}
+	}
+
+	void processEvents() override {}
+	void addEventListener(IEventListener* eventListener) override {}
+	void removeEventListener(IEventListener* eventListener) override {}
+
+	const NullNetworkingEngineStatistics& statistics() const
+	{
+		return statistics_;
+	}
+
+	void resetStatistics()
+	{
+		statistics_.reset();
+	}
+
+private:
+	utilities::Properties* properties_;
+	fs::IFileSystem* fileSystem_;
+	logger::ILogger* logger_;
+
+	std::atomic<uint32> nextIndex_{0};
+	NullNetworkingEngineStatistics statistics_;
+
+	void record(const std::vector<uint8>& data)
+	{
+		record(data.size());
+	}
+
+	void record(const size_t size)
+	{
+		++statistics_.messagesSent;
+		statistics_.bytesSent += size;
+	}
+};
+
+}
+}
+
+#endif /* NULLNETWORKINGENGINE_H_ */
@@ -0,0 +1,32 @@
+#ifndef NULLNETWORKINGENGINEFACTORY_H_
+#define NULLNETWORKINGENGINEFACTORY_H_
+
+#include <memory>
+
+#include "networking/INetworkingEngineFactory.hpp"
+#include "networking/NullNetworkingEngine.hpp"
+
+namespace ice_engine
+{
+namespace networking
+{
+
+class NullNetworkingEngineFactory : public INetworkingEngineFactory
+{
+public:
+	~NullNetworkingEngineFactory() override = default;
+
+	std::unique_ptr<INetworkingEngine> create(
+		utilities::Properties* properties,
+		fs::IFileSystem* fileSystem,
+		logger::ILogger* logger
+	) override
+	{
+		return std::make_unique<NullNetworkingEngine>(properties, fileSystem, logger);
+	}
+};
+
+}
+}
+
+#endif /* NULLNETWORKINGENGINEFACTORY_H_ */
@@ -1,7 +1,13 @@
 #ifndef NOISE_H_
 #define NOISE_H_
 
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
 #include "FastNoise.h"
+#include "IThreadPool.hpp"
 #include "Types.hpp"
 
 namespace ice_engine
@@ -9,6 +15,21 @@ namespace ice_engine
 namespace noise
 {
 
+// In the same order as FastNoise::NoiseType
+enum class NoiseType
+{
+	VALUE = 0,
+	VALUE_FRACTAL,
+	PERLIN,
+	PERLIN_FRACTAL,
+	SIMPLEX,
+	SIMPLEX_FRACTAL,
+	CELLULAR,
+	WHITE_NOISE,
+	CUBIC,
+	CUBIC_FRACTAL
+};
+
 class Noise
 {
 public:
@@ -27,12 +48,114 @@ public:
 	{
 		return noise_.GetSeed();
 	}
-	
+
+	void setNoiseType(const NoiseType noiseType)
+	{
+		noise_.SetNoiseType(static_cast<FastNoise::NoiseType>(noiseType));
+	}
+
+	NoiseType getNoiseType() const
+	{
+		return static_cast<NoiseType>(noise_.GetNoiseType());
+	}
+
+	void setFrequency(const float32 frequency)
+	{
+		noise_.SetFrequency(frequency);
+	}
+
+	float32 getFrequency() const
+	{
+		return noise_.GetFrequency();
+	}
+
+	void setFractalOctaves(const int32 octaves)
+	{
+		noise_.SetFractalOctaves(octaves);
+	}
+
+	int32 getFractalOctaves() const
+	{
+		return noise_.GetFractalOctaves();
+	}
+
+	void setFractalLacunarity(const float32 lacunarity)
+	{
+		noise_.SetFractalLacunarity(lacunarity);
+	}
+
+	float32 getFractalLacunarity() const
+	{
+		return noise_.GetFractalLacunarity();
+	}
+
+	void setFractalGain(const float32 gain)
+	{
+		noise_.SetFractalGain(gain);
+	}
+
+	float32 getFractalGain() const
+	{
+		return noise_.GetFractalGain();
+	}
+
 	float32 getValue(const float32 x, const float32 y) const
 	{
 		return noise_.GetValue(x, y);
 	}
 
+	/**
+	 * Noise of the type set with setNoiseType at a single point.
+	 */
+	float32 getNoise(const float32 x, const float32 y) const
+	{
+		return noise_.GetNoise(x, y);
+	}
+
+	float32 getNoise(const float32 x, const float32 y, const float32 z) const
+	{
+		return noise_.GetNoise(x, y, z);
+	}
+
+	/**
+	 * Fills values with width * height samples of noise, row by row, the sample in column i of row j being at
+	 * (x + i * step, y + j * step).  The rows are shared out across threadPool if there is one, this returns once they
+	 * are all done.
+	 *
+	 * The batch functions give the same values as calling getNoise for each sample, only much faster.
+	 */
+	void getNoise(
+		const float32 x,
+		const float32 y,
+		const uint32 width,
+		const uint32 height,
+		const float32 step,
+		std::vector<float32>& values,
+		IThreadPool* threadPool = nullptr
+	) const;
+
+	/**
+	 * Fills values with width * height * depth samples of noise, in slices of height rows.  The sample in column i of
+	 * row j of slice k is at (x + i * step, y + j * step, z + k * step).
+	 */
+	void getNoise(
+		const float32 x,
+		const float32 y,
+		const float32 z,
+		const uint32 width,
+		const uint32 height,
+		const uint32 depth,
+		const float32 step,
+		std::vector<float32>& values,
+		IThreadPool* threadPool = nullptr
+	) const;
+
+	/**
+	 * Fills values with the noise at each of positions.
+	 */
+	void getNoise(const std::vector<glm::vec2>& positions, std::vector<float32>& values, IThreadPool* threadPool = nullptr) const;
+	void getNoise(const std::vector<glm::vec3>& positions, std::vector<float32>& values, IThreadPool* threadPool = nullptr) const;
+
 private:
 	FastNoise noise_;
 };
@@ -41,4 +164,3 @@ private:
 }
 
 #endif /* NOISE_H_ */
-
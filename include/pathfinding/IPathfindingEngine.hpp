@@ -139,6 +139,34 @@ public:
 		const CrowdHandle& crowdHandle,
 		const AgentHandle& agentHandle
 	) const = 0;
+
+
+	/**
+	 * A 64 bit id kept inline with each agent, 0 until set.  Unlike user data it can be read without copying or
+	 * casting; the engine stores entity ids here.
+	 *
+	 * The defaults keep the id in the agent's user data, for plugins that have no inline storage for it yet.
+	 */
+	virtual void setUserId(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle,
+		const uint64 userId
+	)
+	{
+		setUserData(pathfindingSceneHandle, crowdHandle, agentHandle, boost::any(userId));
+	}
+
+	virtual uint64 userId(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle
+	) const
+	{
+		const auto userId = boost::any_cast<uint64>(&getUserData(pathfindingSceneHandle, crowdHandle, agentHandle));
+
+		return userId ? *userId : 0;
+	}
 };
 
 }
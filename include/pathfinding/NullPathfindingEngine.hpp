@@ -0,0 +1,222 @@
+#ifndef NULLPATHFINDINGENGINE_H_
+#define NULLPATHFINDINGENGINE_H_
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "pathfinding/IPathfindingEngine.hpp"
+
+#include "utilities/Properties.hpp"
+#include "fs/IFileSystem.hpp"
+#include "logger/ILogger.hpp"
+
+namespace ice_engine
+{
+namespace pathfinding
+{
+
+/**
+ * Counts of the calls made on a NullPathfindingEngine.
+ */
+struct NullPathfindingEngineStatistics
+{
+	std::atomic<uint64> ticks{0};
+	std::atomic<uint64> agentsCreated{0};
+	std::atomic<uint64> agentsDestroyed{0};
+	std::atomic<uint64> moveRequests{0};
+
+	void reset()
+	{
+		ticks = 0;
+		agentsCreated = 0;
+		agentsDestroyed = 0;
+		moveRequests = 0;
+	}
+};
+
+/**
+ * Pathfinding engine that does no work.
+ *
+ * Agents keep their user data, but they never move and listeners are never called.  Calls are counted in
+ * statistics().
+ */
+class NullPathfindingEngine : public IPathfindingEngine
+{
+public:
+	NullPathfindingEngine(utilities::Properties* properties, fs::IFileSystem* fileSystem, logger::ILogger* logger)
+		:
+		properties_(properties),
+		fileSystem_(fileSystem),
+		logger_(logger)
+	{
+	}
+
+	~NullPathfindingEngine() override = default;
+
+	void tick(const PathfindingSceneHandle& pathfindingSceneHandle, const float32 delta) override { ++statistics_.ticks; }
+	void renderDebug(const PathfindingSceneHandle& pathfindingSceneHandle) override {}
+
+	PathfindingSceneHandle createPathfindingScene() override { return PathfindingSceneHandle(++nextIndex_, 1); }
+	void destroyPathfindingScene(const PathfindingSceneHandle& pathfindingSceneHandle) override {}
+
+	void setPathfindingDebugRenderer(IPathfindingDebugRenderer* pathfindingDebugRenderer) override {}
+	void setDebugRendering(const PathfindingSceneHandle& pathfindingSceneHandle, const bool enabled) override {}
+
+	PolygonMeshHandle createPolygonMesh(const ITerrain* terrain, const PolygonMeshConfig& polygonMeshConfig) override { return PolygonMeshHandle(++nextIndex_, 1); }
+	void destroy(const PolygonMeshHandle& polygonMeshHandle) override {}
+
+	ObstacleHandle createObstacle(const PolygonMeshHandle& polygonMeshHandle, const glm::vec3& position, const float32 radius, const float32 height) override { return ObstacleHandle(++nextIndex_, 1); }
+	void destroy(const PolygonMeshHandle& polygonMeshHandle, const ObstacleHandle& obstacleHandle) override {}
+
+	NavigationMeshHandle createNavigationMesh(const PolygonMeshHandle& polygonMeshHandle, const NavigationMeshConfig& navigationMeshConfig) override { return NavigationMeshHandle(++nextIndex_, 1); }
+	void destroy(const NavigationMeshHandle& navigationMeshHandle) override {}
+
+	CrowdHandle createCrowd(const PathfindingSceneHandle& pathfindingSceneHandle, const NavigationMeshHandle& navigationMeshHandle, const CrowdConfig& crowdConfig) override { return CrowdHandle(++nextIndex_, 1); }
+	void destroy(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle) override {}
+
+	AgentHandle createAgent(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const glm::vec3& position,
+		const AgentParams& agentParams,
+		std::unique_ptr<IAgentMotionChangeListener> agentMotionChangeListener,
+		std::unique_ptr<IAgentStateChangeListener> agentStateChangeListener,
+		std::unique_ptr<IMovementRequestStateChangeListener> movementRequestStateChangeListener,
+		const boost::any& userData
+	) override
+	{
+		const AgentHandle agentHandle(++nextIndex_, 1);
+
+		++statistics_.agentsCreated;
+
+		std::lock_guard<std::mutex> lock(userDataMutex_);
+		userData_[agentHandle.id()] = userData;
+
+		return agentHandle;
+	}
+	void destroy(const PathfindingSceneHandle& pathfindingSceneHandle, const CrowdHandle& crowdHandle, const AgentHandle& agentHandle) override
+	{
+		++statistics_.agentsDestroyed;
+
+		std::lock_guard<std::mutex> lock(userDataMutex_);
+		userData_.erase(agentHandle.id());
+		userIds_.erase(agentHandle.id());
+	}
+
+	void requestMoveTarget(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle,
+		const glm::vec3& position
+	) override
+	{
+		++statistics_.moveRequests;
+	}
+
+	void resetMoveTarget(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle
+	) override
+	{
+		++statistics_.moveRequests;
+	}
+
+	void requestMoveVelocity(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle,
+		const glm::vec3& velocity
+	) override
+	{
+		++statistics_.moveRequests;
+	}
+
+	void setMotionChangeListener(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle,
+		std::unique_ptr<IAgentMotionChangeListener> agentMotionChangeListener
+	) override {}
+	void setStateChangeListener(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle,
+		std::unique_ptr<IAgentStateChangeListener> agentStateChangeListener
+	) override {}
+	void setMovementRequestChangeListener(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle,
+		std::unique_ptr<IMovementRequestStateChangeListener> movementRequestStateChangeListener
+	) override {}
+
+	void setUserData(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle,
+		const boost::any& userData
+	) override
+	{
+		std::lock_guard<std::mutex> lock(userDataMutex_);
+		userData_[agentHandle.id()] = userData;
+	}
+	boost::any& getUserData(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle
+	) const override
+	{
+		std::lock_guard<std::mutex> lock(userDataMutex_);
+		return userData_[agentHandle.id()];
+	}
+
+	void setUserId(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle,
+		const uint64 userId
+	) override
+	{
+		std::lock_guard<std::mutex> lock(userDataMutex_);
+		userIds_[agentHandle.id()] = userId;
+	}
+	uint64 userId(
+		const PathfindingSceneHandle& pathfindingSceneHandle,
+		const CrowdHandle& crowdHandle,
+		const AgentHandle& agentHandle
+	) const override
+	{
+		std::lock_guard<std::mutex> lock(userDataMutex_);
+		const auto it = userIds_.find(agentHandle.id());
+		return it != userIds_.end() ? it->second : 0;
+	}
+
+	const NullPathfindingEngineStatistics& statistics() const
+	{
+		return statistics_;
+	}
+
+	void resetStatistics()
+	{
+		statistics_.reset();
+	}
+
+private:
+	utilities::Properties* properties_;
+	fs::IFileSystem* fileSystem_;
+	logger::ILogger* logger_;
+
+	std::atomic<uint32> nextIndex_{0};
+	NullPathfindingEngineStatistics statistics_;
+
+	mutable std::mutex userDataMutex_;
+	mutable std::unordered_map<uint64, boost::any> userData_;
+	std::unordered_map<uint64, uint64> userIds_;
+};
+
+}
+}
+
+#endif /* NULLPATHFINDINGENGINE_H_ */
@@ -0,0 +1,32 @@
+#ifndef NULLPATHFINDINGENGINEFACTORY_H_
+#define NULLPATHFINDINGENGINEFACTORY_H_
+
+#include <memory>
+
+#include "pathfinding/IPathfindingEngineFactory.hpp"
+#include "pathfinding/NullPathfindingEngine.hpp"
+
+namespace ice_engine
+{
+namespace pathfinding
+{
+
+class NullPathfindingEngineFactory : public IPathfindingEngineFactory
+{
+public:
+	~NullPathfindingEngineFactory() override = default;
+
+	std::unique_ptr<IPathfindingEngine> create(
+		utilities::Properties* properties,
+		fs::IFileSystem* fileSystem,
+		logger::ILogger* logger
+	) override
+	{
+		return std::make_unique<NullPathfindingEngine>(properties, fileSystem, logger);
+	}
+};
+
+}
+}
+
+#endif /* NULLPATHFINDINGENGINEFACTORY_H_ */
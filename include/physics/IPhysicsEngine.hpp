@@ -10,8 +10,10 @@
 #include <glm/glm.hpp>
 
 #include "Types.hpp"
+#include "ArrayView.hpp"
 
 #include "ray/Ray.hpp"
+#include "ray/Sphere.hpp"
 
 #include "IImage.hpp"
 #include "IHeightfield.hpp"
@@ -21,6 +23,7 @@
 #include "physics/RigidBodyObjectHandle.hpp"
 #include "physics/GhostObjectHandle.hpp"
 #include "physics/IMotionChangeListener.hpp"
+#include "physics/MotionChange.hpp"
 #include "physics/IPhysicsDebugRenderer.hpp"
 #include "physics/Raycast.hpp"
 
@@ -94,13 +97,92 @@ public:
 	virtual void setUserData(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const boost::any& userData) = 0;
 	virtual boost::any& getUserData(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const = 0;
 	virtual boost::any& getUserData(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) const = 0;
+
+	/**
+	 * A 64 bit id kept inline with each object, 0 until set.  Unlike user data it can be read without copying or
+	 * casting, so it is what raycast, query and contact results should be resolved through; the engine stores
+	 * entity ids here.
+	 *
+	 * The defaults keep the id in the object's user data, for plugins that have no inline storage for it yet.
+	 */
+	virtual void setUserId(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const uint64 userId)
+	{
+		setUserData(physicsSceneHandle, rigidBodyObjectHandle, boost::any(userId));
+	}
+
+	virtual void setUserId(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const uint64 userId)
+	{
+		setUserData(physicsSceneHandle, ghostObjectHandle, boost::any(userId));
+	}
+
+	virtual uint64 userId(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const
+	{
+		const auto userId = boost::any_cast<uint64>(&getUserData(physicsSceneHandle, rigidBodyObjectHandle));
+
+		return userId ? *userId : 0;
+	}
+
+	virtual uint64 userId(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) const
+	{
+		const auto userId = boost::any_cast<uint64>(&getUserData(physicsSceneHandle, ghostObjectHandle));
+
+		return userId ? *userId : 0;
+	}
 	
 	virtual Raycast raycast(const PhysicsSceneHandle& physicsSceneHandle, const ray::Ray& ray) = 0;
 	
 	virtual std::vector<boost::variant<RigidBodyObjectHandle, GhostObjectHandle>> query(const PhysicsSceneHandle& physicsSceneHandle, const glm::vec3& origin, const std::vector<glm::vec3>& points) = 0;
 	virtual std::vector<boost::variant<RigidBodyObjectHandle, GhostObjectHandle>> query(const PhysicsSceneHandle& physicsSceneHandle, const glm::vec3& origin, const float32 radius) = 0;
 
+	/**
+	 * Casts each of rays and writes the result for rays[i] into results[i], which must be at least as large as rays.
+	 *
+	 * Batched calls only read the physics scene, so several may run at once on different threads against the same
+	 * scene, as long as nothing modifies the scene while they do.  The defaults call raycast and query once per ray or
+	 * sphere, which is only safe if the plugin's raycast and query are.
+	 */
+	virtual void raycastMany(const PhysicsSceneHandle& physicsSceneHandle, const ArrayView<const ray::Ray>& rays, const ArrayView<Raycast>& results)
+	{
+		for (size_t i = 0; i < rays.size(); ++i)
+		{
+			results[i] = raycast(physicsSceneHandle, rays[i]);
+		}
+	}
+
+	/**
+	 * Appends the objects overlapping each of spheres to results, in sphere order, and writes the number of objects
+	 * found for spheres[i] into counts[i].
+	 */
+	virtual void queryMany(
+		const PhysicsSceneHandle& physicsSceneHandle,
+		const ArrayView<const ray::Sphere>& spheres,
+		std::vector<boost::variant<RigidBodyObjectHandle, GhostObjectHandle>>& results,
+		const ArrayView<uint32>& counts
+	)
+	{
+		for (size_t i = 0; i < spheres.size(); ++i)
+		{
+			const auto found = query(physicsSceneHandle, spheres[i].origin, spheres[i].radius);
+
+			results.insert(results.end(), found.begin(), found.end());
+			counts[i] = static_cast<uint32>(found.size());
+		}
+	}
+
 	virtual void setMotionChangeListener(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, std::unique_ptr<IMotionChangeListener> motionStateListener) = 0;
+
+	/**
+	 * The transforms of the bodies that moved during the last tick of the scene, one entry per body however many
+	 * substeps the tick took.  Sleeping bodies are left out.  The view is valid until the scene is next ticked.
+	 *
+	 * Reading these once per tick is much cheaper than a motion change listener per body.  Scene still sets a motion
+	 * change listener on each rigid body for plugins that don't fill this in yet; a plugin that does may ignore them.
+	 * The default returns an empty view, for those plugins.
+	 */
+	virtual ArrayView<const MotionChange> motionChanges(const PhysicsSceneHandle& physicsSceneHandle) const
+	{
+		return ArrayView<const MotionChange>();
+	}
 	
 	virtual void rotation(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const glm::quat& orientation) = 0;
 	virtual glm::quat rotation(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const = 0;
@@ -0,0 +1,34 @@
+#ifndef MOTIONCHANGE_H_
+#define MOTIONCHANGE_H_
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "physics/RigidBodyObjectHandle.hpp"
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace physics
+{
+
+/**
+ * The transform a rigid body ended a physics tick with.
+ */
+struct MotionChange
+{
+	RigidBodyObjectHandle rigidBodyObjectHandle;
+
+	// The user id set on the body, so callers can find what it belongs to without another lookup
+	uint64 userId = 0;
+
+	glm::vec3 position;
+	glm::quat orientation;
+};
+
+}
+}
+
+#endif /* MOTIONCHANGE_H_ */
@@ -0,0 +1,319 @@
+#ifndef NULLPHYSICSENGINE_H_
+#define NULLPHYSICSENGINE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include "physics/IPhysicsEngine.hpp"
+
+#include "utilities/Properties.hpp"
+#include "fs/IFileSystem.hpp"
+#include "logger/ILogger.hpp"
+
+namespace ice_engine
+{
+namespace physics
+{
+
+/**
+ * Counts of the calls made on a NullPhysicsEngine.
+ */
+struct NullPhysicsEngineStatistics
+{
+	std::atomic<uint64> ticks{0};
+	std::atomic<uint64> rigidBodiesCreated{0};
+	std::atomic<uint64> rigidBodiesDestroyed{0};
+	std::atomic<uint64> ghostObjectsCreated{0};
+	std::atomic<uint64> ghostObjectsDestroyed{0};
+	std::atomic<uint64> transformUpdates{0};
+	std::atomic<uint64> raycasts{0};
+	std::atomic<uint64> queries{0};
+
+	void reset()
+	{
+		ticks = 0;
+		rigidBodiesCreated = 0;
+		rigidBodiesDestroyed = 0;
+		ghostObjectsCreated = 0;
+		ghostObjectsDestroyed = 0;
+		transformUpdates = 0;
+		raycasts = 0;
+		queries = 0;
+	}
+};
+
+/**
+ * Physics engine that does no simulation.
+ *
+ * Rigid bodies and ghost objects keep their transform, material values and user data so that callers reading them
+ * back get what they set.  Nothing moves, raycasts never hit and queries return no results.  Calls are counted in
+ * statistics().
+ */
+class NullPhysicsEngine : public IPhysicsEngine
+{
+public:
+	NullPhysicsEngine(utilities::Properties* properties, fs::IFileSystem* fileSystem, logger::ILogger* logger)
+		:
+		properties_(properties),
+		fileSystem_(fileSystem),
+		logger_(logger)
+	{
+	}
+
+	~NullPhysicsEngine() override = default;
+
+	void tick(const PhysicsSceneHandle& physicsSceneHandle, const float32 delta) override { ++statistics_.ticks; }
+	void renderDebug(const PhysicsSceneHandle& physicsSceneHandle) override {}
+
+	PhysicsSceneHandle createPhysicsScene() override { return PhysicsSceneHandle(++nextIndex_, 1); }
+	void destroy(const PhysicsSceneHandle& physicsSceneHandle) override {}
+
+	void setGravity(const PhysicsSceneHandle& physicsSceneHandle, const glm::vec3& gravity) override {}
+
+	void setPhysicsDebugRenderer(IPhysicsDebugRenderer* physicsDebugRenderer) override {}
+	void setDebugRendering(const PhysicsSceneHandle& physicsSceneHandle, const bool enabled) override {}
+
+	CollisionShapeHandle createStaticPlaneShape(const glm::vec3& planeNormal, const float32 planeConstant) override { return CollisionShapeHandle(++nextIndex_, 1); }
+	CollisionShapeHandle createStaticBoxShape(const glm::vec3& dimensions) override { return CollisionShapeHandle(++nextIndex_, 1); }
+	CollisionShapeHandle createStaticSphereShape(const float32 radius) override { return CollisionShapeHandle(++nextIndex_, 1); }
+	CollisionShapeHandle createStaticTerrainShape(const IHeightfield& heightfield) override { return CollisionShapeHandle(++nextIndex_, 1); }
+	void destroy(const CollisionShapeHandle& collisionShapeHandle) override {}
+	void destroyAllStaticShapes() override {}
+
+	RigidBodyObjectHandle createRigidBodyObject(
+		const PhysicsSceneHandle& physicsSceneHandle,
+		const CollisionShapeHandle& collisionShapeHandle,
+		std::unique_ptr<IMotionChangeListener> motionStateListener,
+		const boost::any& userData
+	) override
+	{
+		return createRigidBodyObject(physicsSceneHandle, collisionShapeHandle, glm::vec3(), glm::quat(), 1.0f, 1.0f, 1.0f, std::move(motionStateListener), userData);
+	}
+
+	RigidBodyObjectHandle createRigidBodyObject(
+		const PhysicsSceneHandle& physicsSceneHandle,
+		const CollisionShapeHandle& collisionShapeHandle,
+		const float32 mass,
+		const float32 friction,
+		const float32 restitution,
+		std::unique_ptr<IMotionChangeListener> motionStateListener,
+		const boost::any& userData
+	) override
+	{
+		return createRigidBodyObject(physicsSceneHandle, collisionShapeHandle, glm::vec3(), glm::quat(), mass, friction, restitution, std::move(motionStateListener), userData);
+	}
+
+	RigidBodyObjectHandle createRigidBodyObject(
+		const PhysicsSceneHandle& physicsSceneHandle,
+		const CollisionShapeHandle& collisionShapeHandle,
+		const glm::vec3& position,
+		const glm::quat& orientation,
+		const float32 mass,
+		const float32 friction,
+		const float32 restitution,
+		std::unique_ptr<IMotionChangeListener> motionStateListener,
+		const boost::any& userData
+	) override
+	{
+		auto object = std::make_unique<NullPhysicsObject>();
+		object->position = position;
+		object->orientation = orientation;
+		object->mass = mass;
+		object->friction = friction;
+		object->restitution = restitution;
+		object->motionChangeListener = std::move(motionStateListener);
+		object->userData = userData;
+
+		++statistics_.rigidBodiesCreated;
+
+		return RigidBodyObjectHandle(add(std::move(object)));
+	}
+
+	GhostObjectHandle createGhostObject(const PhysicsSceneHandle& physicsSceneHandle, const CollisionShapeHandle& collisionShapeHandle, const boost::any& userData) override
+	{
+		return createGhostObject(physicsSceneHandle, collisionShapeHandle, glm::vec3(), glm::quat(), userData);
+	}
+
+	GhostObjectHandle createGhostObject(
+		const PhysicsSceneHandle& physicsSceneHandle,
+		const CollisionShapeHandle& collisionShapeHandle,
+		const glm::vec3& position,
+		const glm::quat& orientation,
+		const boost::any& userData
+	) override
+	{
+		auto object = std::make_unique<NullPhysicsObject>();
+		object->position = position;
+		object->orientation = orientation;
+		object->userData = userData;
+
+		++statistics_.ghostObjectsCreated;
+
+		return GhostObjectHandle(add(std::move(object)));
+	}
+
+	void destroy(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) override
+	{
+		++statistics_.rigidBodiesDestroyed;
+		remove(rigidBodyObjectHandle.get());
+	}
+	void destroy(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) override
+	{
+		++statistics_.ghostObjectsDestroyed;
+		remove(ghostObjectHandle.get());
+	}
+	void destroyAllRigidBodies() override
+	{
+		std::lock_guard<std::mutex> lock(objectsMutex_);
+		objects_.clear();
+	}
+
+	void setUserData(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const boost::any& userData) override { object(rigidBodyObjectHandle)->userData = userData; }
+	void setUserData(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const boost::any& userData) override { object(ghostObjectHandle)->userData = userData; }
+	boost::any& getUserData(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const override { return object(rigidBodyObjectHandle)->userData; }
+	boost::any& getUserData(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) const override { return object(ghostObjectHandle)->userData; }
+
+	void setUserId(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const uint64 userId) override { object(rigidBodyObjectHandle)->userId = userId; }
+	void setUserId(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const uint64 userId) override { object(ghostObjectHandle)->userId = userId; }
+	uint64 userId(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const override { return object(rigidBodyObjectHandle)->userId; }
+	uint64 userId(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) const override { return object(ghostObjectHandle)->userId; }
+
+	Raycast raycast(const PhysicsSceneHandle& physicsSceneHandle, const ray::Ray& ray) override
+	{
+		++statistics_.raycasts;
+
+		return Raycast(ray);
+	}
+
+	std::vector<boost::variant<RigidBodyObjectHandle, GhostObjectHandle>> query(const PhysicsSceneHandle& physicsSceneHandle, const glm::vec3& origin, const std::vector<glm::vec3>& points) override
+	{
+		++statistics_.queries;
+
+		return {};
+	}
+	std::vector<boost::variant<RigidBodyObjectHandle, GhostObjectHandle>> query(const PhysicsSceneHandle& physicsSceneHandle, const glm::vec3& origin, const float32 radius) override
+	{
+		++statistics_.queries;
+
+		return {};
+	}
+
+	void raycastMany(const PhysicsSceneHandle& physicsSceneHandle, const ArrayView<const ray::Ray>& rays, const ArrayView<Raycast>& results) override
+	{
+		statistics_.raycasts += rays.size();
+
+		for (size_t i = 0; i < rays.size(); ++i)
+		{
+			results[i] = Raycast(rays[i]);
+		}
+	}
+
+	void queryMany(
+		const PhysicsSceneHandle& physicsSceneHandle,
+		const ArrayView<const ray::Sphere>& spheres,
+		std::vector<boost::variant<RigidBodyObjectHandle, GhostObjectHandle>>& results,
+		const ArrayView<uint32>& counts
+	) override
+	{
+		statistics_.queries += spheres.size();
+
+		std::fill(counts.begin(), counts.begin() + spheres.size(), 0);
+	}
+
+	void setMotionChangeListener(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, std::unique_ptr<IMotionChangeListener> motionStateListener) override
+	{
+		object(rigidBodyObjectHandle)->motionChangeListener = std::move(motionStateListener);
+	}
+
+	ArrayView<const MotionChange> motionChanges(const PhysicsSceneHandle& physicsSceneHandle) const override
+	{
+		return ArrayView<const MotionChange>();
+	}
+
+	void rotation(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const glm::quat& orientation) override { ++statistics_.transformUpdates; object(rigidBodyObjectHandle)->orientation = orientation; }
+	glm::quat rotation(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const override { return object(rigidBodyObjectHandle)->orientation; }
+
+	void rotation(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const glm::quat& orientation) override { ++statistics_.transformUpdates; object(ghostObjectHandle)->orientation = orientation; }
+	glm::quat rotation(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) const override { return object(ghostObjectHandle)->orientation; }
+
+	void position(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const float32 x, const float32 y, const float32 z) override { ++statistics_.transformUpdates; object(rigidBodyObjectHandle)->position = glm::vec3(x, y, z); }
+	void position(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const glm::vec3& position) override { ++statistics_.transformUpdates; object(rigidBodyObjectHandle)->position = position; }
+	glm::vec3 position(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const override { return object(rigidBodyObjectHandle)->position; }
+
+	void position(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const float32 x, const float32 y, const float32 z) override { ++statistics_.transformUpdates; object(ghostObjectHandle)->position = glm::vec3(x, y, z); }
+	void position(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle, const glm::vec3& position) override { ++statistics_.transformUpdates; object(ghostObjectHandle)->position = position; }
+	glm::vec3 position(const PhysicsSceneHandle& physicsSceneHandle, const GhostObjectHandle& ghostObjectHandle) const override { return object(ghostObjectHandle)->position; }
+
+	void mass(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const float32 mass) override { object(rigidBodyObjectHandle)->mass = mass; }
+	float32 mass(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const override { return object(rigidBodyObjectHandle)->mass; }
+
+	void friction(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const float32 friction) override { object(rigidBodyObjectHandle)->friction = friction; }
+	float32 friction(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const override { return object(rigidBodyObjectHandle)->friction; }
+
+	void restitution(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle, const float32 restitution) override { object(rigidBodyObjectHandle)->restitution = restitution; }
+	float32 restitution(const PhysicsSceneHandle& physicsSceneHandle, const RigidBodyObjectHandle& rigidBodyObjectHandle) const override { return object(rigidBodyObjectHandle)->restitution; }
+
+	const NullPhysicsEngineStatistics& statistics() const
+	{
+		return statistics_;
+	}
+
+	void resetStatistics()
+	{
+		statistics_.reset();
+	}
+
+private:
+	struct NullPhysicsObject
+	{
+		glm::vec3 position;
+		glm::quat orientation;
+		float32 mass = 1.0f;
+		float32 friction = 1.0f;
+		float32 restitution = 1.0f;
+		std::unique_ptr<IMotionChangeListener> motionChangeListener;
+		boost::any userData;
+		uint64 userId = 0;
+	};
+
+	utilities::Properties* properties_;
+	fs::IFileSystem* fileSystem_;
+	logger::ILogger* logger_;
+
+	std::atomic<uint32> nextIndex_{0};
+	NullPhysicsEngineStatistics statistics_;
+
+	std::mutex objectsMutex_;
+	std::unordered_map<void*, std::unique_ptr<NullPhysicsObject>> objects_;
+
+	void* add(std::unique_ptr<NullPhysicsObject> object)
+	{
+		auto pointer = object.get();
+
+		std::lock_guard<std::mutex> lock(objectsMutex_);
+		objects_[pointer] = std::move(object);
+
+		return pointer;
+	}
+
+	void remove(void* pointer)
+	{
+		std::lock_guard<std::mutex> lock(objectsMutex_);
+		objects_.erase(pointer);
+	}
+
+	template<typename T>
+	NullPhysicsObject* object(const T& handle) const
+	{
+		return static_cast<NullPhysicsObject*>(handle.get());
+	}
+};
+
+}
+}
+
+#endif /* NULLPHYSICSENGINE_H_ */
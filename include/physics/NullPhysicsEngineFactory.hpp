@@ -0,0 +1,32 @@
+#ifndef NULLPHYSICSENGINEFACTORY_H_
+#define NULLPHYSICSENGINEFACTORY_H_
+
+#include <memory>
+
+#include "physics/IPhysicsEngineFactory.hpp"
+#include "physics/NullPhysicsEngine.hpp"
+
+namespace ice_engine
+{
+namespace physics
+{
+
+class NullPhysicsEngineFactory : public IPhysicsEngineFactory
+{
+public:
+	~NullPhysicsEngineFactory() override = default;
+
+	std::unique_ptr<IPhysicsEngine> create(
+		utilities::Properties* properties,
+		fs::IFileSystem* fileSystem,
+		logger::ILogger* logger
+	) override
+	{
+		return std::make_unique<NullPhysicsEngine>(properties, fileSystem, logger);
+	}
+};
+
+}
+}
+
+#endif /* NULLPHYSICSENGINEFACTORY_H_ */
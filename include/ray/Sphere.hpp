@@ -0,0 +1,29 @@
+#ifndef SPHERE_H_
+#define SPHERE_H_
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace ray
+{
+
+struct Sphere
+{
+	Sphere() = default;
+
+	Sphere(const glm::vec3& origin, const float32 radius) : origin(origin), radius(radius)
+	{
+	}
+
+	glm::vec3 origin;
+	float32 radius = 0.0f;
+};
+
+}
+}
+
+#endif /* SPHERE_H_ */
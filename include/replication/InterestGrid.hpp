@@ -0,0 +1,61 @@
+#ifndef INTERESTGRID_H_
+#define INTERESTGRID_H_
+
+#include <vector>
+#include <unordered_map>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "Types.hpp"
+
+#include "replication/ReplicationSnapshot.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+struct InterestGridResult
+{
+	uint32 index;
+	float32 distanceSquared;
+};
+
+/**
+ * Uniform grid over the entity positions of a snapshot, used to find the entities near each client.
+ *
+ * The grid refers to entities by their index in the snapshot it was built from, so results come back in network id
+ * order once sorted by index.  Entities without a position are relevant to everyone and are returned by every query
+ * with a distance of zero.
+ */
+class InterestGrid
+{
+public:
+	explicit InterestGrid(const float32 cellSize = 32.0f);
+
+	void build(const ReplicationSnapshot& snapshot);
+	void clear();
+
+	/**
+	 * Appends the entities within radius of position to results, sorted by index.
+	 */
+	void query(const glm::vec3& position, const float32 radius, std::vector<InterestGridResult>& results) const;
+
+	float32 cellSize() const;
+
+private:
+	float32 cellSize_;
+
+	std::unordered_map<uint64, std::vector<uint32>> cells_;
+	std::vector<glm::vec3> positions_;
+	std::vector<uint32> unpositioned_;
+
+	int32 cellCoordinate(const float32 value) const;
+	static uint64 cellKey(const int32 x, const int32 y, const int32 z);
+};
+
+}
+}
+
+#endif /* INTERESTGRID_H_ */
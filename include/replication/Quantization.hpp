@@ -0,0 +1,127 @@
+#ifndef REPLICATIONQUANTIZATION_H_
+#define REPLICATIONQUANTIZATION_H_
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+namespace detail
+{
+
+/**
+ * Round a grid coordinate to the nearest int32.
+ *
+ * Converting NaN or an out of range value to an integer is undefined, so NaN maps to 0 and anything outside the
+ * int32 range (including infinity) is clamped to the nearest representable step.
+ */
+inline int32 quantizeCoordinate(const float64 value)
+{
+	if (std::isnan(value)) return 0;
+
+	const float64 clamped = std::min(
+		std::max(value, static_cast<float64>(std::numeric_limits<int32>::min())),
+		static_cast<float64>(std::numeric_limits<int32>::max())
+	);
+
+	return static_cast<int32>(std::llround(clamped));
+}
+
+}
+
+/**
+ * Quantize a position to a fixed grid with the given precision (in world units per step).
+ *
+ * Non-finite components and components beyond the int32 grid are sanitized (see detail::quantizeCoordinate).
+ */
+inline glm::ivec3 quantizePosition(const glm::vec3& position, const float32 precision)
+{
+	return glm::ivec3(
+		detail::quantizeCoordinate(static_cast<float64>(position.x) / precision),
+		detail::quantizeCoordinate(static_cast<float64>(position.y) / precision),
+		detail::quantizeCoordinate(static_cast<float64>(position.z) / precision)
+	);
+}
+
+inline glm::vec3 dequantizePosition(const glm::ivec3& position, const float32 precision)
+{
+	return glm::vec3(position) * precision;
+}
+
+/**
+ * Pack a unit quaternion into 32 bits using the "smallest three" encoding.
+ *
+ * The largest component is dropped (its index is stored in the top 2 bits) and the remaining three components,
+ * which are in the range [-1/sqrt(2), 1/sqrt(2)], are stored in 10 bits each.
+ */
+inline uint32 quantizeOrientation(const glm::quat& orientation)
+{
+	const float32 maximum = 0.70710678f;
+	const float32 components[4] = {orientation.x, orientation.y, orientation.z, orientation.w};
+
+	uint32 largestIndex = 0;
+	for (uint32 i = 1; i < 4; ++i)
+	{
+		if (std::abs(components[i]) > std::abs(components[largestIndex])) largestIndex = i;
+	}
+
+	// q and -q are the same rotation, so make the dropped component positive
+	const float32 sign = components[largestIndex] < 0.0f ? -1.0f : 1.0f;
+
+	uint32 packed = largestIndex << 30;
+	uint32 shift = 20;
+
+	for (uint32 i = 0; i < 4; ++i)
+	{
+		if (i == largestIndex) continue;
+
+		// NaN compares false against both bounds and would survive the clamp, so send it as 0
+		const float32 scaled = sign * components[i] / maximum;
+		const float32 normalized = std::isnan(scaled) ? 0.0f : std::min(std::max(scaled, -1.0f), 1.0f);
+		const uint32 value = static_cast<uint32>(std::lround((normalized * 0.5f + 0.5f) * 1023.0f));
+
+		packed |= value << shift;
+		shift -= 10;
+	}
+
+	return packed;
+}
+
+inline glm::quat dequantizeOrientation(const uint32 packed)
+{
+	const float32 maximum = 0.70710678f;
+	const uint32 largestIndex = packed >> 30;
+
+	float32 components[4];
+	float32 sumOfSquares = 0.0f;
+	uint32 shift = 20;
+
+	for (uint32 i = 0; i < 4; ++i)
+	{
+		if (i == largestIndex) continue;
+
+		const uint32 value = (packed >> shift) & 0x3FF;
+		components[i] = ((static_cast<float32>(value) / 1023.0f) * 2.0f - 1.0f) * maximum;
+		sumOfSquares += components[i] * components[i];
+		shift -= 10;
+	}
+
+	components[largestIndex] = std::sqrt(std::max(0.0f, 1.0f - sumOfSquares));
+
+	return glm::normalize(glm::quat(components[3], components[0], components[1], components[2]));
+}
+
+}
+}
+
+#endif /* REPLICATIONQUANTIZATION_H_ */
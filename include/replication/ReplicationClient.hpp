@@ -0,0 +1,114 @@
+#ifndef REPLICATIONCLIENT_H_
+#define REPLICATIONCLIENT_H_
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "IMessageEventListener.hpp"
+
+#include "replication/ReplicationSnapshot.hpp"
+
+#include "networking/ClientHandle.hpp"
+#include "scripting/ExecutionContextHandle.hpp"
+#include "scripting/ScriptObjectHandle.hpp"
+#include "scripting/IScriptingEngine.hpp"
+
+#include "ecs/Entity.hpp"
+
+#include "utilities/Properties.hpp"
+#include "logger/ILogger.hpp"
+
+namespace ice_engine
+{
+
+class Scene;
+class GameEngine;
+
+namespace replication
+{
+
+/**
+ * Calls the script object's void readReplicationState(MessageBufferReader) with a reader over a copy of scriptState.
+ * Scripts can keep the reader, so it holds its own reference to the data.
+ */
+void readReplicationState(
+	scripting::IScriptingEngine* scriptingEngine,
+	const scripting::ScriptObjectHandle& scriptObjectHandle,
+	const std::vector<uint8>& scriptState,
+	const scripting::ExecutionContextHandle& executionContextHandle = scripting::ExecutionContextHandle(0)
+);
+
+/**
+ * Receives snapshots from a ReplicationServer and applies them to a scene.
+ *
+ * Snapshots are decoded and acknowledged as soon as they arrive.  Only the most recent one is applied, on the next
+ * scene tick, creating and destroying entities as they appear and disappear on the server.
+ */
+class ReplicationClient : public IMessageEventListener
+{
+public:
+	ReplicationClient(
+		Scene* scene,
+		GameEngine* gameEngine,
+		const networking::ClientHandle& clientHandle,
+		utilities::Properties* properties,
+		logger::ILogger* logger
+	);
+	~ReplicationClient() override;
+
+	ReplicationClient(const ReplicationClient& other) = delete;
+	ReplicationClient& operator=(const ReplicationClient& other) = delete;
+
+	void tick();
+
+	bool processEvent(const networking::MessageEvent& event) override;
+	bool processEvent(const networking::MessageEventBatch& messageEventBatch) override;
+
+	/**
+	 * Returns the local entity replicating the server entity with the given network id, or an invalid entity.
+	 */
+	ecs::Entity entity(const uint32 networkId) const;
+
+	const networking::ClientHandle& clientHandle() const;
+
+private:
+	Scene* scene_;
+	GameEngine* gameEngine_;
+	networking::ClientHandle clientHandle_;
+	logger::ILogger* logger_;
+
+	scripting::ExecutionContextHandle executionContextHandle_;
+
+	uint32 snapshotHistorySize_ = 32;
+
+	// Received snapshots are decoded on the main thread and applied while the scene ticks on a worker thread
+	std::mutex snapshotsMutex_;
+	std::deque<ReplicationSnapshot> baselines_;
+	std::unique_ptr<ReplicationSnapshot> pendingSnapshot_;
+
+	ReplicationSnapshot appliedSnapshot_;
+	std::unordered_map<uint32, ecs::Entity> entities_;
+
+	std::vector<ecs::Entity> positionEntities_;
+	std::vector<glm::vec3> positions_;
+	std::vector<ecs::Entity> orientationEntities_;
+	std::vector<glm::quat> orientations_;
+
+	void receive(const ArrayView<const uint8>& message);
+	void apply(const ReplicationSnapshot& snapshot);
+	void create(const ReplicatedEntityState& state, const float32 positionPrecision);
+	void update(ecs::Entity& entity, const ReplicatedEntityState& state, const uint8 fields, const float32 positionPrecision);
+	void destroy(const uint32 networkId);
+};
+
+}
+}
+
+#endif /* REPLICATIONCLIENT_H_ */
@@ -0,0 +1,141 @@
+#ifndef REPLICATIONSERVER_H_
+#define REPLICATIONSERVER_H_
+
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+#include "IMessageEventListener.hpp"
+
+#include "replication/ReplicationSnapshot.hpp"
+#include "replication/InterestGrid.hpp"
+
+#include "networking/ServerHandle.hpp"
+#include "networking/RemoteConnectionHandle.hpp"
+#include "scripting/ExecutionContextHandle.hpp"
+
+#include "ecs/Entity.hpp"
+
+#include "utilities/Properties.hpp"
+#include "logger/ILogger.hpp"
+
+namespace ice_engine
+{
+
+class Scene;
+class GameEngine;
+
+namespace replication
+{
+
+/**
+ * Replicates the entities of a scene that have a ReplicatedComponent to a set of remote connections.
+ *
+ * Every 'replication.tickspersnapshot' ticks the server captures a snapshot of the replicated entities and sends each
+ * client the delta between that snapshot and the last snapshot the client acknowledged.  Clients that acknowledged the
+ * same snapshot share a single message buffer.
+ */
+class ReplicationServer : public IMessageEventListener
+{
+public:
+	ReplicationServer(
+		Scene* scene,
+		GameEngine* gameEngine,
+		const networking::ServerHandle& serverHandle,
+		utilities::Properties* properties,
+		logger::ILogger* logger
+	);
+	~ReplicationServer() override;
+
+	ReplicationServer(const ReplicationServer& other) = delete;
+	ReplicationServer& operator=(const ReplicationServer& other) = delete;
+
+	void addClient(const networking::RemoteConnectionHandle& remoteConnectionHandle);
+	void removeClient(const networking::RemoteConnectionHandle& remoteConnectionHandle);
+
+	/**
+	 * Limits the client to the entities within radius of position.
+	 */
+	void setInterest(const networking::RemoteConnectionHandle& remoteConnectionHandle, const glm::vec3& position, const float32 radius);
+
+	/**
+	 * Limits the client to the entities within radius of entity, following the entity as it moves.
+	 */
+	void setInterest(const networking::RemoteConnectionHandle& remoteConnectionHandle, const ecs::Entity& entity, const float32 radius);
+
+	/**
+	 * Sends the client every replicated entity again.
+	 */
+	void clearInterest(const networking::RemoteConnectionHandle& remoteConnectionHandle);
+
+	void tick();
+
+	bool processEvent(const networking::MessageEvent& event) override;
+	bool processEvent(const networking::MessageEventBatch& messageEventBatch) override;
+
+	const networking::ServerHandle& serverHandle() const;
+
+private:
+	Scene* scene_;
+	GameEngine* gameEngine_;
+	networking::ServerHandle serverHandle_;
+	logger::ILogger* logger_;
+
+	scripting::ExecutionContextHandle executionContextHandle_;
+
+	uint32 ticksPerSnapshot_ = 3;
+	uint32 snapshotHistorySize_ = 32;
+	float32 positionPrecision_ = 0.01f;
+
+	uint32 midTierRate_ = 2;
+	uint32 farTierRate_ = 4;
+
+	uint32 ticks_ = 0;
+	uint32 sequence_ = 0;
+	uint32 nextNetworkId_ = 1;
+
+	std::deque<ReplicationSnapshot> history_;
+	std::vector<ecs::Entity> entities_;
+
+	struct Acknowledgement
+	{
+		uint32 sequence = 0;
+
+		// Acknowledgements of snapshots sent before the client's interest last changed refer to a different history
+		uint32 minimumSequence = 0;
+	};
+
+	// Acknowledgements arrive on the main thread while the scene ticks on a worker thread
+	mutable std::mutex clientsMutex_;
+	std::unordered_map<networking::RemoteConnectionHandle, Acknowledgement> acknowledgements_;
+
+	struct Interest
+	{
+		glm::vec3 position = glm::vec3(0.0f);
+		ecs::Entity entity;
+		float32 radius = 0.0f;
+
+		std::deque<ReplicationSnapshot> history;
+	};
+
+	// Scripts can change interests from any thread while the scene ticks on a worker thread.  Held while sending, so
+	// it is separate from clientsMutex_ and acknowledgements don't wait on it; when both are held it is taken first.
+	std::mutex interestsMutex_;
+	std::unordered_map<networking::RemoteConnectionHandle, Interest> interests_;
+	InterestGrid interestGrid_;
+	std::vector<InterestGridResult> interestGridResults_;
+
+	ReplicationSnapshot capture();
+	void send(const ReplicationSnapshot& snapshot);
+	void resetAcknowledgement(const networking::RemoteConnectionHandle& remoteConnectionHandle);
+	void setInterest(const networking::RemoteConnectionHandle& remoteConnectionHandle, const glm::vec3& position, const ecs::Entity& entity, const float32 radius);
+	ReplicationSnapshot filter(const ReplicationSnapshot& snapshot, const Interest& interest);
+	uint32 updateRate(const float32 distanceSquared, const float32 radius, const uint8 priority) const;
+	const ReplicationSnapshot* findSnapshot(const std::deque<ReplicationSnapshot>& history, const uint32 sequence) const;
+};
+
+}
+}
+
+#endif /* REPLICATIONSERVER_H_ */
@@ -0,0 +1,122 @@
+#ifndef REPLICATIONSNAPSHOT_H_
+#define REPLICATIONSNAPSHOT_H_
+
+#include <vector>
+#include <string>
+#include <utility>
+
+#define GLM_FORCE_RADIANS
+#include <glm/glm.hpp>
+
+#include "Types.hpp"
+
+#include "networking/MessageBufferBuilder.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+/**
+ * Identifies replication messages so they can share a connection with the game's own messages.
+ */
+const uint32 REPLICATION_MESSAGE_MAGIC = 0x52454349; // "ICER"
+
+enum class ReplicationMessageType : uint8
+{
+	UNKNOWN = 0,
+	SNAPSHOT = 1,
+	ACKNOWLEDGE = 2
+};
+
+enum ReplicatedFields : uint8
+{
+	REPLICATED_NONE				= 0,
+	REPLICATED_POSITION			= 1 << 0,
+	REPLICATED_ORIENTATION		= 1 << 1,
+	REPLICATED_PROPERTIES		= 1 << 2,
+	REPLICATED_SCRIPT_STATE		= 1 << 3,
+
+	REPLICATED_REMOVED			= 1 << 7
+};
+
+/**
+ * The replicated state of a single entity.
+ *
+ * Positions and orientations are stored quantized so that two states compare equal exactly when they encode to the
+ * same bytes.  Only the fields set in 'fields' are meaningful.
+ */
+struct ReplicatedEntityState
+{
+	uint32 networkId = 0;
+	uint8 fields = REPLICATED_NONE;
+
+	glm::ivec3 position = glm::ivec3(0);
+	uint32 orientation = 0;
+	std::vector<std::pair<std::string, std::string>> properties;
+	std::vector<uint8> scriptState;
+
+	// Only used by the server to pick an update rate, never written
+	uint8 priority = 0;
+};
+
+/**
+ * The replicated state of a scene at one point in time, with entities sorted by network id.
+ */
+struct ReplicationSnapshot
+{
+	uint32 sequence = 0;
+	float32 positionPrecision = 0.01f;
+	std::vector<ReplicatedEntityState> entities;
+};
+
+struct ReplicationSnapshotHeader
+{
+	uint32 sequence = 0;
+	uint32 baselineSequence = 0;
+	float32 positionPrecision = 0.0f;
+	uint32 numberOfEntities = 0;
+};
+
+/**
+ * Returns the fields of current that differ from baseline.
+ */
+uint8 changedFields(const ReplicatedEntityState& current, const ReplicatedEntityState& baseline);
+
+/**
+ * Reads the message magic and type.  Returns ReplicationMessageType::UNKNOWN if the message is not a replication
+ * message.
+ */
+ReplicationMessageType readMessageType(networking::MessageBufferReader& reader);
+
+/**
+ * Writes snapshot as a delta against baseline.  If baseline is nullptr, every entity is written in full.
+ *
+ * Entities that are unchanged since the baseline are skipped entirely and entities in the baseline that are no longer
+ * in the snapshot are written as removed.
+ */
+void writeSnapshot(networking::MessageBufferBuilder& builder, const ReplicationSnapshot& snapshot, const ReplicationSnapshot* baseline);
+
+/**
+ * Reads the header of a snapshot message.  The message type must already have been read.
+ */
+ReplicationSnapshotHeader readSnapshotHeader(networking::MessageBufferReader& reader);
+
+/**
+ * Reads the entities of a snapshot message and applies them on top of baseline.
+ *
+ * baseline must be the snapshot with header.baselineSequence, or nullptr if header.baselineSequence is 0.
+ */
+ReplicationSnapshot readSnapshot(networking::MessageBufferReader& reader, const ReplicationSnapshotHeader& header, const ReplicationSnapshot* baseline);
+
+void writeAcknowledge(networking::MessageBufferBuilder& builder, const uint32 sequence);
+
+/**
+ * Reads the acknowledged sequence.  The message type must already have been read.
+ */
+uint32 readAcknowledge(networking::MessageBufferReader& reader);
+
+}
+}
+
+#endif /* REPLICATIONSNAPSHOT_H_ */
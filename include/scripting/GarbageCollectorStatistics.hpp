@@ -0,0 +1,23 @@
+#ifndef GARBAGE_COLLECTOR_STATISTICS_H_
+#define GARBAGE_COLLECTOR_STATISTICS_H_
+
+#include "Types.hpp"
+
+namespace ice_engine
+{
+namespace scripting
+{
+
+struct GarbageCollectorStatistics
+{
+	uint32 currentSize = 0;
+	uint32 totalDestroyed = 0;
+	uint32 totalDetected = 0;
+	uint32 newObjects = 0;
+	uint32 totalNewDestroyed = 0;
+};
+
+}
+}
+
+#endif /* GARBAGE_COLLECTOR_STATISTICS_H_ */
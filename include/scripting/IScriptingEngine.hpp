@@ -17,6 +17,7 @@
 #include "scripting/ScriptObjectFunctionHandle.hpp"
 #include "scripting/ParameterList.hpp"
 #include "scripting/IScriptingEngineDebugger.hpp"
+#include "scripting/GarbageCollectorStatistics.hpp"
 
 #include "Types.hpp"
 
@@ -190,7 +191,16 @@ public:
 	virtual void releaseScriptFunction(const ScriptFunctionHandle& scriptFunctionHandle) = 0;
 	virtual void releaseAllScriptFunctions() = 0;
 
+	virtual void clearScriptObjectPool(const ModuleHandle& moduleHandle) = 0;
+
     virtual void tick(const float32 delta) = 0;
+
+	/**
+	 * Run at most numberOfSteps incremental steps of the garbage collector.
+	 */
+	virtual void garbageCollect(const uint32 numberOfSteps) = 0;
+	virtual void garbageCollectFullCycle() = 0;
+	virtual GarbageCollectorStatistics getGarbageCollectorStatistics() const = 0;
 	
 	virtual void registerGlobalFunction(const std::string& name, const asSFuncPtr& funcPointer, asDWORD callConv, void* objForThiscall = nullptr) = 0;
 	virtual void registerGlobalProperty(const std::string& declaration, void* pointer) = 0;
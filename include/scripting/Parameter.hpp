@@ -61,34 +61,32 @@ public:
 	 * copy this parameter.
 	 * 
 	 * Note that if the other Parameter has an object copied by value, the copy constructor
-	 * will make another copy of that object by allocating new memory and copying the contents of that object.
+	 * will make another copy of that object using the object's own copy constructor.
 	 * 
-	 * When this newly created parameter is destroyed, it will call the destructor on that copied object.
+	 * When this newly created parameter is destroyed, it will destroy that copied object.
 	 */
 	Parameter(const Parameter& other)
 	{
-		type_ = other.type_;
-		value_ = other.value_;
-		sizeOf_ = other.sizeOf_;
-		destructor_ = other.destructor_;
-		
-		if (type_ == ParameterType::TYPE_OBJECT_VAL)
+		copy(other);
+	};
+
+	Parameter& operator=(const Parameter& other)
+	{
+		if (this != &other)
 		{
-			void* p = malloc(sizeOf_);
-			memcpy(p, value_.valuePointer, sizeOf_);
-			value_.valuePointer = p;
+			destroy();
+			copy(other);
 		}
+
+		return *this;
 	};
 	
 	/**
-	 * If the parameter holds a copy of an object, the destructor for that object will be called.
+	 * If the parameter holds a copy of an object, that object will be destroyed.
 	 */
 	virtual ~Parameter()
 	{
-		if (type_ == ParameterType::TYPE_OBJECT_VAL)
-		{
-			destructor_(value_.valuePointer);
-		}
+		destroy();
 	};
 	
 	/**
@@ -116,7 +114,8 @@ public:
 		T* p = new T(value);
 		value_.valuePointer = (void*)p;
 		sizeOf_ = sizeof(T);
-		destructor_ = [](const void* x) { static_cast<const T*>(x)->~T(); };
+		destructor_ = [](const void* x) { delete static_cast<const T*>(x); };
+		copier_ = [](const void* x) -> void* { return new T(*static_cast<const T*>(x)); };
 	};
 	
 	template <typename T>
@@ -147,6 +146,31 @@ private:
 	Value value_;
 	size_t sizeOf_;
 	std::function<void(const void*)> destructor_;
+	std::function<void*(const void*)> copier_;
+
+	void copy(const Parameter& other)
+	{
+		type_ = other.type_;
+		value_ = other.value_;
+		sizeOf_ = other.sizeOf_;
+		destructor_ = other.destructor_;
+		copier_ = other.copier_;
+
+		// Objects held by value can own resources, so they are copied properly rather than byte by byte
+		if (type_ == ParameterType::TYPE_OBJECT_VAL)
+		{
+			value_.valuePointer = copier_(other.value_.valuePointer);
+		}
+	};
+
+	void destroy()
+	{
+		if (type_ == ParameterType::TYPE_OBJECT_VAL)
+		{
+			destructor_(value_.valuePointer);
+			type_ = ParameterType::TYPE_UNKNOWN;
+		}
+	};
 	
 };
 
@@ -2,6 +2,8 @@
 #define SCRIPTINGENGINE_H_
 
 #include <vector>
+#include <unordered_map>
+#include <mutex>
 
 #include "scripting/IScriptingEngine.hpp"
 
@@ -29,9 +31,26 @@ struct ScriptContextData
     asIScriptContext* context;
 };
 
+struct ScriptTypeData
+{
+    asITypeInfo* type = nullptr;
+    std::unordered_map<std::string, asIScriptFunction*> factories;
+};
+
+struct ScriptPoolData
+{
+    std::vector<asIScriptObject*> objects;
+    // The type's 'void reset()' method, if it has one
+    asIScriptFunction* reset = nullptr;
+};
+
 struct ScriptModuleData
 {
     asIScriptModule* module;
+    // Keyed by the declaration the type was looked up with
+    std::unordered_map<std::string, ScriptTypeData> types;
+    // Keyed by type, since a recycled object only knows its type and not the declaration it was acquired with
+    std::unordered_map<asITypeInfo*, ScriptPoolData> pools;
 };
 
 struct ScriptObjectData
@@ -209,8 +228,14 @@ public:
 	void releaseScriptFunction(const ScriptFunctionHandle& scriptFunctionHandle) override;
 	void releaseAllScriptFunctions() override;
 
+	void clearScriptObjectPool(const ModuleHandle& moduleHandle) override;
+
     void tick(const float32 delta) override;
 
+	void garbageCollect(const uint32 numberOfSteps) override;
+	void garbageCollectFullCycle() override;
+	GarbageCollectorStatistics getGarbageCollectorStatistics() const override;
+
     void registerGlobalFunction(const std::string& name, const asSFuncPtr& funcPointer, asDWORD callConv, void* objForThiscall = nullptr) override;
 	void registerGlobalProperty(const std::string& declaration, void* pointer) override;
 	
@@ -268,6 +293,11 @@ private:
 	handles::HandleVector<ScriptModuleData, ModuleHandle> moduleData_;
 
     std::unique_ptr<AngelscriptDebugger> debugger_;
+
+	uint32 garbageCollectorStepsPerTick_ = 1;
+	uint32 garbageCollectorMaximumSize_ = 0;
+	uint32 maximumPooledScriptObjectsPerType_ = 1024;
+	std::mutex scriptObjectPoolMutex_;
 	
 	asIScriptModule* getModule(const ScriptObjectHandle& scriptObjectHandle) const;
 	asIScriptFunction* getMethod(const ScriptObjectHandle& scriptObjectHandle, const std::string& function) const;
@@ -280,6 +310,18 @@ private:
 
 	CScriptHandle createScriptObjectReturnAsScriptHandle(const ModuleHandle& moduleHandle, const std::string& objectName, const std::string& factoryName, const ExecutionContextHandle& executionContextHandle = ExecutionContextHandle(0));
 	asIScriptObject* createScriptObject(const ModuleHandle& moduleHandle, const std::string& objectName, const std::string& factoryName, const ExecutionContextHandle& executionContextHandle = ExecutionContextHandle(0));
+	/**
+	 * Returns a recycled object of the given type if one is pooled, otherwise creates a new one with factoryName.
+	 *
+	 * A recycled object keeps the field values it had when it was recycled.  If the type declares 'void reset()' it is
+	 * called before the object is handed out; types without one must be fully reinitialized by the caller.
+	 */
+	CScriptHandle acquireScriptObject(const ModuleHandle& moduleHandle, const std::string& objectName, const std::string& factoryName, const ExecutionContextHandle& executionContextHandle = ExecutionContextHandle(0));
+	void recycleScriptObject(CScriptHandle handle);
+
+	ScriptTypeData& getScriptTypeData(ScriptModuleData& moduleData, const std::string& objectName);
+	asIScriptFunction* getFactory(ScriptTypeData& scriptTypeData, const std::string& objectName, const std::string& factoryName);
+	void releaseScriptObjectPool(ScriptModuleData& moduleData);
 
 	void setArguments(asIScriptContext* context, ParameterList& arguments) const;
 
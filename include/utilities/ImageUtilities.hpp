@@ -7,6 +7,8 @@
 
 #include "Image.hpp"
 
+#include "image/ImageProcessing.hpp"
+
 namespace ice_engine
 {
 namespace utilities
@@ -20,16 +22,7 @@ inline void saveImageToFile(fs::IFile& file, const Image& image)
 	{
 		// Convert from RGBA to RGB
 		data.resize(image.data().size()/4 * 3);
-
-		int j=0;
-		for (int i=0; i < data.size(); i+=3)
-		{
-			data[i] = image.data()[j];
-			data[i+1] = image.data()[j+1];
-			data[i+2] = image.data()[j+2];
-
-			j+=4;
-		}
+		image::rgbaToRgb(image.data().data(), data.data(), image.data().size()/4);
 	}
 	else
 	{
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "Types.hpp"
 
@@ -91,6 +92,46 @@ public:
 		return defaultValue;
 	}
 
+	/**
+	 * Sets name to value, overriding any value read from the settings file.
+	 */
+	void setValue(const std::string& name, std::string value)
+	{
+		parameters_[name] = std::move(value);
+	}
+
+	/**
+	 * Applies command line overrides.  '--headless' runs as a dedicated server and '--<name>=<value>' overrides the
+	 * setting 'name' (e.g. '--engine.tickrate=30').
+	 *
+	 * Returns the arguments that were not recognized.
+	 */
+	std::vector<std::string> applyCommandLine(const int argc, const char* const* argv)
+	{
+		std::vector<std::string> unknownArguments;
+
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string argument = argv[i];
+			const auto separator = argument.find('=');
+
+			if (argument == "--headless")
+			{
+				setValue("engine.headless", "true");
+			}
+			else if (argument.compare(0, 2, "--") == 0 && separator != std::string::npos && separator > 2)
+			{
+				setValue(argument.substr(2, separator - 2), argument.substr(separator + 1));
+			}
+			else
+			{
+				unknownArguments.push_back(argument);
+			}
+		}
+
+		return unknownArguments;
+	}
+
 private:
 	std::unordered_map<std::string, std::string> parameters_;
 };
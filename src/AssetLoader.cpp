@@ -0,0 +1,287 @@
+#include <algorithm>
+
+#include <boost/exception/diagnostic_information.hpp>
+
+#include "AssetLoader.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+
+namespace
+{
+bool finished(const AssetLoadState state)
+{
+	return state == AssetLoadState::LOADED || state == AssetLoadState::FAILED;
+}
+
+std::string describe(const std::exception_ptr& error)
+{
+	try
+	{
+		std::rethrow_exception(error);
+	}
+	catch (const std::exception& e)
+	{
+		return boost::diagnostic_information(e);
+	}
+	catch (...)
+	{
+		return "unknown error";
+	}
+}
+}
+
+AssetLoader::AssetLoader(IThreadPool* threadPool, IOpenGlLoader* openGlLoader, logger::ILogger* logger)
+	:
+	threadPool_(threadPool),
+	openGlLoader_(openGlLoader),
+	logger_(logger)
+{
+}
+
+void AssetLoader::load(AssetLoadRequest request, AssetLoadCallback callback)
+{
+	const auto name = request.name;
+
+	if (std::find(request.dependencies.begin(), request.dependencies.end(), name) != request.dependencies.end())
+	{
+		throw InvalidArgumentException(detail::format("Unable to load asset '%s' - it depends on itself.", name));
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(nodesMutex_);
+
+		auto& node = nodes_[name];
+
+		if (node.requested)
+		{
+			if (callback) addCallback(node, name, std::move(callback), lock);
+			return;
+		}
+
+		node.requested = true;
+		node.request = std::move(request);
+		++pendingCount_;
+
+		if (callback) node.callbacks.push_back(std::move(callback));
+
+		std::exception_ptr error;
+
+		for (const auto& dependency : node.request.dependencies)
+		{
+			// References into an unordered_map stay valid when it rehashes, so node is safe to use after this
+			auto& dependencyNode = nodes_[dependency];
+
+			if (dependencyNode.state == AssetLoadState::LOADED) continue;
+
+			if (dependencyNode.state == AssetLoadState::FAILED)
+			{
+				error = dependencyNode.error;
+				break;
+			}
+
+			++node.remainingDependencies;
+			dependencyNode.dependents.push_back(name);
+		}
+
+		const bool ready = (node.remainingDependencies == 0);
+
+		lock.unlock();
+
+		if (error)
+		{
+			finish(name, error);
+		}
+		else if (ready)
+		{
+			decode(name);
+		}
+	}
+}
+
+void AssetLoader::onLoaded(const std::string& name, AssetLoadCallback callback)
+{
+	std::unique_lock<std::mutex> lock(nodesMutex_);
+
+	addCallback(nodes_[name], name, std::move(callback), lock);
+}
+
+AssetLoadState AssetLoader::state(const std::string& name) const
+{
+	std::lock_guard<std::mutex> lock(nodesMutex_);
+
+	const auto it = nodes_.find(name);
+
+	if (it == nodes_.end() || !it->second.requested) return AssetLoadState::UNKNOWN;
+
+	return it->second.state;
+}
+
+void AssetLoader::forget(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(nodesMutex_);
+
+	const auto it = nodes_.find(name);
+
+	if (it != nodes_.end() && finished(it->second.state))
+	{
+		nodes_.erase(it);
+	}
+}
+
+uint32 AssetLoader::pendingCount() const
+{
+	std::lock_guard<std::mutex> lock(nodesMutex_);
+
+	return pendingCount_;
+}
+
+void AssetLoader::decode(const std::string& name)
+{
+	std::function<void()> decode;
+
+	{
+		std::lock_guard<std::mutex> lock(nodesMutex_);
+
+		auto& node = nodes_[name];
+		node.state = AssetLoadState::DECODING;
+		decode = std::move(node.request.decode);
+	}
+
+	threadPool_->postWork([this, name, decode = std::move(decode)]() {
+		try
+		{
+			if (decode) decode();
+		}
+		catch (...)
+		{
+			finish(name, std::current_exception());
+			return;
+		}
+
+		upload(name);
+	});
+}
+
+void AssetLoader::upload(const std::string& name)
+{
+	std::function<void()> upload;
+
+	{
+		std::lock_guard<std::mutex> lock(nodesMutex_);
+
+		auto& node = nodes_[name];
+		node.state = AssetLoadState::UPLOADING;
+		upload = std::move(node.request.upload);
+	}
+
+	openGlLoader_->postWork([this, name, upload = std::move(upload)]() {
+		try
+		{
+			if (upload) upload();
+		}
+		catch (...)
+		{
+			finish(name, std::current_exception());
+			return;
+		}
+
+		finish(name, nullptr);
+	}, WorkPriority::LOW);
+}
+
+void AssetLoader::finish(const std::string& name, const std::exception_ptr& error)
+{
+	std::vector<AssetLoadCallback> callbacks;
+	std::vector<std::string> ready;
+	std::vector<std::string> failed;
+
+	{
+		std::lock_guard<std::mutex> lock(nodesMutex_);
+
+		auto& node = nodes_[name];
+
+		// An asset with several failed dependencies is failed by the first one
+		if (finished(node.state)) return;
+
+		node.state = (error ? AssetLoadState::FAILED : AssetLoadState::LOADED);
+		node.error = error;
+		node.request = AssetLoadRequest();
+		--pendingCount_;
+
+		callbacks = std::move(node.callbacks);
+		node.callbacks.clear();
+
+		for (const auto& dependent : node.dependents)
+		{
+			auto& dependentNode = nodes_[dependent];
+
+			if (dependentNode.state != AssetLoadState::WAITING) continue;
+
+			if (error)
+			{
+				failed.push_back(dependent);
+			}
+			else if (--dependentNode.remainingDependencies == 0)
+			{
+				ready.push_back(dependent);
+			}
+		}
+
+		node.dependents.clear();
+	}
+
+	if (error)
+	{
+		LOG_WARN(logger_, "Unable to load asset '%s': %s", name, describe(error));
+	}
+
+	for (auto& callback : callbacks)
+	{
+		postCallback(name, error, std::move(callback));
+	}
+
+	for (const auto& dependent : failed)
+	{
+		finish(dependent, error);
+	}
+
+	for (const auto& dependent : ready)
+	{
+		decode(dependent);
+	}
+}
+
+void AssetLoader::addCallback(Node& node, const std::string& name, AssetLoadCallback callback, std::unique_lock<std::mutex>& lock)
+{
+	if (!finished(node.state))
+	{
+		node.callbacks.push_back(std::move(callback));
+		return;
+	}
+
+	const auto error = node.error;
+	lock.unlock();
+
+	postCallback(name, error, std::move(callback));
+}
+
+void AssetLoader::postCallback(const std::string& name, const std::exception_ptr& error, AssetLoadCallback callback)
+{
+	openGlLoader_->postWork([this, name, error, callback = std::move(callback)]() {
+		try
+		{
+			callback(name, error);
+		}
+		catch (const std::exception& e)
+		{
+			LOG_ERROR(logger_, "Error in load callback for asset '%s': %s", name, boost::diagnostic_information(e));
+		}
+	});
+}
+
+}
@@ -87,6 +87,8 @@ static void InitConstructorImage(Image* memory, const std::vector<byte>& data, c
 static void InitConstructorPbrMaterial(PbrMaterial* memory, IImage* albedo, IImage* normal, IImage* metalness, IImage* roughness, IImage* ambientOcclusion) { new(memory) PbrMaterial(albedo, normal, metalness, roughness, ambientOcclusion); }
 static void InitConstructorHeightMap(HeightMap* memory, const IImage& image) { new(memory) HeightMap(image); }
 static void InitConstructorHeightMap(HeightMap* memory, const std::vector<uint8>& imageData, const uint32 width, const uint32 height) { new(memory) HeightMap(imageData, width, height); }
+static void InitConstructorHeightMap(HeightMap* memory, const IImage& image, IThreadPool* threadPool) { new(memory) HeightMap(image, threadPool); }
+static void InitConstructorHeightMap(HeightMap* memory, const std::vector<uint8>& imageData, const uint32 width, const uint32 height, IThreadPool* threadPool) { new(memory) HeightMap(imageData, width, height, threadPool); }
 static void InitConstructorSplatMap(SplatMap* memory, std::vector<PbrMaterial> materialMap, IImage* terrainMap) { new(memory) SplatMap(std::move(materialMap), terrainMap); }
 static void InitConstructorHeightfield(Heightfield* memory, const IImage& image) { new(memory) Heightfield(image); }
 static void InitConstructorPathfindingTerrain(PathfindingTerrain* memory, const HeightMap& heightMap) { new(memory) PathfindingTerrain(heightMap); }
@@ -260,6 +262,11 @@ uint32 iImageHeightProxy(const IImage* image)
     return image->height();
 }
 
+uint32 iImageMipLevelCountProxy(const IImage* image)
+{
+    return image->mipLevelCount();
+}
+
 void BindingDelegate::bind()
 {
     scriptingEngine_->registerGlobalFunction("void mrtest(int& out, string& out)", asFUNCTION(mrtest), asCALL_CDECL);
@@ -269,6 +276,7 @@ void BindingDelegate::bind()
     scriptingEngine_->registerObjectMethod("IImage", "const vectorUInt8& data() const", asFUNCTION(iImageDataProxy), asCALL_CDECL_OBJFIRST);
     scriptingEngine_->registerObjectMethod("IImage", "uint32 width() const", asFUNCTION(iImageWidthProxy), asCALL_CDECL_OBJFIRST);
     scriptingEngine_->registerObjectMethod("IImage", "uint32 height() const", asFUNCTION(iImageHeightProxy), asCALL_CDECL_OBJFIRST);
+    scriptingEngine_->registerObjectMethod("IImage", "uint32 mipLevelCount() const", asFUNCTION(iImageMipLevelCountProxy), asCALL_CDECL_OBJFIRST);
 //	scriptingEngine_->registerClassMethod("IImage", "const vectorUInt8& data() const", asMETHOD(IImage, data));
 //	scriptingEngine_->registerClassMethod("IImage", "uint32 width() const", asMETHOD(IImage, width));
 //	scriptingEngine_->registerClassMethod("IImage", "uint32 height() const", asMETHOD(IImage, height));
@@ -277,6 +285,9 @@ void BindingDelegate::bind()
     scriptingEngine_->registerEnumValue("IImageFormat", "FORMAT_UNKNOWN", IImage::Format::FORMAT_UNKNOWN);
     scriptingEngine_->registerEnumValue("IImageFormat", "FORMAT_RGB", IImage::Format::FORMAT_RGB);
     scriptingEngine_->registerEnumValue("IImageFormat", "FORMAT_RGBA", IImage::Format::FORMAT_RGBA);
+    scriptingEngine_->registerEnumValue("IImageFormat", "FORMAT_BC1", IImage::Format::FORMAT_BC1);
+    scriptingEngine_->registerEnumValue("IImageFormat", "FORMAT_BC3", IImage::Format::FORMAT_BC3);
+    scriptingEngine_->registerEnumValue("IImageFormat", "FORMAT_BC5", IImage::Format::FORMAT_BC5);
 
     scriptingEngine_->registerObjectType("Image", sizeof(Image), asOBJ_VALUE | asGetTypeTraits<Image>());
     scriptingEngine_->registerObjectBehaviour("Image", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(DefaultConstructor<Image>), asCALL_CDECL_OBJLAST);
@@ -286,6 +297,7 @@ void BindingDelegate::bind()
     scriptingEngine_->registerClassMethod("Image", "const vectorUInt8& data() const", asMETHOD(Image, data));
     scriptingEngine_->registerClassMethod("Image", "uint32 width() const", asMETHOD(Image, width));
     scriptingEngine_->registerClassMethod("Image", "uint32 height() const", asMETHOD(Image, height));
+    scriptingEngine_->registerClassMethod("Image", "uint32 mipLevelCount() const", asMETHOD(Image, mipLevelCount));
 
 	scriptingEngine_->registerObjectType("Audio", 0, asOBJ_REF | asOBJ_NOCOUNT);
 
@@ -512,6 +524,7 @@ void BindingDelegate::bind()
 
 	// Register function declarations
 	scriptingEngine_->registerFunctionDefinition("void WorkFunction()");
+	scriptingEngine_->registerFunctionDefinition("void AssetLoadedFunction(const string& in, bool)");
 
 	// Listeners
 	scriptingEngine_->registerInterface("IWindowEventListener");
@@ -533,6 +546,8 @@ void BindingDelegate::bind()
 	scriptingEngine_->registerInterfaceMethod("IDisconnectEventListener", "bool processEvent(const DisconnectEvent& in)");
 	scriptingEngine_->registerInterface("IMessageEventListener");
 	scriptingEngine_->registerInterfaceMethod("IMessageEventListener", "bool processEvent(const MessageEvent& in)");
+	scriptingEngine_->registerInterface("IMessageEventBatchListener");
+	scriptingEngine_->registerInterfaceMethod("IMessageEventBatchListener", "bool processEvent(const MessageEventBatch& in)");
 
     scriptingEngine_->registerInterface("IScriptingEngineDebugHandler");
     scriptingEngine_->registerInterfaceMethod("IScriptingEngineDebugHandler", "void tick(const float)");
@@ -551,6 +566,18 @@ void BindingDelegate::bind()
 	auto entityBindingDelegate = EntityBindingDelegate(logger_, scriptingEngine_, gameEngine_);
 	entityBindingDelegate.bind();
 
+	// ITerrain methods that need Entity
+	scriptingEngine_->registerClassMethod(
+		"ITerrain",
+		"void addViewer(const Entity& in)",
+		asMETHODPR(ITerrain, addViewer, (const ecs::Entity&), void)
+	);
+	scriptingEngine_->registerClassMethod(
+		"ITerrain",
+		"void removeViewer(const Entity& in)",
+		asMETHODPR(ITerrain, removeViewer, (const ecs::Entity&), void)
+	);
+
 	auto sceneBindingDelegate = SceneBindingDelegate(logger_, scriptingEngine_, gameEngine_, graphicsEngine_, audioEngine_, networkingEngine_, physicsEngine_, pathfindingEngine_);
 	sceneBindingDelegate.bind();
 
@@ -560,13 +587,6 @@ void BindingDelegate::bind()
 	scriptingEngine_->registerInterfaceMethod("IScriptObject", "void serialize(Entity)");
 	scriptingEngine_->registerInterfaceMethod("IScriptObject", "void deserialize(Entity)");
 
-	scriptingEngine_->registerObjectType("Noise", sizeof(noise::Noise), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLFLOATS | asGetTypeTraits<noise::Noise>());
-	scriptingEngine_->registerClassMethod(
-		"Noise",
-		"float getValue(const float, const float) const",
-		asMETHODPR(noise::Noise, getValue, (const float32, const float32) const, float32)
-	);
-
 	// ILogger bindings
 	scriptingEngine_->registerObjectType("ILogger", 0, asOBJ_REF | asOBJ_NOCOUNT);
 	scriptingEngine_->registerGlobalProperty("ILogger logger", logger_);
@@ -624,6 +644,76 @@ void BindingDelegate::bind()
 		asMETHODPR(IThreadPool, getWorkQueueCount, () const, uint32)
 	);
 
+	// HeightMap constructors that work out the normals on a thread pool, registered here since they need IThreadPool
+	scriptingEngine_->registerObjectBehaviour("HeightMap", asBEHAVE_CONSTRUCT, "void f(const IImage& in, IThreadPool@)", asFUNCTIONPR(InitConstructorHeightMap, (HeightMap*, const IImage&, IThreadPool*), void), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("HeightMap", asBEHAVE_CONSTRUCT, "void f(const vectorUInt8& in, const uint32, const uint32, IThreadPool@)", asFUNCTIONPR(InitConstructorHeightMap, (HeightMap*, const std::vector<uint8>&, const uint32, const uint32, IThreadPool*), void), asCALL_CDECL_OBJFIRST);
+
+	// Noise bindings
+	scriptingEngine_->registerEnum("NoiseType");
+	scriptingEngine_->registerEnumValue("NoiseType", "VALUE", static_cast<int32>(noise::NoiseType::VALUE));
+	scriptingEngine_->registerEnumValue("NoiseType", "VALUE_FRACTAL", static_cast<int32>(noise::NoiseType::VALUE_FRACTAL));
+	scriptingEngine_->registerEnumValue("NoiseType", "PERLIN", static_cast<int32>(noise::NoiseType::PERLIN));
+	scriptingEngine_->registerEnumValue("NoiseType", "PERLIN_FRACTAL", static_cast<int32>(noise::NoiseType::PERLIN_FRACTAL));
+	scriptingEngine_->registerEnumValue("NoiseType", "SIMPLEX", static_cast<int32>(noise::NoiseType::SIMPLEX));
+	scriptingEngine_->registerEnumValue("NoiseType", "SIMPLEX_FRACTAL", static_cast<int32>(noise::NoiseType::SIMPLEX_FRACTAL));
+	scriptingEngine_->registerEnumValue("NoiseType", "CELLULAR", static_cast<int32>(noise::NoiseType::CELLULAR));
+	scriptingEngine_->registerEnumValue("NoiseType", "WHITE_NOISE", static_cast<int32>(noise::NoiseType::WHITE_NOISE));
+	scriptingEngine_->registerEnumValue("NoiseType", "CUBIC", static_cast<int32>(noise::NoiseType::CUBIC));
+	scriptingEngine_->registerEnumValue("NoiseType", "CUBIC_FRACTAL", static_cast<int32>(noise::NoiseType::CUBIC_FRACTAL));
+
+	scriptingEngine_->registerObjectType("Noise", sizeof(noise::Noise), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLFLOATS | asGetTypeTraits<noise::Noise>());
+	// FastNoise sets up its permutation tables when constructed
+	scriptingEngine_->registerObjectBehaviour("Noise", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(DefaultConstructor<noise::Noise>), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("Noise", asBEHAVE_CONSTRUCT, "void f(const uint32)", asFUNCTION((InitConstructorNoForward<noise::Noise, uint32>)), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerClassMethod(
+		"Noise",
+		"float getValue(const float, const float) const",
+		asMETHODPR(noise::Noise, getValue, (const float32, const float32) const, float32)
+	);
+	scriptingEngine_->registerClassMethod("Noise", "void setSeed(const uint32)", asMETHOD(noise::Noise, setSeed));
+	scriptingEngine_->registerClassMethod("Noise", "uint32 getSeed() const", asMETHOD(noise::Noise, getSeed));
+	scriptingEngine_->registerClassMethod("Noise", "void setNoiseType(const NoiseType)", asMETHOD(noise::Noise, setNoiseType));
+	scriptingEngine_->registerClassMethod("Noise", "NoiseType getNoiseType() const", asMETHOD(noise::Noise, getNoiseType));
+	scriptingEngine_->registerClassMethod("Noise", "void setFrequency(const float)", asMETHOD(noise::Noise, setFrequency));
+	scriptingEngine_->registerClassMethod("Noise", "float getFrequency() const", asMETHOD(noise::Noise, getFrequency));
+	scriptingEngine_->registerClassMethod("Noise", "void setFractalOctaves(const int32)", asMETHOD(noise::Noise, setFractalOctaves));
+	scriptingEngine_->registerClassMethod("Noise", "int32 getFractalOctaves() const", asMETHOD(noise::Noise, getFractalOctaves));
+	scriptingEngine_->registerClassMethod("Noise", "void setFractalLacunarity(const float)", asMETHOD(noise::Noise, setFractalLacunarity));
+	scriptingEngine_->registerClassMethod("Noise", "float getFractalLacunarity() const", asMETHOD(noise::Noise, getFractalLacunarity));
+	scriptingEngine_->registerClassMethod("Noise", "void setFractalGain(const float)", asMETHOD(noise::Noise, setFractalGain));
+	scriptingEngine_->registerClassMethod("Noise", "float getFractalGain() const", asMETHOD(noise::Noise, getFractalGain));
+	scriptingEngine_->registerClassMethod(
+		"Noise",
+		"float getNoise(const float, const float) const",
+		asMETHODPR(noise::Noise, getNoise, (const float32, const float32) const, float32)
+	);
+	scriptingEngine_->registerClassMethod(
+		"Noise",
+		"float getNoise(const float, const float, const float) const",
+		asMETHODPR(noise::Noise, getNoise, (const float32, const float32, const float32) const, float32)
+	);
+	// Batch versions, so that a whole height map is one call rather than one call per sample
+	scriptingEngine_->registerClassMethod(
+		"Noise",
+		"void getNoise(const float, const float, const uint32, const uint32, const float, vectorFloat& inout, IThreadPool@ = null) const",
+		asMETHODPR(noise::Noise, getNoise, (const float32, const float32, const uint32, const uint32, const float32, std::vector<float32>&, IThreadPool*) const, void)
+	);
+	scriptingEngine_->registerClassMethod(
+		"Noise",
+		"void getNoise(const float, const float, const float, const uint32, const uint32, const uint32, const float, vectorFloat& inout, IThreadPool@ = null) const",
+		asMETHODPR(noise::Noise, getNoise, (const float32, const float32, const float32, const uint32, const uint32, const uint32, const float32, std::vector<float32>&, IThreadPool*) const, void)
+	);
+	scriptingEngine_->registerClassMethod(
+		"Noise",
+		"void getNoise(const vectorVec2& in, vectorFloat& inout, IThreadPool@ = null) const",
+		asMETHODPR(noise::Noise, getNoise, (const std::vector<glm::vec2>&, std::vector<float32>&, IThreadPool*) const, void)
+	);
+	scriptingEngine_->registerClassMethod(
+		"Noise",
+		"void getNoise(const vectorVec3& in, vectorFloat& inout, IThreadPool@ = null) const",
+		asMETHODPR(noise::Noise, getNoise, (const std::vector<glm::vec3>&, std::vector<float32>&, IThreadPool*) const, void)
+	);
+
 	// IOpenGlLoader bindings
 	scriptingEngine_->registerObjectType("IOpenGlLoader", 0, asOBJ_REF | asOBJ_NOCOUNT);
 	scriptingEngine_->registerClassMethod(
@@ -635,6 +725,32 @@ void BindingDelegate::bind()
 	scriptingEngine_->registerObjectType("EngineStatistics", 0, asOBJ_REF | asOBJ_NOCOUNT);
 	scriptingEngine_->registerObjectProperty("EngineStatistics", "float fps", asOFFSET(EngineStatistics, fps));
 	scriptingEngine_->registerObjectProperty("EngineStatistics", "chrono::durationFloat renderTime", asOFFSET(EngineStatistics, renderTime));
+	scriptingEngine_->registerObjectProperty("EngineStatistics", "chrono::durationFloat tickTime", asOFFSET(EngineStatistics, tickTime));
+	scriptingEngine_->registerObjectProperty("EngineStatistics", "chrono::durationFloat frameTime", asOFFSET(EngineStatistics, frameTime));
+	scriptingEngine_->registerObjectProperty("EngineStatistics", "uint ticksPerFrame", asOFFSET(EngineStatistics, ticksPerFrame));
+	scriptingEngine_->registerObjectProperty("EngineStatistics", "uint64 droppedTicks", asOFFSET(EngineStatistics, droppedTicks));
+	scriptingEngine_->registerObjectProperty("EngineStatistics", "float interpolationAlpha", asOFFSET(EngineStatistics, interpolationAlpha));
+	scriptingEngine_->registerObjectProperty("EngineStatistics", "uint64 allocationsPerFrame", asOFFSET(EngineStatistics, allocationsPerFrame));
+	scriptingEngine_->registerObjectProperty("EngineStatistics", "chrono::durationFloat scriptGarbageCollectionTime", asOFFSET(EngineStatistics, scriptGarbageCollectionTime));
+	scriptingEngine_->registerObjectProperty("EngineStatistics", "uint scriptObjectsCollected", asOFFSET(EngineStatistics, scriptObjectsCollected));
+
+	// Profiler
+	scriptingEngine_->registerObjectType("Profiler", 0, asOBJ_REF | asOBJ_NOCOUNT);
+	scriptingEngine_->registerClassMethod(
+		"Profiler",
+		"void setEnabled(const bool)",
+		asMETHODPR(Profiler, setEnabled, (const bool), void)
+	);
+	scriptingEngine_->registerClassMethod(
+		"Profiler",
+		"bool enabled() const",
+		asMETHODPR(Profiler, enabled, () const, bool)
+	);
+	scriptingEngine_->registerClassMethod(
+		"Profiler",
+		"uint64 frameNumber() const",
+		asMETHODPR(Profiler, frameNumber, () const, uint64)
+	);
 
 	// IDebugRenderer
 	scriptingEngine_->registerObjectType("IDebugRenderer", 0, asOBJ_REF | asOBJ_NOCOUNT);
@@ -653,6 +769,12 @@ void BindingDelegate::bind()
 		asCALL_THISCALL_ASGLOBAL,
 		gameEngine_
 	);
+	scriptingEngine_->registerGlobalFunction(
+		"bool headless()",
+		asMETHODPR(GameEngine, headless, () const, bool),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
 	scriptingEngine_->registerGlobalFunction(
 		"void setIGameInstance(IGame@)",
 		asMETHODPR(GameEngine, setIGameInstance, (void*), void),
@@ -689,6 +811,18 @@ void BindingDelegate::bind()
 		asCALL_THISCALL_ASGLOBAL,
 		gameEngine_
 	);
+	scriptingEngine_->registerGlobalFunction(
+		"Profiler@ profiler()",
+		asMETHODPR(GameEngine, profiler, () const, Profiler*),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+	scriptingEngine_->registerGlobalFunction(
+		"void exportProfilerTrace(const string& in)",
+		asMETHODPR(GameEngine, exportProfilerTrace, (const std::string&) const, void),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
 	scriptingEngine_->registerGlobalFunction(
 		"IGui@ createGui(const string& in)",
 		asMETHODPR(GameEngine, createGui, (const std::string&), graphics::gui::IGui*),
@@ -791,6 +925,12 @@ void BindingDelegate::bind()
 		asCALL_THISCALL_ASGLOBAL,
 		gameEngine_
 	);
+	scriptingEngine_->registerGlobalFunction(
+		"void addMessageEventBatchListener(IMessageEventBatchListener@)",
+		asMETHODPR(GameEngine, addMessageEventBatchListener, (void*), void),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
 	scriptingEngine_->registerGlobalFunction(
 		"void removeConnectEventListener(IConnectEventListener@)",
 		asMETHODPR(GameEngine, removeConnectEventListener, (void*), void),
@@ -809,6 +949,12 @@ void BindingDelegate::bind()
 		asCALL_THISCALL_ASGLOBAL,
 		gameEngine_
 	);
+	scriptingEngine_->registerGlobalFunction(
+		"void removeMessageEventBatchListener(IMessageEventBatchListener@)",
+		asMETHODPR(GameEngine, removeMessageEventBatchListener, (void*), void),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
     scriptingEngine_->registerGlobalFunction(
             "void addScriptingEngineDebugHandler(IScriptingEngineDebugHandler@)",
             asMETHODPR(GameEngine, addScriptingEngineDebugHandler, (void*), void),
@@ -883,6 +1029,36 @@ void BindingDelegate::bind()
 		asCALL_THISCALL_ASGLOBAL,
 		gameEngine_
 	);
+	scriptingEngine_->registerGlobalFunction(
+		"Model@ loadModel(const string& in, const string& in)",
+		asMETHOD(GameEngine, loadModel),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+	scriptingEngine_->registerGlobalFunction(
+		"shared_futureModel loadModelAsync(const string& in, const string& in)",
+		asMETHOD(GameEngine, loadModelAsync),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+	scriptingEngine_->registerGlobalFunction(
+		"HeightMap loadHeightMap(const string& in)",
+		asMETHOD(GameEngine, loadHeightMap),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+	scriptingEngine_->registerGlobalFunction(
+		"void requestTexture(const string& in, const string& in, AssetLoadedFunction@)",
+		asMETHODPR(GameEngine, requestTexture, (const std::string&, const std::string&, void*), void),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+	scriptingEngine_->registerGlobalFunction(
+		"void requestModel(const string& in, const string& in, AssetLoadedFunction@)",
+		asMETHODPR(GameEngine, requestModel, (const std::string&, const std::string&, void*), void),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
 	scriptingEngine_->registerGlobalFunction(
 		"Audio@ loadAudio(const string& in, const string& in)",
 		asMETHOD(GameEngine, loadAudio),
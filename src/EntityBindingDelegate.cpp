@@ -283,6 +283,28 @@ void EntityBindingDelegate::bind()
 		{}
 	);
 
+	registerComponent<ecs::ReplicatedComponent, uint32, bool, uint8>(
+		scriptingEngine_,
+		"ReplicatedComponent",
+		{
+			{"uint32 networkId", asOFFSET(ecs::ReplicatedComponent, networkId)},
+			{"bool scriptState", asOFFSET(ecs::ReplicatedComponent, scriptState)},
+			{"uint8 priority", asOFFSET(ecs::ReplicatedComponent, priority)}
+		},
+		"uint32, bool, uint8"
+	);
+
+	registerComponent<ecs::LevelOfDetailComponent, float32, float32>(
+		scriptingEngine_,
+		"LevelOfDetailComponent",
+		{
+			{"float radius", asOFFSET(ecs::LevelOfDetailComponent, radius)},
+			{"float bias", asOFFSET(ecs::LevelOfDetailComponent, bias)},
+			{"const uint32 levelOfDetail", asOFFSET(ecs::LevelOfDetailComponent, levelOfDetail)}
+		},
+		"float, float"
+	);
+
 //	enum DirtyFlags : uint16
 //	{
 //		DIRTY_SOURCE_SCRIPT				= 1 << 0,
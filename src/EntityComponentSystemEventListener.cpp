@@ -14,6 +14,8 @@ EntityComponentSystemEventListener::EntityComponentSystemEventListener(Scene& sc
 	entityComponentSystem.subscribe<entityx::EntityDestroyedEvent>(*this);
 	entityComponentSystem.subscribe<entityx::ComponentAddedEvent<ecs::GraphicsComponent>>(*this);
 	entityComponentSystem.subscribe<entityx::ComponentRemovedEvent<ecs::GraphicsComponent>>(*this);
+	entityComponentSystem.subscribe<entityx::ComponentAddedEvent<ecs::PositionComponent>>(*this);
+	entityComponentSystem.subscribe<entityx::ComponentRemovedEvent<ecs::PositionComponent>>(*this);
 	entityComponentSystem.subscribe<entityx::ComponentRemovedEvent<ecs::AnimationComponent>>(*this);
 	entityComponentSystem.subscribe<entityx::ComponentRemovedEvent<ecs::RigidBodyObjectComponent>>(*this);
 	entityComponentSystem.subscribe<entityx::ComponentRemovedEvent<ecs::GhostObjectComponent>>(*this);
@@ -45,6 +47,16 @@ void EntityComponentSystemEventListener::receive(const entityx::ComponentRemoved
 	if (event.component->renderableHandle) scene_.destroy(event.component->renderableHandle);
 }
 
+void EntityComponentSystemEventListener::receive(const entityx::ComponentAddedEvent<ecs::PositionComponent>& event)
+{
+	scene_.updateSpatialIndex(ecs::Entity(&scene_, event.entity), event.component->position);
+}
+
+void EntityComponentSystemEventListener::receive(const entityx::ComponentRemovedEvent<ecs::PositionComponent>& event)
+{
+	scene_.spatialIndex().remove(event.entity.id().id());
+}
+
 void EntityComponentSystemEventListener::receive(const entityx::ComponentRemovedEvent<ecs::AnimationComponent>& event)
 {
 	if (event.component->bonesHandle)
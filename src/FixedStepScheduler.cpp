@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "FixedStepScheduler.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+namespace ice_engine
+{
+
+FixedStepScheduler::FixedStepScheduler(
+	const float64 tickRate,
+	const uint32 maximumTicksPerFrame,
+	const std::chrono::nanoseconds maximumFrameTime,
+	const CatchUpPolicy catchUpPolicy
+)
+	:
+	maximumTicksPerFrame_(std::max(maximumTicksPerFrame, 1u)),
+	maximumFrameTime_(maximumFrameTime),
+	catchUpPolicy_(catchUpPolicy)
+{
+	if (!(tickRate > 0.0))
+	{
+		throw InvalidArgumentException(std::string("Tick rate must be greater than 0, got ") + std::to_string(tickRate) + ".");
+	}
+
+	step_ = std::chrono::nanoseconds(static_cast<int64>(std::llround(1.0e9 / tickRate)));
+	step_ = std::max(step_, std::chrono::nanoseconds(1));
+
+	// A frame time shorter than a step would stop the simulation entirely
+	maximumFrameTime_ = std::max(maximumFrameTime_, step_);
+}
+
+uint32 FixedStepScheduler::advance(const std::chrono::nanoseconds elapsed)
+{
+	auto frameTime = std::max(elapsed, std::chrono::nanoseconds(0));
+
+	if (frameTime > maximumFrameTime_)
+	{
+		droppedTime_ += frameTime - maximumFrameTime_;
+		droppedTicks_ += static_cast<uint64>((frameTime - maximumFrameTime_) / step_);
+		frameTime = maximumFrameTime_;
+	}
+
+	accumulator_ += frameTime;
+
+	auto numberOfTicks = static_cast<uint64>(accumulator_ / step_);
+	const uint32 limit = (catchUpPolicy_ == CatchUpPolicy::SKIP ? 1u : maximumTicksPerFrame_);
+
+	if (numberOfTicks > limit)
+	{
+		const uint64 dropped = numberOfTicks - limit;
+
+		droppedTicks_ += dropped;
+		droppedTime_ += step_ * static_cast<int64>(dropped);
+		accumulator_ -= step_ * static_cast<int64>(dropped);
+
+		numberOfTicks = limit;
+	}
+
+	accumulator_ -= step_ * static_cast<int64>(numberOfTicks);
+	ticks_ += numberOfTicks;
+
+	return static_cast<uint32>(numberOfTicks);
+}
+
+float32 FixedStepScheduler::alpha() const
+{
+	return static_cast<float32>(static_cast<float64>(accumulator_.count()) / static_cast<float64>(step_.count()));
+}
+
+std::chrono::nanoseconds FixedStepScheduler::timeUntilNextTick() const
+{
+	return step_ - accumulator_;
+}
+
+std::chrono::nanoseconds FixedStepScheduler::step() const
+{
+	return step_;
+}
+
+float32 FixedStepScheduler::stepSeconds() const
+{
+	return std::chrono::duration<float32>(step_).count();
+}
+
+float64 FixedStepScheduler::tickRate() const
+{
+	return 1.0e9 / static_cast<float64>(step_.count());
+}
+
+uint32 FixedStepScheduler::maximumTicksPerFrame() const
+{
+	return maximumTicksPerFrame_;
+}
+
+std::chrono::nanoseconds FixedStepScheduler::maximumFrameTime() const
+{
+	return maximumFrameTime_;
+}
+
+CatchUpPolicy FixedStepScheduler::catchUpPolicy() const
+{
+	return catchUpPolicy_;
+}
+
+uint64 FixedStepScheduler::ticks() const
+{
+	return ticks_;
+}
+
+uint64 FixedStepScheduler::droppedTicks() const
+{
+	return droppedTicks_;
+}
+
+std::chrono::nanoseconds FixedStepScheduler::droppedTime() const
+{
+	return droppedTime_;
+}
+
+void FixedStepScheduler::reset()
+{
+	accumulator_ = std::chrono::nanoseconds(0);
+}
+
+CatchUpPolicy FixedStepScheduler::catchUpPolicyFromString(const std::string& catchUpPolicy)
+{
+	if (catchUpPolicy == "catchup") return CatchUpPolicy::CATCH_UP;
+	if (catchUpPolicy == "skip") return CatchUpPolicy::SKIP;
+
+	throw InvalidArgumentException(std::string("Unknown catch up policy '") + catchUpPolicy + "'.");
+}
+
+void sleepPrecisely(const std::chrono::steady_clock::time_point& deadline, const std::chrono::nanoseconds spinThreshold)
+{
+	auto now = std::chrono::steady_clock::now();
+
+	if (deadline - now > spinThreshold)
+	{
+		std::this_thread::sleep_for(deadline - now - spinThreshold);
+	}
+
+	while (std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::yield();
+	}
+}
+
+}
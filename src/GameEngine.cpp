@@ -32,6 +32,9 @@
 #include "logger/Logger.hpp"
 #include "fs/FileSystem.hpp"
 #include "Image.hpp"
+#include "cooking/CookedAsset.hpp"
+#include "image/BlockCompression.hpp"
+#include "Texture.hpp"
 
 #include "resources/EngineResourceManager.MeshHandle.hpp"
 #include "resources/EngineResourceManager.TextureHandle.hpp"
@@ -39,6 +42,7 @@
 
 #include "exceptions/FileNotFoundException.hpp"
 #include "exceptions/InvalidArgumentException.hpp"
+#include "exceptions/InvalidOperationException.hpp"
 
 #include "utilities/IoUtilities.hpp"
 
@@ -59,6 +63,16 @@ catch (const std::exception& e) \
 namespace ice_engine
 {
 
+namespace
+{
+// Images resolved from cooked models are cached under their own prefix, so they can't collide with an image loaded by
+// name under the same path
+std::string cookedImageName(const std::string& filename)
+{
+	return "cooked:" + filename;
+}
+}
+
 GameEngine::GameEngine(
 	std::unique_ptr<utilities::Properties> properties,
     std::unique_ptr<fs::IFileSystem> fileSystem,
@@ -130,6 +144,11 @@ const EngineStatistics& GameEngine::getEngineStatistics() const
 	return engineStatistics_;
 }
 
+bool GameEngine::headless() const
+{
+	return headless_;
+}
+
 void GameEngine::exit()
 {
 	running_ = false;
@@ -251,41 +270,76 @@ std::shared_future<void> GameEngine::postWorkToOpenGlWorker(void* object) {
 
 void GameEngine::tick(const float32 delta)
 {
-	handleEvents();
-
-	scripting::ParameterList params;
-	params.add(delta);
+	PROFILER_SCOPE(profiler_.get(), "GameEngine::tick");
 
-	scriptingEngine_->execute(scriptObjectHandle_, "void tick(const float)", params);
+	{
+		PROFILER_SCOPE(profiler_.get(), "GameEngine::handleEvents");
+		handleEvents();
+	}
 
-	std::vector<std::future<void>> futures;
-	for (auto& scene : scenes_)
 	{
-		std::function<void()> work = [&scene, delta = delta]() {
-			scene->tick(delta);
-		};
-		futures.push_back(foregroundThreadPool_->postWork(std::move(work)));
+		PROFILER_SCOPE(profiler_.get(), "GameEngine::scriptTick");
+
+		scripting::ParameterList params;
+		params.add(delta);
+
+		scriptingEngine_->execute(scriptObjectHandle_, "void tick(const float)", params);
 	}
 
-	for (auto& f : futures)
 	{
-		f.wait();
-		f.get();
+		PROFILER_SCOPE(profiler_.get(), "GameEngine::sceneTicks");
+
+		std::vector<std::future<void>> futures;
+		for (auto& scene : scenes_)
+		{
+			std::function<void()> work = [&scene, delta = delta, profiler = profiler_.get()]() {
+				PROFILER_SCOPE(profiler, "Scene::tick", scene->name());
+				scene->tick(delta);
+			};
+			futures.push_back(foregroundThreadPool_->postWork(std::move(work)));
+		}
+
+		for (auto& f : futures)
+		{
+			f.wait();
+			f.get();
+		}
+
+		while (foregroundThreadPool_->getWorkQueueCount() + foregroundThreadPool_->getActiveWorkerCount() > 0)
+		{
+			// sleep
+		}
 	}
 
-	while (foregroundThreadPool_->getWorkQueueCount() + foregroundThreadPool_->getActiveWorkerCount() > 0)
 	{
-		// sleep
+		PROFILER_SCOPE(profiler_.get(), "ScriptingEngine::tick");
+
+		// Scenes have finished ticking, so the garbage collector's statistics are only changed here
+		const auto beginGarbageCollectionTime = std::chrono::steady_clock::now();
+		const auto totalDestroyedBefore = scriptingEngine_->getGarbageCollectorStatistics().totalDestroyed;
+
+		scriptingEngine_->tick(delta);
+
+		engineStatistics_.scriptGarbageCollectionTime = std::chrono::duration<float32>(std::chrono::steady_clock::now() - beginGarbageCollectionTime);
+		engineStatistics_.scriptObjectsCollected = scriptingEngine_->getGarbageCollectorStatistics().totalDestroyed - totalDestroyedBefore;
 	}
 
-	for (auto& module : modules_)
 	{
-		module->tick(delta);
+		PROFILER_SCOPE(profiler_.get(), "GameEngine::modules");
+
+		for (auto& module : modules_)
+		{
+			module->tick(delta);
+		}
 	}
 
-	for (auto& gui : guis_)
 	{
-		gui->tick(delta);
+		PROFILER_SCOPE(profiler_.get(), "GameEngine::guis");
+
+		for (auto& gui : guis_)
+		{
+			gui->tick(delta);
+		}
 	}
 
     // We do the creation and destruction asynchronously so that we don't concurrently modify the guis_ vector
@@ -309,25 +363,42 @@ void GameEngine::tick(const float32 delta)
         guisDeleted_.clear();
     }
 
-	// Load any opengl assets (this needs work...)
-	if (openGlLoader_->getWorkQueueCount() != 0u)
-	{
-		openGlLoader_->tick();
-	}
+	profiler_->counter("Pending assets", assetLoader_->pendingCount());
+	profiler_->counter("Background thread pool queue", backgroundThreadPool_->getWorkQueueCount());
+	profiler_->counter("Background thread pool active workers", backgroundThreadPool_->getActiveWorkerCount());
+	profiler_->counter("Foreground thread pool queue", foregroundThreadPool_->getWorkQueueCount());
+	profiler_->counter("Foreground thread pool active workers", foregroundThreadPool_->getActiveWorkerCount());
+}
+
+void GameEngine::uploadGraphicsAssets()
+{
+	profiler_->counter("OpenGlLoader queue", openGlLoader_->getWorkQueueCount());
+	profiler_->counter("Foreground graphics queue", forgroundGraphicsThreadPool_->getWorkQueueCount());
 
-	while (forgroundGraphicsThreadPool_->getWorkQueueCount() != 0u)
 	{
-		forgroundGraphicsThreadPool_->tick();
+		PROFILER_SCOPE(profiler_.get(), "GameEngine::openGlLoader");
+
+		// Load opengl assets until the upload budget for this frame is used up
+		openGlLoader_->tick(gpuUploadBudget_);
+
+		forgroundGraphicsThreadPool_->tick(std::chrono::nanoseconds::max());
 	}
+
+	const auto& openGlLoaderStatistics = openGlLoader_->statistics();
+	profiler_->counter("OpenGlLoader tasks run", openGlLoaderStatistics.tasksRun);
+	profiler_->counter("OpenGlLoader average latency (us)", std::chrono::duration_cast<std::chrono::microseconds>(openGlLoaderStatistics.averageQueueLatency).count());
+	profiler_->counter("OpenGlLoader maximum latency (us)", std::chrono::duration_cast<std::chrono::microseconds>(openGlLoaderStatistics.maximumQueueLatency).count());
 }
 
-void GameEngine::render()
+void GameEngine::render(const float32 alpha)
 {
+	PROFILER_SCOPE(profiler_.get(), "GameEngine::render");
+
     graphicsEngine_->beginRender();
 
     for (auto& scene : scenes_)
     {
-        scene->render();
+        scene->render(alpha);
     }
 
     debugRenderer_->render();
@@ -354,10 +425,18 @@ void GameEngine::initialize()
 
 	LOG_INFO(logger_, "Initializing...");
 
+	headless_ = properties_->getBoolValue("engine.headless", false);
+
+	if (headless_) LOG_INFO(logger_, "Running headless.");
+
 	initializeFileSystemSubSystem();
 
 	initializeDataStoreSubSystem();
 
+	initializeProfilingSubSystem();
+
+	initializeTimingSubSystem();
+
 	initializeThreadingSubSystem();
 
 	initializeEntitySubSystem();
@@ -408,6 +487,8 @@ void GameEngine::initializeFileSystemSubSystem()
 
 void GameEngine::initializeInputSubSystem()
 {
+	if (headless_) return;
+
 	LOG_INFO(logger_, "initialize keyboard and mouse.");
 }
 
@@ -634,6 +715,46 @@ void GameEngine::initializeThreadingSubSystem()
 	LOG_DEBUG(logger_, "Load opengl loader...");
 	openGlLoader_ = std::make_unique<OpenGlLoader>();
 	forgroundGraphicsThreadPool_ = std::make_unique<OpenGlLoader>();
+
+	// GPU work from the opengl loader runs until this much of the frame is used, rather than one task per frame
+	gpuUploadBudget_ = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<float64, std::milli>(properties_->getFloatValue("engine.gpuuploadbudget", 4.0f)));
+
+	assetLoader_ = std::make_unique<AssetLoader>(backgroundThreadPool_.get(), openGlLoader_.get(), logger_.get());
+
+	// Requested textures that aren't cooked can be compressed with their mips while decoding, and their images dropped once
+	// they are on the GPU
+	const auto textureFormat = properties_->getStringValue("engine.textureformat");
+	textureFormat_ = (textureFormat.empty() ? IImage::Format::FORMAT_UNKNOWN : image::formatFromString(textureFormat));
+	releaseTextureImages_ = properties_->getBoolValue("engine.releasetextureimages", false);
+}
+
+void GameEngine::initializeProfilingSubSystem()
+{
+	LOG_INFO(logger_, "Load profiler...");
+	profiler_ = std::make_unique<Profiler>(static_cast<uint32>(properties_->getIntValue("profiler.historysize", 300)));
+	profiler_->setEnabled(properties_->getBoolValue("profiler.enabled", false));
+}
+
+void GameEngine::initializeTimingSubSystem()
+{
+	LOG_INFO(logger_, "Load timing...");
+
+	const auto tickRate = properties_->getFloatValue("engine.tickrate", 60.0f);
+	const auto maximumTicksPerFrame = properties_->getIntValue("engine.maxticksperframe", 5);
+	const auto maximumFrameTime = std::chrono::duration<float64>(properties_->getFloatValue("engine.maxframetime", 0.25f));
+	const auto catchUpPolicy = FixedStepScheduler::catchUpPolicyFromString(properties_->getStringValue("engine.catchuppolicy", "catchup"));
+
+	fixedStepScheduler_ = std::make_unique<FixedStepScheduler>(
+		tickRate,
+		static_cast<uint32>(std::max(maximumTicksPerFrame, 1)),
+		std::chrono::duration_cast<std::chrono::nanoseconds>(maximumFrameTime),
+		catchUpPolicy
+	);
+
+	// There are no frames to draw between ticks when headless
+	sleepUntilNextTick_ = properties_->getBoolValue("engine.sleepuntilnexttick", headless_);
+
+	LOG_INFO(logger_, "Ticking at %s Hz, at most %s ticks per frame.", fixedStepScheduler_->tickRate(), fixedStepScheduler_->maximumTicksPerFrame());
 }
 
 void GameEngine::initializeDataStoreSubSystem()
@@ -726,7 +847,7 @@ void GameEngine::processEvent(const scripting::DebugEvent& event)
                         a++;
                     }
 
-                    render();
+                    if (!headless_) render(1.0f);
 
                     endFpsTime = beginFpsTime;
                 }
@@ -909,6 +1030,11 @@ pathfinding::IPathfindingEngine* GameEngine::pathfindingEngine() const
 	return pathfindingEngine_.get();
 }
 
+networking::INetworkingEngine* GameEngine::networkingEngine() const
+{
+	return networkingEngine_.get();
+}
+
 IThreadPool* GameEngine::backgroundThreadPool() const
 {
 	return backgroundThreadPool_.get();
@@ -934,8 +1060,37 @@ fs::IFileSystem* GameEngine::fileSystem() const
 	return fileSystem_.get();
 }
 
+Profiler* GameEngine::profiler() const
+{
+	return profiler_.get();
+}
+
+networking::MessageBufferPool& GameEngine::messageBufferPool()
+{
+	return messageBufferPool_;
+}
+
+networking::MessageBufferBuilder GameEngine::createMessageBufferBuilder(const uint64 capacity)
+{
+	return networking::MessageBufferBuilder(&messageBufferPool_, static_cast<size_t>(capacity));
+}
+
+void GameEngine::exportProfilerTrace(const std::string& filename) const
+{
+	LOG_INFO(logger_, "Exporting profiler trace to '%s'.", filename);
+
+	auto file = fileSystem_->open(filename, fs::FileFlags::WRITE);
+
+	profiler_->exportChromeTrace(file->getOutputStream());
+}
+
 graphics::gui::IGui* GameEngine::createGui(const std::string& name)
 {
+	if (headless_)
+	{
+		throw InvalidOperationException(detail::format("Unable to create gui '%s', there is no gui when running headless.", name));
+	}
+
 	const auto& guiPlugins = pluginManager_->getGuiPlugins();
 
 	auto guiPlugin = std::find_if(guiPlugins.begin(), guiPlugins.end(), [&name](const auto& guiPlugin) -> bool { return guiPlugin->getName() == name; });
@@ -1110,11 +1265,17 @@ IImage* GameEngine::loadImage(const std::string& name, const std::string& filena
 		throw std::runtime_error(detail::format("Image file '%s' does not exist.", filename));
 	}
 
-	auto& resourceManager = this->resourceManager<Image>();
-    auto test = std::unique_ptr<Image>(resourceManager.import(name, filename));
+	auto mappedFile = fileSystem_->map(filename);
 
-//	auto file = fileSystem_->open(filename, fs::FileFlags::READ | fs::FileFlags::BINARY);
-	resourceCache_.addImage(name, std::move(test));
+	if (cooking::cookedAssetType(mappedFile->data(), mappedFile->size()) == cooking::CookedAssetType::IMAGE)
+	{
+		resourceCache_.addImage(name, cooking::loadImage(mappedFile->data(), mappedFile->size()));
+	}
+	else
+	{
+		auto& resourceManager = this->resourceManager<Image>();
+		resourceCache_.addImage(name, std::unique_ptr<Image>(resourceManager.import(name, filename)));
+	}
 
 	LOG_DEBUG(logger_, "Done loading image: %s", filename);
 
@@ -1151,12 +1312,200 @@ std::shared_future<IImage*> GameEngine::loadImageAsync(const std::string& name,
 
 Model* GameEngine::loadModel(const std::string& name, const std::string& filename)
 {
-	throw std::logic_error("loadModel not yet implemented.");
+	// Each cooked image is loaded once and shared through the resource cache
+	return loadModel(name, filename, [this](const std::string& imageFilename) -> IImage* {
+		return resourceCache_.getOrAddImage(cookedImageName(imageFilename), [this, &imageFilename]() {
+			if (!fileSystem_->exists(imageFilename))
+			{
+				throw FileNotFoundException(detail::format("Cooked image file '%s' does not exist.", imageFilename));
+			}
+
+			auto mappedImageFile = fileSystem_->map(imageFilename);
+			return cooking::loadImage(mappedImageFile->data(), mappedImageFile->size());
+		});
+	});
+}
+
+Model* GameEngine::loadModel(const std::string& name, const std::string& filename, const std::function<IImage*(const std::string&)>& resolveImage)
+{
+	LOG_DEBUG(logger_, "Loading model: %s", filename);
+	if (!fileSystem_->exists(filename))
+	{
+		throw FileNotFoundException(detail::format("Model file '%s' does not exist.", filename));
+	}
+
+	auto mappedFile = fileSystem_->map(filename);
+
+	// Texture paths are relative to the cooked model
+	const auto basePath = fileSystem_->getBasePath(filename);
+	auto model = cooking::loadModel(mappedFile->data(), mappedFile->size(), [this, &basePath, &resolveImage](const std::string& path) -> IImage* {
+		return resolveImage(basePath.empty() ? path : basePath + fileSystem_->getDirectorySeperator() + path);
+	});
+
+	resourceCache_.addModel(name, std::move(model));
+
+	LOG_DEBUG(logger_, "Done loading model: %s", filename);
+
+	return resourceCache_.getModel(name);
 }
 
 std::shared_future<Model*> GameEngine::loadModelAsync(const std::string& name, const std::string& filename)
 {
-	throw std::logic_error("loadModelAsync not yet implemented.");
+	auto promise = std::make_shared<std::promise<Model*>>();
+	auto sharedFuture = promise->get_future().share();
+
+	std::function<void()> func = [=, &logger = logger_, promise = promise, sharedFuture = sharedFuture, name = name, filename = filename]() {
+		try
+		{
+			auto model = this->loadModel(name, filename);
+			promise->set_value(model);
+		}
+		catch (const Exception& e)
+		{
+			promise->set_exception(std::current_exception());
+			LOG_ERROR(logger, "Error while loading model '%s' with filename '%s': %s", name, filename, boost::diagnostic_information(e));
+		}
+		catch (const std::exception& e)
+		{
+			promise->set_exception(std::current_exception());
+			LOG_ERROR(logger, "Error while loading model '%s' with filename '%s': %s", name, filename, boost::diagnostic_information(e));
+		}
+	};
+
+	backgroundThreadPool_->postWork(std::move(func));
+
+	return sharedFuture;
+}
+
+AssetLoader* GameEngine::assetLoader() const
+{
+	return assetLoader_.get();
+}
+
+void GameEngine::requestTexture(const std::string& name, const std::string& filename, AssetLoadCallback callback)
+{
+	AssetLoadRequest request;
+	request.name = name;
+	// Only an image this request loaded itself is released once uploaded, one that was already loaded belongs to whoever
+	// loaded it
+	auto loadedImage = std::make_shared<bool>(false);
+
+	request.decode = [this, name, filename, loadedImage]() {
+		if (resourceCache_.getImage(name)) return;
+
+		const auto image = this->loadImage(name, filename);
+		*loadedImage = true;
+
+		// Cooked images already have their mips
+		if (textureFormat_ != IImage::Format::FORMAT_UNKNOWN && image->mipLevelCount() == 1 && !image::isBlockCompressed(static_cast<IImage::Format>(image->format())))
+		{
+			resourceCache_.replaceImage(name, image::createTextureImage(*image, textureFormat_));
+		}
+	};
+	request.upload = [this, name, loadedImage]() {
+		if (!getTexture(name)) createTexture(name, Texture(name, resourceCache_.getImage(name)));
+
+		if (releaseTextureImages_ && *loadedImage) unloadImage(name);
+	};
+
+	assetLoader_->load(std::move(request), std::move(callback));
+}
+
+void GameEngine::requestTexture(const std::string& name, const std::string& filename, void* object)
+{
+	requestTexture(name, filename, scriptAssetLoadCallback(object));
+}
+
+void GameEngine::requestModel(const std::string& name, const std::string& filename, AssetLoadCallback callback)
+{
+	if (!fileSystem_->exists(filename))
+	{
+		throw FileNotFoundException(detail::format("Model file '%s' does not exist.", filename));
+	}
+
+	// Only the texture paths are read here, so the model's textures can decode in parallel before the model itself
+	std::vector<std::string> texturePaths;
+	{
+		auto mappedFile = fileSystem_->map(filename);
+		texturePaths = cooking::cookedModelTexturePaths(mappedFile->data(), mappedFile->size());
+	}
+
+	const auto basePath = fileSystem_->getBasePath(filename);
+
+	AssetLoadRequest request;
+	request.name = name;
+
+	for (const auto& path : texturePaths)
+	{
+		if (path.empty()) continue;
+
+		const auto imageFilename = basePath.empty() ? path : basePath + fileSystem_->getDirectorySeperator() + path;
+
+		requestTexture(cookedImageName(imageFilename), imageFilename);
+		request.dependencies.push_back(cookedImageName(imageFilename));
+	}
+
+	// The textures are uploaded by the time the model decodes, so it uses whatever image they left in the cache rather
+	// than decoding them again - with engine.releasetextureimages set, that is none
+	request.decode = [this, name, filename]() {
+		this->loadModel(name, filename, [this](const std::string& imageFilename) -> IImage* {
+			return resourceCache_.getImage(cookedImageName(imageFilename));
+		});
+	};
+	request.upload = [this, name]() {
+		const auto model = resourceCache_.getModel(name);
+
+		for (size_t i = 0; i < model->meshes().size(); ++i)
+		{
+			const auto meshHandle = createStaticMesh(detail::format("%s/%s", name, i), model->meshes()[i]);
+
+			if (i >= model->levelsOfDetail().size() || model->levelsOfDetail()[i].empty()) continue;
+
+			std::vector<graphics::MeshHandle> levelsOfDetail;
+			for (size_t j = 0; j < model->levelsOfDetail()[i].size(); ++j)
+			{
+				levelsOfDetail.push_back(createStaticMesh(detail::format("%s/%s/lod%s", name, i, j + 1), model->levelsOfDetail()[i][j]));
+			}
+
+			levelsOfDetail_[meshHandle] = std::move(levelsOfDetail);
+		}
+	};
+
+	assetLoader_->load(std::move(request), std::move(callback));
+}
+
+void GameEngine::requestModel(const std::string& name, const std::string& filename, void* object)
+{
+	requestModel(name, filename, scriptAssetLoadCallback(object));
+}
+
+AssetLoadCallback GameEngine::scriptAssetLoadCallback(void* object)
+{
+	scripting::ScriptFunctionHandle scriptFunctionHandle(object);
+
+	auto scriptFunctionHandleWrapper = ScriptFunctionHandleWrapper(scriptingEngine_.get(), scriptFunctionHandle);
+
+	return [&scriptingEngine_ = scriptingEngine_, scriptFunctionHandleWrapper = scriptFunctionHandleWrapper](const std::string& name, const std::exception_ptr& error) {
+		auto assetName = name;
+
+		scripting::ParameterList arguments;
+		arguments.addRef(assetName);
+		arguments.add(!error);
+
+		scriptingEngine_->execute(scriptFunctionHandleWrapper.get(), arguments);
+	};
+}
+
+HeightMap GameEngine::loadHeightMap(const std::string& filename)
+{
+	if (!fileSystem_->exists(filename))
+	{
+		throw FileNotFoundException(detail::format("Height map file '%s' does not exist.", filename));
+	}
+
+	auto mappedFile = fileSystem_->map(filename);
+
+	return cooking::loadHeightMap(mappedFile->data(), mappedFile->size());
 }
 
 Model* GameEngine::importModel(const std::string& name, const std::string& filename)
@@ -1628,6 +1977,16 @@ graphics::RenderableHandle GameEngine::createRenderable(
 	const glm::vec3& scale
 )
 {
+	auto it = levelsOfDetail_.find(meshHandle);
+
+	if (it != levelsOfDetail_.end())
+	{
+		std::vector<graphics::MeshHandle> levelsOfDetail = {meshHandle};
+		levelsOfDetail.insert(levelsOfDetail.end(), it->second.begin(), it->second.end());
+
+		return graphicsEngine_->createRenderable(renderSceneHandle, levelsOfDetail, textureHandle, position, orientation, scale);
+	}
+
 	return graphicsEngine_->createRenderable(renderSceneHandle, meshHandle, textureHandle, position, orientation, scale);
 }
 
@@ -1697,7 +2056,8 @@ void GameEngine::animateSkeleton(
 
 void GameEngine::handleEvents()
 {
-	graphicsEngine_->processEvents();
+	// Without a window the only events come from the network
+	if (!headless_) graphicsEngine_->processEvents();
 
 	networkingEngine_->processEvents();
 }
@@ -1975,6 +2335,14 @@ void GameEngine::addMessageEventListener(void* object)
 	scriptMessageEventListeners_.push_back( std::make_pair(listener, scriptObjectFunctionHandle) );
 }
 
+void GameEngine::addMessageEventBatchListener(void* object)
+{
+	scripting::ScriptObjectHandle listener(object);
+	auto scriptObjectFunctionHandle = scriptingEngine_->getScriptObjectFunction(listener, "bool processEvent(const MessageEventBatch& in)");
+
+	scriptMessageEventBatchListeners_.push_back( std::make_pair(listener, scriptObjectFunctionHandle) );
+}
+
 void GameEngine::removeConnectEventListener(void* object)
 {
 
@@ -1990,6 +2358,19 @@ void GameEngine::removeMessageEventListener(void* object)
 
 }
 
+void GameEngine::removeMessageEventBatchListener(void* object)
+{
+	const auto it = std::find_if(scriptMessageEventBatchListeners_.begin(), scriptMessageEventBatchListeners_.end(), [object](const auto& data) {
+		return data.first.get() == object;
+	});
+
+	if (it != scriptMessageEventBatchListeners_.end())
+	{
+		scriptingEngine_->releaseScriptObjectFunction(it->second);
+		scriptMessageEventBatchListeners_.erase(it);
+	}
+}
+
 void GameEngine::addScriptingEngineDebugHandler(IScriptingEngineDebugHandler* handler)
 {
     if (std::find(scriptingEngineDebugHandlers_.begin(), scriptingEngineDebugHandlers_.end(), handler) != scriptingEngineDebugHandlers_.end())
@@ -2264,36 +2645,96 @@ bool GameEngine::processEvent(const networking::DisconnectEvent& event)
 
 bool GameEngine::processEvent(const networking::MessageEvent& event)
 {
-	switch (event.type)
+	// Networking engines that still deliver messages one at a time already own the payload, so hand that same
+	// MessageEvent to the per-message listeners instead of copying it out of a batch
+	bool processed = false;
+
+	for (auto listener : messageEventListeners_)
 	{
-		case networking::SERVERMESSAGE:
-		case networking::CLIENTMESSAGE:
-			for (auto listener : messageEventListeners_)
-			{
-				bool returnValue = listener->processEvent(event);
-			}
-			for (const auto& data : scriptMessageEventListeners_)
-			{
-				scripting::ParameterList arguments;
-				arguments.addRef(event);
-				uint8 returnValue = false;
+		processed = listener->processEvent(event) || processed;
+	}
 
-				scriptingEngine_->execute(data.first, data.second, arguments, returnValue);
-			}
+	if (!scriptMessageEventBatchListeners_.empty())
+	{
+		networking::MessageEventView messageEventView;
+		static_cast<networking::GenericEvent&>(messageEventView) = event;
+		messageEventView.message = event.message.view();
 
-			{
-				std::string msg(event.message.begin(), event.message.end());
-				std::cout << "Message: " << msg << std::endl;
+		processed = dispatchMessageEventBatchToScripts(networking::MessageEventBatch(&messageEventView, 1)) || processed;
+	}
 
-				return true;
-			}
-			break;
+	return dispatchMessageEventToScripts(event) || processed;
+}
 
-		default:
-			break;
+bool GameEngine::processEvent(const networking::MessageEventBatch& messageEventBatch)
+{
+	if (messageEventBatch.empty()) return false;
+
+	LOG_TRACE(logger_, "Dispatching %s messages.", messageEventBatch.size());
+
+	bool processed = false;
+
+	for (auto listener : messageEventListeners_)
+	{
+		processed = listener->processEvent(messageEventBatch) || processed;
 	}
 
-	return false;
+	processed = dispatchMessageEventBatchToScripts(messageEventBatch) || processed;
+
+	// Listeners that take one message at a time get their own copy of each payload
+	if (!scriptMessageEventListeners_.empty())
+	{
+		for (const auto& messageEventView : messageEventBatch)
+		{
+			processed = dispatchMessageEventToScripts(networking::copyMessageEvent(messageEventView)) || processed;
+		}
+	}
+
+	return processed;
+}
+
+bool GameEngine::dispatchMessageEventBatchToScripts(const networking::MessageEventBatch& messageEventBatch)
+{
+	bool processed = false;
+
+	if (!scriptMessageEventBatchListeners_.empty())
+	{
+		scripting::ParameterList arguments;
+		arguments.addRef(messageEventBatch);
+
+		for (const auto& data : scriptMessageEventBatchListeners_)
+		{
+			uint8 returnValue = false;
+
+			scriptingEngine_->execute(data.first, data.second, arguments, returnValue);
+
+			processed = processed || returnValue;
+		}
+	}
+
+	return processed;
+}
+
+bool GameEngine::dispatchMessageEventToScripts(const networking::MessageEvent& messageEvent)
+{
+	bool processed = false;
+
+	if (!scriptMessageEventListeners_.empty())
+	{
+		scripting::ParameterList arguments;
+		arguments.addRef(messageEvent);
+
+		for (const auto& data : scriptMessageEventListeners_)
+		{
+			uint8 returnValue = false;
+
+			scriptingEngine_->execute(data.first, data.second, arguments, returnValue);
+
+			processed = processed || returnValue;
+		}
+	}
+
+	return processed;
 }
 
 void GameEngine::run()
@@ -2305,13 +2746,12 @@ void GameEngine::run()
 		LOG_INFO(logger_, "We have liftoff...");
 
 		// start our clock
-		auto beginFpsTime = std::chrono::high_resolution_clock::now();
-		auto endFpsTime = std::chrono::high_resolution_clock::now();
+		auto beginFpsTime = std::chrono::steady_clock::now();
+		auto endFpsTime = std::chrono::steady_clock::now();
 		auto previousFpsTime = beginFpsTime;
 		float32 currentFps = 0.0f;
 		float32 tempFps = 0.0f;
 		float32 delta = 0.0f;
-		float32 cumulativeDelta = 0.0f;
 
 		//float32 runningTime;
 		//std::vector<glm::mat4> transformations;
@@ -2333,11 +2773,16 @@ void GameEngine::run()
 
 		scriptingEngine_->execute(scriptObjectHandle_, "void initialize()");
 
+		// Don't count the time spent starting up against the first frame
+		endFpsTime = std::chrono::steady_clock::now();
+
 		while ( running_ )
 		{
-			beginFpsTime = std::chrono::high_resolution_clock::now();
+			profiler_->beginFrame();
+			const auto frameAllocations = Profiler::allocationCount();
+
+			beginFpsTime = std::chrono::steady_clock::now();
 			delta = std::chrono::duration<float32>(beginFpsTime - endFpsTime).count();
-			cumulativeDelta += delta;
 
 			tempFps++;
 
@@ -2348,29 +2793,61 @@ void GameEngine::run()
 				tempFps = 0;
 			}
 
-			networkingEngine_->tick(delta);
+			{
+				PROFILER_SCOPE(profiler_.get(), "NetworkingEngine::tick");
+				networkingEngine_->tick(delta);
+			}
+
+			auto beginTickTime = std::chrono::steady_clock::now();
+
+			const auto droppedTicks = fixedStepScheduler_->droppedTicks();
+			const uint32 numberOfTicks = fixedStepScheduler_->advance(beginFpsTime - endFpsTime);
 
-			const float32 updateFrequency = 1.0f / 60.0f;
-			int a = 0;
-			while (cumulativeDelta >= updateFrequency && a < 3)
+			for (uint32 i = 0; i < numberOfTicks; ++i)
 			{
-				tick(updateFrequency);
-				cumulativeDelta -= updateFrequency;
-				a++;
+				tick(fixedStepScheduler_->stepSeconds());
 			}
-	//		tick(delta);
 
-			auto beginRenderTime = std::chrono::high_resolution_clock::now();
+			engineStatistics_.tickTime = std::chrono::duration<float32>(std::chrono::steady_clock::now() - beginTickTime);
+			engineStatistics_.ticksPerFrame = numberOfTicks;
+			engineStatistics_.droppedTicks = fixedStepScheduler_->droppedTicks();
+			engineStatistics_.interpolationAlpha = fixedStepScheduler_->alpha();
 
-            render();
+			if (fixedStepScheduler_->droppedTicks() != droppedTicks)
+			{
+				LOG_DEBUG(logger_, "Falling behind, dropped %s ticks.", fixedStepScheduler_->droppedTicks() - droppedTicks);
+			}
 
-            auto endRenderTime = std::chrono::high_resolution_clock::now();
+			profiler_->counter("droppedTicks", static_cast<int64>(fixedStepScheduler_->droppedTicks() - droppedTicks));
 
-			engineStatistics_.renderTime = std::chrono::duration<float32>(endRenderTime - beginRenderTime);
+			// The upload budget is per frame, however many fixed ticks ran (or didn't) to catch up
+			uploadGraphicsAssets();
+
+			if (!headless_)
+			{
+				auto beginRenderTime = std::chrono::steady_clock::now();
+
+				render(fixedStepScheduler_->alpha());
+
+				auto endRenderTime = std::chrono::steady_clock::now();
+
+				engineStatistics_.renderTime = std::chrono::duration<float32>(endRenderTime - beginRenderTime);
+			}
 
 			endFpsTime = beginFpsTime;
 
 			engineStatistics_.fps = currentFps;
+			engineStatistics_.frameTime = std::chrono::duration<float32>(std::chrono::steady_clock::now() - beginFpsTime);
+			engineStatistics_.allocationsPerFrame = Profiler::allocationCount() - frameAllocations;
+
+			if (sleepUntilNextTick_)
+			{
+				// Nothing changes until the next tick, so there is no point drawing another frame before it
+				PROFILER_SCOPE(profiler_.get(), "GameEngine::sleep");
+				sleepPrecisely(beginFpsTime + fixedStepScheduler_->timeUntilNextTick());
+			}
+
+			profiler_->endFrame();
 		}
 
 //		scriptingEngine_->releaseAllScriptObjects();
@@ -1261,6 +1261,11 @@ void GraphicsEngineBindingDelegate::bind()
 		"RenderableHandle createRenderable(const RenderSceneHandle& in, const MeshHandle& in, const TextureHandle& in, const vec3& in, const quat& in, const vec3& in = vec3(1.0f), const ShaderProgramHandle& in = ShaderProgramHandle())",
 		asMETHODPR(graphics::IGraphicsEngine, createRenderable, (const graphics::RenderSceneHandle&, const graphics::MeshHandle&, const graphics::TextureHandle&, const glm::vec3&, const glm::quat&, const glm::vec3&, const graphics::ShaderProgramHandle&), graphics::RenderableHandle)
 	);
+	scriptingEngine_->registerClassMethod(
+		"IGraphicsEngine",
+		"void levelOfDetail(const RenderSceneHandle& in, const RenderableHandle& in, const uint32)",
+		asMETHODPR(graphics::IGraphicsEngine, levelOfDetail, (const graphics::RenderSceneHandle&, const graphics::RenderableHandle&, const uint32), void)
+	);
 	scriptingEngine_->registerClassMethod(
 		"IGraphicsEngine",
 		"void rotate(const CameraHandle& in, const quat& in, const TransformSpace& in = TransformSpace::TS_LOCAL)",
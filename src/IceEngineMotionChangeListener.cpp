@@ -1,37 +1,51 @@
 #include "IceEngineMotionChangeListener.hpp"
 
-#include "Scene.hpp"
+#include "ecs/EntityComponentSystem.hpp"
 
 namespace ice_engine
 {
 
-IceEngineMotionChangeListener::IceEngineMotionChangeListener(ecs::Entity entity, Scene* scene) : entity_(entity), scene_(scene)
+bool applyMotionChange(ecs::EntityComponentSystem& entityComponentSystem, const entityx::Entity::Id id, const glm::vec3& position, const glm::quat& orientation)
 {
-	
-}
+	if (!entityComponentSystem.valid(id)) return false;
 
-IceEngineMotionChangeListener::~IceEngineMotionChangeListener()
-{
-}
+	auto positionComponent = entityComponentSystem.component<ecs::PositionComponent>(id);
+	auto orientationComponent = entityComponentSystem.component<ecs::OrientationComponent>(id);
 
-void IceEngineMotionChangeListener::update(const glm::vec3& position, const glm::quat& orientation)
-{
-	auto pc = entity_.component<ecs:: PositionComponent>();
-	auto oc = entity_.component<ecs:: OrientationComponent>();
+	if (!positionComponent || !orientationComponent) return false;
+
+	positionComponent->position = position;
+	orientationComponent->orientation = glm::normalize(orientation);
 
-	pc->position = position;
-	oc->orientation = glm::normalize(orientation);
+	constexpr uint16 dirty = ecs::DirtyFlags::DIRTY_SOURCE_PHYSICS | ecs::DirtyFlags::DIRTY_POSITION | ecs::DirtyFlags::DIRTY_ORIENTATION;
 
-	if (entity_.hasComponent<ecs::DirtyComponent>())
+	if (auto dirtyComponent = entityComponentSystem.component<ecs::DirtyComponent>(id))
 	{
-		auto dirtyComponent = entity_.component<ecs::DirtyComponent>();
-		dirtyComponent->dirty |= ecs::DirtyFlags::DIRTY_SOURCE_PHYSICS | ecs::DirtyFlags::DIRTY_POSITION | ecs::DirtyFlags::DIRTY_ORIENTATION;
+		dirtyComponent->dirty |= dirty;
 	}
 	else
 	{
-		entity_.assign<ecs::DirtyComponent>(ecs::DirtyFlags::DIRTY_SOURCE_PHYSICS | ecs::DirtyFlags::DIRTY_POSITION | ecs::DirtyFlags::DIRTY_ORIENTATION);
+		entityComponentSystem.assign<ecs::DirtyComponent>(id, dirty);
 	}
+
+	return true;
+}
+
+IceEngineMotionChangeListener::IceEngineMotionChangeListener(ecs::Entity entity, ecs::EntityComponentSystem* entityComponentSystem)
+	:
+	entity_(entity),
+	entityComponentSystem_(entityComponentSystem)
+{
+	
+}
+
+IceEngineMotionChangeListener::~IceEngineMotionChangeListener()
+{
 }
 
+void IceEngineMotionChangeListener::update(const glm::vec3& position, const glm::quat& orientation)
+{
+	applyMotionChange(*entityComponentSystem_, entity_.id(), position, orientation);
+}
 
 }
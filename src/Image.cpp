@@ -1,7 +1,11 @@
+#include <algorithm>
+
 #include <FreeImage.h>
 
 #include "Image.hpp"
 
+#include "image/ImageProcessing.hpp"
+
 #include "exceptions/RuntimeException.hpp"
 
 namespace ice_engine
@@ -58,18 +62,18 @@ void Image::importImage(const std::vector<byte>& data, bool hasAlpha)
                 pixelSize = 4;
             }
 
-            // FreeImage loads in BGR format, so you need to swap some bytes (Or use GL_BGR)
-            for ( int j = 0; j < w * h; j++ )
+            const auto pitch = FreeImage_GetPitch(bitmap);
+            const size_t rowSize = static_cast<size_t>(pixelSize * w);
+
+            // Transfer raw data into a vector, leaving out any padding FreeImage puts at the end of each row
+            data_.resize(rowSize * h);
+            for ( int j = 0; j < h; j++ )
             {
-                byte swap = pixels[j * pixelSize + 2];
-                pixels[j * pixelSize + 2] = pixels[j * pixelSize + 0];
-                pixels[j * pixelSize + 0] = swap;
+                std::copy(pixels + j * pitch, pixels + j * pitch + rowSize, data_.begin() + j * rowSize);
             }
 
-            int imageBytesLength = pixelSize * w * h;
-
-            // Transfer raw data into a vector
-            data_ = std::vector<byte>(pixels, pixels+imageBytesLength);
+            // FreeImage loads in BGR format, so you need to swap some bytes (Or use GL_BGR)
+            image::swapRedAndBlue(data_.data(), static_cast<size_t>(w) * h, pixelSize);
 
             width_ = w;
             height_ = h;
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <string>
+#include <sstream>
 
 #include "Main.hpp"
 
@@ -17,7 +19,34 @@ Main::~Main()
 {
 }
 
-int main()
+namespace
+{
+/**
+ * Mounts the comma separated list of pack archives in the 'filesystem.archives' setting.  Later archives override
+ * files in earlier ones, so patch archives go last.
+ */
+void mountArchives(const ice_engine::utilities::Properties& properties, ice_engine::fs::FileSystem& fileSystem)
+{
+	std::stringstream archives(properties.getStringValue("filesystem.archives", ""));
+	std::string archive;
+
+	while (std::getline(archives, archive, ','))
+	{
+		if (archive.empty()) continue;
+
+		try
+		{
+			fileSystem.mountArchive(archive);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "Unable to mount archive '" << archive << "': " << e.what() << std::endl;
+		}
+	}
+}
+}
+
+int main(int argc, char** argv)
 {
 	auto logger = std::make_unique< ice_engine::logger::Logger >();
 
@@ -38,6 +67,13 @@ int main()
 	}
 	
 	auto properties = std::make_unique< ice_engine::utilities::Properties >(configData);
+	for (const auto& argument : properties->applyCommandLine(argc, argv))
+	{
+		std::cerr << "Ignoring unknown argument '" << argument << "'." << std::endl;
+	}
+
+	mountArchives(*properties, *fileSystem);
+
 	auto pluginManager = std::make_unique< ice_engine::PluginManager >(properties.get(), fileSystem.get(), logger.get());
 	
 	// Start the game engine
@@ -2,6 +2,7 @@
 #include "Types.hpp"
 
 #include "networking/INetworkingEngine.hpp"
+#include "networking/MessageBufferBuilder.hpp"
 
 #include "NetworkingEngineBindingDelegate.hpp"
 #include "BindingDelegateUtilities.hpp"
@@ -13,6 +14,9 @@
 namespace ice_engine
 {
 
+static void InitConstructorMessageBufferReader(networking::SharedMessageBufferReader* memory, const networking::MessageBuffer& messageBuffer) { new(memory) networking::SharedMessageBufferReader(messageBuffer); }
+static void InitConstructorMessageBufferReaderCopy(networking::SharedMessageBufferReader* memory, const ArrayView<const uint8>& data) { new(memory) networking::SharedMessageBufferReader(data); }
+
 NetworkingEngineBindingDelegate::NetworkingEngineBindingDelegate(logger::ILogger* logger, scripting::IScriptingEngine* scriptingEngine, GameEngine* gameEngine, networking::INetworkingEngine* networkingEngine)
 	:
 	logger_(logger),
@@ -38,6 +42,7 @@ void NetworkingEngineBindingDelegate::bind()
 	registerHandleBindings<networking::ServerHandle>(scriptingEngine_, "ServerHandle");
 	registerHandleBindings<networking::ClientHandle>(scriptingEngine_, "ClientHandle");
 	registerHandleBindings<networking::RemoteConnectionHandle>(scriptingEngine_, "RemoteConnectionHandle");
+	registerVectorBindings<networking::RemoteConnectionHandle>(scriptingEngine_, "vectorRemoteConnectionHandle", "RemoteConnectionHandle");
 
 	scriptingEngine_->registerObjectType("ConnectEvent", sizeof(networking::ConnectEvent), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLINTS | asGetTypeTraits<networking::ConnectEvent>());
 	scriptingEngine_->registerObjectProperty("ConnectEvent", "uint32 type", asOFFSET(networking::ConnectEvent, type));
@@ -51,13 +56,89 @@ void NetworkingEngineBindingDelegate::bind()
 	scriptingEngine_->registerObjectProperty("DisconnectEvent", "ServerHandle serverHandle", asOFFSET(networking::DisconnectEvent, serverHandle));
 	scriptingEngine_->registerObjectProperty("DisconnectEvent", "ClientHandle clientHandle", asOFFSET(networking::DisconnectEvent, clientHandle));
 	scriptingEngine_->registerObjectProperty("DisconnectEvent", "RemoteConnectionHandle remoteConnectionHandle", asOFFSET(networking::DisconnectEvent, remoteConnectionHandle));
-	scriptingEngine_->registerObjectType("MessageEvent", sizeof(networking::MessageEvent), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLINTS | asGetTypeTraits<networking::MessageEvent>());
+
+	registerArrayViewBindings<const uint8>(scriptingEngine_, "arrayViewUInt8", "uint8");
+
+	// MessageBuffer
+	scriptingEngine_->registerObjectType("MessageBuffer", sizeof(networking::MessageBuffer), asOBJ_VALUE | asOBJ_APP_CLASS_CDAK | asGetTypeTraits<networking::MessageBuffer>());
+	scriptingEngine_->registerObjectBehaviour("MessageBuffer", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(DefaultConstructor<networking::MessageBuffer>), asCALL_CDECL_OBJLAST);
+	scriptingEngine_->registerObjectBehaviour("MessageBuffer", asBEHAVE_CONSTRUCT, "void f(const MessageBuffer& in)", asFUNCTION(CopyConstructor<networking::MessageBuffer>), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("MessageBuffer", asBEHAVE_DESTRUCT, "void f()", asFUNCTION(DefaultDestructor<networking::MessageBuffer>), asCALL_CDECL_OBJLAST);
+	scriptingEngine_->registerClassMethod("MessageBuffer", "MessageBuffer& opAssign(const MessageBuffer& in)", asMETHODPR(networking::MessageBuffer, operator=, (const networking::MessageBuffer&), networking::MessageBuffer&));
+	scriptingEngine_->registerClassMethod("MessageBuffer", "uint64 size() const", asMETHODPR(networking::MessageBuffer, size, () const, size_t));
+	scriptingEngine_->registerClassMethod("MessageBuffer", "uint64 length() const", asMETHODPR(networking::MessageBuffer, length, () const, size_t));
+	scriptingEngine_->registerClassMethod("MessageBuffer", "bool empty() const", asMETHODPR(networking::MessageBuffer, empty, () const, bool));
+	scriptingEngine_->registerClassMethod("MessageBuffer", "uint8 at(uint64) const", asMETHODPR(networking::MessageBuffer, at, (const size_t) const, uint8));
+	scriptingEngine_->registerClassMethod("MessageBuffer", "uint8 opIndex(uint64) const", asMETHODPR(networking::MessageBuffer, at, (const size_t) const, uint8));
+	scriptingEngine_->registerClassMethod("MessageBuffer", "arrayViewUInt8 view() const", asMETHODPR(networking::MessageBuffer, view, () const, ArrayView<const uint8>));
+
+	// MessageBufferBuilder
+	scriptingEngine_->registerObjectType("MessageBufferBuilder", sizeof(networking::MessageBufferBuilder), asOBJ_VALUE | asOBJ_APP_CLASS_CDAK | asGetTypeTraits<networking::MessageBufferBuilder>());
+	scriptingEngine_->registerObjectBehaviour("MessageBufferBuilder", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(DefaultConstructor<networking::MessageBufferBuilder>), asCALL_CDECL_OBJLAST);
+	scriptingEngine_->registerObjectBehaviour("MessageBufferBuilder", asBEHAVE_CONSTRUCT, "void f(const MessageBufferBuilder& in)", asFUNCTION(CopyConstructor<networking::MessageBufferBuilder>), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("MessageBufferBuilder", asBEHAVE_DESTRUCT, "void f()", asFUNCTION(DefaultDestructor<networking::MessageBufferBuilder>), asCALL_CDECL_OBJLAST);
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "MessageBufferBuilder& opAssign(const MessageBufferBuilder& in)", asMETHODPR(networking::MessageBufferBuilder, operator=, (const networking::MessageBufferBuilder&), networking::MessageBufferBuilder&));
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "void writeUInt8(const uint8)", asMETHODPR(networking::MessageBufferBuilder, writeUInt8, (const uint8), void));
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "void writeUInt16(const uint16)", asMETHODPR(networking::MessageBufferBuilder, writeUInt16, (const uint16), void));
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "void writeUInt32(const uint32)", asMETHODPR(networking::MessageBufferBuilder, writeUInt32, (const uint32), void));
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "void writeUInt64(const uint64)", asMETHODPR(networking::MessageBufferBuilder, writeUInt64, (const uint64), void));
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "void writeInt32(const int32)", asMETHODPR(networking::MessageBufferBuilder, writeInt32, (const int32), void));
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "void writeInt64(const int64)", asMETHODPR(networking::MessageBufferBuilder, writeInt64, (const int64), void));
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "void writeFloat(const float)", asMETHODPR(networking::MessageBufferBuilder, writeFloat, (const float32), void));
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "void writeBool(const bool)", asMETHODPR(networking::MessageBufferBuilder, writeBool, (const bool), void));
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "void writeVec3(const vec3& in)", asMETHODPR(networking::MessageBufferBuilder, writeVec3, (const glm::vec3&), void));
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "void writeQuat(const quat& in)", asMETHODPR(networking::MessageBufferBuilder, writeQuat, (const glm::quat&), void));
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "void writeString(const string& in)", asMETHODPR(networking::MessageBufferBuilder, writeString, (const std::string&), void));
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "uint64 size() const", asMETHODPR(networking::MessageBufferBuilder, size, () const, size_t));
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "void clear()", asMETHODPR(networking::MessageBufferBuilder, clear, (), void));
+	scriptingEngine_->registerClassMethod("MessageBufferBuilder", "MessageBuffer build()", asMETHODPR(networking::MessageBufferBuilder, build, (), networking::MessageBuffer));
+	scriptingEngine_->registerGlobalFunction(
+		"MessageBufferBuilder createMessageBufferBuilder(const uint64 = 0)",
+		asMETHODPR(GameEngine, createMessageBufferBuilder, (const uint64), networking::MessageBufferBuilder),
+		asCALL_THISCALL_ASGLOBAL,
+		gameEngine_
+	);
+
+	// MessageBufferReader - the script type holds a reference to the message, so a reader made from a temporary buffer stays valid
+	scriptingEngine_->registerObjectType("MessageBufferReader", sizeof(networking::SharedMessageBufferReader), asOBJ_VALUE | asOBJ_APP_CLASS_CDAK | asGetTypeTraits<networking::SharedMessageBufferReader>());
+	scriptingEngine_->registerObjectBehaviour("MessageBufferReader", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(DefaultConstructor<networking::SharedMessageBufferReader>), asCALL_CDECL_OBJLAST);
+	scriptingEngine_->registerObjectBehaviour("MessageBufferReader", asBEHAVE_CONSTRUCT, "void f(const MessageBufferReader& in)", asFUNCTION(CopyConstructor<networking::SharedMessageBufferReader>), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("MessageBufferReader", asBEHAVE_CONSTRUCT, "void f(const MessageBuffer& in)", asFUNCTION(InitConstructorMessageBufferReader), asCALL_CDECL_OBJFIRST);
+	// Views can refer to data that goes away (a batch's payloads, for example), so the reader copies them
+	scriptingEngine_->registerObjectBehaviour("MessageBufferReader", asBEHAVE_CONSTRUCT, "void f(const arrayViewUInt8& in)", asFUNCTION(InitConstructorMessageBufferReaderCopy), asCALL_CDECL_OBJFIRST);
+	scriptingEngine_->registerObjectBehaviour("MessageBufferReader", asBEHAVE_DESTRUCT, "void f()", asFUNCTION(DefaultDestructor<networking::SharedMessageBufferReader>), asCALL_CDECL_OBJLAST);
+	scriptingEngine_->registerClassMethod("MessageBufferReader", "MessageBufferReader& opAssign(const MessageBufferReader& in)", asMETHODPR(networking::SharedMessageBufferReader, operator=, (const networking::SharedMessageBufferReader&), networking::SharedMessageBufferReader&));
+	scriptingEngine_->registerClassMethod("MessageBufferReader", "uint8 readUInt8()", asMETHODPR(networking::MessageBufferReader, readUInt8, (), uint8));
+	scriptingEngine_->registerClassMethod("MessageBufferReader", "uint16 readUInt16()", asMETHODPR(networking::MessageBufferReader, readUInt16, (), uint16));
+	scriptingEngine_->registerClassMethod("MessageBufferReader", "uint32 readUInt32()", asMETHODPR(networking::MessageBufferReader, readUInt32, (), uint32));
+	scriptingEngine_->registerClassMethod("MessageBufferReader", "uint64 readUInt64()", asMETHODPR(networking::MessageBufferReader, readUInt64, (), uint64));
+	scriptingEngine_->registerClassMethod("MessageBufferReader", "int32 readInt32()", asMETHODPR(networking::MessageBufferReader, readInt32, (), int32));
+	scriptingEngine_->registerClassMethod("MessageBufferReader", "int64 readInt64()", asMETHODPR(networking::MessageBufferReader, readInt64, (), int64));
+	scriptingEngine_->registerClassMethod("MessageBufferReader", "float readFloat()", asMETHODPR(networking::MessageBufferReader, readFloat, (), float32));
+	scriptingEngine_->registerClassMethod("MessageBufferReader", "bool readBool()", asMETHODPR(networking::MessageBufferReader, readBool, (), bool));
+	scriptingEngine_->registerClassMethod("MessageBufferReader", "vec3 readVec3()", asMETHODPR(networking::MessageBufferReader, readVec3, (), glm::vec3));
+	scriptingEngine_->registerClassMethod("MessageBufferReader", "quat readQuat()", asMETHODPR(networking::MessageBufferReader, readQuat, (), glm::quat));
+	scriptingEngine_->registerClassMethod("MessageBufferReader", "string readString()", asMETHODPR(networking::MessageBufferReader, readString, (), std::string));
+	scriptingEngine_->registerClassMethod("MessageBufferReader", "uint64 remaining() const", asMETHODPR(networking::MessageBufferReader, remaining, () const, size_t));
+	scriptingEngine_->registerClassMethod("MessageBufferReader", "bool eof() const", asMETHODPR(networking::MessageBufferReader, eof, () const, bool));
+
+	// MessageEvent owns a reference counted buffer, so scripts only ever see it by reference
+	scriptingEngine_->registerObjectType("MessageEvent", 0, asOBJ_REF | asOBJ_NOCOUNT);
 	scriptingEngine_->registerObjectProperty("MessageEvent", "uint32 type", asOFFSET(networking::MessageEvent, type));
 	scriptingEngine_->registerObjectProperty("MessageEvent", "uint32 timestamp", asOFFSET(networking::MessageEvent, timestamp));
 	scriptingEngine_->registerObjectProperty("MessageEvent", "ServerHandle serverHandle", asOFFSET(networking::MessageEvent, serverHandle));
 	scriptingEngine_->registerObjectProperty("MessageEvent", "ClientHandle clientHandle", asOFFSET(networking::MessageEvent, clientHandle));
 	scriptingEngine_->registerObjectProperty("MessageEvent", "RemoteConnectionHandle remoteConnectionHandle", asOFFSET(networking::MessageEvent, remoteConnectionHandle));
-	scriptingEngine_->registerObjectProperty("MessageEvent", "vectorUInt8 message", asOFFSET(networking::MessageEvent, message));
+	scriptingEngine_->registerObjectProperty("MessageEvent", "MessageBuffer message", asOFFSET(networking::MessageEvent, message));
+
+	scriptingEngine_->registerObjectType("MessageEventView", sizeof(networking::MessageEventView), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLINTS | asGetTypeTraits<networking::MessageEventView>());
+	scriptingEngine_->registerObjectProperty("MessageEventView", "uint32 type", asOFFSET(networking::MessageEventView, type));
+	scriptingEngine_->registerObjectProperty("MessageEventView", "uint32 timestamp", asOFFSET(networking::MessageEventView, timestamp));
+	scriptingEngine_->registerObjectProperty("MessageEventView", "ServerHandle serverHandle", asOFFSET(networking::MessageEventView, serverHandle));
+	scriptingEngine_->registerObjectProperty("MessageEventView", "ClientHandle clientHandle", asOFFSET(networking::MessageEventView, clientHandle));
+	scriptingEngine_->registerObjectProperty("MessageEventView", "RemoteConnectionHandle remoteConnectionHandle", asOFFSET(networking::MessageEventView, remoteConnectionHandle));
+	scriptingEngine_->registerObjectProperty("MessageEventView", "arrayViewUInt8 message", asOFFSET(networking::MessageEventView, message));
+	registerArrayViewBindings<const networking::MessageEventView>(scriptingEngine_, "MessageEventBatch", "MessageEventView");
 	
 	// INetworkingEngine
 	scriptingEngine_->registerObjectType("INetworkingEngine", 0, asOBJ_REF | asOBJ_NOCOUNT);
@@ -97,6 +178,26 @@ void NetworkingEngineBindingDelegate::bind()
 		"void send(const ClientHandle& in, const vectorUInt8& in)",
 		asMETHODPR(networking::INetworkingEngine, send, (const networking::ClientHandle&, const std::vector<uint8>&), void)
 	);
+	scriptingEngine_->registerClassMethod(
+		"INetworkingEngine",
+		"void send(const ServerHandle& in, const MessageBuffer& in)",
+		asMETHODPR(networking::INetworkingEngine, send, (const networking::ServerHandle&, const networking::MessageBuffer&), void)
+	);
+	scriptingEngine_->registerClassMethod(
+		"INetworkingEngine",
+		"void send(const ServerHandle& in, const RemoteConnectionHandle& in, const MessageBuffer& in)",
+		asMETHODPR(networking::INetworkingEngine, send, (const networking::ServerHandle&, const networking::RemoteConnectionHandle&, const networking::MessageBuffer&), void)
+	);
+	scriptingEngine_->registerClassMethod(
+		"INetworkingEngine",
+		"void send(const ServerHandle& in, const vectorRemoteConnectionHandle& in, const MessageBuffer& in)",
+		asMETHODPR(networking::INetworkingEngine, send, (const networking::ServerHandle&, const std::vector<networking::RemoteConnectionHandle>&, const networking::MessageBuffer&), void)
+	);
+	scriptingEngine_->registerClassMethod(
+		"INetworkingEngine",
+		"void send(const ClientHandle& in, const MessageBuffer& in)",
+		asMETHODPR(networking::INetworkingEngine, send, (const networking::ClientHandle&, const networking::MessageBuffer&), void)
+	);
 	scriptingEngine_->registerClassMethod(
 		"INetworkingEngine",
 		"void processEvents()",
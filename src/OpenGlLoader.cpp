@@ -1,15 +1,26 @@
+#include <algorithm>
+
 #include "OpenGlLoader.hpp"
 
 namespace ice_engine
 {
 
-OpenGlLoader::OpenGlLoader()
+OpenGlLoader::OpenGlLoader() : incomingWork_(nullptr), workQueueCount_(0), blocked_(false)
 {
 	initialize();
 }
 
 OpenGlLoader::~OpenGlLoader()
 {
+	// Work that never ran is destroyed here, which breaks the promises of any futures still waiting on it
+	auto task = incomingWork_.exchange(nullptr, std::memory_order_acquire);
+
+	while (task)
+	{
+		const auto next = task->next;
+		delete task;
+		task = next;
+	}
 }
 
 void OpenGlLoader::initialize()
@@ -18,26 +29,57 @@ void OpenGlLoader::initialize()
 
 std::future<void> OpenGlLoader::postWork(const std::function<void()>& work)
 {
-	auto task = std::make_shared<std::packaged_task<void()>>([work = work]() {
-		work();
-	});
-	
-	std::lock_guard<std::mutex> lockGuard(enqueuedWorkMutex_);
-	enqueuedWork_.push_back(task);
-	
-	return task->get_future();
+	return postWork(std::function<void()>(work), WorkPriority::NORMAL);
 }
 
 std::future<void> OpenGlLoader::postWork(std::function<void()>&& work)
 {
-	auto task = std::make_shared<std::packaged_task<void()>>([work = std::move(work)]() {
-		work();
-	});
-	
-	std::lock_guard<std::mutex> lockGuard(enqueuedWorkMutex_);
-	enqueuedWork_.push_back(task);
-	
-	return task->get_future();
+	return postWork(std::move(work), WorkPriority::NORMAL);
+}
+
+std::future<void> OpenGlLoader::postWork(std::function<void()>&& work, const WorkPriority priority)
+{
+	auto task = std::make_unique<Task>();
+	task->work = std::packaged_task<void()>(std::move(work));
+	task->priority = priority;
+	task->enqueuedTime = std::chrono::steady_clock::now();
+
+	return push(std::move(task));
+}
+
+std::future<void> OpenGlLoader::push(std::unique_ptr<Task> task)
+{
+	auto future = task->work.get_future();
+
+	workQueueCount_.fetch_add(1, std::memory_order_relaxed);
+
+	auto node = task.release();
+	node->next = incomingWork_.load(std::memory_order_relaxed);
+	while (!incomingWork_.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed));
+
+	return future;
+}
+
+void OpenGlLoader::takeIncomingWork()
+{
+	auto task = incomingWork_.exchange(nullptr, std::memory_order_acquire);
+
+	// The list is newest first, so reverse it to run work in the order it was posted
+	Task* reversed = nullptr;
+	while (task)
+	{
+		const auto next = task->next;
+		task->next = reversed;
+		reversed = task;
+		task = next;
+	}
+
+	while (reversed)
+	{
+		const auto next = reversed->next;
+		enqueuedWork_[static_cast<size_t>(reversed->priority)].push_back(std::unique_ptr<Task>(reversed));
+		reversed = next;
+	}
 }
 
 void OpenGlLoader::waitAll()
@@ -47,34 +89,98 @@ void OpenGlLoader::waitAll()
 
 uint32 OpenGlLoader::getWorkQueueCount() const
 {
-	uint size = 0;
-	
-	std::lock_guard<std::mutex> lockGuard(enqueuedWorkMutex_);
-	size = enqueuedWork_.size();
-	
-	return size;
+	return workQueueCount_.load(std::memory_order_relaxed);
 }
 
 void OpenGlLoader::block()
 {
-	enqueuedWorkMutex_.lock();
+	blocked_ = true;
 }
 
 void OpenGlLoader::unblock()
 {
-	enqueuedWorkMutex_.unlock();
+	blocked_ = false;
+}
+
+const OpenGlLoaderStatistics& OpenGlLoader::statistics() const
+{
+	return statistics_;
+}
+
+void OpenGlLoader::run(Task& task)
+{
+	const auto latency = std::chrono::steady_clock::now() - task.enqueuedTime;
+
+	statistics_.maximumQueueLatency = std::max(statistics_.maximumQueueLatency, std::chrono::duration_cast<std::chrono::nanoseconds>(latency));
+	statistics_.averageQueueLatency += std::chrono::duration_cast<std::chrono::nanoseconds>(latency);
+	++statistics_.tasksRun;
+
+	workQueueCount_.fetch_sub(1, std::memory_order_relaxed);
+
+	task.work();
 }
 
 void OpenGlLoader::tick()
 {
-	std::lock_guard<std::mutex> lockGuard(enqueuedWorkMutex_);
-	if (enqueuedWork_.size() > 0)
+	tick(std::chrono::nanoseconds::zero());
+}
+
+uint32 OpenGlLoader::tick(const std::chrono::nanoseconds budget)
+{
+	statistics_ = OpenGlLoaderStatistics();
+
+	if (blocked_)
 	{
-		auto work = enqueuedWork_.front();
-		enqueuedWork_.pop_front();
-		
-		(*work)();
+		statistics_.tasksRemaining = getWorkQueueCount();
+		return 0;
 	}
+
+	const auto startTime = std::chrono::steady_clock::now();
+	const auto deadline = startTime + budget;
+
+	takeIncomingWork();
+
+	auto& highPriorityWork = enqueuedWork_[static_cast<size_t>(WorkPriority::HIGH)];
+
+	bool budgetUsed = false;
+	while (!budgetUsed)
+	{
+		std::unique_ptr<Task> task;
+
+		for (auto& work : enqueuedWork_)
+		{
+			if (work.empty()) continue;
+
+			task = std::move(work.front());
+			work.pop_front();
+			break;
+		}
+
+		if (!task) break;
+
+		run(*task);
+
+		// Pick up work posted while running, such as work chained on from the task that just ran
+		takeIncomingWork();
+
+		budgetUsed = (std::chrono::steady_clock::now() >= deadline);
+	}
+
+	// High priority work always runs, whatever the budget - but only the work queued by now.  High priority work it posts
+	// waits for the next tick, otherwise work that keeps posting more would never let the tick finish.
+	for (auto count = highPriorityWork.size(); count > 0; --count)
+	{
+		auto task = std::move(highPriorityWork.front());
+		highPriorityWork.pop_front();
+
+		run(*task);
+	}
+
+	if (statistics_.tasksRun > 0) statistics_.averageQueueLatency /= statistics_.tasksRun;
+	statistics_.executionTime = std::chrono::steady_clock::now() - startTime;
+	statistics_.tasksRemaining = getWorkQueueCount();
+
+	return statistics_.tasksRun;
 }
 
 }
@@ -5,6 +5,12 @@
 
 #include "PluginManager.hpp"
 
+#include "NullGraphicsPlugin.hpp"
+#include "NullAudioPlugin.hpp"
+#include "NullPathfindingPlugin.hpp"
+#include "NullPhysicsPlugin.hpp"
+#include "NullNetworkingPlugin.hpp"
+
 #include "exceptions/Exception.hpp"
 
 #include "detail/Format.hpp"
@@ -14,6 +20,12 @@
 namespace ice_engine
 {
 
+namespace
+{
+// Plugin name that selects the built in null implementation instead of loading a shared library
+const std::string NULL_PLUGIN_NAME = "null";
+}
+
 template<class T>
 auto import(const std::string& path, const std::string& name, boost::dll::load_mode::type mode)
 {
@@ -34,6 +46,11 @@ PluginManager::PluginManager(utilities::Properties* properties, fs::IFileSystem*
 		logger_(logger)
 {
 	LOG_INFO(logger_, "Loading plugins.");
+
+	// A headless server never draws or plays anything, so don't pay for loading the graphics, audio and gui plugins
+	const bool headless = properties_->getBoolValue("engine.headless", false);
+
+	if (headless) LOG_INFO(logger_, "Running headless, gui, graphics and audio plugins will not be loaded.");
 	
 	LOG_INFO(logger_, "Loading image resource importer plugins.");
 
@@ -60,6 +77,8 @@ PluginManager::PluginManager(utilities::Properties* properties, fs::IFileSystem*
 	std::vector<std::string> guiPluginNames;
 	utilities::explode(properties_->getStringValue("plugins.guiplugins"), ',', std::back_inserter(guiPluginNames));
 
+	if (headless) guiPluginNames.clear();
+
 	for (const auto& guiPluginName : guiPluginNames)
 	{
 		LOG_INFO(logger_, "Loading gui plugin '%s'.", guiPluginName);
@@ -75,9 +94,14 @@ PluginManager::PluginManager(utilities::Properties* properties, fs::IFileSystem*
 
 	LOG_INFO(logger_, "Loading graphics plugin.");
 
-    const std::string graphicsPluginName = properties_->getStringValue("plugins.graphicsplugin");
+    const std::string graphicsPluginName = headless ? NULL_PLUGIN_NAME : properties_->getStringValue("plugins.graphicsplugin");
 	
-	if (!graphicsPluginName.empty())
+	if (graphicsPluginName == NULL_PLUGIN_NAME)
+	{
+		LOG_INFO(logger_, "Using built in null graphics plugin.");
+		graphicsPlugin_ = std::make_shared<NullGraphicsPlugin>();
+	}
+	else if (!graphicsPluginName.empty())
 	{
 		LOG_INFO(logger_, "Loading graphics plugin '%s'.", graphicsPluginName);
 		auto pluginBoostSharedPtr = import<ice_engine::IGraphicsPlugin>("./" + graphicsPluginName + "_plugin", "plugin", boost::dll::load_mode::append_decorations);
@@ -90,9 +114,14 @@ PluginManager::PluginManager(utilities::Properties* properties, fs::IFileSystem*
 
 	LOG_INFO(logger_, "Loading audio plugin.");
 
-    const std::string audioPluginName = properties_->getStringValue("plugins.audioplugin");
+    const std::string audioPluginName = headless ? NULL_PLUGIN_NAME : properties_->getStringValue("plugins.audioplugin");
 
-	if (!audioPluginName.empty())
+	if (audioPluginName == NULL_PLUGIN_NAME)
+	{
+		LOG_INFO(logger_, "Using built in null audio plugin.");
+		audioPlugin_ = std::make_shared<NullAudioPlugin>();
+	}
+	else if (!audioPluginName.empty())
 	{
 		LOG_INFO(logger_, "Loading audio plugin '%s'.", audioPluginName);
 		auto pluginBoostSharedPtr = import<ice_engine::IAudioPlugin>("./" + audioPluginName + "_plugin", "plugin", boost::dll::load_mode::append_decorations);
@@ -107,7 +136,12 @@ PluginManager::PluginManager(utilities::Properties* properties, fs::IFileSystem*
 
 	const std::string pathfindingPluginName = properties_->getStringValue("plugins.pathfindingplugin");
 
-	if (!pathfindingPluginName.empty())
+	if (pathfindingPluginName == NULL_PLUGIN_NAME)
+	{
+		LOG_INFO(logger_, "Using built in null pathfinding plugin.");
+		pathfindingPlugin_ = std::make_shared<NullPathfindingPlugin>();
+	}
+	else if (!pathfindingPluginName.empty())
 	{
 		LOG_INFO(logger_, "Loading pathfinding plugin '%s'.", pathfindingPluginName);
 		auto pluginBoostSharedPtr = import<ice_engine::IPathfindingPlugin>("./" + pathfindingPluginName + "_plugin", "plugin", boost::dll::load_mode::append_decorations);
@@ -122,7 +156,12 @@ PluginManager::PluginManager(utilities::Properties* properties, fs::IFileSystem*
 
     const std::string physicsPluginName = properties_->getStringValue("plugins.physicsplugin");
 
-	if (!physicsPluginName.empty())
+	if (physicsPluginName == NULL_PLUGIN_NAME)
+	{
+		LOG_INFO(logger_, "Using built in null physics plugin.");
+		physicsPlugin_ = std::make_shared<NullPhysicsPlugin>();
+	}
+	else if (!physicsPluginName.empty())
 	{
 		LOG_INFO(logger_, "Loading physics plugin '%s'.", physicsPluginName);
 		auto pluginBoostSharedPtr = import<ice_engine::IPhysicsPlugin>("./" + physicsPluginName + "_plugin", "plugin", boost::dll::load_mode::append_decorations);
@@ -137,7 +176,12 @@ PluginManager::PluginManager(utilities::Properties* properties, fs::IFileSystem*
 
 	const std::string networkingPluginName = properties_->getStringValue("plugins.networkingplugin");
 
-	if (!networkingPluginName.empty())
+	if (networkingPluginName == NULL_PLUGIN_NAME)
+	{
+		LOG_INFO(logger_, "Using built in null networking plugin.");
+		networkingPlugin_ = std::make_shared<NullNetworkingPlugin>();
+	}
+	else if (!networkingPluginName.empty())
 	{
 		LOG_INFO(logger_, "Loading networking plugin '%s'.", networkingPluginName);
 		auto pluginBoostSharedPtr = import<ice_engine::INetworkingPlugin>("./" + networkingPluginName + "_plugin", "plugin", boost::dll::load_mode::append_decorations);
@@ -0,0 +1,293 @@
+#include <cstdlib>
+#include <new>
+
+#include "Profiler.hpp"
+
+namespace ice_engine
+{
+
+namespace
+{
+std::atomic<uint64> allocations{0};
+std::atomic<uint32> nextThreadId{0};
+
+thread_local uint32 profilerDepth = 0;
+thread_local uint32 profilerThreadId = nextThreadId++;
+
+void writeJsonString(std::ostream& outputStream, const char* value)
+{
+	outputStream << '"';
+
+	for (const char* c = value; *c != '\0'; ++c)
+	{
+		switch (*c)
+		{
+			case '"':
+				outputStream << "\\\"";
+				break;
+
+			case '\\':
+				outputStream << "\\\\";
+				break;
+
+			case '\n':
+				outputStream << "\\n";
+				break;
+
+			default:
+				if (static_cast<unsigned char>(*c) >= 0x20) outputStream << *c;
+				break;
+		}
+	}
+
+	outputStream << '"';
+}
+
+float64 toMicroseconds(const std::chrono::nanoseconds& nanoseconds)
+{
+	return std::chrono::duration<float64, std::micro>(nanoseconds).count();
+}
+}
+
+Profiler::Profiler(const uint32 historySize) : history_(historySize == 0 ? 1 : historySize), epoch_(std::chrono::high_resolution_clock::now())
+{
+}
+
+void Profiler::setEnabled(const bool enabled)
+{
+	enabled_ = enabled;
+}
+
+bool Profiler::enabled() const
+{
+	return enabled_;
+}
+
+ProfilerFrame& Profiler::currentFrame()
+{
+	return history_[frameNumber_ % history_.size()];
+}
+
+void Profiler::beginFrame()
+{
+	if (!enabled_) return;
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	++frameNumber_;
+
+	// Re-use the slot so the vectors keep their capacity and a running profiler doesn't allocate every frame
+	auto& frame = currentFrame();
+	frame.frameNumber = frameNumber_;
+	frame.start = std::chrono::high_resolution_clock::now() - epoch_;
+	frame.duration = std::chrono::nanoseconds(0);
+	frame.allocations = 0;
+	frame.markers.clear();
+	frame.counters.clear();
+
+	frameAllocationsStart_ = allocationCount();
+	frameInProgress_ = true;
+}
+
+void Profiler::endFrame()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	if (!frameInProgress_) return;
+
+	auto& frame = currentFrame();
+	frame.duration = (std::chrono::high_resolution_clock::now() - epoch_) - frame.start;
+	frame.allocations = allocationCount() - frameAllocationsStart_;
+
+	frameInProgress_ = false;
+}
+
+void Profiler::record(
+	const char* name,
+	const std::chrono::high_resolution_clock::time_point& start,
+	const std::chrono::high_resolution_clock::time_point& end,
+	const uint32 depth,
+	std::string detail
+)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	if (!frameInProgress_) return;
+
+	ProfilerMarker marker;
+	marker.name = name;
+	marker.detail = std::move(detail);
+	marker.threadId = profilerThreadId;
+	marker.depth = depth;
+	marker.start = start - epoch_;
+	marker.duration = end - start;
+
+	currentFrame().markers.push_back(std::move(marker));
+}
+
+void Profiler::counter(const char* name, const int64 value)
+{
+	if (!enabled_) return;
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	if (!frameInProgress_) return;
+
+	currentFrame().counters.push_back({name, value});
+}
+
+uint64 Profiler::frameNumber() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	return frameNumber_;
+}
+
+std::vector<ProfilerFrame> Profiler::history() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	std::vector<ProfilerFrame> frames;
+
+	const uint64 numberOfFrames = std::min<uint64>(frameNumber_, history_.size());
+	frames.reserve(numberOfFrames);
+
+	for (uint64 i = frameNumber_ - numberOfFrames + 1; i <= frameNumber_; ++i)
+	{
+		const auto& frame = history_[i % history_.size()];
+
+		// Skip the frame currently being recorded
+		if (frame.frameNumber == frameNumber_ && frameInProgress_) continue;
+
+		frames.push_back(frame);
+	}
+
+	return frames;
+}
+
+void Profiler::exportChromeTrace(std::ostream& outputStream) const
+{
+	const auto frames = history();
+
+	outputStream << "{\"traceEvents\":[";
+
+	bool first = true;
+	auto separator = [&outputStream, &first]() {
+		if (!first) outputStream << ",";
+		first = false;
+	};
+
+	for (const auto& frame : frames)
+	{
+		separator();
+		outputStream << "{\"name\":\"Frame\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":0"
+			<< ",\"ts\":" << toMicroseconds(frame.start)
+			<< ",\"dur\":" << toMicroseconds(frame.duration)
+			<< ",\"args\":{\"frame\":" << frame.frameNumber << ",\"allocations\":" << frame.allocations << "}}";
+
+		for (const auto& marker : frame.markers)
+		{
+			separator();
+			outputStream << "{\"name\":";
+			writeJsonString(outputStream, marker.name);
+			outputStream << ",\"cat\":\"engine\",\"ph\":\"X\",\"pid\":1"
+				<< ",\"tid\":" << marker.threadId
+				<< ",\"ts\":" << toMicroseconds(marker.start)
+				<< ",\"dur\":" << toMicroseconds(marker.duration)
+				<< ",\"args\":{\"depth\":" << marker.depth;
+
+			if (!marker.detail.empty())
+			{
+				outputStream << ",\"detail\":";
+				writeJsonString(outputStream, marker.detail.c_str());
+			}
+
+			outputStream << "}}";
+		}
+
+		// Counters are sampled once per frame, so stamp them at the end of the frame
+		for (const auto& counter : frame.counters)
+		{
+			separator();
+			outputStream << "{\"name\":";
+			writeJsonString(outputStream, counter.name);
+			outputStream << ",\"ph\":\"C\",\"pid\":1"
+				<< ",\"ts\":" << toMicroseconds(frame.start + frame.duration)
+				<< ",\"args\":{\"value\":" << counter.value << "}}";
+		}
+	}
+
+	outputStream << "],\"displayTimeUnit\":\"ms\"}";
+}
+
+uint64 Profiler::allocationCount()
+{
+	return allocations.load(std::memory_order_relaxed);
+}
+
+ProfilerScope::ProfilerScope(Profiler* profiler, const char* name) : profiler_(profiler && profiler->enabled() ? profiler : nullptr), name_(name)
+{
+	if (profiler_)
+	{
+		depth_ = profilerDepth++;
+		start_ = std::chrono::high_resolution_clock::now();
+	}
+}
+
+ProfilerScope::ProfilerScope(Profiler* profiler, const char* name, std::string detail) : ProfilerScope(profiler, name)
+{
+	if (profiler_) detail_ = std::move(detail);
+}
+
+ProfilerScope::~ProfilerScope()
+{
+	if (profiler_)
+	{
+		--profilerDepth;
+		profiler_->record(name_, start_, std::chrono::high_resolution_clock::now(), depth_, std::move(detail_));
+	}
+}
+
+}
+
+#if defined(ICEENGINE_ENABLE_ALLOCATION_PROFILING)
+
+void* operator new(std::size_t size)
+{
+	ice_engine::allocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* pointer = std::malloc(size == 0 ? 1 : size)) return pointer;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	ice_engine::allocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* pointer = std::malloc(size == 0 ? 1 : size)) return pointer;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t size) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t size) noexcept
+{
+	std::free(pointer);
+}
+
+#endif
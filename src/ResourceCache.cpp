@@ -111,5 +111,48 @@ Model* ResourceCache::getModel(const std::string& name) const
 	return nullptr;
 }
 
+Image* ResourceCache::getOrAddImage(const std::string& name, const std::function<std::unique_ptr<Image>()>& create)
+{
+	{
+		std::lock_guard<std::recursive_mutex> lock(imageMutex_);
+
+		auto it = images_.find(name);
+		if (it != images_.end())
+		{
+			return it->second.get();
+		}
+	}
+
+	// Decoding can take a while, so don't hold up other image lookups for it
+	auto image = create();
+	if (!image)
+	{
+		throw RuntimeException(detail::format("Unable to create image '%s'.", name));
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(imageMutex_);
+
+	// Another thread may have added the same image while we were creating ours, in which case everyone gets theirs
+	auto it = images_.find(name);
+	if (it != images_.end())
+	{
+		return it->second.get();
+	}
+
+	auto result = image.get();
+	images_[name] = std::move(image);
+
+	return result;
+}
+
+Image* ResourceCache::replaceImage(const std::string& name, std::unique_ptr<Image> image)
+{
+	std::lock_guard<std::recursive_mutex> lock(imageMutex_);
+
+	auto result = image.get();
+	images_[name] = std::move(image);
+
+	return result;
+}
 
 }
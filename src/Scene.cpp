@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <fstream>
 #include <sstream>
 
@@ -7,6 +10,8 @@
 #include <boost/uuid/uuid_io.hpp>
 
 #include "exceptions/Throw.hpp"
+#include "exceptions/InvalidArgumentException.hpp"
+#include "exceptions/InvalidOperationException.hpp"
 #include <boost/archive/text_oarchive.hpp>
 
 #include <glm/gtx/string_cast.hpp>
@@ -22,12 +27,35 @@
 #include "IceEnginePathfindingMovementRequestStateChangeListener.hpp"
 
 #include "detail/Format.hpp"
+#include "detail/ForEachChunk.hpp"
+
+#include "mesh/LevelOfDetail.hpp"
 
 namespace ice_engine
 {
 
 namespace
 {
+// Rays or spheres handled by one worker in raycastMany and queryMany
+constexpr size_t BATCH_QUERY_CHUNK_SIZE = 64;
+
+/**
+ * Returns the entity whose id was stored as the user id of a physics or pathfinding object, or an invalid entity if
+ * the object has no entity.
+ */
+ecs::Entity toEntity(logger::ILogger* logger, ecs::EntityComponentSystem& entityComponentSystem, const uint64 userId)
+{
+	const auto id = entityx::Entity::Id(userId);
+
+	if (userId == 0 || !entityComponentSystem.valid(id))
+	{
+		LOG_WARN(logger, "User id did not refer to a valid Entity")
+		return ecs::Entity();
+	}
+
+	return entityComponentSystem.get(id);
+}
+
 class QueryVisitor :  public boost::static_visitor<>
 {
 public:
@@ -35,47 +63,65 @@ public:
 		logger::ILogger* logger,
 		physics::IPhysicsEngine& physicsEngine,
 		physics::PhysicsSceneHandle physicsSceneHandle,
+		ecs::EntityComponentSystem& entityComponentSystem,
 		std::vector<ecs::Entity>& entities)
 	:
 		logger_(logger),
 		physicsEngine_(physicsEngine),
 		physicsSceneHandle_(physicsSceneHandle),
+		entityComponentSystem_(entityComponentSystem),
 		entities_(entities)
 	{
 	}
 
     void operator()(const physics::RigidBodyObjectHandle& rigidBodyObjectHandle)
     {
-    	auto userData = physicsEngine_.getUserData(physicsSceneHandle_, rigidBodyObjectHandle);
-		if (userData.type() == typeid(ecs::Entity))
-		{
-			entities_.push_back(boost::any_cast<ecs::Entity>(userData));
-		}
-		else
-		{
-			LOG_WARN(logger_, "User data was empty or was not of type Entity")
-		}
+		add(physicsEngine_.userId(physicsSceneHandle_, rigidBodyObjectHandle));
     }
 
     void operator()(const physics::GhostObjectHandle& ghostObjectHandle)
     {
-    	auto userData = physicsEngine_.getUserData(physicsSceneHandle_, ghostObjectHandle);
-		if (userData.type() == typeid(ecs::Entity))
-		{
-			entities_.push_back(boost::any_cast<ecs::Entity>(userData));
-		}
-		else
-		{
-			LOG_WARN(logger_, "User data was empty or was not of type Entity")
-		}
+		add(physicsEngine_.userId(physicsSceneHandle_, ghostObjectHandle));
     }
 
 private:
     logger::ILogger* logger_;
 	physics::IPhysicsEngine& physicsEngine_;
 	physics::PhysicsSceneHandle physicsSceneHandle_;
+	ecs::EntityComponentSystem& entityComponentSystem_;
     std::vector<ecs::Entity>& entities_;
+
+	void add(const uint64 userId)
+	{
+		const auto entity = toEntity(logger_, entityComponentSystem_, userId);
+		if (entity) entities_.push_back(entity);
+	}
 };
+
+Raycast toRaycast(
+	logger::ILogger* logger,
+	physics::IPhysicsEngine& physicsEngine,
+	const physics::PhysicsSceneHandle& physicsSceneHandle,
+	ecs::EntityComponentSystem& entityComponentSystem,
+	const physics::Raycast& physicsRaycast)
+{
+	Raycast result;
+
+	result.setRay(physicsRaycast.ray());
+	result.setHitPointWorld(physicsRaycast.hitPointWorld());
+	result.setHitNormalWorld(physicsRaycast.hitNormalWorld());
+
+	if (physicsRaycast.rigidBodyObjectHandle())
+	{
+		result.setEntity(toEntity(logger, entityComponentSystem, physicsEngine.userId(physicsSceneHandle, physicsRaycast.rigidBodyObjectHandle())));
+	}
+	else if (physicsRaycast.ghostObjectHandle())
+	{
+		result.setEntity(toEntity(logger, entityComponentSystem, physicsEngine.userId(physicsSceneHandle, physicsRaycast.ghostObjectHandle())));
+	}
+
+	return result;
+}
 }
 
 Scene::Scene(
@@ -105,6 +151,7 @@ Scene::Scene(
 		logger_(logger),
 		threadPool_(gameEngine->backgroundThreadPool()),
 		openGlLoader_(gameEngine->openGlLoader()),
+		profiler_(gameEngine->profiler()),
 		entityComponentSystem_(std::make_unique<ecs::EntityComponentSystem>(this))
 {
 	initialize();
@@ -137,6 +184,7 @@ Scene::Scene(
 		logger_(logger),
 		threadPool_(gameEngine->backgroundThreadPool()),
 		openGlLoader_(gameEngine->openGlLoader()),
+		profiler_(gameEngine->profiler()),
 		entityComponentSystem_(std::make_unique<ecs::EntityComponentSystem>(this))
 {
 	initialize();
@@ -149,6 +197,18 @@ Scene::~Scene()
 
 void Scene::initialize()
 {
+	renderInterpolation_ = properties_->getBoolValue("engine.renderinterpolation", true);
+
+	// Each level of detail is drawn down to half the screen size of the one before it
+	const auto levelOfDetailScreenSize = properties_->getFloatValue("engine.lodscreensize", 0.25f);
+	for (uint32 i = 0; i + 1 < mesh::MAXIMUM_LEVELS_OF_DETAIL; ++i)
+	{
+		levelOfDetailScreenSizes_.push_back(levelOfDetailScreenSize / static_cast<float32>(1 << i));
+	}
+
+	levelOfDetailFieldOfView_ = glm::radians(properties_->getFloatValue("engine.lodfieldofview", 60.0f));
+	levelOfDetailHysteresis_ = properties_->getFloatValue("engine.lodhysteresis", 0.1f);
+
 	audioSceneHandle_ = audioEngine_->createAudioScene();
 	renderSceneHandle_ = graphicsEngine_->createRenderScene();
 	physicsSceneHandle_ = physicsEngine_->createPhysicsScene();
@@ -174,6 +234,8 @@ void Scene::destroy()
 {
 	LOG_DEBUG(logger_, "Destroying scene: %s", name_);
 
+	stopReplication();
+
 	audioEngine_->destroyAudioScene(audioSceneHandle_);
     graphicsEngine_->destroy(renderSceneHandle_);
     physicsEngine_->destroy(physicsSceneHandle_);
@@ -208,6 +270,11 @@ void Scene::applyChangesToEntities()
 
 		auto dirtyComponent = entity.component<ecs::DirtyComponent>();
 
+		if (dirtyComponent->dirty & ecs::DirtyFlags::DIRTY_POSITION)
+		{
+			if (auto pc = entity.component<ecs::PositionComponent>()) updateSpatialIndex(entity, pc->position);
+		}
+
 		if (dirtyComponent->dirty & ecs::DirtyFlags::DIRTY_SOURCE_SCRIPT)
 		{
 			if (dirtyComponent->dirty & ecs::DirtyFlags::DIRTY_POSITION)
@@ -369,20 +436,71 @@ void Scene::applyChangesToEntities()
 		}
 	}
 
+	if (renderInterpolation_) recordRenderInterpolations(dirtyEntities);
+
 	for (auto& entity : dirtyEntities)
 	{
 		entity.remove<ecs::DirtyComponent>();
 	}
 }
 
+void Scene::recordRenderInterpolations(const std::vector<ecs::Entity>& dirtyEntities)
+{
+	for (const auto& entity : dirtyEntities)
+	{
+		const auto dirtyComponent = entity.component<ecs::DirtyComponent>();
+
+		if (!(dirtyComponent->dirty & (ecs::DirtyFlags::DIRTY_POSITION | ecs::DirtyFlags::DIRTY_ORIENTATION))) continue;
+		if (!entity.hasComponent<ecs::GraphicsComponent>()) continue;
+
+		// Children are drawn where their parent is, which may not have been copied to them yet
+		const auto root = transformRoot(entity);
+		if (!root.hasComponent<ecs::PositionComponent>() || !root.hasComponent<ecs::OrientationComponent>()) continue;
+
+		const auto position = root.component<ecs::PositionComponent>()->position;
+		const auto orientation = root.component<ecs::OrientationComponent>()->orientation;
+
+		auto it = renderInterpolations_.find(entity.id().id());
+
+		if (it == renderInterpolations_.end())
+		{
+			// We don't know where it was drawn before this tick, so it starts interpolating from the next one
+			RenderInterpolation renderInterpolation;
+			renderInterpolation.entity = entity;
+			renderInterpolation.previousPosition = position;
+			renderInterpolation.previousOrientation = orientation;
+
+			it = renderInterpolations_.emplace(entity.id().id(), renderInterpolation).first;
+		}
+
+		it->second.currentPosition = position;
+		it->second.currentOrientation = orientation;
+		it->second.changed = true;
+	}
+}
+
+ecs::Entity Scene::transformRoot(ecs::Entity entity) const
+{
+	// Entities with a ParentComponent take their parent's transform, so an entity's world transform is that of the
+	// first ancestor without a parent.  The depth limit guards against parent cycles.
+	for (uint32 depth = 0; depth < 32 && entity.hasComponent<ecs::ParentComponent>(); ++depth)
+	{
+		const auto parent = entity.component<ecs::ParentComponent>()->entity;
+		if (!parent.valid()) break;
+
+		entity = parent;
+	}
+
+	return entity;
+}
+
 void Scene::tick(const float32 delta)
 {
+	tickRenderInterpolations();
+
     if (!active())
     {
-        handleAsyncEntityCreation();
-        handleAsyncEntityDeletion();
-        handleParentComponentChanges();
-        applyChangesToEntities();
+        tickEntityChanges();
         return;
     }
 
@@ -391,31 +509,128 @@ void Scene::tick(const float32 delta)
 
 	if (scriptObjectHandle_)
 	{
+		PROFILER_SCOPE(profiler_, "Scene::preTick");
 		scriptingEngine_->execute(scriptObjectHandle_, std::string("void preTick(const float)"), params, executionContextHandle_);
 	}
 
 	tickAudio(delta);
+	tickTerrain(delta);
 	tickPhysics(delta);
 	tickPathfinding(delta);
 	tickScriptObjects(delta);
 
 	if (scriptObjectHandle_)
 	{
+		PROFILER_SCOPE(profiler_, "Scene::postTick");
 		scriptingEngine_->execute(scriptObjectHandle_, std::string("void postTick(const float)"), params, executionContextHandle_);
 	}
 
-	handleAsyncEntityCreation();
-	handleAsyncEntityDeletion();
+	{
+		PROFILER_SCOPE(profiler_, "Scene::asyncEntityChanges");
+		handleAsyncEntityCreation();
+		handleAsyncEntityDeletion();
+	}
 
 	tickAnimations(delta);
 
-	handleParentComponentChanges();
+	// Replicated transforms go through the same propagation as everything else this tick
+	tickReplicationClient();
+
+	{
+		PROFILER_SCOPE(profiler_, "Scene::parentChanges");
+		handleParentComponentChanges();
+	}
+
+	{
+		PROFILER_SCOPE(profiler_, "Scene::dirtyPropagation");
+		applyChangesToEntities();
+	}
+
+	tickReplicationServer();
+}
+
+void Scene::tickEntityChanges()
+{
+	{
+		PROFILER_SCOPE(profiler_, "Scene::asyncEntityChanges");
+		handleAsyncEntityCreation();
+		handleAsyncEntityDeletion();
+	}
+
+	{
+		PROFILER_SCOPE(profiler_, "Scene::parentChanges");
+		handleParentComponentChanges();
+	}
+
+	{
+		PROFILER_SCOPE(profiler_, "Scene::dirtyPropagation");
+		applyChangesToEntities();
+	}
+}
+
+void Scene::tickRenderInterpolations()
+{
+	for (auto it = renderInterpolations_.begin(); it != renderInterpolations_.end();)
+	{
+		auto& renderInterpolation = it->second;
+
+		if (!renderInterpolation.entity.valid() || !renderInterpolation.entity.hasComponent<ecs::GraphicsComponent>())
+		{
+			it = renderInterpolations_.erase(it);
+			continue;
+		}
+
+		if (!renderInterpolation.changed)
+		{
+			// It came to rest last tick, make sure it isn't left drawn part way there
+			const auto graphicsComponent = renderInterpolation.entity.component<ecs::GraphicsComponent>();
+			graphicsEngine_->position(renderSceneHandle_, graphicsComponent->renderableHandle, renderInterpolation.currentPosition);
+			graphicsEngine_->rotation(renderSceneHandle_, graphicsComponent->renderableHandle, renderInterpolation.currentOrientation);
+
+			it = renderInterpolations_.erase(it);
+			continue;
+		}
+
+		renderInterpolation.previousPosition = renderInterpolation.currentPosition;
+		renderInterpolation.previousOrientation = renderInterpolation.currentOrientation;
+		renderInterpolation.changed = false;
+
+		++it;
+	}
+}
+
+void Scene::tickReplicationClient()
+{
+	if (replicationClient_)
+	{
+		PROFILER_SCOPE(profiler_, "Scene::replicationClient");
+		replicationClient_->tick();
+	}
+}
+
+void Scene::tickReplicationServer()
+{
+	if (replicationServer_)
+	{
+		PROFILER_SCOPE(profiler_, "Scene::replicationServer");
+		replicationServer_->tick();
+	}
+}
+
+void Scene::tickTerrain(const float32 delta)
+{
+	PROFILER_SCOPE(profiler_, "Scene::tickTerrain");
 
-	applyChangesToEntities();
+	for (auto& terrain : terrain_)
+	{
+		terrain->tick(delta);
+	}
 }
 
 void Scene::tickPhysics(const float32 delta)
 {
+	PROFILER_SCOPE(profiler_, "Scene::tickPhysics");
+
     auto beginPhysicsTime = std::chrono::high_resolution_clock::now();
 
     physicsEngine_->tick(physicsSceneHandle_, delta);
@@ -423,20 +638,44 @@ void Scene::tickPhysics(const float32 delta)
     auto endPhysicsTime = std::chrono::high_resolution_clock::now();
 
     sceneStatistics_.physicsTime = std::chrono::duration<float32>(endPhysicsTime - beginPhysicsTime).count();
+
+	applyMotionChanges();
+}
+
+void Scene::applyMotionChanges()
+{
+	PROFILER_SCOPE(profiler_, "Scene::applyMotionChanges");
+
+	const auto motionChanges = physicsEngine_->motionChanges(physicsSceneHandle_);
+
+	profiler_->counter("Physics motion changes", static_cast<int64>(motionChanges.size()));
+
+	for (const auto& motionChange : motionChanges)
+	{
+		if (motionChange.userId == 0) continue;
+
+		applyMotionChange(*entityComponentSystem_, entityx::Entity::Id(motionChange.userId), motionChange.position, motionChange.orientation);
+	}
 }
 
 void Scene::tickAudio(const float32 delta)
 {
+	PROFILER_SCOPE(profiler_, "Scene::tickAudio");
+
     audioEngine_->tick(audioSceneHandle_, delta);
 }
 
 void Scene::tickPathfinding(const float32 delta)
 {
+	PROFILER_SCOPE(profiler_, "Scene::tickPathfinding");
+
     pathfindingEngine_->tick(pathfindingSceneHandle_, delta);
 }
 
 void Scene::tickScriptObjects(const float32 delta)
 {
+	PROFILER_SCOPE(profiler_, "Scene::tickScriptObjects");
+
     scripting::ParameterList params;
     params.add(delta);
 
@@ -454,6 +693,8 @@ void Scene::tickScriptObjects(const float32 delta)
 
 void Scene::tickAnimations(const float32 delta)
 {
+	PROFILER_SCOPE(profiler_, "Scene::tickAnimations");
+
     for (auto e : entityComponentSystem_->entitiesWithComponents<ecs::GraphicsComponent, ecs::AnimationComponent>())
     {
         const auto graphicsComponent = e.component<ecs::GraphicsComponent>();
@@ -464,9 +705,9 @@ void Scene::tickAnimations(const float32 delta)
         {
             gameEngine_->foregroundThreadPool()->postWork([=, &transformations = animationComponent->transformations, runningTime = animationComponent->runningTime]() {
                 gameEngine_->animateSkeleton(transformations, runningTime, animationComponent->startFrame, animationComponent->endFrame, graphicsComponent->meshHandle, animationComponent->animationHandle, skeletonComponent->skeletonHandle);
-                gameEngine_->foregroundGraphicsThreadPool()->postWork([=]() {
+                gameEngine_->openGlLoader()->postWork([=]() {
                     graphicsEngine_->update(renderSceneHandle_, graphicsComponent->renderableHandle, animationComponent->bonesHandle, animationComponent->transformations);
-                });
+                }, WorkPriority::HIGH);
             });
 
             animationComponent->runningTime += std::chrono::duration<float32>(delta) * animationComponent->speed;
@@ -526,18 +767,90 @@ void Scene::handleParentComponentChanges()
     }
 }
 
-void Scene::render()
+void Scene::render(const float32 alpha)
 {
 	if (visible())
     {
+		PROFILER_SCOPE(profiler_, "Scene::render", name_);
+
+        auto beginRenderTime = std::chrono::high_resolution_clock::now();
+
+		if (renderInterpolation_)
+		{
+			PROFILER_SCOPE(profiler_, "Scene::renderInterpolation");
+
+			for (const auto& kv : renderInterpolations_)
+			{
+				const auto& renderInterpolation = kv.second;
+
+				if (!renderInterpolation.entity.valid()) continue;
+
+				const auto graphicsComponent = renderInterpolation.entity.component<ecs::GraphicsComponent>();
+				if (!graphicsComponent) continue;
+
+				graphicsEngine_->position(renderSceneHandle_, graphicsComponent->renderableHandle, glm::mix(renderInterpolation.previousPosition, renderInterpolation.currentPosition, alpha));
+				graphicsEngine_->rotation(renderSceneHandle_, graphicsComponent->renderableHandle, glm::slerp(renderInterpolation.previousOrientation, renderInterpolation.currentOrientation, alpha));
+			}
+		}
+
+		selectLevelsOfDetail();
+
 	    graphicsEngine_->render(renderSceneHandle_);
 	    physicsEngine_->renderDebug(physicsSceneHandle_);
 	    pathfindingEngine_->renderDebug(pathfindingSceneHandle_);
 
         audioEngine_->render(audioSceneHandle_);
+
+        auto endRenderTime = std::chrono::high_resolution_clock::now();
+
+        sceneStatistics_.renderTime = std::chrono::duration<float32>(endRenderTime - beginRenderTime).count();
     }
 }
 
+void Scene::selectLevelsOfDetail()
+{
+	if (!levelOfDetailCamera_) return;
+
+	PROFILER_SCOPE(profiler_, "Scene::selectLevelsOfDetail");
+
+	const auto cameraPosition = graphicsEngine_->position(levelOfDetailCamera_);
+
+	for (auto entity : entityComponentSystem_->entitiesWithComponents<ecs::GraphicsComponent, ecs::LevelOfDetailComponent>())
+	{
+		const auto graphicsComponent = entity.component<ecs::GraphicsComponent>();
+		auto levelOfDetailComponent = entity.component<ecs::LevelOfDetailComponent>();
+
+		// A new renderable starts out drawing its most detailed level, whatever the old one was drawing
+		if (levelOfDetailComponent->renderableHandle != graphicsComponent->renderableHandle)
+		{
+			levelOfDetailComponent->renderableHandle = graphicsComponent->renderableHandle;
+			levelOfDetailComponent->levelOfDetail = 0;
+		}
+
+		if (!graphicsComponent->renderableHandle) continue;
+
+		const auto levelCount = gameEngine_->levelOfDetailCount(graphicsComponent->meshHandle);
+		if (levelCount == 1) continue;
+
+		// Children are drawn where their parent is
+		const auto root = transformRoot(entity);
+		if (!root.hasComponent<ecs::PositionComponent>()) continue;
+
+		const auto& scale = graphicsComponent->scale;
+		const auto radius = levelOfDetailComponent->radius * std::max(std::abs(scale.x), std::max(std::abs(scale.y), std::abs(scale.z)));
+		const auto distance = glm::length(root.component<ecs::PositionComponent>()->position - cameraPosition);
+		const auto screenSize = mesh::screenSize(radius, distance, levelOfDetailFieldOfView_) * levelOfDetailComponent->bias;
+
+		const auto levelOfDetail = mesh::selectLevelOfDetail(levelOfDetailScreenSizes_, levelCount, screenSize, levelOfDetailComponent->levelOfDetail, levelOfDetailHysteresis_);
+
+		if (levelOfDetail != levelOfDetailComponent->levelOfDetail)
+		{
+			levelOfDetailComponent->levelOfDetail = levelOfDetail;
+			graphicsEngine_->levelOfDetail(renderSceneHandle_, graphicsComponent->renderableHandle, levelOfDetail);
+		}
+	}
+}
+
 void Scene::setSceneThingyInstance(void* object)
 {
 	scriptObjectHandle_ = scripting::ScriptObjectHandle(object);
@@ -681,7 +994,8 @@ void Scene::addMotionChangeListener(const ecs::Entity& entity)
 {
 	auto rigidBodyObjectComponent = entityComponentSystem_->component<ecs::RigidBodyObjectComponent>(entity.id());
 
-	std::unique_ptr<IceEngineMotionChangeListener> motionChangeListener = std::make_unique<IceEngineMotionChangeListener>(entity, this);
+	// Physics plugins that don't publish motionChanges() yet still move entities through this listener
+	std::unique_ptr<IceEngineMotionChangeListener> motionChangeListener = std::make_unique<IceEngineMotionChangeListener>(entity, entityComponentSystem_.get());
 
 	physicsEngine_->setMotionChangeListener(physicsSceneHandle_, rigidBodyObjectComponent->rigidBodyObjectHandle, std::move(motionChangeListener));
 }
@@ -727,32 +1041,32 @@ void Scene::removePathfindingMovementRequestStateChangeListener(const ecs::Entit
 
 void Scene::addUserData(const ecs::Entity& entity, const ecs::RigidBodyObjectComponent& rigidBodyObjectComponent)
 {
-	physicsEngine_->setUserData(physicsSceneHandle_, rigidBodyObjectComponent.rigidBodyObjectHandle, boost::any(entity));
+	physicsEngine_->setUserId(physicsSceneHandle_, rigidBodyObjectComponent.rigidBodyObjectHandle, entity.id().id());
 }
 
 void Scene::addUserData(const ecs::Entity& entity, const ecs::GhostObjectComponent& ghostObjectComponent)
 {
-	physicsEngine_->setUserData(physicsSceneHandle_, ghostObjectComponent.ghostObjectHandle, boost::any(entity));
+	physicsEngine_->setUserId(physicsSceneHandle_, ghostObjectComponent.ghostObjectHandle, entity.id().id());
 }
 
 void Scene::addUserData(const ecs::Entity& entity, const ecs::PathfindingAgentComponent& pathfindingAgentComponent)
 {
-	pathfindingEngine_->setUserData(pathfindingSceneHandle_, pathfindingAgentComponent.crowdHandle, pathfindingAgentComponent.agentHandle, boost::any(entity));
+	pathfindingEngine_->setUserId(pathfindingSceneHandle_, pathfindingAgentComponent.crowdHandle, pathfindingAgentComponent.agentHandle, entity.id().id());
 }
 
 void Scene::removeUserData(const ecs::Entity& entity, const ecs::RigidBodyObjectComponent& rigidBodyObjectComponent)
 {
-	physicsEngine_->setUserData(physicsSceneHandle_, rigidBodyObjectComponent.rigidBodyObjectHandle, boost::any());
+	physicsEngine_->setUserId(physicsSceneHandle_, rigidBodyObjectComponent.rigidBodyObjectHandle, 0);
 }
 
 void Scene::removeUserData(const ecs::Entity& entity, const ecs::GhostObjectComponent& ghostObjectComponent)
 {
-	physicsEngine_->setUserData(physicsSceneHandle_, ghostObjectComponent.ghostObjectHandle, boost::any());
+	physicsEngine_->setUserId(physicsSceneHandle_, ghostObjectComponent.ghostObjectHandle, 0);
 }
 
 void Scene::removeUserData(const ecs::Entity& entity, const ecs::PathfindingAgentComponent& pathfindingAgentComponent)
 {
-	pathfindingEngine_->setUserData(pathfindingSceneHandle_, pathfindingAgentComponent.crowdHandle, pathfindingAgentComponent.agentHandle, boost::any());
+	pathfindingEngine_->setUserId(pathfindingSceneHandle_, pathfindingAgentComponent.crowdHandle, pathfindingAgentComponent.agentHandle, 0);
 }
 
 graphics::RenderableHandle Scene::createRenderable(
@@ -781,6 +1095,11 @@ void Scene::destroy(const graphics::RenderableHandle& renderableHandle)
 	graphicsEngine_->destroy(renderSceneHandle_, renderableHandle);
 }
 
+void Scene::setLevelOfDetailCamera(const graphics::CameraHandle& cameraHandle)
+{
+	levelOfDetailCamera_ = cameraHandle;
+}
+
 audio::SoundSourceHandle Scene::play(const audio::SoundHandle& soundHandle, const glm::vec3& position)
 {
 	return audioEngine_->play(audioSceneHandle_, soundHandle, position);
@@ -872,42 +1191,98 @@ size_t Scene::getNumEntities() const
 	return entityComponentSystem_->numEntities();
 }
 
-Raycast Scene::raycast(const ray::Ray& ray)
+void Scene::startReplicationServer(const networking::ServerHandle& serverHandle)
 {
-	Raycast result;
+	LOG_INFO(logger_, "Starting replication server for scene '%s'.", name_);
 
-	auto physicsRaycast = physicsEngine_->raycast(physicsSceneHandle_, ray);
+	replicationServer_ = std::make_unique<replication::ReplicationServer>(this, gameEngine_, serverHandle, properties_, logger_);
+}
 
-	result.setRay(physicsRaycast.ray());
-	result.setHitPointWorld(physicsRaycast.hitPointWorld());
-	result.setHitNormalWorld(physicsRaycast.hitNormalWorld());
+void Scene::addReplicationClient(const networking::RemoteConnectionHandle& remoteConnectionHandle)
+{
+	if (!replicationServer_)
+	{
+		throw InvalidOperationException(detail::format("Scene '%s' is not a replication server.", name_));
+	}
 
-	if (physicsRaycast.rigidBodyObjectHandle())
+	replicationServer_->addClient(remoteConnectionHandle);
+}
+
+void Scene::removeReplicationClient(const networking::RemoteConnectionHandle& remoteConnectionHandle)
+{
+	if (replicationServer_) replicationServer_->removeClient(remoteConnectionHandle);
+}
+
+void Scene::setReplicationInterest(const networking::RemoteConnectionHandle& remoteConnectionHandle, const glm::vec3& position, const float32 radius)
+{
+	if (!replicationServer_)
 	{
-		auto userData = physicsEngine_->getUserData(physicsSceneHandle_, physicsRaycast.rigidBodyObjectHandle());
-		if (userData.type() == typeid(ecs::Entity))
-		{
-			result.setEntity(boost::any_cast<ecs::Entity>(userData));
-		}
-		else
-		{
-			LOG_WARN(logger_, "User data was empty or was not of type Entity")
-		}
+		throw InvalidOperationException(detail::format("Scene '%s' is not a replication server.", name_));
 	}
-	else if (physicsRaycast.ghostObjectHandle())
+
+	replicationServer_->setInterest(remoteConnectionHandle, position, radius);
+}
+
+void Scene::setReplicationInterest(const networking::RemoteConnectionHandle& remoteConnectionHandle, const ecs::Entity& entity, const float32 radius)
+{
+	if (!replicationServer_)
 	{
-		auto userData = physicsEngine_->getUserData(physicsSceneHandle_, physicsRaycast.ghostObjectHandle());
-		if (userData.type() == typeid(ecs::Entity))
-		{
-			result.setEntity(boost::any_cast<ecs::Entity>(userData));
-		}
-		else
-		{
-			LOG_WARN(logger_, "User data was empty or was not of type Entity")
-		}
+		throw InvalidOperationException(detail::format("Scene '%s' is not a replication server.", name_));
 	}
 
-	return result;
+	replicationServer_->setInterest(remoteConnectionHandle, entity, radius);
+}
+
+void Scene::clearReplicationInterest(const networking::RemoteConnectionHandle& remoteConnectionHandle)
+{
+	if (replicationServer_) replicationServer_->clearInterest(remoteConnectionHandle);
+}
+
+void Scene::startReplicationClient(const networking::ClientHandle& clientHandle)
+{
+	LOG_INFO(logger_, "Starting replication client for scene '%s'.", name_);
+
+	replicationClient_ = std::make_unique<replication::ReplicationClient>(this, gameEngine_, clientHandle, properties_, logger_);
+}
+
+void Scene::stopReplication()
+{
+	replicationServer_.reset();
+	replicationClient_.reset();
+}
+
+ecs::Entity Scene::replicatedEntity(const uint32 networkId) const
+{
+	return replicationClient_ ? replicationClient_->entity(networkId) : ecs::Entity();
+}
+
+Raycast Scene::raycast(const ray::Ray& ray)
+{
+	return toRaycast(logger_, *physicsEngine_, physicsSceneHandle_, *entityComponentSystem_, physicsEngine_->raycast(physicsSceneHandle_, ray));
+}
+
+void Scene::raycastMany(const std::vector<ray::Ray>& rays, std::vector<Raycast>& results)
+{
+	PROFILER_SCOPE(profiler_, "Scene::raycastMany");
+
+	results.resize(rays.size());
+
+	detail::forEachChunk(gameEngine_->foregroundThreadPool(), rays.size(), BATCH_QUERY_CHUNK_SIZE, [this, &rays, &results](const size_t chunk, const size_t begin, const size_t end) {
+		std::array<physics::Raycast, BATCH_QUERY_CHUNK_SIZE> physicsRaycasts;
+
+		const auto count = end - begin;
+
+		physicsEngine_->raycastMany(
+			physicsSceneHandle_,
+			ArrayView<const ray::Ray>(rays.data() + begin, count),
+			ArrayView<physics::Raycast>(physicsRaycasts.data(), count)
+		);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			results[begin + i] = toRaycast(logger_, *physicsEngine_, physicsSceneHandle_, *entityComponentSystem_, physicsRaycasts[i]);
+		}
+	});
 }
 
 std::vector<ecs::Entity> Scene::query(const glm::vec3& origin, const std::vector<glm::vec3>& points)
@@ -916,7 +1291,7 @@ std::vector<ecs::Entity> Scene::query(const glm::vec3& origin, const std::vector
 
 	const auto physicsResult = physicsEngine_->query(physicsSceneHandle_, origin, points);
 
-	QueryVisitor visitor(logger_, *physicsEngine_, physicsSceneHandle_, results);
+	QueryVisitor visitor(logger_, *physicsEngine_, physicsSceneHandle_, *entityComponentSystem_, results);
 
 	for (const auto& variant : physicsResult)
 	{
@@ -932,7 +1307,7 @@ std::vector<ecs::Entity> Scene::query(const glm::vec3& origin, const float32 rad
 
 	const auto physicsResult = physicsEngine_->query(physicsSceneHandle_, origin, radius);
 
-	QueryVisitor visitor(logger_, *physicsEngine_, physicsSceneHandle_, results);
+	QueryVisitor visitor(logger_, *physicsEngine_, physicsSceneHandle_, *entityComponentSystem_, results);
 
 	for (const auto& variant : physicsResult)
 	{
@@ -942,6 +1317,256 @@ std::vector<ecs::Entity> Scene::query(const glm::vec3& origin, const float32 rad
 	return results;
 }
 
+ArrayView<ecs::Entity> Scene::queryView(const glm::vec3& origin, const float32 radius)
+{
+	queryViewBuffer_.clear();
+	++queryViewGeneration_;
+
+	const auto physicsResult = physicsEngine_->query(physicsSceneHandle_, origin, radius);
+
+	QueryVisitor visitor(logger_, *physicsEngine_, physicsSceneHandle_, *entityComponentSystem_, queryViewBuffer_);
+
+	for (const auto& variant : physicsResult)
+	{
+		boost::apply_visitor(visitor, variant);
+	}
+
+	return ArrayView<ecs::Entity>(queryViewBuffer_, &queryViewGeneration_);
+}
+
+void Scene::queryMany(const std::vector<ray::Sphere>& spheres, std::vector<ecs::Entity>& entities, std::vector<uint32>& counts)
+{
+	PROFILER_SCOPE(profiler_, "Scene::queryMany");
+
+	entities.clear();
+	counts.resize(spheres.size());
+
+	const size_t chunks = (spheres.size() + BATCH_QUERY_CHUNK_SIZE - 1) / BATCH_QUERY_CHUNK_SIZE;
+	if (batchQueryBuffers_.size() < chunks) batchQueryBuffers_.resize(chunks);
+
+	detail::forEachChunk(gameEngine_->foregroundThreadPool(), spheres.size(), BATCH_QUERY_CHUNK_SIZE, [this, &spheres, &counts](const size_t chunk, const size_t begin, const size_t end) {
+		auto& buffer = batchQueryBuffers_[chunk];
+		buffer.physicsResults.clear();
+		buffer.entities.clear();
+
+		const auto count = end - begin;
+
+		physicsEngine_->queryMany(
+			physicsSceneHandle_,
+			ArrayView<const ray::Sphere>(spheres.data() + begin, count),
+			buffer.physicsResults,
+			ArrayView<uint32>(counts.data() + begin, count)
+		);
+
+		QueryVisitor visitor(logger_, *physicsEngine_, physicsSceneHandle_, *entityComponentSystem_, buffer.entities);
+
+		// Objects without an entity are dropped, so recount what each sphere actually found
+		size_t physicsResultIndex = 0;
+		for (size_t i = begin; i < end; ++i)
+		{
+			const auto entityCount = buffer.entities.size();
+
+			for (uint32 j = 0; j < counts[i]; ++j)
+			{
+				boost::apply_visitor(visitor, buffer.physicsResults[physicsResultIndex++]);
+			}
+
+			counts[i] = static_cast<uint32>(buffer.entities.size() - entityCount);
+		}
+	});
+
+	size_t size = 0;
+	for (size_t chunk = 0; chunk < chunks; ++chunk)
+	{
+		size += batchQueryBuffers_[chunk].entities.size();
+	}
+
+	entities.reserve(size);
+
+	for (size_t chunk = 0; chunk < chunks; ++chunk)
+	{
+		const auto& chunkEntities = batchQueryBuffers_[chunk].entities;
+		entities.insert(entities.end(), chunkEntities.begin(), chunkEntities.end());
+	}
+}
+
+SpatialIndex& Scene::spatialIndex()
+{
+	return spatialIndex_;
+}
+
+IThreadPool* Scene::backgroundThreadPool() const
+{
+	return threadPool_;
+}
+
+IOpenGlLoader* Scene::openGlLoader() const
+{
+	return openGlLoader_;
+}
+
+void Scene::entitiesInRadius(const glm::vec3& center, const float32 radius, std::vector<ecs::Entity>& entities)
+{
+	spatialIndex_.queryRadius(center, radius, spatialIndexResults_);
+	toEntities(spatialIndexResults_, entities);
+}
+
+void Scene::entitiesInBox(const glm::vec3& minimum, const glm::vec3& maximum, std::vector<ecs::Entity>& entities)
+{
+	spatialIndex_.queryBox(minimum, maximum, spatialIndexResults_);
+	toEntities(spatialIndexResults_, entities);
+}
+
+void Scene::entitiesInFrustum(const glm::mat4& viewProjection, std::vector<ecs::Entity>& entities)
+{
+	spatialIndex_.queryFrustum(viewProjection, spatialIndexResults_);
+	toEntities(spatialIndexResults_, entities);
+}
+
+void Scene::nearestEntities(const glm::vec3& position, const uint32 count, std::vector<ecs::Entity>& entities)
+{
+	spatialIndex_.queryNearest(position, count, spatialIndexResults_);
+	toEntities(spatialIndexResults_, entities);
+}
+
+void Scene::rebuildSpatialIndex()
+{
+	spatialIndex_.clear();
+
+	for (auto entity : entityComponentSystem_->entitiesWithComponents<ecs::PositionComponent>())
+	{
+		updateSpatialIndex(entity, entity.component<ecs::PositionComponent>()->position);
+	}
+}
+
+void Scene::updateSpatialIndex(const ecs::Entity& entity, const glm::vec3& position)
+{
+	// One entity a script or the physics engine sent to infinity shouldn't stop the whole scene from ticking, so leave
+	// it out of the index until it has a real position again
+	if (!std::isfinite(position.x) || !std::isfinite(position.y) || !std::isfinite(position.z))
+	{
+		LOG_WARN(logger_, "Entity %s has a position that is not finite, leaving it out of the spatial index.", entity);
+		spatialIndex_.remove(entity.id().id());
+		return;
+	}
+
+	spatialIndex_.set(entity.id().id(), position);
+}
+
+void Scene::toEntities(const std::vector<uint64>& ids, std::vector<ecs::Entity>& entities)
+{
+	entities.clear();
+	entities.reserve(ids.size());
+
+	for (const auto id : ids)
+	{
+		entities.push_back(entityComponentSystem_->get(entityx::Entity::Id(id)));
+	}
+}
+
+ArrayView<glm::vec3> Scene::positions(const ArrayView<ecs::Entity>& entities)
+{
+	entities.requireCurrent();
+
+	positionViewBuffer_.resize(entities.size());
+	++positionViewGeneration_;
+
+	for (size_t i = 0; i < entities.size(); ++i)
+	{
+		const auto& entity = entities[i];
+
+		positionViewBuffer_[i] = entity.hasComponent<ecs::PositionComponent>() ? entity.component<ecs::PositionComponent>()->position : glm::vec3();
+	}
+
+	return ArrayView<glm::vec3>(positionViewBuffer_, &positionViewGeneration_);
+}
+
+ArrayView<glm::quat> Scene::orientations(const ArrayView<ecs::Entity>& entities)
+{
+	entities.requireCurrent();
+
+	orientationViewBuffer_.resize(entities.size());
+	++orientationViewGeneration_;
+
+	for (size_t i = 0; i < entities.size(); ++i)
+	{
+		const auto& entity = entities[i];
+
+		orientationViewBuffer_[i] = entity.hasComponent<ecs::OrientationComponent>() ? entity.component<ecs::OrientationComponent>()->orientation : glm::quat();
+	}
+
+	return ArrayView<glm::quat>(orientationViewBuffer_, &orientationViewGeneration_);
+}
+
+void Scene::setPositions(const ArrayView<ecs::Entity>& entities, const ArrayView<glm::vec3>& positions)
+{
+	entities.requireCurrent();
+	positions.requireCurrent();
+
+	if (entities.size() != positions.size())
+	{
+		throw InvalidArgumentException(detail::format("Number of entities (%s) does not match number of positions (%s).", entities.size(), positions.size()));
+	}
+
+	for (size_t i = 0; i < entities.size(); ++i)
+	{
+		auto entity = entities[i];
+
+		if (!entity.hasComponent<ecs::PositionComponent>())
+		{
+			throw InvalidArgumentException(detail::format("Entity %s does not have a PositionComponent.", entity));
+		}
+
+		entity.component<ecs::PositionComponent>()->position = positions[i];
+
+		if (entity.hasComponent<ecs::DirtyComponent>())
+		{
+			entity.component<ecs::DirtyComponent>()->dirty |= ecs::DirtyFlags::DIRTY_SOURCE_SCRIPT | ecs::DirtyFlags::DIRTY_POSITION;
+		}
+		else
+		{
+			entity.assign<ecs::DirtyComponent>(ecs::DirtyFlags::DIRTY_SOURCE_SCRIPT | ecs::DirtyFlags::DIRTY_POSITION);
+		}
+	}
+}
+
+void Scene::setPositions(const ArrayView<ecs::Entity>& entities, const std::vector<glm::vec3>& positions)
+{
+	setPositions(entities, ArrayView<glm::vec3>(const_cast<glm::vec3*>(positions.data()), positions.size()));
+}
+
+void Scene::setOrientations(const ArrayView<ecs::Entity>& entities, const ArrayView<glm::quat>& orientations)
+{
+	entities.requireCurrent();
+	orientations.requireCurrent();
+
+	if (entities.size() != orientations.size())
+	{
+		throw InvalidArgumentException(detail::format("Number of entities (%s) does not match number of orientations (%s).", entities.size(), orientations.size()));
+	}
+
+	for (size_t i = 0; i < entities.size(); ++i)
+	{
+		auto entity = entities[i];
+
+		if (!entity.hasComponent<ecs::OrientationComponent>())
+		{
+			throw InvalidArgumentException(detail::format("Entity %s does not have an OrientationComponent.", entity));
+		}
+
+		entity.component<ecs::OrientationComponent>()->orientation = orientations[i];
+
+		if (entity.hasComponent<ecs::DirtyComponent>())
+		{
+			entity.component<ecs::DirtyComponent>()->dirty |= ecs::DirtyFlags::DIRTY_SOURCE_SCRIPT | ecs::DirtyFlags::DIRTY_ORIENTATION;
+		}
+		else
+		{
+			entity.assign<ecs::DirtyComponent>(ecs::DirtyFlags::DIRTY_SOURCE_SCRIPT | ecs::DirtyFlags::DIRTY_ORIENTATION);
+		}
+	}
+}
+
 std::unordered_map<scripting::ScriptObjectHandle, std::string> Scene::getScriptObjectNameMap() const
 {
 	std::unordered_map<scripting::ScriptObjectHandle, std::string> map;
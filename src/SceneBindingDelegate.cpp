@@ -39,6 +39,11 @@ namespace raybinding
 void InitConstructor(const glm::vec3& from, const glm::vec3& to, void* memory) { new(memory) ray::Ray(from, to); }
 }
 
+namespace spherebinding
+{
+void InitConstructor(const glm::vec3& origin, const float32 radius, void* memory) { new(memory) ray::Sphere(origin, radius); }
+}
+
 uint64 sceneGetNumEntitiesProxy(const Scene* scene)
 {
     return static_cast<uint64>(scene->getNumEntities());
@@ -105,6 +110,16 @@ void SceneBindingDelegate::bind()
 		"Entity entity() const",
 		asMETHODPR(Raycast, entity, () const, ecs::Entity)
 	);
+
+	scriptingEngine_->registerObjectType("Sphere", sizeof(ray::Sphere), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLFLOATS | asGetTypeTraits<ray::Sphere>());
+	scriptingEngine_->registerObjectBehaviour("Sphere", asBEHAVE_CONSTRUCT, "void f(const vec3& in, const float)", asFUNCTION(spherebinding::InitConstructor), asCALL_CDECL_OBJLAST);
+	scriptingEngine_->registerObjectProperty("Sphere", "vec3 origin", asOFFSET(ray::Sphere, origin));
+	scriptingEngine_->registerObjectProperty("Sphere", "float radius", asOFFSET(ray::Sphere, radius));
+
+	registerVectorBindings<ray::Ray>(scriptingEngine_, "vectorRay", "Ray");
+	registerVectorBindings<Raycast>(scriptingEngine_, "vectorRaycast", "Raycast");
+	registerVectorBindings<ray::Sphere>(scriptingEngine_, "vectorSphere", "Sphere");
+
 	//scriptingEngine_->registerObjectProperty("Raycast", "vec3 from", asOFFSET(ray::Ray, from));
 	//scriptingEngine_->registerObjectProperty("Raycast", "vec3 to", asOFFSET(ray::Ray, to));
 
@@ -127,6 +142,10 @@ void SceneBindingDelegate::bind()
 
 	scriptingEngine_->registerFunctionDefinition("void EntitiesWithComponentsCallBack(Entity)");
 
+	registerArrayViewBindings<ecs::Entity>(scriptingEngine_, "arrayViewEntity", "Entity");
+	registerArrayViewBindings<glm::vec3>(scriptingEngine_, "arrayViewVec3", "vec3");
+	registerArrayViewBindings<glm::quat>(scriptingEngine_, "arrayViewQuat", "quat");
+
 	// Scene
 //	scriptingEngine_->registerObjectType("Scene", 0, asOBJ_REF | asOBJ_NOCOUNT);
 	scriptingEngine_->registerClassMethod("Scene", "const string& name() const", asMETHOD(Scene, name));
@@ -193,6 +212,11 @@ void SceneBindingDelegate::bind()
 		"RenderableHandle createRenderable(const MeshHandle& in, const TextureHandle& in, const vec3& in, const quat& in, const vec3& in = vec3(1.0f))",
 		asMETHODPR(Scene, createRenderable, (const graphics::MeshHandle&, const graphics::TextureHandle&, const glm::vec3&, const glm::quat&, const glm::vec3&), graphics::RenderableHandle)
 	);
+	scriptingEngine_->registerClassMethod(
+		"Scene",
+		"void setLevelOfDetailCamera(const CameraHandle& in)",
+		asMETHODPR(Scene, setLevelOfDetailCamera, (const graphics::CameraHandle&), void)
+	);
 	scriptingEngine_->registerClassMethod(
 		"Scene",
 		"SoundSourceHandle play(const SoundHandle& in, const vec3& in)",
@@ -213,6 +237,34 @@ void SceneBindingDelegate::bind()
 		"void entitiesWithComponentsScriptObjectComponent(EntitiesWithComponentsCallBack@)",
 		asMETHODPR(Scene, entitiesWithComponents<ecs::ScriptObjectComponent>, (void*), void)
 	);
+	scriptingEngine_->registerClassMethod(
+		"Scene",
+		"arrayViewEntity entitiesWithComponentsViewScriptObjectComponent()",
+		asMETHODPR(Scene, entitiesWithComponentsView<ecs::ScriptObjectComponent>, (), ArrayView<ecs::Entity>)
+	);
+	scriptingEngine_->registerClassMethod(
+		"Scene",
+		"arrayViewEntity entitiesWithComponentsViewPositionComponent()",
+		asMETHODPR(Scene, entitiesWithComponentsView<ecs::PositionComponent>, (), ArrayView<ecs::Entity>)
+	);
+	scriptingEngine_->registerClassMethod(
+		"Scene",
+		"arrayViewEntity entitiesWithComponentsViewPathfindingAgentComponent()",
+		asMETHODPR(Scene, entitiesWithComponentsView<ecs::PathfindingAgentComponent>, (), ArrayView<ecs::Entity>)
+	);
+	scriptingEngine_->registerClassMethod("Scene", "arrayViewVec3 positions(const arrayViewEntity& in)", asMETHOD(Scene, positions));
+	scriptingEngine_->registerClassMethod("Scene", "arrayViewQuat orientations(const arrayViewEntity& in)", asMETHOD(Scene, orientations));
+	scriptingEngine_->registerClassMethod(
+		"Scene",
+		"void setPositions(const arrayViewEntity& in, const arrayViewVec3& in)",
+		asMETHODPR(Scene, setPositions, (const ArrayView<ecs::Entity>&, const ArrayView<glm::vec3>&), void)
+	);
+	scriptingEngine_->registerClassMethod(
+		"Scene",
+		"void setPositions(const arrayViewEntity& in, const vectorVec3& in)",
+		asMETHODPR(Scene, setPositions, (const ArrayView<ecs::Entity>&, const std::vector<glm::vec3>&), void)
+	);
+	scriptingEngine_->registerClassMethod("Scene", "void setOrientations(const arrayViewEntity& in, const arrayViewQuat& in)", asMETHOD(Scene, setOrientations));
 	scriptingEngine_->registerClassMethod("Scene", "void addPreSerializeCallback(PreSerializeCallback@)", asMETHODPR(Scene, addPreSerializeCallback, (void*), void));
 	scriptingEngine_->registerClassMethod("Scene", "void addPostSerializeCallback(PostSerializeCallback@)", asMETHODPR(Scene, addPostSerializeCallback, (void*), void));
 	scriptingEngine_->registerClassMethod("Scene", "void addPreDeserializeCallback(PreDeserializeCallback@)", asMETHODPR(Scene, addPreDeserializeCallback, (void*), void));
@@ -224,8 +276,32 @@ void SceneBindingDelegate::bind()
 	scriptingEngine_->registerClassMethod("Scene", "void destroyAsync(Entity& in)", asMETHOD(Scene, destroyAsync));
 	scriptingEngine_->registerObjectMethod("Scene", "uint64 getNumEntities() const", asFUNCTION(sceneGetNumEntitiesProxy), asCALL_CDECL_OBJFIRST);
 	scriptingEngine_->registerClassMethod("Scene", "Raycast raycast(const Ray& in)", asMETHOD(Scene, raycast));
+	scriptingEngine_->registerClassMethod("Scene", "void raycastMany(const vectorRay& in, vectorRaycast& inout)", asMETHOD(Scene, raycastMany));
 	scriptingEngine_->registerClassMethod("Scene", "vectorEntity query(const vec3& in, const vectorVec3& in)", asMETHODPR(Scene, query, (const glm::vec3&, const std::vector<glm::vec3>&), std::vector<ecs::Entity>));
 	scriptingEngine_->registerClassMethod("Scene", "vectorEntity query(const vec3& in, const float)", asMETHODPR(Scene, query, (const glm::vec3&, const float32), std::vector<ecs::Entity>));
+	scriptingEngine_->registerClassMethod("Scene", "arrayViewEntity queryView(const vec3& in, const float)", asMETHOD(Scene, queryView));
+	scriptingEngine_->registerClassMethod("Scene", "void queryMany(const vectorSphere& in, vectorEntity& inout, vectorUInt32& inout)", asMETHOD(Scene, queryMany));
+	scriptingEngine_->registerClassMethod("Scene", "void entitiesInRadius(const vec3& in, const float, vectorEntity& inout)", asMETHOD(Scene, entitiesInRadius));
+	scriptingEngine_->registerClassMethod("Scene", "void entitiesInBox(const vec3& in, const vec3& in, vectorEntity& inout)", asMETHOD(Scene, entitiesInBox));
+	scriptingEngine_->registerClassMethod("Scene", "void entitiesInFrustum(const mat4& in, vectorEntity& inout)", asMETHOD(Scene, entitiesInFrustum));
+	scriptingEngine_->registerClassMethod("Scene", "void nearestEntities(const vec3& in, const uint32, vectorEntity& inout)", asMETHOD(Scene, nearestEntities));
+	scriptingEngine_->registerClassMethod("Scene", "void startReplicationServer(const ServerHandle& in)", asMETHOD(Scene, startReplicationServer));
+	scriptingEngine_->registerClassMethod("Scene", "void addReplicationClient(const RemoteConnectionHandle& in)", asMETHOD(Scene, addReplicationClient));
+	scriptingEngine_->registerClassMethod("Scene", "void removeReplicationClient(const RemoteConnectionHandle& in)", asMETHOD(Scene, removeReplicationClient));
+	scriptingEngine_->registerClassMethod(
+		"Scene",
+		"void setReplicationInterest(const RemoteConnectionHandle& in, const vec3& in, const float)",
+		asMETHODPR(Scene, setReplicationInterest, (const networking::RemoteConnectionHandle&, const glm::vec3&, const float32), void)
+	);
+	scriptingEngine_->registerClassMethod(
+		"Scene",
+		"void setReplicationInterest(const RemoteConnectionHandle& in, const Entity& in, const float)",
+		asMETHODPR(Scene, setReplicationInterest, (const networking::RemoteConnectionHandle&, const ecs::Entity&, const float32), void)
+	);
+	scriptingEngine_->registerClassMethod("Scene", "void clearReplicationInterest(const RemoteConnectionHandle& in)", asMETHOD(Scene, clearReplicationInterest));
+	scriptingEngine_->registerClassMethod("Scene", "void startReplicationClient(const ClientHandle& in)", asMETHOD(Scene, startReplicationClient));
+	scriptingEngine_->registerClassMethod("Scene", "void stopReplication()", asMETHOD(Scene, stopReplication));
+	scriptingEngine_->registerClassMethod("Scene", "Entity replicatedEntity(const uint32) const", asMETHOD(Scene, replicatedEntity));
 }
 
 };
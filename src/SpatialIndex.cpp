@@ -0,0 +1,468 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+
+#include "SpatialIndex.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+
+namespace
+{
+float32 distanceToNode2(const glm::vec3& center, const float32 halfSize, const glm::vec3& position)
+{
+	float32 distance2 = 0.0f;
+
+	for (int i = 0; i < 3; ++i)
+	{
+		const float32 d = std::max(0.0f, std::abs(position[i] - center[i]) - halfSize);
+		distance2 += d * d;
+	}
+
+	return distance2;
+}
+
+float32 distance2(const glm::vec3& a, const glm::vec3& b)
+{
+	const glm::vec3 d = a - b;
+	return d.x * d.x + d.y * d.y + d.z * d.z;
+}
+
+std::array<glm::vec4, 6> frustumPlanes(const glm::mat4& viewProjection)
+{
+	std::array<glm::vec4, 4> rows;
+	for (int i = 0; i < 4; ++i)
+	{
+		rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+	}
+
+	// Points inside the frustum are on the positive side of every plane
+	return {{
+		rows[3] + rows[0],
+		rows[3] - rows[0],
+		rows[3] + rows[1],
+		rows[3] - rows[1],
+		rows[3] + rows[2],
+		rows[3] - rows[2]
+	}};
+}
+
+float32 planeDistance(const glm::vec4& plane, const glm::vec3& position)
+{
+	return plane.x * position.x + plane.y * position.y + plane.z * position.z + plane.w;
+}
+}
+
+constexpr uint32 SpatialIndex::INVALID_NODE;
+
+SpatialIndex::SpatialIndex(const float32 minimumNodeSize, const uint32 maximumNodeItems)
+	:
+	minimumNodeSize_(minimumNodeSize),
+	maximumNodeItems_(maximumNodeItems)
+{
+	if (!(minimumNodeSize_ > 0.0f))
+	{
+		throw InvalidArgumentException(detail::format("Minimum node size (%s) must be greater than 0.", minimumNodeSize_));
+	}
+
+	if (maximumNodeItems_ == 0)
+	{
+		throw InvalidArgumentException("Maximum node items must be greater than 0.");
+	}
+}
+
+void SpatialIndex::set(const uint64 id, const glm::vec3& position)
+{
+	if (!std::isfinite(position.x) || !std::isfinite(position.y) || !std::isfinite(position.z))
+	{
+		throw InvalidArgumentException(detail::format("Position for id %s is not finite.", id));
+	}
+
+	auto it = leaves_.find(id);
+	if (it != leaves_.end())
+	{
+		auto& leaf = nodes_[it->second];
+
+		// Most moves are small, so check whether it is still in the same leaf before doing any real work
+		if (containsPoint(leaf, position))
+		{
+			for (auto& item : leaf.items)
+			{
+				if (item.id == id)
+				{
+					item.position = position;
+					return;
+				}
+			}
+		}
+
+		remove(id);
+	}
+
+	insert(id, position);
+}
+
+void SpatialIndex::remove(const uint64 id)
+{
+	auto it = leaves_.find(id);
+	if (it == leaves_.end()) return;
+
+	const auto leaf = it->second;
+	leaves_.erase(it);
+
+	auto& items = nodes_[leaf].items;
+	for (auto item = items.begin(); item != items.end(); ++item)
+	{
+		if (item->id == id)
+		{
+			*item = items.back();
+			items.pop_back();
+			break;
+		}
+	}
+
+	prune(leaf);
+}
+
+bool SpatialIndex::contains(const uint64 id) const
+{
+	return leaves_.find(id) != leaves_.end();
+}
+
+void SpatialIndex::clear()
+{
+	nodes_.clear();
+	freeNodes_.clear();
+	leaves_.clear();
+	root_ = INVALID_NODE;
+}
+
+size_t SpatialIndex::size() const
+{
+	return leaves_.size();
+}
+
+void SpatialIndex::queryRadius(const glm::vec3& center, const float32 radius, std::vector<uint64>& results) const
+{
+	const float32 radius2 = radius * radius;
+
+	query(
+		[&center, radius2](const glm::vec3& nodeCenter, const float32 halfSize) { return distanceToNode2(nodeCenter, halfSize, center) <= radius2; },
+		[&center, radius2](const glm::vec3& position) { return distance2(position, center) <= radius2; },
+		results
+	);
+}
+
+void SpatialIndex::queryBox(const glm::vec3& minimum, const glm::vec3& maximum, std::vector<uint64>& results) const
+{
+	query(
+		[&minimum, &maximum](const glm::vec3& nodeCenter, const float32 halfSize) {
+			for (int i = 0; i < 3; ++i)
+			{
+				if (nodeCenter[i] + halfSize < minimum[i] || nodeCenter[i] - halfSize > maximum[i]) return false;
+			}
+
+			return true;
+		},
+		[&minimum, &maximum](const glm::vec3& position) {
+			for (int i = 0; i < 3; ++i)
+			{
+				if (position[i] < minimum[i] || position[i] > maximum[i]) return false;
+			}
+
+			return true;
+		},
+		results
+	);
+}
+
+void SpatialIndex::queryFrustum(const glm::mat4& viewProjection, std::vector<uint64>& results) const
+{
+	const auto planes = frustumPlanes(viewProjection);
+
+	query(
+		[&planes](const glm::vec3& nodeCenter, const float32 halfSize) {
+			for (const auto& plane : planes)
+			{
+				// The corner furthest along the plane normal; if that is outside, the whole node is
+				const glm::vec3 corner(
+					plane.x >= 0.0f ? nodeCenter.x + halfSize : nodeCenter.x - halfSize,
+					plane.y >= 0.0f ? nodeCenter.y + halfSize : nodeCenter.y - halfSize,
+					plane.z >= 0.0f ? nodeCenter.z + halfSize : nodeCenter.z - halfSize
+				);
+
+				if (planeDistance(plane, corner) < 0.0f) return false;
+			}
+
+			return true;
+		},
+		[&planes](const glm::vec3& position) {
+			for (const auto& plane : planes)
+			{
+				if (planeDistance(plane, position) < 0.0f) return false;
+			}
+
+			return true;
+		},
+		results
+	);
+}
+
+void SpatialIndex::queryNearest(const glm::vec3& position, const uint32 count, std::vector<uint64>& results) const
+{
+	results.clear();
+
+	if (root_ == INVALID_NODE || count == 0) return;
+
+	typedef std::pair<float32, uint32> NodeDistance;
+	typedef std::pair<float32, uint64> ItemDistance;
+
+	// Visit nodes nearest first, keeping the best count items found so far with the furthest on top
+	std::priority_queue<NodeDistance, std::vector<NodeDistance>, std::greater<NodeDistance>> nodes;
+	std::priority_queue<ItemDistance> best;
+
+	nodes.emplace(distanceToNode2(nodes_[root_].center, nodes_[root_].halfSize, position), root_);
+
+	while (!nodes.empty())
+	{
+		const auto nodeDistance = nodes.top();
+		nodes.pop();
+
+		if (best.size() == count && nodeDistance.first > best.top().first) break;
+
+		const auto& node = nodes_[nodeDistance.second];
+
+		for (const auto& item : node.items)
+		{
+			const auto itemDistance = distance2(item.position, position);
+
+			if (best.size() < count)
+			{
+				best.emplace(itemDistance, item.id);
+			}
+			else if (itemDistance < best.top().first)
+			{
+				best.pop();
+				best.emplace(itemDistance, item.id);
+			}
+		}
+
+		if (node.childCount == 0) continue;
+
+		for (const auto child : node.children)
+		{
+			if (child == INVALID_NODE) continue;
+
+			nodes.emplace(distanceToNode2(nodes_[child].center, nodes_[child].halfSize, position), child);
+		}
+	}
+
+	results.resize(best.size());
+	for (auto i = results.size(); i > 0; --i)
+	{
+		results[i - 1] = best.top().second;
+		best.pop();
+	}
+}
+
+uint32 SpatialIndex::createNode(const glm::vec3& center, const float32 halfSize, const uint32 parent)
+{
+	uint32 index;
+
+	if (!freeNodes_.empty())
+	{
+		index = freeNodes_.back();
+		freeNodes_.pop_back();
+	}
+	else
+	{
+		index = static_cast<uint32>(nodes_.size());
+		nodes_.emplace_back();
+	}
+
+	auto& node = nodes_[index];
+	node.center = center;
+	node.halfSize = halfSize;
+	node.parent = parent;
+	node.childCount = 0;
+	node.children.fill(INVALID_NODE);
+	node.items.clear();
+
+	return index;
+}
+
+void SpatialIndex::destroyNode(const uint32 node)
+{
+	nodes_[node].items.clear();
+	freeNodes_.push_back(node);
+}
+
+bool SpatialIndex::containsPoint(const Node& node, const glm::vec3& position) const
+{
+	return std::abs(position.x - node.center.x) <= node.halfSize
+		&& std::abs(position.y - node.center.y) <= node.halfSize
+		&& std::abs(position.z - node.center.z) <= node.halfSize;
+}
+
+uint32 SpatialIndex::childIndex(const Node& node, const glm::vec3& position) const
+{
+	return (position.x >= node.center.x ? 1 : 0) | (position.y >= node.center.y ? 2 : 0) | (position.z >= node.center.z ? 4 : 0);
+}
+
+glm::vec3 SpatialIndex::childCenter(const Node& node, const uint32 index) const
+{
+	const float32 offset = node.halfSize * 0.5f;
+
+	return glm::vec3(
+		node.center.x + (index & 1 ? offset : -offset),
+		node.center.y + (index & 2 ? offset : -offset),
+		node.center.z + (index & 4 ? offset : -offset)
+	);
+}
+
+void SpatialIndex::growToFit(const glm::vec3& position)
+{
+	while (!containsPoint(nodes_[root_], position))
+	{
+		const auto oldRoot = root_;
+		const auto center = nodes_[oldRoot].center;
+		const auto halfSize = nodes_[oldRoot].halfSize;
+
+		// Double the root towards the position, with the old root as one of its children
+		const glm::vec3 newCenter(
+			center.x + (position.x >= center.x ? halfSize : -halfSize),
+			center.y + (position.y >= center.y ? halfSize : -halfSize),
+			center.z + (position.z >= center.z ? halfSize : -halfSize)
+		);
+
+		root_ = createNode(newCenter, halfSize * 2.0f, INVALID_NODE);
+
+		auto& newRoot = nodes_[root_];
+		newRoot.children[childIndex(newRoot, center)] = oldRoot;
+		newRoot.childCount = 1;
+
+		nodes_[oldRoot].parent = root_;
+	}
+}
+
+void SpatialIndex::insert(const uint64 id, const glm::vec3& position)
+{
+	if (root_ == INVALID_NODE)
+	{
+		root_ = createNode(position, minimumNodeSize_, INVALID_NODE);
+	}
+
+	growToFit(position);
+
+	auto node = root_;
+	while (nodes_[node].childCount > 0)
+	{
+		const auto index = childIndex(nodes_[node], position);
+		auto child = nodes_[node].children[index];
+
+		if (child == INVALID_NODE)
+		{
+			child = createNode(childCenter(nodes_[node], index), nodes_[node].halfSize * 0.5f, node);
+			nodes_[node].children[index] = child;
+			++nodes_[node].childCount;
+		}
+
+		node = child;
+	}
+
+	nodes_[node].items.push_back({id, position});
+	leaves_[id] = node;
+
+	if (nodes_[node].items.size() > maximumNodeItems_ && nodes_[node].halfSize >= minimumNodeSize_)
+	{
+		split(node);
+	}
+}
+
+void SpatialIndex::split(const uint32 node)
+{
+	const auto items = std::move(nodes_[node].items);
+	nodes_[node].items.clear();
+
+	for (const auto& item : items)
+	{
+		const auto index = childIndex(nodes_[node], item.position);
+		auto child = nodes_[node].children[index];
+
+		if (child == INVALID_NODE)
+		{
+			child = createNode(childCenter(nodes_[node], index), nodes_[node].halfSize * 0.5f, node);
+			nodes_[node].children[index] = child;
+			++nodes_[node].childCount;
+		}
+
+		nodes_[child].items.push_back(item);
+		leaves_[item.id] = child;
+	}
+
+	for (size_t i = 0; i < 8; ++i)
+	{
+		const auto child = nodes_[node].children[i];
+
+		if (child != INVALID_NODE && nodes_[child].items.size() > maximumNodeItems_ && nodes_[child].halfSize >= minimumNodeSize_)
+		{
+			split(child);
+		}
+	}
+}
+
+void SpatialIndex::prune(uint32 node)
+{
+	while (node != root_ && nodes_[node].items.empty() && nodes_[node].childCount == 0)
+	{
+		const auto parent = nodes_[node].parent;
+
+		auto& children = nodes_[parent].children;
+		*std::find(children.begin(), children.end(), node) = INVALID_NODE;
+		--nodes_[parent].childCount;
+
+		destroyNode(node);
+		node = parent;
+	}
+
+	if (leaves_.empty()) clear();
+}
+
+template<typename NodeTest, typename ItemTest>
+void SpatialIndex::query(const NodeTest& nodeTest, const ItemTest& itemTest, std::vector<uint64>& results) const
+{
+	results.clear();
+
+	if (root_ == INVALID_NODE) return;
+
+	std::vector<uint32> stack;
+	stack.push_back(root_);
+
+	while (!stack.empty())
+	{
+		const auto& node = nodes_[stack.back()];
+		stack.pop_back();
+
+		if (!nodeTest(node.center, node.halfSize)) continue;
+
+		for (const auto& item : node.items)
+		{
+			if (itemTest(item.position)) results.push_back(item.id);
+		}
+
+		if (node.childCount == 0) continue;
+
+		for (const auto child : node.children)
+		{
+			if (child != INVALID_NODE) stack.push_back(child);
+		}
+	}
+}
+
+}
@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <chrono>
+
+#include "StreamingTerrain.hpp"
+
+#include "Scene.hpp"
+
+#include "ecs/PositionComponent.hpp"
+#include "ecs/OrientationComponent.hpp"
+#include "ecs/GraphicsComponent.hpp"
+#include "ecs/RigidBodyObjectComponent.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+
+StreamingTerrain::StreamingTerrain(
+	utilities::Properties* properties,
+	logger::ILogger* logger,
+	Scene* scene,
+	HeightMap heightMap,
+	graphics::IGraphicsEngine* graphicsEngine,
+	pathfinding::IPathfindingEngine* pathfindingEngine,
+	physics::IPhysicsEngine* physicsEngine,
+	IThreadPool* threadPool,
+	IOpenGlLoader* openGlLoader
+)
+	:
+	graphicsEngine_(graphicsEngine),
+	physicsEngine_(physicsEngine),
+	pathfindingEngine_(pathfindingEngine),
+	properties_(properties),
+	logger_(logger),
+	threadPool_(threadPool),
+	openGlLoader_(openGlLoader),
+	scene_(scene),
+	heightMap_(std::move(heightMap))
+{
+	// Every tile is generated from the height map, so a bad one would fail every tile over and over
+	const graphics::IImage* image = heightMap_.image();
+	if (!image || image->width() == 0 || image->height() == 0)
+	{
+		throw InvalidArgumentException("Height map for streaming terrain is empty.");
+	}
+
+	if (image->format() != graphics::IImage::Format::FORMAT_RGBA || image->data().size() < static_cast<size_t>(image->width()) * image->height() * 4)
+	{
+		throw InvalidArgumentException(detail::format("Height map for streaming terrain (%sx%s, format %s) is not a formatted RGBA height map.", image->width(), image->height(), image->format()));
+	}
+
+	const int32 tileSamples = properties_->getIntValue("terrain.tilesamples", 64);
+	if (tileSamples <= 0 || (tileSamples & (tileSamples - 1)) != 0)
+	{
+		throw InvalidArgumentException(detail::format("Terrain tile samples (%s) must be a power of 2.", tileSamples));
+	}
+
+	tileSamples_ = static_cast<uint32>(tileSamples);
+	tileInstallsPerTick_ = static_cast<uint32>(std::max(1, properties_->getIntValue("terrain.tileinstallspertick", 2)));
+
+	// Levels of detail past the one where a tile is a single quad would all look the same
+	uint32 maximumLodCount = 1;
+	while ((1u << maximumLodCount) <= tileSamples_) ++maximumLodCount;
+
+	const uint32 lodCount = std::min(static_cast<uint32>(std::max(1, properties_->getIntValue("terrain.lodcount", 4))), maximumLodCount);
+	const float32 lodDistance = properties_->getFloatValue("terrain.loddistance", 64.0f);
+
+	std::vector<float32> lodDistances;
+	for (uint32 i = 1; i < lodCount; ++i)
+	{
+		lodDistances.push_back(lodDistance * static_cast<float32>(1u << (i - 1)));
+	}
+
+	// Collision doesn't depend on the render level of detail, by default it just covers the full detail tiles
+	const float32 collisionRadius = properties_->getFloatValue("terrain.collisionradius", lodDistance);
+
+	const auto memoryBudget = static_cast<uint64>(std::max(0.0f, properties_->getFloatValue("terrain.memorybudget", 256.0f)) * 1024.0f * 1024.0f);
+
+	streamer_ = std::make_unique<TerrainTileStreamer>(
+		static_cast<float32>(tileSamples_),
+		properties_->getFloatValue("terrain.loadradius", 384.0f),
+		std::move(lodDistances),
+		memoryBudget,
+		collisionRadius
+	);
+}
+
+StreamingTerrain::~StreamingTerrain()
+{
+	// Generation work reads the height map, so it has to finish before we go
+	for (auto& pendingTile : pendingTiles_)
+	{
+		if (pendingTile->future.valid()) pendingTile->future.wait();
+
+		// Uploads still queued on the OpenGL loader see they are abandoned and do nothing, ones that already ran leave
+		// us a mesh to clean up
+		if (pendingTile->meshUpload)
+		{
+			std::lock_guard<std::mutex> lock(pendingTile->meshUpload->mutex);
+
+			pendingTile->meshUpload->abandoned = true;
+			if (pendingTile->meshUpload->meshHandle) graphicsEngine_->destroy(pendingTile->meshUpload->meshHandle);
+		}
+	}
+
+	// The scene has already torn down its render, physics and pathfinding scenes along with the tile entities, all that
+	// is left is what the tiles created outside of the scene
+	for (const auto& kv : residentTiles_)
+	{
+		destroyResources(kv.second);
+	}
+}
+
+void StreamingTerrain::tick(const float32 delta)
+{
+	viewers_.erase(std::remove_if(viewers_.begin(), viewers_.end(), [](const ecs::Entity& entity) { return !entity.valid(); }), viewers_.end());
+
+	viewerPositions_.clear();
+	for (const auto& viewer : viewers_)
+	{
+		if (viewer.hasComponent<ecs::PositionComponent>()) viewerPositions_.push_back(viewer.component<ecs::PositionComponent>()->position);
+	}
+
+	streamer_->update(viewerPositions_, requests_, unloads_);
+
+	for (const auto& coordinate : unloads_)
+	{
+		uninstall(coordinate);
+	}
+
+	for (const auto& request : requests_)
+	{
+		generate(request);
+	}
+
+	installGeneratedTiles();
+}
+
+void StreamingTerrain::generate(const TerrainTileRequest& request)
+{
+	auto pendingTile = std::make_unique<PendingTile>();
+	pendingTile->coordinate = request.coordinate;
+	pendingTile->lod = request.lod;
+	pendingTile->collision = request.collision;
+
+	// The tile is owned by pendingTile, which outlives the work since we wait on it before letting it go
+	auto tile = &pendingTile->tile;
+	const auto heightMap = &heightMap_;
+	const auto tileSamples = tileSamples_;
+
+	pendingTile->future = threadPool_->postWork([tile, heightMap, tileSamples, coordinate = request.coordinate, lod = request.lod, collision = request.collision]() {
+		*tile = std::make_shared<TerrainTile>(*heightMap, coordinate, tileSamples, lod, collision);
+	});
+
+	pendingTiles_.push_back(std::move(pendingTile));
+}
+
+void StreamingTerrain::installGeneratedTiles()
+{
+	uint32 installed = 0;
+
+	// Requests are posted nearest first, so keeping them in order installs the nearest tiles first
+	for (auto it = pendingTiles_.begin(); it != pendingTiles_.end() && installed < tileInstallsPerTick_;)
+	{
+		auto& pendingTile = *it;
+
+		// First the tile is generated, then its mesh is uploaded on the OpenGL loader, and only then is it installed
+		if (!pendingTile->meshUpload)
+		{
+			if (pendingTile->future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				++it;
+				continue;
+			}
+
+			try
+			{
+				pendingTile->future.get();
+			}
+			catch (const std::exception& e)
+			{
+				LOG_ERROR(logger_, "Unable to generate terrain tile (%s, %s): %s", pendingTile->coordinate.x, pendingTile->coordinate.z, e.what())
+
+				streamer_->failed(pendingTile->coordinate);
+				it = pendingTiles_.erase(it);
+				continue;
+			}
+
+			uploadMesh(*pendingTile);
+		}
+
+		if (pendingTile->meshUploadFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			++it;
+			continue;
+		}
+
+		graphics::MeshHandle meshHandle;
+
+		try
+		{
+			pendingTile->meshUploadFuture.get();
+
+			std::lock_guard<std::mutex> lock(pendingTile->meshUpload->mutex);
+			meshHandle = pendingTile->meshUpload->meshHandle;
+		}
+		catch (const std::exception& e)
+		{
+			LOG_ERROR(logger_, "Unable to upload terrain tile (%s, %s): %s", pendingTile->coordinate.x, pendingTile->coordinate.z, e.what())
+
+			streamer_->failed(pendingTile->coordinate);
+			it = pendingTiles_.erase(it);
+			continue;
+		}
+
+		try
+		{
+			install(*pendingTile->tile, meshHandle);
+		}
+		catch (const std::exception& e)
+		{
+			LOG_ERROR(logger_, "Unable to install terrain tile (%s, %s): %s", pendingTile->coordinate.x, pendingTile->coordinate.z, e.what())
+
+			streamer_->failed(pendingTile->coordinate);
+			it = pendingTiles_.erase(it);
+			continue;
+		}
+
+		streamer_->loaded(pendingTile->coordinate, pendingTile->lod, pendingTile->tile->memorySize(), pendingTile->tile->hasCollision());
+
+		++installed;
+		it = pendingTiles_.erase(it);
+	}
+}
+
+void StreamingTerrain::uploadMesh(PendingTile& pendingTile)
+{
+	pendingTile.meshUpload = std::make_shared<MeshUpload>();
+
+	// The upload keeps its own references to the tile and upload state, so it is safe to run after we are gone
+	auto meshUpload = pendingTile.meshUpload;
+	auto tile = pendingTile.tile;
+	auto graphicsEngine = graphicsEngine_;
+
+	auto upload = [meshUpload, tile, graphicsEngine]() {
+		std::lock_guard<std::mutex> lock(meshUpload->mutex);
+
+		if (meshUpload->abandoned) return;
+
+		meshUpload->meshHandle = graphicsEngine->createStaticMesh(tile->mesh());
+	};
+
+	pendingTile.meshUploadFuture = openGlLoader_->postWork(std::move(upload), WorkPriority::NORMAL);
+}
+
+void StreamingTerrain::install(const TerrainTile& tile, const graphics::MeshHandle& meshHandle)
+{
+	ResidentTile residentTile;
+
+	residentTile.meshHandle = meshHandle;
+
+	try
+	{
+		residentTile.entity = scene_->createEntity();
+		residentTile.entity.assign<ecs::PositionComponent>(tile.position());
+		residentTile.entity.assign<ecs::OrientationComponent>();
+		residentTile.entity.assign<ecs::GraphicsComponent>(residentTile.meshHandle);
+
+		if (tile.hasCollision())
+		{
+			residentTile.collisionShapeHandle = physicsEngine_->createStaticTerrainShape(tile.heightfield());
+			residentTile.entity.assign<ecs::RigidBodyObjectComponent>(residentTile.collisionShapeHandle, 0.0f, 1.0f, 1.0f);
+
+			residentTile.polygonMeshHandle = pathfindingEngine_->createPolygonMesh(&tile.pathfindingTerrain());
+			residentTile.navigationMeshHandle = pathfindingEngine_->createNavigationMesh(residentTile.polygonMeshHandle);
+		}
+	}
+	catch (...)
+	{
+		// Leave whatever tile is already resident in place, and don't leak the parts of this one we did create,
+		// including the uploaded mesh
+		if (residentTile.entity.valid()) scene_->destroy(residentTile.entity);
+
+		destroyResources(residentTile);
+
+		throw;
+	}
+
+	// Swap out the tile it replaces, at another level of detail, only once the new one is in place so there is no gap
+	uninstall(tile.coordinate());
+
+	residentTiles_[tile.coordinate()] = residentTile;
+}
+
+void StreamingTerrain::uninstall(const TerrainTileCoordinate& coordinate)
+{
+	auto it = residentTiles_.find(coordinate);
+
+	if (it == residentTiles_.end()) return;
+
+	// Destroying the entity destroys its renderable and rigid body
+	if (it->second.entity.valid()) scene_->destroy(it->second.entity);
+
+	destroyResources(it->second);
+
+	residentTiles_.erase(it);
+}
+
+void StreamingTerrain::destroyResources(const ResidentTile& residentTile)
+{
+	if (residentTile.navigationMeshHandle) pathfindingEngine_->destroy(residentTile.navigationMeshHandle);
+	if (residentTile.polygonMeshHandle) pathfindingEngine_->destroy(residentTile.polygonMeshHandle);
+	if (residentTile.collisionShapeHandle) physicsEngine_->destroy(residentTile.collisionShapeHandle);
+	if (residentTile.meshHandle) graphicsEngine_->destroy(residentTile.meshHandle);
+}
+
+const std::vector<pathfinding::CrowdHandle>& StreamingTerrain::crowds() const
+{
+	return crowdHandles_;
+}
+
+void StreamingTerrain::addViewer(const ecs::Entity& entity)
+{
+	const auto it = std::find_if(viewers_.begin(), viewers_.end(), [&entity](const ecs::Entity& viewer) { return viewer.id() == entity.id(); });
+
+	if (it == viewers_.end()) viewers_.push_back(entity);
+}
+
+void StreamingTerrain::removeViewer(const ecs::Entity& entity)
+{
+	viewers_.erase(std::remove_if(viewers_.begin(), viewers_.end(), [&entity](const ecs::Entity& viewer) { return viewer.id() == entity.id(); }), viewers_.end());
+}
+
+const TerrainTileStreamer& StreamingTerrain::streamer() const
+{
+	return *streamer_;
+}
+
+}
@@ -456,4 +456,13 @@ const std::vector<pathfinding::CrowdHandle>& Terrain::crowds() const
 	return crowdHandles_;
 }
 
+void Terrain::addViewer(const ecs::Entity& entity)
+{
+	// The whole terrain is always loaded, so there is nothing to stream
+}
+
+void Terrain::removeViewer(const ecs::Entity& entity)
+{
+}
+
 }
@@ -1,6 +1,8 @@
 #include "TerrainFactory.hpp"
 
 #include "Terrain.hpp"
+#include "StreamingTerrain.hpp"
+#include "Scene.hpp"
 
 namespace ice_engine
 {
@@ -26,6 +28,12 @@ std::unique_ptr<ITerrain> TerrainFactory::create(
 	pathfinding::PathfindingSceneHandle pathfindingSceneHandle
 )
 {
+	// Streamed terrain builds its own per tile collision shapes and navigation meshes
+	if (properties->getBoolValue("terrain.streaming", false))
+	{
+		return std::make_unique< StreamingTerrain >( properties, logger, scene, std::move(heightMap), graphicsEngine, pathfindingEngine, physicsEngine, scene->backgroundThreadPool(), scene->openGlLoader() );
+	}
+
 	std::unique_ptr<ITerrain> ptr = std::make_unique< Terrain >( properties, fileSystem, logger, scene, heightMap, splatMap, displacementMap, collisionShapeHandle, polygonMeshHandle, navigationMeshHandle, graphicsEngine, pathfindingEngine, physicsEngine, audioEngine, audioSceneHandle, renderSceneHandle, physicsSceneHandle, pathfindingSceneHandle );
 	
 	return std::move( ptr );
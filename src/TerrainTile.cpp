@@ -0,0 +1,180 @@
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "TerrainTile.hpp"
+
+#include "detail/GenerateVertices.hpp"
+#include "detail/Format.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+namespace ice_engine
+{
+
+namespace
+{
+// Matches the single piece terrain, heights span 15 units and are centred on 0
+constexpr float32 TERRAIN_HEIGHT = 15.0f;
+constexpr float32 TERRAIN_HEIGHT_OFFSET = -7.5f;
+
+int32 wrap(const int32 value, const int32 size)
+{
+	const int32 result = value % size;
+	return result < 0 ? result + size : result;
+}
+
+byte sample(const HeightMap& heightMap, const int32 x, const int32 z)
+{
+	const auto image = heightMap.image();
+
+	return heightMap.height(
+		static_cast<uint32>(wrap(x, static_cast<int32>(image->width()))),
+		static_cast<uint32>(wrap(z, static_cast<int32>(image->height())))
+	);
+}
+
+float32 height(const HeightMap& heightMap, const int32 x, const int32 z)
+{
+	return (static_cast<float32>(sample(heightMap, x, z)) / 255.0f) * TERRAIN_HEIGHT;
+}
+
+template<typename T>
+uint64 capacityInBytes(const std::vector<T>& v)
+{
+	return static_cast<uint64>(v.capacity() * sizeof(T));
+}
+}
+
+uint64 TerrainTile::memorySize() const
+{
+	return sizeof(TerrainTile)
+		+ capacityInBytes(mesh_.vertices())
+		+ capacityInBytes(mesh_.indices())
+		+ capacityInBytes(mesh_.normals())
+		+ capacityInBytes(mesh_.textureCoordinates())
+		+ capacityInBytes(heightfield_.data())
+		+ capacityInBytes(pathfindingTerrain_.vertices())
+		+ capacityInBytes(pathfindingTerrain_.indices());
+}
+
+void TerrainTile::generateTerrainTile(const HeightMap& heightMap, const uint32 tileSamples)
+{
+	if (!heightMap.image() || heightMap.image()->width() == 0 || heightMap.image()->height() == 0)
+	{
+		throw InvalidArgumentException("Height map for terrain tile is empty.");
+	}
+
+	if (tileSamples == 0 || (tileSamples & (tileSamples - 1)) != 0)
+	{
+		throw InvalidArgumentException(detail::format("Terrain tile samples (%s) must be a power of 2.", tileSamples));
+	}
+
+	if (lod_ >= 32 || (1u << lod_) > tileSamples)
+	{
+		throw InvalidArgumentException(detail::format("Terrain tile level of detail %s is too coarse for %s samples.", lod_, tileSamples));
+	}
+
+	const int32 step = static_cast<int32>(1u << lod_);
+	const int32 quads = static_cast<int32>(tileSamples) / step;
+	const int32 halfSize = static_cast<int32>(tileSamples / 2);
+
+	const int32 worldX = coordinate_.x * static_cast<int32>(tileSamples);
+	const int32 worldZ = coordinate_.z * static_cast<int32>(tileSamples);
+
+	// Height map sample for world coordinate 0
+	const int32 originX = worldX + static_cast<int32>(heightMap.image()->width() / 2);
+	const int32 originZ = worldZ + static_cast<int32>(heightMap.image()->height() / 2);
+
+	position_ = glm::vec3(static_cast<float32>(worldX + halfSize), TERRAIN_HEIGHT_OFFSET, static_cast<float32>(worldZ + halfSize));
+
+	std::vector<glm::vec3> vertices;
+	std::vector<uint32> indices;
+	std::tie(vertices, indices) = detail::generateGrid(static_cast<uint32>(quads), static_cast<uint32>(quads));
+
+	std::vector<glm::vec3> normals(vertices.size());
+	std::vector<glm::vec2> textureCoordinates(vertices.size());
+
+	const float32 mapWidth = static_cast<float32>(heightMap.image()->width());
+	const float32 mapHeight = static_cast<float32>(heightMap.image()->height());
+
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		auto& v = vertices[i];
+
+		const int32 x = static_cast<int32>(v.x) * step;
+		const int32 z = static_cast<int32>(v.z) * step;
+		const int32 sx = originX + x;
+		const int32 sz = originZ + z;
+
+		v = glm::vec3(static_cast<float32>(x - halfSize), height(heightMap, sx, sz), static_cast<float32>(z - halfSize));
+
+		// Central differences over the samples the mesh actually uses, so neighbouring tiles at the same level of detail agree on their shared edge
+		const float32 dx = height(heightMap, sx - step, sz) - height(heightMap, sx + step, sz);
+		const float32 dz = height(heightMap, sx, sz - step) - height(heightMap, sx, sz + step);
+		normals[i] = glm::normalize(glm::vec3(dx, 2.0f * static_cast<float32>(step), dz));
+
+		textureCoordinates[i] = glm::vec2(static_cast<float32>(sx) / mapWidth, static_cast<float32>(sz) / mapHeight);
+	}
+
+	// generateGrid winds its triangles facing down
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		std::swap(indices[i], indices[i + 2]);
+	}
+
+	if (collision_)
+	{
+		const uint32 samples = tileSamples + 1;
+
+		std::vector<byte> data(samples * samples);
+		for (uint32 z = 0; z < samples; ++z)
+		{
+			for (uint32 x = 0; x < samples; ++x)
+			{
+				data[z * samples + x] = sample(heightMap, originX + static_cast<int32>(x), originZ + static_cast<int32>(z));
+			}
+		}
+
+		heightfield_ = Heightfield(std::move(data), samples, samples);
+
+		// The render mesh only has every sample at level of detail 0, otherwise the navigation mesh gets its own full grid
+		std::vector<glm::vec3> pathfindingVertices;
+		std::vector<uint32> pathfindingIndices;
+
+		if (lod_ == 0)
+		{
+			pathfindingVertices = vertices;
+			pathfindingIndices = indices;
+		}
+		else
+		{
+			std::tie(pathfindingVertices, pathfindingIndices) = detail::generateGrid(tileSamples, tileSamples);
+
+			for (auto& v : pathfindingVertices)
+			{
+				const int32 x = static_cast<int32>(v.x);
+				const int32 z = static_cast<int32>(v.z);
+
+				v = glm::vec3(static_cast<float32>(x - halfSize), height(heightMap, originX + x, originZ + z), static_cast<float32>(z - halfSize));
+			}
+
+			for (size_t i = 0; i + 2 < pathfindingIndices.size(); i += 3)
+			{
+				std::swap(pathfindingIndices[i], pathfindingIndices[i + 2]);
+			}
+		}
+
+		for (auto& v : pathfindingVertices)
+		{
+			v += position_;
+		}
+
+		pathfindingTerrain_ = PathfindingTerrain(std::move(pathfindingVertices), std::move(pathfindingIndices));
+	}
+
+	const std::string name = detail::format("terrain_tile_%s_%s_%s", coordinate_.x, coordinate_.z, lod_);
+	mesh_ = Mesh(name, std::move(vertices), std::move(indices), {}, std::move(normals), std::move(textureCoordinates));
+}
+
+}
@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <cmath>
+
+#include "TerrainTileStreamer.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+#include "detail/Format.hpp"
+
+namespace ice_engine
+{
+
+constexpr uint32 TerrainTileStreamer::INVALID_LOD;
+constexpr uint32 TerrainTileStreamer::MAX_RETRY_DELAY;
+
+TerrainTileStreamer::TerrainTileStreamer(const float32 tileSize, const float32 loadRadius, std::vector<float32> lodDistances, const uint64 memoryBudget, const float32 collisionRadius)
+	:
+	tileSize_(tileSize),
+	loadRadius_(loadRadius),
+	lodDistances_(std::move(lodDistances)),
+	memoryBudget_(memoryBudget),
+	collisionRadius_(collisionRadius)
+{
+	if (!(tileSize_ > 0.0f) || !std::isfinite(tileSize_))
+	{
+		throw InvalidArgumentException(detail::format("Tile size (%s) must be greater than 0.", tileSize_));
+	}
+
+	if (!(loadRadius_ >= 0.0f) || !std::isfinite(loadRadius_))
+	{
+		throw InvalidArgumentException(detail::format("Load radius (%s) must not be negative.", loadRadius_));
+	}
+
+	if (std::isnan(collisionRadius_))
+	{
+		throw InvalidArgumentException("Collision radius must be a number.");
+	}
+
+	if (!std::is_sorted(lodDistances_.begin(), lodDistances_.end()))
+	{
+		throw InvalidArgumentException("Level of detail distances must be increasing.");
+	}
+}
+
+float32 TerrainTileStreamer::tileSize() const
+{
+	return tileSize_;
+}
+
+uint32 TerrainTileStreamer::lodCount() const
+{
+	return static_cast<uint32>(lodDistances_.size()) + 1;
+}
+
+TerrainTileCoordinate TerrainTileStreamer::tileCoordinate(const glm::vec3& position) const
+{
+	return TerrainTileCoordinate(static_cast<int32>(std::floor(position.x / tileSize_)), static_cast<int32>(std::floor(position.z / tileSize_)));
+}
+
+uint32 TerrainTileStreamer::lod(const float32 distance) const
+{
+	return static_cast<uint32>(std::upper_bound(lodDistances_.begin(), lodDistances_.end(), distance) - lodDistances_.begin());
+}
+
+bool TerrainTileStreamer::collision(const float32 distance) const
+{
+	return distance <= collisionRadius_;
+}
+
+float32 TerrainTileStreamer::distance(const TerrainTileCoordinate& coordinate, const glm::vec3& position) const
+{
+	// Distance on the xz plane to the nearest point of the tile
+	const float32 minimumX = static_cast<float32>(coordinate.x) * tileSize_;
+	const float32 minimumZ = static_cast<float32>(coordinate.z) * tileSize_;
+
+	const float32 dx = std::max(0.0f, std::max(minimumX - position.x, position.x - (minimumX + tileSize_)));
+	const float32 dz = std::max(0.0f, std::max(minimumZ - position.z, position.z - (minimumZ + tileSize_)));
+
+	return std::sqrt(dx * dx + dz * dz);
+}
+
+void TerrainTileStreamer::update(const std::vector<glm::vec3>& viewers, std::vector<TerrainTileRequest>& requests, std::vector<TerrainTileCoordinate>& unloads)
+{
+	requests.clear();
+	unloads.clear();
+
+	++updateCount_;
+
+	for (const auto& viewer : viewers)
+	{
+		if (!std::isfinite(viewer.x) || !std::isfinite(viewer.z)) continue;
+
+		const auto minimum = tileCoordinate(glm::vec3(viewer.x - loadRadius_, 0.0f, viewer.z - loadRadius_));
+		const auto maximum = tileCoordinate(glm::vec3(viewer.x + loadRadius_, 0.0f, viewer.z + loadRadius_));
+
+		for (int32 z = minimum.z; z <= maximum.z; ++z)
+		{
+			for (int32 x = minimum.x; x <= maximum.x; ++x)
+			{
+				const TerrainTileCoordinate coordinate(x, z);
+				const float32 d = distance(coordinate, viewer);
+
+				if (d > loadRadius_) continue;
+
+				auto& tile = tiles_[coordinate];
+
+				if (tile.lastWanted != updateCount_)
+				{
+					tile.lastWanted = updateCount_;
+					tile.distance = d;
+				}
+				else
+				{
+					tile.distance = std::min(tile.distance, d);
+				}
+			}
+		}
+	}
+
+	for (auto& kv : tiles_)
+	{
+		auto& tile = kv.second;
+
+		if (tile.lastWanted != updateCount_ || tile.pending || updateCount_ < tile.retryAt) continue;
+
+		const uint32 wantedLod = lod(tile.distance);
+		const bool wantedCollision = collision(tile.distance);
+
+		if (tile.lod == wantedLod && tile.collision == wantedCollision) continue;
+
+		TerrainTileRequest request;
+		request.coordinate = kv.first;
+		request.lod = wantedLod;
+		request.collision = wantedCollision;
+		request.distance = tile.distance;
+		requests.push_back(request);
+
+		tile.pending = true;
+		++pendingCount_;
+	}
+
+	std::sort(requests.begin(), requests.end(), [](const TerrainTileRequest& a, const TerrainTileRequest& b) {
+		return a.distance < b.distance;
+	});
+
+	evict(unloads);
+}
+
+void TerrainTileStreamer::evict(std::vector<TerrainTileCoordinate>& unloads)
+{
+	std::vector<std::pair<TerrainTileCoordinate, const Tile*>> candidates;
+
+	for (auto it = tiles_.begin(); it != tiles_.end();)
+	{
+		const auto& tile = it->second;
+
+		if (tile.pending || tile.lastWanted == updateCount_)
+		{
+			++it;
+			continue;
+		}
+
+		// Tiles that failed to load and are no longer wanted have nothing to unload
+		if (tile.lod == INVALID_LOD)
+		{
+			it = tiles_.erase(it);
+			continue;
+		}
+
+		if (memoryUsed_ > memoryBudget_) candidates.push_back(std::make_pair(it->first, &tile));
+
+		++it;
+	}
+
+	if (candidates.empty()) return;
+
+	std::sort(candidates.begin(), candidates.end(), [](const std::pair<TerrainTileCoordinate, const Tile*>& a, const std::pair<TerrainTileCoordinate, const Tile*>& b) {
+		if (a.second->lastWanted != b.second->lastWanted) return a.second->lastWanted < b.second->lastWanted;
+		return a.second->distance > b.second->distance;
+	});
+
+	for (const auto& candidate : candidates)
+	{
+		if (memoryUsed_ <= memoryBudget_) break;
+
+		memoryUsed_ -= candidate.second->memorySize;
+		unloads.push_back(candidate.first);
+
+		tiles_.erase(candidate.first);
+	}
+}
+
+void TerrainTileStreamer::loaded(const TerrainTileCoordinate& coordinate, const uint32 lod, const uint64 memorySize, const bool collision)
+{
+	auto& tile = tiles_[coordinate];
+
+	if (tile.pending)
+	{
+		tile.pending = false;
+		--pendingCount_;
+	}
+
+	memoryUsed_ = memoryUsed_ - tile.memorySize + memorySize;
+
+	tile.lod = lod;
+	tile.collision = collision;
+	tile.memorySize = memorySize;
+	tile.failures = 0;
+	tile.retryAt = 0;
+}
+
+void TerrainTileStreamer::failed(const TerrainTileCoordinate& coordinate)
+{
+	auto it = tiles_.find(coordinate);
+
+	if (it == tiles_.end() || !it->second.pending) return;
+
+	auto& tile = it->second;
+
+	tile.pending = false;
+	--pendingCount_;
+
+	// A tile that can't be loaded, say because its height map is bad, shouldn't be retried every update
+	const uint32 delay = tile.failures < 8 ? std::min(1u << tile.failures, MAX_RETRY_DELAY) : MAX_RETRY_DELAY;
+
+	++tile.failures;
+	tile.retryAt = updateCount_ + delay;
+}
+
+bool TerrainTileStreamer::resident(const TerrainTileCoordinate& coordinate) const
+{
+	const auto it = tiles_.find(coordinate);
+
+	return it != tiles_.end() && it->second.lod != INVALID_LOD;
+}
+
+bool TerrainTileStreamer::pending(const TerrainTileCoordinate& coordinate) const
+{
+	const auto it = tiles_.find(coordinate);
+
+	return it != tiles_.end() && it->second.pending;
+}
+
+size_t TerrainTileStreamer::residentCount() const
+{
+	return static_cast<size_t>(std::count_if(tiles_.begin(), tiles_.end(), [](const std::pair<const TerrainTileCoordinate, Tile>& kv) {
+		return kv.second.lod != INVALID_LOD;
+	}));
+}
+
+size_t TerrainTileStreamer::pendingCount() const
+{
+	return pendingCount_;
+}
+
+uint64 TerrainTileStreamer::memoryUsed() const
+{
+	return memoryUsed_;
+}
+
+}
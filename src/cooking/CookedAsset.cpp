@@ -0,0 +1,596 @@
+#include <algorithm>
+
+#include "cooking/CookedAsset.hpp"
+#include "cooking/CookedAssetStream.hpp"
+
+#include "image/BlockCompression.hpp"
+
+#include "detail/Format.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+namespace ice_engine
+{
+namespace cooking
+{
+
+namespace
+{
+
+// The fewest bytes each element of a counted list takes, used to reject counts the data can't hold
+const size_t MINIMUM_MESH_SIZE = 9 * sizeof(uint64) + 7 * sizeof(uint32);
+const size_t MINIMUM_BONE_INDEX_SIZE = 2 * sizeof(uint32);
+const size_t MINIMUM_BONE_SIZE = sizeof(uint32) + sizeof(glm::mat4);
+const size_t MINIMUM_BONE_NODE_SIZE = 2 * sizeof(uint32) + sizeof(glm::mat4);
+const size_t VERTEX_ATTRIBUTE_SIZE = 4 * sizeof(uint32);
+const size_t MINIMUM_VERTEX_STREAM_SIZE = sizeof(uint64);
+const size_t MINIMUM_TEXTURE_SIZE = 2 * sizeof(uint32);
+const size_t MINIMUM_ANIMATED_BONE_NODE_SIZE = 2 * sizeof(uint32) + 3 * sizeof(uint64);
+const size_t MINIMUM_ANIMATION_SIZE = 4 * sizeof(uint32);
+
+// Real skeletons are far shallower - this only stops a corrupt asset from overflowing the stack
+const uint32 MAXIMUM_BONE_NODE_DEPTH = 256;
+
+void writeHeader(CookedAssetWriter& writer, const CookedAssetType type)
+{
+	writer.write(COOKED_ASSET_MAGIC);
+	writer.write(COOKED_ASSET_VERSION);
+	writer.write(static_cast<uint32>(type));
+	writer.write(static_cast<uint32>(0));
+}
+
+void readHeader(CookedAssetReader& reader, const CookedAssetType expectedType)
+{
+	const auto magic = reader.read<uint32>();
+	const auto version = reader.read<uint32>();
+	const auto type = static_cast<CookedAssetType>(reader.read<uint32>());
+	reader.read<uint32>();
+
+	if (magic != COOKED_ASSET_MAGIC)
+	{
+		throw RuntimeException("Not a cooked asset.");
+	}
+	if (version != COOKED_ASSET_VERSION)
+	{
+		throw RuntimeException(detail::format("Cooked asset has version %s, expected version %s - it needs to be cooked again.", version, COOKED_ASSET_VERSION));
+	}
+	if (type != expectedType)
+	{
+		throw RuntimeException(detail::format("Cooked asset has type %s, expected type %s.", static_cast<uint32>(type), static_cast<uint32>(expectedType)));
+	}
+}
+
+void writeImage(CookedAssetWriter& writer, const graphics::IImage& image)
+{
+	writer.write(image.width());
+	writer.write(image.height());
+	writer.write(image.format());
+	writer.writeArray(image.data());
+
+	writer.write(image.mipLevelCount() - 1);
+	for (uint32 i = 1; i < image.mipLevelCount(); ++i)
+	{
+		writer.writeArray(image.mipLevel(i));
+	}
+}
+
+std::unique_ptr<Image> readImage(CookedAssetReader& reader)
+{
+	const auto width = reader.read<uint32>();
+	const auto height = reader.read<uint32>();
+	const auto format = reader.read<int32>();
+
+	std::vector<byte> data;
+	reader.readArray(data);
+
+	const auto mipLevelCount = reader.read<uint32>();
+
+	// A 32 bit wide image has at most 31 levels below the full size one
+	if (mipLevelCount > 31)
+	{
+		throw RuntimeException(detail::format("Cooked image has %s mip levels, which is more than an image can have.", mipLevelCount));
+	}
+
+	std::vector<std::vector<byte>> mipLevels(mipLevelCount);
+	for (auto& mipLevel : mipLevels)
+	{
+		reader.readArray(mipLevel);
+	}
+
+	// Everything that reads the image trusts its size, so a truncated or corrupt asset must not get past here
+	if (format != IImage::Format::FORMAT_RGB && format != IImage::Format::FORMAT_RGBA && !image::isBlockCompressed(static_cast<IImage::Format>(format)))
+	{
+		throw RuntimeException(detail::format("Cooked image has unknown format %s.", format));
+	}
+
+	for (uint32 i = 0; i <= mipLevelCount; ++i)
+	{
+		const auto& level = (i == 0 ? data : mipLevels[i - 1]);
+		const auto expectedSize = image::imageSize(static_cast<IImage::Format>(format), std::max<uint32>(1, width >> i), std::max<uint32>(1, height >> i));
+
+		if (level.size() != expectedSize)
+		{
+			throw RuntimeException(detail::format("Cooked image level %s has %s bytes, expected %s for a %sx%s image with format %s.", i, level.size(), expectedSize, width, height, format));
+		}
+	}
+
+	return std::make_unique<Image>(std::move(data), width, height, static_cast<IImage::Format>(format), std::move(mipLevels));
+}
+
+template<typename K, typename V>
+std::vector<typename std::unordered_map<K, V>::const_iterator> sorted(const std::unordered_map<K, V>& map)
+{
+	// Write maps in a fixed order so cooking the same asset twice gives the same bytes
+	std::vector<typename std::unordered_map<K, V>::const_iterator> iterators;
+	iterators.reserve(map.size());
+
+	for (auto it = map.begin(); it != map.end(); ++it)
+	{
+		iterators.push_back(it);
+	}
+
+	std::sort(iterators.begin(), iterators.end(), [](const auto& a, const auto& b) {
+		return a->first < b->first;
+	});
+
+	return iterators;
+}
+
+void writeMesh(CookedAssetWriter& writer, const Mesh& mesh)
+{
+	writer.writeString(mesh.name());
+
+	writer.writeArray(mesh.vertices());
+	writer.writeArray(mesh.indices());
+	writer.writeArray(mesh.colors());
+	writer.writeArray(mesh.normals());
+	writer.writeArray(mesh.textureCoordinates());
+
+	writer.writeArray(mesh.vertexBoneData().boneIds());
+	writer.writeArray(mesh.vertexBoneData().boneWeights());
+
+	const auto& boneData = mesh.boneData();
+
+	writer.writeString(boneData.name);
+
+	writer.write(static_cast<uint32>(boneData.boneIndexMap.size()));
+	for (const auto& it : sorted(boneData.boneIndexMap))
+	{
+		writer.writeString(it->first);
+		writer.write(it->second);
+	}
+
+	writer.write(static_cast<uint32>(boneData.boneTransform.size()));
+	for (const auto& bone : boneData.boneTransform)
+	{
+		writer.writeString(bone.name);
+		writer.write(bone.inverseModelSpacePoseTransform);
+	}
+
+	const auto& vertexLayout = mesh.vertexLayout();
+
+	writer.write(static_cast<uint32>(vertexLayout.attributes.size()));
+	for (const auto& attribute : vertexLayout.attributes)
+	{
+		writer.write(static_cast<uint32>(attribute.attribute));
+		writer.write(static_cast<uint32>(attribute.format));
+		writer.write(attribute.stream);
+		writer.write(attribute.offset);
+	}
+
+	writer.writeArray(vertexLayout.strides);
+	writer.write(static_cast<uint32>(vertexLayout.indexFormat));
+
+	writer.write(static_cast<uint32>(mesh.vertexStreams().size()));
+	for (const auto& vertexStream : mesh.vertexStreams())
+	{
+		writer.writeArray(vertexStream);
+	}
+
+	writer.writeArray(mesh.indexData());
+}
+
+Mesh readMesh(CookedAssetReader& reader)
+{
+	auto name = reader.readString();
+
+	std::vector<glm::vec3> vertices;
+	std::vector<uint32> indices;
+	std::vector<glm::vec4> colors;
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec2> textureCoordinates;
+
+	reader.readArray(vertices);
+	reader.readArray(indices);
+	reader.readArray(colors);
+	reader.readArray(normals);
+	reader.readArray(textureCoordinates);
+
+	std::vector<glm::ivec4> boneIds;
+	std::vector<glm::vec4> boneWeights;
+
+	reader.readArray(boneIds);
+	reader.readArray(boneWeights);
+
+	BoneData boneData;
+	boneData.name = reader.readString();
+
+	const auto numberOfBoneIndices = reader.readCount(MINIMUM_BONE_INDEX_SIZE);
+	for (uint32 i = 0; i < numberOfBoneIndices; ++i)
+	{
+		auto boneName = reader.readString();
+		boneData.boneIndexMap[std::move(boneName)] = reader.read<uint32>();
+	}
+
+	const auto numberOfBones = reader.readCount(MINIMUM_BONE_SIZE);
+	boneData.boneTransform.resize(numberOfBones);
+	for (auto& bone : boneData.boneTransform)
+	{
+		bone.name = reader.readString();
+		bone.inverseModelSpacePoseTransform = reader.read<glm::mat4>();
+	}
+
+	graphics::VertexLayout vertexLayout;
+
+	vertexLayout.attributes.resize(reader.readCount(VERTEX_ATTRIBUTE_SIZE));
+	for (auto& attribute : vertexLayout.attributes)
+	{
+		attribute.attribute = static_cast<graphics::VertexAttribute>(reader.read<uint32>());
+		attribute.format = static_cast<graphics::VertexAttributeFormat>(reader.read<uint32>());
+		attribute.stream = reader.read<uint32>();
+		attribute.offset = reader.read<uint32>();
+	}
+
+	reader.readArray(vertexLayout.strides);
+	vertexLayout.indexFormat = static_cast<graphics::IndexFormat>(reader.read<uint32>());
+
+	const auto numberOfVertexStreams = reader.readCount(MINIMUM_VERTEX_STREAM_SIZE);
+	if (numberOfVertexStreams != vertexLayout.strides.size())
+	{
+		throw RuntimeException(detail::format("Cooked mesh '%s' has %s vertex streams but its layout has %s.", name, numberOfVertexStreams, vertexLayout.strides.size()));
+	}
+
+	std::vector<std::vector<byte>> vertexStreams(numberOfVertexStreams);
+	for (auto& vertexStream : vertexStreams)
+	{
+		reader.readArray(vertexStream);
+	}
+
+	std::vector<byte> indexData;
+	reader.readArray(indexData);
+
+	return Mesh(
+		std::move(name),
+		std::move(vertices),
+		std::move(indices),
+		std::move(colors),
+		std::move(normals),
+		std::move(textureCoordinates),
+		VertexBoneData(std::move(boneIds), std::move(boneWeights)),
+		std::move(boneData),
+		std::move(vertexLayout),
+		std::move(vertexStreams),
+		std::move(indexData)
+	);
+}
+
+void skipMesh(CookedAssetReader& reader)
+{
+	reader.skipString();
+
+	reader.skipArray<glm::vec3>();
+	reader.skipArray<uint32>();
+	reader.skipArray<glm::vec4>();
+	reader.skipArray<glm::vec3>();
+	reader.skipArray<glm::vec2>();
+
+	reader.skipArray<glm::ivec4>();
+	reader.skipArray<glm::vec4>();
+
+	reader.skipString();
+
+	const auto numberOfBoneIndices = reader.read<uint32>();
+	for (uint32 i = 0; i < numberOfBoneIndices; ++i)
+	{
+		reader.skipString();
+		reader.read<uint32>();
+	}
+
+	const auto numberOfBones = reader.read<uint32>();
+	for (uint32 i = 0; i < numberOfBones; ++i)
+	{
+		reader.skipString();
+		reader.read<glm::mat4>();
+	}
+
+	const auto numberOfAttributes = reader.read<uint32>();
+	for (uint32 i = 0; i < numberOfAttributes * 4; ++i)
+	{
+		reader.read<uint32>();
+	}
+
+	reader.skipArray<uint32>();
+	reader.read<uint32>();
+
+	const auto numberOfVertexStreams = reader.read<uint32>();
+	for (uint32 i = 0; i < numberOfVertexStreams; ++i)
+	{
+		reader.skipArray<byte>();
+	}
+
+	reader.skipArray<byte>();
+}
+
+void writeBoneNode(CookedAssetWriter& writer, const BoneNode& boneNode)
+{
+	writer.writeString(boneNode.name);
+	writer.write(boneNode.transformation);
+	writer.write(static_cast<uint32>(boneNode.children.size()));
+
+	for (const auto& child : boneNode.children)
+	{
+		writeBoneNode(writer, child);
+	}
+}
+
+BoneNode readBoneNode(CookedAssetReader& reader, const uint32 depth = 0)
+{
+	if (depth > MAXIMUM_BONE_NODE_DEPTH)
+	{
+		throw RuntimeException(detail::format("Cooked skeleton is more than %s bones deep.", MAXIMUM_BONE_NODE_DEPTH));
+	}
+
+	BoneNode boneNode;
+	boneNode.name = reader.readString();
+	boneNode.transformation = reader.read<glm::mat4>();
+	boneNode.children.resize(reader.readCount(MINIMUM_BONE_NODE_SIZE));
+
+	for (auto& child : boneNode.children)
+	{
+		child = readBoneNode(reader, depth + 1);
+	}
+
+	return boneNode;
+}
+
+void writeAnimation(CookedAssetWriter& writer, const Animation& animation)
+{
+	writer.writeString(animation.name());
+	writer.write(animation.duration().count());
+	writer.write(animation.ticksPerSecond());
+
+	writer.write(static_cast<uint32>(animation.animatedBoneNodes().size()));
+	for (const auto& it : sorted(animation.animatedBoneNodes()))
+	{
+		const auto& animatedBoneNode = it->second;
+
+		writer.writeString(it->first);
+		writer.writeString(animatedBoneNode.name);
+		writer.writeArray(animatedBoneNode.positionKeyFrames);
+		writer.writeArray(animatedBoneNode.rotationKeyFrames);
+		writer.writeArray(animatedBoneNode.scalingKeyFrames);
+	}
+}
+
+Animation readAnimation(CookedAssetReader& reader)
+{
+	auto name = reader.readString();
+	const auto duration = std::chrono::duration<float32>(reader.read<float32>());
+	const auto ticksPerSecond = reader.read<float32>();
+
+	std::unordered_map<std::string, AnimatedBoneNode> animatedBoneNodes;
+
+	const auto numberOfAnimatedBoneNodes = reader.readCount(MINIMUM_ANIMATED_BONE_NODE_SIZE);
+	animatedBoneNodes.reserve(numberOfAnimatedBoneNodes);
+
+	for (uint32 i = 0; i < numberOfAnimatedBoneNodes; ++i)
+	{
+		auto key = reader.readString();
+
+		AnimatedBoneNode animatedBoneNode;
+		animatedBoneNode.name = reader.readString();
+		reader.readArray(animatedBoneNode.positionKeyFrames);
+		reader.readArray(animatedBoneNode.rotationKeyFrames);
+		reader.readArray(animatedBoneNode.scalingKeyFrames);
+
+		animatedBoneNodes[std::move(key)] = std::move(animatedBoneNode);
+	}
+
+	return Animation(std::move(name), duration, ticksPerSecond, std::move(animatedBoneNodes));
+}
+
+}
+
+CookedAssetType cookedAssetType(const byte* data, const size_t size)
+{
+	CookedAssetReader reader(data, size);
+
+	if (size < 4 * sizeof(uint32) || reader.read<uint32>() != COOKED_ASSET_MAGIC) return CookedAssetType::UNKNOWN;
+
+	reader.read<uint32>();
+
+	return static_cast<CookedAssetType>(reader.read<uint32>());
+}
+
+std::vector<byte> cookImage(const graphics::IImage& image)
+{
+	CookedAssetWriter writer;
+	writeHeader(writer, CookedAssetType::IMAGE);
+	writeImage(writer, image);
+
+	return writer.release();
+}
+
+std::vector<byte> cookHeightMap(const HeightMap& heightMap)
+{
+	if (!heightMap.image())
+	{
+		throw RuntimeException("Unable to cook an empty height map.");
+	}
+
+	CookedAssetWriter writer;
+	writeHeader(writer, CookedAssetType::HEIGHT_MAP);
+	writeImage(writer, *heightMap.image());
+
+	return writer.release();
+}
+
+std::vector<byte> cookModel(const Model& model, const std::vector<std::string>& texturePaths)
+{
+	if (texturePaths.size() != model.textures().size())
+	{
+		throw RuntimeException(detail::format("Model '%s' has %s textures but %s texture paths were given.", model.name(), model.textures().size(), texturePaths.size()));
+	}
+
+	CookedAssetWriter writer;
+	writeHeader(writer, CookedAssetType::MODEL);
+
+	writer.writeString(model.name());
+
+	writer.write(static_cast<uint32>(model.meshes().size()));
+	for (size_t i = 0; i < model.meshes().size(); ++i)
+	{
+		writeMesh(writer, model.meshes()[i]);
+
+		if (i < model.levelsOfDetail().size())
+		{
+			const auto& levelsOfDetail = model.levelsOfDetail()[i];
+
+			writer.write(static_cast<uint32>(levelsOfDetail.size()));
+			for (const auto& levelOfDetail : levelsOfDetail)
+			{
+				writeMesh(writer, levelOfDetail);
+			}
+		}
+		else
+		{
+			writer.write(static_cast<uint32>(0));
+		}
+	}
+
+	writer.write(static_cast<uint32>(model.textures().size()));
+	for (size_t i = 0; i < model.textures().size(); ++i)
+	{
+		writer.writeString(model.textures()[i].name());
+		writer.writeString(texturePaths[i]);
+	}
+
+	const auto& skeleton = model.skeleton();
+	writer.writeString(skeleton.name());
+	writer.write(skeleton.globalInverseTransformation());
+	writeBoneNode(writer, skeleton.rootBoneNode());
+
+	writer.write(static_cast<uint32>(model.animations().size()));
+	for (const auto& it : sorted(model.animations()))
+	{
+		writeAnimation(writer, it->second);
+	}
+
+	return writer.release();
+}
+
+std::vector<std::string> cookedModelTexturePaths(const byte* data, const size_t size)
+{
+	CookedAssetReader reader(data, size);
+	readHeader(reader, CookedAssetType::MODEL);
+
+	reader.skipString();
+
+	const auto numberOfMeshes = reader.read<uint32>();
+	for (uint32 i = 0; i < numberOfMeshes; ++i)
+	{
+		skipMesh(reader);
+
+		const auto numberOfLevelsOfDetail = reader.read<uint32>();
+		for (uint32 j = 0; j < numberOfLevelsOfDetail; ++j)
+		{
+			skipMesh(reader);
+		}
+	}
+
+	std::vector<std::string> texturePaths;
+
+	const auto numberOfTextures = reader.read<uint32>();
+	for (uint32 i = 0; i < numberOfTextures; ++i)
+	{
+		reader.skipString();
+		texturePaths.push_back(reader.readString());
+	}
+
+	return texturePaths;
+}
+
+std::unique_ptr<Image> loadImage(const byte* data, const size_t size)
+{
+	CookedAssetReader reader(data, size);
+	readHeader(reader, CookedAssetType::IMAGE);
+
+	return readImage(reader);
+}
+
+HeightMap loadHeightMap(const byte* data, const size_t size)
+{
+	CookedAssetReader reader(data, size);
+	readHeader(reader, CookedAssetType::HEIGHT_MAP);
+
+	return HeightMap(std::unique_ptr<IImage>(readImage(reader)));
+}
+
+std::unique_ptr<Model> loadModel(const byte* data, const size_t size, const std::function<IImage*(const std::string&)>& resolveImage)
+{
+	CookedAssetReader reader(data, size);
+	readHeader(reader, CookedAssetType::MODEL);
+
+	auto name = reader.readString();
+
+	std::vector<Mesh> meshes(reader.readCount(MINIMUM_MESH_SIZE + sizeof(uint32)));
+	std::vector<std::vector<Mesh>> levelsOfDetail(meshes.size());
+	for (size_t i = 0; i < meshes.size(); ++i)
+	{
+		meshes[i] = readMesh(reader);
+
+		levelsOfDetail[i].resize(reader.readCount(MINIMUM_MESH_SIZE));
+		for (auto& levelOfDetail : levelsOfDetail[i])
+		{
+			levelOfDetail = readMesh(reader);
+		}
+	}
+
+	std::vector<Texture> textures;
+	const auto numberOfTextures = reader.readCount(MINIMUM_TEXTURE_SIZE);
+	textures.reserve(numberOfTextures);
+
+	for (uint32 i = 0; i < numberOfTextures; ++i)
+	{
+		auto textureName = reader.readString();
+		const auto texturePath = reader.readString();
+
+		textures.emplace_back(std::move(textureName), texturePath.empty() ? nullptr : resolveImage(texturePath));
+	}
+
+	auto skeletonName = reader.readString();
+	const auto globalInverseTransformation = reader.read<glm::mat4>();
+	auto rootBoneNode = readBoneNode(reader);
+
+	std::unordered_map<std::string, Animation> animations;
+
+	const auto numberOfAnimations = reader.readCount(MINIMUM_ANIMATION_SIZE);
+	for (uint32 i = 0; i < numberOfAnimations; ++i)
+	{
+		auto animation = readAnimation(reader);
+		auto animationName = animation.name();
+		animations[std::move(animationName)] = std::move(animation);
+	}
+
+	return std::make_unique<Model>(
+		std::move(name),
+		std::move(meshes),
+		std::move(textures),
+		Skeleton(std::move(skeletonName), std::move(rootBoneNode), globalInverseTransformation),
+		std::move(animations),
+		std::move(levelsOfDetail)
+	);
+}
+
+}
+}
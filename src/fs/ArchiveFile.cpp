@@ -0,0 +1,90 @@
+#include <sstream>
+
+#include "fs/ArchiveFile.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+#include "exceptions/InvalidOperationException.hpp"
+
+namespace ice_engine
+{
+namespace fs
+{
+
+ArchiveFile::ArchiveFile(std::unique_ptr<IMappedFile> mappedFile, int32 flags) : mappedFile_(std::move(mappedFile))
+{
+	if (!(flags & FileFlags::READ) || flags & (FileFlags::WRITE | FileFlags::APPEND))
+	{
+		throw InvalidArgumentException( std::string("Unable to open file - files in an archive can only be opened in READ mode: ") + mappedFile_->path());
+	}
+
+	inputStream_.open(reinterpret_cast<const char*>(mappedFile_->data()), static_cast<std::size_t>(mappedFile_->size()));
+}
+
+bool ArchiveFile::isOpen() const
+{
+	return inputStream_.is_open();
+}
+
+uint64 ArchiveFile::size() const
+{
+	return mappedFile_->size();
+}
+
+bool ArchiveFile::eof() const
+{
+	return inputStream_.eof();
+}
+
+std::string ArchiveFile::path() const
+{
+	return mappedFile_->path();
+}
+
+void ArchiveFile::close()
+{
+	if (inputStream_.is_open())
+	{
+		inputStream_.close();
+	}
+}
+
+void ArchiveFile::write(const char* data)
+{
+	throw InvalidOperationException( std::string("Unable to write to file - files in an archive are read only.") );
+}
+
+void ArchiveFile::write(const std::string& data)
+{
+	this->write(data.c_str());
+}
+
+std::string ArchiveFile::read(const uint32 length)
+{
+	std::string data(length, '\0');
+
+	inputStream_.read(&data[0], length);
+	data.resize(static_cast<size_t>(inputStream_.gcount()));
+
+	return data;
+}
+
+std::string ArchiveFile::readAll()
+{
+	std::stringstream buffer;
+	buffer << inputStream_.rdbuf();
+
+	return buffer.str();
+}
+
+std::istream& ArchiveFile::getInputStream()
+{
+	return inputStream_;
+}
+
+std::ostream& ArchiveFile::getOutputStream()
+{
+	throw InvalidOperationException( std::string("Unable to get output stream from file - files in an archive are read only.") );
+}
+
+}
+}
@@ -2,6 +2,8 @@
 
 #include "fs/FileSystem.hpp"
 #include "fs/File.hpp"
+#include "fs/MappedFile.hpp"
+#include "fs/ArchiveFile.hpp"
 
 //#include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
@@ -82,6 +84,67 @@ void FileSystem::unmountFile(const std::string& mountPoint)
     mountedFiles_.erase(it);
 }
 
+void FileSystem::mountArchive(const std::string& path, const std::string& mountPoint)
+{
+    if (!boost::filesystem::exists(boost::filesystem::path(path)))
+    {
+        throw FileNotFoundException( std::string("Unable to mount archive '") + path + "' - file does not exist.");
+    }
+    if (boost::filesystem::is_directory(boost::filesystem::path(path)))
+    {
+        throw InvalidArgumentException( std::string("Unable to mount archive '") + path + "' - it's a directory.");
+    }
+
+    const auto it = std::find_if(mountedArchives_.cbegin(), mountedArchives_.cend(), [&path](const MountedArchive& mountedArchive) { return mountedArchive.path == path; });
+
+    if (it != mountedArchives_.cend())
+    {
+        throw InvalidArgumentException( std::string("Unable to mount archive '") + path + "' - archive already mounted.");
+    }
+
+    auto normalizedMountPoint = normalizePackArchivePath(mountPoint);
+    if (!normalizedMountPoint.empty() && normalizedMountPoint.back() != '/')
+    {
+        normalizedMountPoint += '/';
+    }
+
+    mountedArchives_.push_back({path, std::move(normalizedMountPoint), std::make_unique<PackArchive>(path)});
+}
+
+void FileSystem::unmountArchive(const std::string& path)
+{
+    const auto it = std::find_if(mountedArchives_.cbegin(), mountedArchives_.cend(), [&path](const MountedArchive& mountedArchive) { return mountedArchive.path == path; });
+
+    if (it == mountedArchives_.cend())
+    {
+        throw InvalidArgumentException( std::string("Unable to unmount archive '") + path + "' - file is not a mounted archive.");
+    }
+
+    mountedArchives_.erase(it);
+}
+
+const PackArchive* FileSystem::findArchive(const std::string& file, std::string& archivePath) const
+{
+    if (mountedArchives_.empty()) return nullptr;
+
+    const auto normalizedFile = normalizePackArchivePath(file);
+
+    // Most recently mounted archives take precedence, so patch archives override the archives they patch
+    for (auto it = mountedArchives_.crbegin(); it != mountedArchives_.crend(); ++it)
+    {
+        if (normalizedFile.compare(0, it->mountPoint.size(), it->mountPoint) != 0) continue;
+
+        archivePath = normalizedFile.substr(it->mountPoint.size());
+
+        if (it->archive->contains(archivePath))
+        {
+            return it->archive.get();
+        }
+    }
+
+    return nullptr;
+}
+
 boost::filesystem::path FileSystem::findPath(const std::string& file) const
 {
     const auto filePath = boost::filesystem::path(file);
@@ -146,6 +209,9 @@ boost::filesystem::path FileSystem::findPath(const std::string& file) const
 
 bool FileSystem::exists(const std::string& file) const
 {
+    std::string archivePath;
+    if (findArchive(file, archivePath)) return true;
+
     const auto path = findPath(file);
 
     return boost::filesystem::exists(path);
@@ -248,6 +314,9 @@ std::string FileSystem::getFilenameWithoutExtension(const std::string& filename)
 
 std::string FileSystem::getCanonicalPath(const std::string& filename) const
 {
+    std::string archivePath;
+    if (findArchive(filename, archivePath)) return normalizePackArchivePath(filename);
+
     const auto path = findPath(filename);
 
     if (!boost::filesystem::exists(path))
@@ -274,6 +343,14 @@ std::string FileSystem::readAll(const std::string& file, const bool isBinary) co
 
 std::unique_ptr<IFile> FileSystem::open(const std::string& file, int32 flags) const
 {
+    std::string archivePath;
+    if (flags & FileFlags::READ)
+    {
+        const auto archive = findArchive(file, archivePath);
+
+        if (archive) return std::make_unique<ArchiveFile>(archive->map(archivePath), flags);
+    }
+
     const auto path = findPath(file); //, flags);
 
 //    std::cout << "HIMOM ABC " << path << " | " << file << std::endl;
@@ -303,6 +380,28 @@ std::unique_ptr<IFile> FileSystem::open(const std::string& file, int32 flags) co
 	return std::make_unique<File>(path.string(), flags);
 }
 
+std::unique_ptr<IMappedFile> FileSystem::map(const std::string& file) const
+{
+    std::string archivePath;
+    const auto archive = findArchive(file, archivePath);
+
+    if (archive) return archive->map(archivePath);
+
+    const auto path = findPath(file);
+
+    if (!boost::filesystem::exists(path))
+    {
+        throw FileNotFoundException(std::string("Unable to map file - file does not exist: ") + file);
+    }
+
+    if (boost::filesystem::is_directory(path))
+    {
+        throw InvalidArgumentException(std::string("Unable to map file - file is a directory: ") + file);
+    }
+
+    return std::make_unique<MappedFile>(path.string());
+}
+
 std::string FileSystem::generateTempFilename() const
 {
 	const auto tempDirPath = boost::filesystem::temp_directory_path();
@@ -0,0 +1,44 @@
+#include <boost/filesystem.hpp>
+
+#include "fs/MappedFile.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+namespace ice_engine
+{
+namespace fs
+{
+
+MappedFile::MappedFile(const std::string& file) : file_(file)
+{
+	// Mapping an empty file fails, so leave the region empty instead
+	if (boost::filesystem::file_size(file) == 0) return;
+
+	try
+	{
+		fileMapping_ = boost::interprocess::file_mapping(file.c_str(), boost::interprocess::read_only);
+		mappedRegion_ = boost::interprocess::mapped_region(fileMapping_, boost::interprocess::read_only);
+	}
+	catch (const boost::interprocess::interprocess_exception& e)
+	{
+		throw RuntimeException(std::string("Unable to map file '") + file + "': " + e.what());
+	}
+}
+
+const byte* MappedFile::data() const
+{
+	return static_cast<const byte*>(mappedRegion_.get_address());
+}
+
+uint64 MappedFile::size() const
+{
+	return mappedRegion_.get_size();
+}
+
+std::string MappedFile::path() const
+{
+	return file_;
+}
+
+}
+}
@@ -0,0 +1,415 @@
+#include <cstring>
+#include <algorithm>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+
+#include "fs/PackArchive.hpp"
+#include "fs/MappedFile.hpp"
+
+#include "detail/Format.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+#include "exceptions/FileNotFoundException.hpp"
+#include "exceptions/InvalidArgumentException.hpp"
+
+namespace ice_engine
+{
+namespace fs
+{
+
+namespace
+{
+
+const uint32 EMPTY_SLOT = 0;
+
+uint64 alignOffset(const uint64 offset)
+{
+	return (offset + PACK_ARCHIVE_ALIGNMENT - 1) / PACK_ARCHIVE_ALIGNMENT * PACK_ARCHIVE_ALIGNMENT;
+}
+
+uint32 numberOfSlotsFor(const uint32 numberOfEntries)
+{
+	// Keep the table at most half full so probe sequences stay short
+	uint32 numberOfSlots = 1;
+	while (numberOfSlots < numberOfEntries * 2) numberOfSlots <<= 1;
+
+	return numberOfSlots;
+}
+
+/**
+ * Exposes part of an archive's mapping, or the decompressed contents of an entry.
+ */
+class PackArchiveMappedFile : public IMappedFile
+{
+public:
+	PackArchiveMappedFile(std::shared_ptr<MappedFile> mappedFile, const byte* data, const uint64 size, std::string path)
+		:
+		mappedFile_(std::move(mappedFile)),
+		data_(data),
+		size_(size),
+		path_(std::move(path))
+	{
+	}
+
+	PackArchiveMappedFile(std::vector<byte> decompressed, std::string path)
+		:
+		decompressed_(std::move(decompressed)),
+		data_(decompressed_.data()),
+		size_(decompressed_.size()),
+		path_(std::move(path))
+	{
+	}
+
+	const byte* data() const override
+	{
+		return data_;
+	}
+
+	uint64 size() const override
+	{
+		return size_;
+	}
+
+	std::string path() const override
+	{
+		return path_;
+	}
+
+private:
+	std::shared_ptr<MappedFile> mappedFile_;
+	std::vector<byte> decompressed_;
+
+	const byte* data_;
+	uint64 size_;
+	std::string path_;
+};
+
+std::vector<byte> compress(const std::vector<byte>& data)
+{
+	std::string compressed;
+
+	{
+		boost::iostreams::filtering_ostream outputStream;
+		outputStream.push(boost::iostreams::zlib_compressor());
+		outputStream.push(boost::iostreams::back_inserter(compressed));
+		outputStream.write(reinterpret_cast<const char*>(data.data()), data.size());
+	}
+
+	return std::vector<byte>(compressed.begin(), compressed.end());
+}
+
+std::vector<byte> decompress(const byte* data, const uint64 storedSize, const uint64 size, const std::string& path)
+{
+	std::vector<byte> decompressed(size);
+
+	boost::iostreams::filtering_istream inputStream;
+	inputStream.push(boost::iostreams::zlib_decompressor());
+	inputStream.push(boost::iostreams::array_source(reinterpret_cast<const char*>(data), storedSize));
+
+	try
+	{
+		inputStream.read(reinterpret_cast<char*>(decompressed.data()), size);
+	}
+	catch (const boost::iostreams::zlib_error& e)
+	{
+		throw RuntimeException(detail::format("Unable to decompress '%s' from archive: %s", path, e.what()));
+	}
+
+	if (static_cast<uint64>(inputStream.gcount()) != size)
+	{
+		throw RuntimeException(detail::format("Unable to decompress '%s' from archive - data is truncated.", path));
+	}
+
+	return decompressed;
+}
+
+}
+
+std::string normalizePackArchivePath(const std::string& path)
+{
+	std::string normalized;
+	normalized.reserve(path.size());
+
+	for (const auto c : path)
+	{
+		const char character = (c == '\\' ? '/' : c);
+
+		// Skip leading and repeated separators
+		if (character == '/' && (normalized.empty() || normalized.back() == '/')) continue;
+
+		normalized += character;
+
+		// Skip './' path components
+		if (character == '/' && (normalized == "./" || (normalized.size() >= 3 && normalized.compare(normalized.size() - 3, 3, "/./") == 0)))
+		{
+			normalized.resize(normalized.size() - 2);
+		}
+	}
+
+	return normalized;
+}
+
+uint64 packArchivePathHash(const std::string& path)
+{
+	uint64 hash = 14695981039346656037ull;
+
+	for (const auto c : path)
+	{
+		hash ^= static_cast<byte>(c);
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+PackArchive::PackArchive(const std::string& filename) : filename_(filename)
+{
+	mappedFile_ = std::make_shared<MappedFile>(filename);
+
+	const auto data = mappedFile_->data();
+	const auto size = mappedFile_->size();
+
+	if (size < sizeof(PackArchiveHeader))
+	{
+		throw RuntimeException(detail::format("Unable to open archive '%s' - file is too small.", filename));
+	}
+
+	std::memcpy(&header_, data, sizeof(PackArchiveHeader));
+
+	if (header_.magic != PACK_ARCHIVE_MAGIC)
+	{
+		throw RuntimeException(detail::format("Unable to open archive '%s' - not an archive.", filename));
+	}
+	if (header_.version != PACK_ARCHIVE_VERSION)
+	{
+		throw RuntimeException(detail::format("Unable to open archive '%s' - archive has version %s, expected version %s.", filename, header_.version, PACK_ARCHIVE_VERSION));
+	}
+
+	const auto entriesSize = static_cast<uint64>(header_.numberOfEntries) * sizeof(PackArchiveEntry);
+	const auto slotsSize = static_cast<uint64>(header_.numberOfSlots) * sizeof(uint32);
+
+	if (header_.entriesOffset > size || entriesSize > size - header_.entriesOffset
+		|| header_.slotsOffset > size || slotsSize > size - header_.slotsOffset
+		|| header_.pathsOffset > size || header_.pathsSize > size - header_.pathsOffset
+		|| header_.slotsOffset % alignof(uint32) != 0
+		|| header_.numberOfSlots < header_.numberOfEntries || (header_.numberOfSlots & (header_.numberOfSlots - 1)) != 0)
+	{
+		throw RuntimeException(detail::format("Unable to open archive '%s' - index is corrupt.", filename));
+	}
+
+	entries_.resize(header_.numberOfEntries);
+	if (entriesSize > 0) std::memcpy(entries_.data(), data + header_.entriesOffset, entriesSize);
+
+	for (const auto& entry : entries_)
+	{
+		if (entry.offset > size || entry.storedSize > size - entry.offset
+			|| entry.pathOffset > header_.pathsSize || entry.pathLength > header_.pathsSize - entry.pathOffset)
+		{
+			throw RuntimeException(detail::format("Unable to open archive '%s' - index is corrupt.", filename));
+		}
+	}
+
+	slots_ = reinterpret_cast<const uint32*>(data + header_.slotsOffset);
+	paths_ = reinterpret_cast<const char*>(data + header_.pathsOffset);
+}
+
+PackArchive::~PackArchive() = default;
+
+bool PackArchive::contains(const std::string& path) const
+{
+	return find(path) != nullptr;
+}
+
+const PackArchiveEntry* PackArchive::find(const std::string& path) const
+{
+	if (header_.numberOfEntries == 0) return nullptr;
+
+	const auto normalizedPath = normalizePackArchivePath(path);
+	const auto hash = packArchivePathHash(normalizedPath);
+	const auto mask = header_.numberOfSlots - 1;
+
+	for (uint32 i = 0, slot = static_cast<uint32>(hash) & mask; i < header_.numberOfSlots; ++i, slot = (slot + 1) & mask)
+	{
+		const auto index = slots_[slot];
+
+		if (index == EMPTY_SLOT) return nullptr;
+		if (index > entries_.size()) break;
+
+		const auto& entry = entries_[index - 1];
+
+		if (entry.hash == hash && entry.pathLength == normalizedPath.size() && normalizedPath.compare(0, std::string::npos, paths_ + entry.pathOffset, entry.pathLength) == 0)
+		{
+			return &entry;
+		}
+	}
+
+	return nullptr;
+}
+
+std::unique_ptr<IMappedFile> PackArchive::map(const std::string& path) const
+{
+	const auto entry = find(path);
+
+	if (!entry)
+	{
+		throw FileNotFoundException(detail::format("Unable to map file - file does not exist in archive '%s': %s", filename_, path));
+	}
+
+	const auto data = mappedFile_->data() + entry->offset;
+	const auto fullPath = filename_ + ":" + entryPath(*entry);
+
+	switch (entry->compression)
+	{
+		case PackArchiveCompression::NONE:
+			if (entry->storedSize != entry->size)
+			{
+				throw RuntimeException(detail::format("Unable to map file '%s' - index is corrupt.", fullPath));
+			}
+			return std::make_unique<PackArchiveMappedFile>(mappedFile_, data, entry->size, fullPath);
+
+		case PackArchiveCompression::ZLIB:
+			return std::make_unique<PackArchiveMappedFile>(decompress(data, entry->storedSize, entry->size, fullPath), fullPath);
+	}
+
+	throw RuntimeException(detail::format("Unable to map file '%s' - unknown compression %s.", fullPath, static_cast<uint32>(entry->compression)));
+}
+
+std::vector<std::string> PackArchive::paths() const
+{
+	std::vector<std::string> paths;
+	paths.reserve(entries_.size());
+
+	for (const auto& entry : entries_)
+	{
+		paths.push_back(entryPath(entry));
+	}
+
+	return paths;
+}
+
+const std::string& PackArchive::filename() const
+{
+	return filename_;
+}
+
+uint32 PackArchive::size() const
+{
+	return header_.numberOfEntries;
+}
+
+std::string PackArchive::entryPath(const PackArchiveEntry& entry) const
+{
+	return std::string(paths_ + entry.pathOffset, entry.pathLength);
+}
+
+void PackArchiveWriter::add(const std::string& path, std::vector<byte> data, const bool compress)
+{
+	auto normalizedPath = normalizePackArchivePath(path);
+
+	if (normalizedPath.empty())
+	{
+		throw InvalidArgumentException(detail::format("Unable to add '%s' to archive - path is empty.", path));
+	}
+
+	if (paths_.find(normalizedPath) != paths_.end())
+	{
+		throw InvalidArgumentException(detail::format("Unable to add '%s' to archive - path is already in the archive.", path));
+	}
+
+	PendingEntry entry;
+	entry.path = std::move(normalizedPath);
+	entry.size = data.size();
+	entry.compression = PackArchiveCompression::NONE;
+
+	if (compress && !data.empty())
+	{
+		auto compressed = fs::compress(data);
+
+		if (compressed.size() < data.size())
+		{
+			data = std::move(compressed);
+			entry.compression = PackArchiveCompression::ZLIB;
+		}
+	}
+
+	entry.data = std::move(data);
+
+	paths_.insert(entry.path);
+	entries_.push_back(std::move(entry));
+}
+
+void PackArchiveWriter::write(const std::string& filename) const
+{
+	PackArchiveHeader header;
+	header.numberOfEntries = static_cast<uint32>(entries_.size());
+	header.numberOfSlots = numberOfSlotsFor(header.numberOfEntries);
+
+	std::vector<PackArchiveEntry> entries(entries_.size());
+	std::vector<uint32> slots(header.numberOfSlots, EMPTY_SLOT);
+	std::string paths;
+
+	uint64 offset = alignOffset(sizeof(PackArchiveHeader));
+	const auto mask = header.numberOfSlots - 1;
+
+	for (size_t i = 0; i < entries_.size(); ++i)
+	{
+		auto& entry = entries[i];
+		entry.hash = packArchivePathHash(entries_[i].path);
+		entry.offset = offset;
+		entry.size = entries_[i].size;
+		entry.storedSize = entries_[i].data.size();
+		entry.pathOffset = static_cast<uint32>(paths.size());
+		entry.pathLength = static_cast<uint32>(entries_[i].path.size());
+		entry.compression = entries_[i].compression;
+
+		paths += entries_[i].path;
+		offset = alignOffset(offset + entry.storedSize);
+
+		auto slot = static_cast<uint32>(entry.hash) & mask;
+		while (slots[slot] != EMPTY_SLOT) slot = (slot + 1) & mask;
+		slots[slot] = static_cast<uint32>(i + 1);
+	}
+
+	header.entriesOffset = offset;
+	header.slotsOffset = alignOffset(header.entriesOffset + entries.size() * sizeof(PackArchiveEntry));
+	header.pathsOffset = alignOffset(header.slotsOffset + slots.size() * sizeof(uint32));
+	header.pathsSize = paths.size();
+
+	boost::filesystem::ofstream outputStream(boost::filesystem::path(filename), std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (!outputStream)
+	{
+		throw RuntimeException(detail::format("Unable to write archive '%s'.", filename));
+	}
+
+	uint64 position = 0;
+	const auto writeAt = [&outputStream, &position](const uint64 target, const void* data, const uint64 size) {
+		static const char padding[PACK_ARCHIVE_ALIGNMENT] = {};
+		outputStream.write(padding, static_cast<std::streamsize>(target - position));
+		outputStream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		position = target + size;
+	};
+
+	writeAt(0, &header, sizeof(PackArchiveHeader));
+
+	for (size_t i = 0; i < entries_.size(); ++i)
+	{
+		writeAt(entries[i].offset, entries_[i].data.data(), entries_[i].data.size());
+	}
+
+	writeAt(header.entriesOffset, entries.data(), entries.size() * sizeof(PackArchiveEntry));
+	writeAt(header.slotsOffset, slots.data(), slots.size() * sizeof(uint32));
+	writeAt(header.pathsOffset, paths.data(), paths.size());
+
+	if (!outputStream)
+	{
+		throw RuntimeException(detail::format("Unable to write archive '%s'.", filename));
+	}
+}
+
+}
+}
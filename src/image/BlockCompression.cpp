@@ -0,0 +1,418 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "image/BlockCompression.hpp"
+#include "image/ImageProcessing.hpp"
+
+#include "detail/ForEachChunk.hpp"
+#include "detail/Format.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+namespace ice_engine
+{
+namespace image
+{
+
+namespace
+{
+// Enough blocks per task that handing it to a worker is worth it
+constexpr size_t BLOCKS_PER_CHUNK = 1024;
+
+typedef byte Block[16][4];
+
+size_t blockSize(const IImage::Format format)
+{
+	return (format == IImage::Format::FORMAT_BC1 ? 8 : 16);
+}
+
+/**
+ * Copies the 4x4 block of pixels at (blockX, blockY), repeating the last row and column of the image for any part of
+ * the block that hangs over its edge.
+ */
+void loadBlock(const byte* rgba, const uint32 width, const uint32 height, const uint32 blockX, const uint32 blockY, Block& block)
+{
+	for (uint32 y = 0; y < 4; ++y)
+	{
+		const uint32 sourceY = std::min(blockY * 4 + y, height - 1);
+
+		for (uint32 x = 0; x < 4; ++x)
+		{
+			const uint32 sourceX = std::min(blockX * 4 + x, width - 1);
+			std::copy_n(rgba + (static_cast<size_t>(sourceY) * width + sourceX) * 4, 4, block[y * 4 + x]);
+		}
+	}
+}
+
+uint16 toRgb565(const byte* colour)
+{
+	const uint32 r = (colour[0] * 31u + 127u) / 255u;
+	const uint32 g = (colour[1] * 63u + 127u) / 255u;
+	const uint32 b = (colour[2] * 31u + 127u) / 255u;
+
+	return static_cast<uint16>((r << 11) | (g << 5) | b);
+}
+
+void fromRgb565(const uint16 colour, int32 (&rgb)[3])
+{
+	const int32 r = (colour >> 11) & 31;
+	const int32 g = (colour >> 5) & 63;
+	const int32 b = colour & 31;
+
+	rgb[0] = (r << 3) | (r >> 2);
+	rgb[1] = (g << 2) | (g >> 4);
+	rgb[2] = (b << 3) | (b >> 2);
+}
+
+void writeLittleEndian(byte* destination, const uint64 value, const uint32 bytes)
+{
+	for (uint32 i = 0; i < bytes; ++i)
+	{
+		destination[i] = static_cast<byte>(value >> (8 * i));
+	}
+}
+
+/**
+ * Encodes the colour of a block as BC1, into 8 bytes.
+ */
+void encodeColourBlock(const Block& block, byte* destination)
+{
+	float32 mean[3] = {0.0f, 0.0f, 0.0f};
+	for (const auto& pixel : block)
+	{
+		for (uint32 c = 0; c < 3; ++c) mean[c] += pixel[c];
+	}
+	for (auto& value : mean) value /= 16.0f;
+
+	// rr, rg, rb, gg, gb, bb
+	float32 covariance[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+	for (const auto& pixel : block)
+	{
+		const float32 r = pixel[0] - mean[0];
+		const float32 g = pixel[1] - mean[1];
+		const float32 b = pixel[2] - mean[2];
+
+		covariance[0] += r * r;
+		covariance[1] += r * g;
+		covariance[2] += r * b;
+		covariance[3] += g * g;
+		covariance[4] += g * b;
+		covariance[5] += b * b;
+	}
+
+	// The principal axis, by power iteration from the column of the channel that varies most
+	float32 axis[3];
+	if (covariance[0] >= covariance[3] && covariance[0] >= covariance[5])
+	{
+		axis[0] = covariance[0]; axis[1] = covariance[1]; axis[2] = covariance[2];
+	}
+	else if (covariance[3] >= covariance[5])
+	{
+		axis[0] = covariance[1]; axis[1] = covariance[3]; axis[2] = covariance[4];
+	}
+	else
+	{
+		axis[0] = covariance[2]; axis[1] = covariance[4]; axis[2] = covariance[5];
+	}
+
+	for (uint32 iteration = 0; iteration < 4; ++iteration)
+	{
+		const float32 r = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+		const float32 g = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+		const float32 b = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+
+		const float32 largest = std::max(std::abs(r), std::max(std::abs(g), std::abs(b)));
+		if (largest == 0.0f) break;
+
+		axis[0] = r / largest;
+		axis[1] = g / largest;
+		axis[2] = b / largest;
+	}
+
+	// The endpoints are the pixels furthest apart along the axis
+	uint32 minimumIndex = 0;
+	uint32 maximumIndex = 0;
+	float32 minimum = std::numeric_limits<float32>::max();
+	float32 maximum = std::numeric_limits<float32>::lowest();
+
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		const float32 projection = block[i][0] * axis[0] + block[i][1] * axis[1] + block[i][2] * axis[2];
+
+		if (projection < minimum)
+		{
+			minimum = projection;
+			minimumIndex = i;
+		}
+		if (projection > maximum)
+		{
+			maximum = projection;
+			maximumIndex = i;
+		}
+	}
+
+	uint16 colour0 = toRgb565(block[maximumIndex]);
+	uint16 colour1 = toRgb565(block[minimumIndex]);
+
+	// colour0 > colour1 picks the 4 colour mode
+	if (colour0 < colour1) std::swap(colour0, colour1);
+
+	uint32 indices = 0;
+
+	if (colour0 != colour1)
+	{
+		int32 palette[4][3];
+		fromRgb565(colour0, palette[0]);
+		fromRgb565(colour1, palette[1]);
+
+		for (uint32 c = 0; c < 3; ++c)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			uint32 best = 0;
+			int32 bestDistance = std::numeric_limits<int32>::max();
+
+			for (uint32 j = 0; j < 4; ++j)
+			{
+				const int32 r = block[i][0] - palette[j][0];
+				const int32 g = block[i][1] - palette[j][1];
+				const int32 b = block[i][2] - palette[j][2];
+				const int32 distance = r * r + g * g + b * b;
+
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = j;
+				}
+			}
+
+			indices |= best << (2 * i);
+		}
+	}
+
+	writeLittleEndian(destination, colour0, 2);
+	writeLittleEndian(destination + 2, colour1, 2);
+	writeLittleEndian(destination + 4, indices, 4);
+}
+
+/**
+ * Encodes one channel of a block as BC4 (the alpha of BC3, or either channel of BC5), into 8 bytes.
+ */
+void encodeChannelBlock(const Block& block, const uint32 channel, byte* destination)
+{
+	int32 minimum = 255;
+	int32 maximum = 0;
+
+	for (const auto& pixel : block)
+	{
+		minimum = std::min<int32>(minimum, pixel[channel]);
+		maximum = std::max<int32>(maximum, pixel[channel]);
+	}
+
+	uint64 indices = 0;
+
+	// maximum > minimum picks the 8 value mode
+	if (maximum != minimum)
+	{
+		int32 palette[8] = {maximum, minimum};
+		for (int32 i = 1; i < 7; ++i)
+		{
+			palette[i + 1] = ((7 - i) * maximum + i * minimum + 3) / 7;
+		}
+
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			uint64 best = 0;
+			int32 bestDistance = std::numeric_limits<int32>::max();
+
+			for (uint32 j = 0; j < 8; ++j)
+			{
+				const int32 distance = std::abs(block[i][channel] - palette[j]);
+
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = j;
+				}
+			}
+
+			indices |= best << (3 * i);
+		}
+	}
+
+	destination[0] = static_cast<byte>(maximum);
+	destination[1] = static_cast<byte>(minimum);
+	writeLittleEndian(destination + 2, indices, 6);
+}
+}
+
+IImage::Format formatFromString(const std::string& format)
+{
+	if (format == "rgb") return IImage::Format::FORMAT_RGB;
+	if (format == "rgba") return IImage::Format::FORMAT_RGBA;
+	if (format == "bc1") return IImage::Format::FORMAT_BC1;
+	if (format == "bc3") return IImage::Format::FORMAT_BC3;
+	if (format == "bc5") return IImage::Format::FORMAT_BC5;
+
+	throw InvalidArgumentException(detail::format("Unknown image format '%s'.", format));
+}
+
+bool isBlockCompressed(const IImage::Format format)
+{
+	return format == IImage::Format::FORMAT_BC1 || format == IImage::Format::FORMAT_BC3 || format == IImage::Format::FORMAT_BC5;
+}
+
+size_t imageSize(const IImage::Format format, const uint32 width, const uint32 height)
+{
+	switch (format)
+	{
+		case IImage::Format::FORMAT_RGB:
+			return static_cast<size_t>(width) * height * 3;
+
+		case IImage::Format::FORMAT_RGBA:
+			return static_cast<size_t>(width) * height * 4;
+
+		case IImage::Format::FORMAT_BC1:
+		case IImage::Format::FORMAT_BC3:
+		case IImage::Format::FORMAT_BC5:
+			return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * blockSize(format);
+
+		case IImage::Format::FORMAT_UNKNOWN:
+		default:
+			throw InvalidArgumentException(detail::format("Unable to work out the size of an image with format %s.", static_cast<int32>(format)));
+	}
+}
+
+void compress(
+	const byte* rgba,
+	const uint32 width,
+	const uint32 height,
+	const IImage::Format format,
+	std::vector<byte>& result,
+	IThreadPool* threadPool
+)
+{
+	if (!isBlockCompressed(format))
+	{
+		throw InvalidArgumentException(detail::format("Unable to block compress into format %s.", static_cast<int32>(format)));
+	}
+	if (width == 0 || height == 0)
+	{
+		throw InvalidArgumentException(detail::format("Unable to block compress a %sx%s image.", width, height));
+	}
+
+	const uint32 blocksWide = (width + 3) / 4;
+	const uint32 blocksHigh = (height + 3) / 4;
+	const size_t size = blockSize(format);
+
+	result.resize(imageSize(format, width, height));
+
+	byte* destination = result.data();
+
+	detail::forEachChunk(threadPool, blocksHigh, std::max<size_t>(1, BLOCKS_PER_CHUNK / blocksWide), [=](const size_t chunk, const size_t begin, const size_t end) {
+		Block block;
+
+		for (size_t blockY = begin; blockY < end; ++blockY)
+		{
+			for (uint32 blockX = 0; blockX < blocksWide; ++blockX)
+			{
+				loadBlock(rgba, width, height, blockX, static_cast<uint32>(blockY), block);
+
+				byte* blockDestination = destination + (blockY * blocksWide + blockX) * size;
+
+				switch (format)
+				{
+					case IImage::Format::FORMAT_BC1:
+						encodeColourBlock(block, blockDestination);
+						break;
+
+					case IImage::Format::FORMAT_BC3:
+						encodeChannelBlock(block, 3, blockDestination);
+						encodeColourBlock(block, blockDestination + 8);
+						break;
+
+					case IImage::Format::FORMAT_BC5:
+					default:
+						encodeChannelBlock(block, 0, blockDestination);
+						encodeChannelBlock(block, 1, blockDestination + 8);
+						break;
+				}
+			}
+		}
+	});
+}
+
+std::unique_ptr<Image> createTextureImage(const graphics::IImage& image, const IImage::Format format, IThreadPool* threadPool)
+{
+	const auto sourceFormat = image.format();
+	const auto width = image.width();
+	const auto height = image.height();
+
+	if (sourceFormat != IImage::Format::FORMAT_RGB && sourceFormat != IImage::Format::FORMAT_RGBA)
+	{
+		throw InvalidArgumentException(detail::format("Unable to create a texture image from an image with format %s.", sourceFormat));
+	}
+	if (format == IImage::Format::FORMAT_UNKNOWN)
+	{
+		throw InvalidArgumentException("Unable to create a texture image with an unknown format.");
+	}
+	if (width == 0 || height == 0 || image.data().size() < imageSize(static_cast<IImage::Format>(sourceFormat), width, height))
+	{
+		throw InvalidArgumentException(detail::format("Image data is too small for a %sx%s image.", width, height));
+	}
+
+	// Mips are made from RGB pixels for an RGB texture, and from RGBA pixels for everything else
+	const auto pixelFormat = (format == IImage::Format::FORMAT_RGB ? IImage::Format::FORMAT_RGB : IImage::Format::FORMAT_RGBA);
+	const uint32 pixelSize = (pixelFormat == IImage::Format::FORMAT_RGB ? 3 : 4);
+	const size_t pixelCount = static_cast<size_t>(width) * height;
+
+	std::vector<std::vector<byte>> levels(1);
+
+	if (sourceFormat == pixelFormat)
+	{
+		levels[0].assign(image.data().begin(), image.data().begin() + pixelCount * pixelSize);
+	}
+	else if (pixelFormat == IImage::Format::FORMAT_RGBA)
+	{
+		levels[0].resize(pixelCount * 4);
+		rgbToRgba(image.data().data(), levels[0].data(), pixelCount, threadPool);
+	}
+	else
+	{
+		levels[0].resize(pixelCount * 3);
+		rgbaToRgb(image.data().data(), levels[0].data(), pixelCount, threadPool);
+	}
+
+	for (uint32 levelWidth = width, levelHeight = height; levelWidth > 1 || levelHeight > 1; )
+	{
+		std::vector<byte> level;
+		downsample(levels.back().data(), levelWidth, levelHeight, pixelSize, level, threadPool);
+		levels.push_back(std::move(level));
+
+		levelWidth = std::max<uint32>(1, levelWidth / 2);
+		levelHeight = std::max<uint32>(1, levelHeight / 2);
+	}
+
+	if (isBlockCompressed(format))
+	{
+		for (uint32 i = 0; i < levels.size(); ++i)
+		{
+			std::vector<byte> compressed;
+			compress(levels[i].data(), std::max<uint32>(1, width >> i), std::max<uint32>(1, height >> i), format, compressed, threadPool);
+			levels[i] = std::move(compressed);
+		}
+	}
+
+	auto data = std::move(levels[0]);
+	levels.erase(levels.begin());
+
+	return std::make_unique<Image>(std::move(data), width, height, format, std::move(levels));
+}
+
+}
+}
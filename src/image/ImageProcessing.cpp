@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <cmath>
+
+#include "image/ImageProcessing.hpp"
+
+#include "detail/ForEachChunk.hpp"
+#include "detail/Format.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+namespace ice_engine
+{
+namespace image
+{
+
+namespace
+{
+// Enough pixels per task that handing it to a worker is worth it
+constexpr size_t PIXELS_PER_CHUNK = 64 * 1024;
+
+size_t rowsPerChunk(const uint32 width)
+{
+	return std::max<size_t>(1, PIXELS_PER_CHUNK / std::max<uint32>(1, width));
+}
+
+/**
+ * Fills heights with row z of the heights stored in alpha, as floats in [0, 1], with the last column copied in front
+ * and the first copied behind so the filter can read one past either edge without wrapping its index.
+ */
+void loadHeightRow(const byte* rgba, const uint32 width, const uint32 z, std::vector<float32>& heights)
+{
+	const byte* row = rgba + static_cast<size_t>(z) * width * 4;
+	float32* rowHeights = heights.data() + 1;
+
+	for (size_t i = 0; i < width; ++i)
+	{
+		rowHeights[i] = static_cast<float32>(row[i * 4 + 3]) / 255.0f;
+	}
+
+	heights[0] = heights[width];
+	heights[width + 1] = heights[1];
+}
+
+byte normalToByte(const float32 value)
+{
+	return static_cast<byte>((value + 1.0f) * (255.0f / 2.0f));
+}
+
+byte average(const byte a, const byte b, const byte c, const byte d)
+{
+	return static_cast<byte>((static_cast<uint32>(a) + b + c + d + 2) / 4);
+}
+
+/**
+ * Box filters one row of the smaller image from two rows of the larger one.  The pixel size is a template parameter so
+ * the channel loop unrolls and the row loop can be vectorised.
+ */
+template<uint32 PixelSize>
+void downsampleRow(const byte* top, const byte* bottom, const size_t nextColumn, const uint32 resultWidth, byte* resultRow)
+{
+	for (size_t i = 0; i < resultWidth; ++i)
+	{
+		for (size_t c = 0; c < PixelSize; ++c)
+		{
+			const size_t k = i * 2 * PixelSize + c;
+			resultRow[i * PixelSize + c] = average(top[k], top[k + nextColumn], bottom[k], bottom[k + nextColumn]);
+		}
+	}
+}
+}
+
+void swapRedAndBlue(byte* pixels, const size_t pixelCount, const uint32 pixelSize, IThreadPool* threadPool)
+{
+	if (pixelSize != 3 && pixelSize != 4)
+	{
+		throw InvalidArgumentException(detail::format("Unable to swap red and blue in pixels of %s bytes.", pixelSize));
+	}
+
+	detail::forEachChunk(threadPool, pixelCount, PIXELS_PER_CHUNK, [pixels, pixelSize](const size_t chunk, const size_t begin, const size_t end) {
+		// Local pointers, since the compiler has to assume a byte store could change anything captured
+		byte* chunkPixels = pixels + begin * pixelSize;
+		const size_t count = end - begin;
+
+		// A separate loop for each pixel size so the stride is known at compile time
+		if (pixelSize == 4)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const byte red = chunkPixels[i * 4 + 2];
+				chunkPixels[i * 4 + 2] = chunkPixels[i * 4 + 0];
+				chunkPixels[i * 4 + 0] = red;
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const byte red = chunkPixels[i * 3 + 2];
+				chunkPixels[i * 3 + 2] = chunkPixels[i * 3 + 0];
+				chunkPixels[i * 3 + 0] = red;
+			}
+		}
+	});
+}
+
+void rgbToRgba(const byte* rgb, byte* rgba, const size_t pixelCount, IThreadPool* threadPool)
+{
+	detail::forEachChunk(threadPool, pixelCount, PIXELS_PER_CHUNK, [rgb, rgba](const size_t chunk, const size_t begin, const size_t end) {
+		const byte* in = rgb + begin * 3;
+		byte* out = rgba + begin * 4;
+		const size_t count = end - begin;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i * 4 + 0] = in[i * 3 + 0];
+			out[i * 4 + 1] = in[i * 3 + 1];
+			out[i * 4 + 2] = in[i * 3 + 2];
+			out[i * 4 + 3] = 255;
+		}
+	});
+}
+
+void rgbaToRgb(const byte* rgba, byte* rgb, const size_t pixelCount, IThreadPool* threadPool)
+{
+	detail::forEachChunk(threadPool, pixelCount, PIXELS_PER_CHUNK, [rgba, rgb](const size_t chunk, const size_t begin, const size_t end) {
+		const byte* in = rgba + begin * 4;
+		byte* out = rgb + begin * 3;
+		const size_t count = end - begin;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i * 3 + 0] = in[i * 4 + 0];
+			out[i * 3 + 1] = in[i * 4 + 1];
+			out[i * 3 + 2] = in[i * 4 + 2];
+		}
+	});
+}
+
+void luminanceToAlpha(byte* rgba, const size_t pixelCount, IThreadPool* threadPool)
+{
+	detail::forEachChunk(threadPool, pixelCount, PIXELS_PER_CHUNK, [rgba](const size_t chunk, const size_t begin, const size_t end) {
+		byte* pixels = rgba + begin * 4;
+		const size_t count = end - begin;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint32 sum = static_cast<uint32>(pixels[i * 4 + 0]) + pixels[i * 4 + 1] + pixels[i * 4 + 2];
+			pixels[i * 4 + 3] = static_cast<byte>(sum / 3);
+		}
+	});
+}
+
+// Source:
+// https://stackoverflow.com/questions/2368728/can-normal-maps-be-generated-from-a-texture
+// and
+// http://www.catalinzima.com/2008/01/converting-displacement-maps-into-normal-maps/
+void sobelNormals(byte* rgba, const uint32 width, const uint32 height, const float32 strength, IThreadPool* threadPool)
+{
+	// Only alpha is read and only red, green and blue are written, so rows can be done in any order
+	detail::forEachChunk(threadPool, height, rowsPerChunk(width), [rgba, width, height, strength](const size_t chunk, const size_t begin, const size_t end) {
+		std::vector<float32> below(width + 2);
+		std::vector<float32> middle(width + 2);
+		std::vector<float32> above(width + 2);
+
+		const float32 dZ = 1.0f / strength;
+
+		loadHeightRow(rgba, width, begin == 0 ? height - 1 : static_cast<uint32>(begin - 1), below);
+		loadHeightRow(rgba, width, static_cast<uint32>(begin), middle);
+
+		for (size_t z = begin; z < end; ++z)
+		{
+			loadHeightRow(rgba, width, z + 1 == height ? 0 : static_cast<uint32>(z + 1), above);
+
+			byte* row = rgba + z * width * 4;
+			const float32* aboveHeights = above.data();
+			const float32* middleHeights = middle.data();
+			const float32* belowHeights = below.data();
+			const size_t rowWidth = width;
+
+			for (size_t i = 0; i < rowWidth; ++i)
+			{
+				const float32 tl = aboveHeights[i];
+				const float32  t = aboveHeights[i + 1];
+				const float32 tr = aboveHeights[i + 2];
+				const float32  l = middleHeights[i];
+				const float32  r = middleHeights[i + 2];
+				const float32 bl = belowHeights[i];
+				const float32  b = belowHeights[i + 1];
+				const float32 br = belowHeights[i + 2];
+
+				const float32 dX = (tr + 2.0f * r + br) - (tl + 2.0f * l + bl);
+				const float32 dY = (bl + 2.0f * b + br) - (tl + 2.0f * t + tr);
+				const float32 inverseLength = 1.0f / std::sqrt(dX * dX + dY * dY + dZ * dZ);
+
+				row[i * 4 + 0] = normalToByte(dX * inverseLength);
+				row[i * 4 + 1] = normalToByte(dY * inverseLength);
+				row[i * 4 + 2] = normalToByte(dZ * inverseLength);
+			}
+
+			std::swap(below, middle);
+			std::swap(middle, above);
+		}
+	});
+}
+
+void downsample(
+	const byte* pixels,
+	const uint32 width,
+	const uint32 height,
+	const uint32 pixelSize,
+	std::vector<byte>& result,
+	IThreadPool* threadPool
+)
+{
+	if (width == 0 || height == 0 || pixelSize == 0)
+	{
+		throw InvalidArgumentException(detail::format("Unable to downsample a %sx%s image with %s bytes per pixel.", width, height, pixelSize));
+	}
+
+	const uint32 resultWidth = std::max<uint32>(1, width / 2);
+	const uint32 resultHeight = std::max<uint32>(1, height / 2);
+	const size_t rowSize = static_cast<size_t>(width) * pixelSize;
+	const size_t resultRowSize = static_cast<size_t>(resultWidth) * pixelSize;
+
+	result.resize(resultRowSize * resultHeight);
+
+	byte* resultPixels = result.data();
+
+	detail::forEachChunk(threadPool, resultHeight, rowsPerChunk(resultWidth), [=](const size_t chunk, const size_t begin, const size_t end) {
+		// A 1 wide (or high) image averages each pixel with itself along that side
+		const size_t nextColumn = (width > 1 ? pixelSize : 0);
+
+		for (size_t j = begin; j < end; ++j)
+		{
+			const byte* top = pixels + (j * 2) * rowSize;
+			const byte* bottom = (height > 1 ? top + rowSize : top);
+			byte* resultRow = resultPixels + j * resultRowSize;
+
+			switch (pixelSize)
+			{
+				case 1:
+					downsampleRow<1>(top, bottom, nextColumn, resultWidth, resultRow);
+					break;
+
+				case 3:
+					downsampleRow<3>(top, bottom, nextColumn, resultWidth, resultRow);
+					break;
+
+				case 4:
+					downsampleRow<4>(top, bottom, nextColumn, resultWidth, resultRow);
+					break;
+
+				default:
+					for (size_t i = 0; i < resultRowSize; ++i)
+					{
+						const size_t k = (i / pixelSize) * 2 * pixelSize + i % pixelSize;
+						resultRow[i] = average(top[k], top[k + nextColumn], bottom[k], bottom[k + nextColumn]);
+					}
+					break;
+			}
+		}
+	});
+}
+
+}
+}
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "mesh/LevelOfDetail.hpp"
+#include "mesh/MeshSimplification.hpp"
+
+#include "detail/Format.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+namespace ice_engine
+{
+namespace mesh
+{
+
+std::vector<Mesh> generateLevelsOfDetail(const Mesh& mesh, const LevelOfDetailOptions& options)
+{
+	if (options.reduction <= 0.0f || options.reduction >= 1.0f)
+	{
+		throw InvalidArgumentException(detail::format("Level of detail reduction must be between 0 and 1 (was %s).", options.reduction));
+	}
+
+	std::vector<Mesh> levelsOfDetail;
+
+	if (mesh.vertices().empty()) return levelsOfDetail;
+
+	const auto levelCount = std::min(options.levelCount, MAXIMUM_LEVELS_OF_DETAIL - 1);
+	levelsOfDetail.reserve(levelCount);
+
+	const std::vector<uint32>* previousIndices = &mesh.indices();
+
+	for (uint32 level = 0; level < levelCount; ++level)
+	{
+		const auto previousTriangleCount = previousIndices->size() / 3;
+		const auto targetTriangleCount = static_cast<size_t>(previousTriangleCount * options.reduction);
+
+		auto indices = simplify(*previousIndices, mesh.vertices(), targetTriangleCount * 3, options.maximumError);
+
+		// Not worth drawing if it saves less than half of what it should
+		if (indices.empty() || indices.size() / 3 > (previousTriangleCount + targetTriangleCount) / 2) break;
+
+		levelsOfDetail.push_back(Mesh(
+			mesh.name(),
+			mesh.vertices(),
+			std::move(indices),
+			mesh.colors(),
+			mesh.normals(),
+			mesh.textureCoordinates(),
+			mesh.vertexBoneData(),
+			mesh.boneData()
+		));
+
+		previousIndices = &levelsOfDetail.back().indices();
+	}
+
+	return levelsOfDetail;
+}
+
+float32 screenSize(const float32 radius, const float32 distance, const float32 fieldOfView)
+{
+	if (distance <= radius) return std::numeric_limits<float32>::max();
+
+	return radius / (distance * std::tan(fieldOfView * 0.5f));
+}
+
+uint32 selectLevelOfDetail(
+	const std::vector<float32>& screenSizes,
+	const uint32 levelCount,
+	const float32 screenSize,
+	const uint32 levelOfDetail,
+	const float32 hysteresis
+)
+{
+	if (levelCount == 0) return 0;
+
+	const auto lowestLevel = std::min(levelCount - 1, static_cast<uint32>(screenSizes.size()));
+	const auto current = std::min(levelOfDetail, lowestLevel);
+
+	auto level = current;
+	while (level < lowestLevel && screenSize < screenSizes[level] * (1.0f - hysteresis))
+	{
+		++level;
+	}
+
+	if (level != current) return level;
+
+	while (level > 0 && screenSize > screenSizes[level - 1] * (1.0f + hysteresis))
+	{
+		--level;
+	}
+
+	return level;
+}
+
+}
+}
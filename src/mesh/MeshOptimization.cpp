@@ -0,0 +1,797 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#include "mesh/MeshOptimization.hpp"
+
+#include "detail/Format.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+namespace ice_engine
+{
+namespace mesh
+{
+
+namespace
+{
+// Scoring from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+constexpr uint32 CACHE_SIZE = 32;
+constexpr uint32 MAXIMUM_VALENCE = 32;
+constexpr float32 CACHE_DECAY_POWER = 1.5f;
+constexpr float32 LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float32 VALENCE_BOOST_SCALE = 2.0f;
+constexpr float32 VALENCE_BOOST_POWER = 0.5f;
+
+// The cache size the overdraw optimizer measures against, which is about what hardware has
+constexpr uint32 SIMULATED_CACHE_SIZE = 16;
+
+constexpr uint32 INVALID_TRIANGLE = ~0u;
+
+void validateIndices(const std::vector<uint32>& indices, const uint32 vertexCount)
+{
+	if (indices.size() % 3 != 0)
+	{
+		throw InvalidArgumentException(detail::format("Number of indices (%s) is not a multiple of 3.", indices.size()));
+	}
+
+	for (const auto index : indices)
+	{
+		if (index >= vertexCount)
+		{
+			throw InvalidArgumentException(detail::format("Index %s is out of range for %s vertices.", index, vertexCount));
+		}
+	}
+}
+
+/**
+ * A FIFO post transform cache, where a vertex is cached if fewer than cacheSize misses have happened since its own.
+ */
+class CacheSimulation
+{
+public:
+	CacheSimulation(const uint32 vertexCount, const uint32 cacheSize)
+	:
+		cacheSize_(cacheSize),
+		time_(cacheSize + 1),
+		timestamps_(vertexCount, 0)
+	{
+	}
+
+	uint32 triangleMisses(const uint32* triangle)
+	{
+		uint32 misses = 0;
+
+		for (uint32 i = 0; i < 3; ++i)
+		{
+			if (time_ - timestamps_[triangle[i]] > cacheSize_)
+			{
+				timestamps_[triangle[i]] = time_++;
+				++misses;
+			}
+		}
+
+		return misses;
+	}
+
+	void clear()
+	{
+		time_ += cacheSize_ + 1;
+	}
+
+private:
+	uint32 cacheSize_;
+	uint32 time_;
+	std::vector<uint32> timestamps_;
+};
+
+class VertexScoreTable
+{
+public:
+	VertexScoreTable()
+	{
+		for (uint32 i = 0; i < CACHE_SIZE; ++i)
+		{
+			if (i < 3)
+			{
+				// The vertices of the triangle just drawn are scored the same, so the next triangle isn't chosen by which
+				// of them happens to be first
+				cache_[i] = LAST_TRIANGLE_SCORE;
+			}
+			else
+			{
+				cache_[i] = std::pow(1.0f - static_cast<float32>(i - 3) / (CACHE_SIZE - 3), CACHE_DECAY_POWER);
+			}
+		}
+
+		valence_[0] = 0.0f;
+		for (uint32 i = 1; i <= MAXIMUM_VALENCE; ++i)
+		{
+			valence_[i] = VALENCE_BOOST_SCALE * std::pow(static_cast<float32>(i), -VALENCE_BOOST_POWER);
+		}
+	}
+
+	float32 score(const int32 cachePosition, const uint32 remainingTriangles) const
+	{
+		if (remainingTriangles == 0) return -1.0f;
+
+		// Vertices with few triangles left are boosted, so they get finished off rather than left as lone triangles
+		const float32 score = valence_[std::min(remainingTriangles, MAXIMUM_VALENCE)];
+
+		return (cachePosition >= 0 ? score + cache_[cachePosition] : score);
+	}
+
+private:
+	float32 cache_[CACHE_SIZE];
+	float32 valence_[MAXIMUM_VALENCE + 1];
+};
+
+template<typename T>
+std::vector<T> remapVertices(const std::vector<T>& values, const std::vector<uint32>& remap, const uint32 vertexCount)
+{
+	if (values.empty()) return values;
+
+	std::vector<T> result(vertexCount);
+
+	for (size_t i = 0; i < remap.size(); ++i)
+	{
+		if (remap[i] != INVALID_VERTEX) result[remap[i]] = values[i];
+	}
+
+	return result;
+}
+
+/**
+ * Converts to a half float, rounding to nearest even.  Values too large for a half become infinity.
+ */
+uint16 toFloat16(const float32 value)
+{
+	uint32 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	const uint32 sign = (bits >> 16) & 0x8000;
+	const uint32 magnitude = bits & 0x7FFFFFFF;
+
+	// NaN stays NaN, and infinity and anything too large for a half becomes infinity
+	if (magnitude >= 0x7F800000) return static_cast<uint16>(sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x200 : 0));
+	if (magnitude >= 0x477FF000) return static_cast<uint16>(sign | 0x7C00);
+
+	// Too small even for a denormal half
+	if (magnitude < 0x33000000) return static_cast<uint16>(sign);
+
+	const int32 exponent = static_cast<int32>(magnitude >> 23) - 127;
+
+	if (exponent < -14)
+	{
+		// Denormal half - shift the mantissa, with its implicit 1, down into place
+		const uint32 mantissa = (magnitude & 0x7FFFFF) | 0x800000;
+		const uint32 shift = static_cast<uint32>(-exponent - 1);
+		const uint32 half = mantissa >> shift;
+		const uint32 remainder = mantissa & ((1u << shift) - 1);
+		const uint32 midpoint = 1u << (shift - 1);
+
+		return static_cast<uint16>(sign | (half + (remainder > midpoint || (remainder == midpoint && (half & 1)) ? 1 : 0)));
+	}
+
+	// Rebias the exponent and round the mantissa from 23 to 10 bits, letting a carry spill into the exponent
+	const uint32 half = ((static_cast<uint32>(exponent + 15) << 10) | ((magnitude >> 13) & 0x3FF));
+	const uint32 remainder = magnitude & 0x1FFF;
+
+	return static_cast<uint16>(sign | (half + (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)) ? 1 : 0)));
+}
+
+int8 toSnorm8(const float32 value)
+{
+	return static_cast<int8>(std::round(std::max(-1.0f, std::min(1.0f, value)) * 127.0f));
+}
+
+byte toUnorm8(const float32 value)
+{
+	return static_cast<byte>(std::round(std::max(0.0f, std::min(1.0f, value)) * 255.0f));
+}
+
+/**
+ * Quantizes bone weights to 8 bits each, normalized so that they still add up to exactly 1.
+ */
+void quantizeBoneWeights(const glm::vec4& weights, byte* destination)
+{
+	const float32 sum = weights[0] + weights[1] + weights[2] + weights[3];
+
+	if (sum <= 0.0f)
+	{
+		std::fill_n(destination, 4, 0);
+		return;
+	}
+
+	int32 total = 0;
+	uint32 largest = 0;
+
+	for (uint32 i = 0; i < 4; ++i)
+	{
+		destination[i] = toUnorm8(weights[i] / sum);
+		total += destination[i];
+
+		if (weights[i] > weights[largest]) largest = i;
+	}
+
+	// Rounding is put right on the largest weight, where it makes the least difference
+	destination[largest] = static_cast<byte>(destination[largest] + 255 - total);
+}
+
+uint32 attributeSize(const graphics::VertexAttributeFormat format)
+{
+	switch (format)
+	{
+		case graphics::VertexAttributeFormat::FLOAT32_3:
+			return 12;
+
+		case graphics::VertexAttributeFormat::UINT16_4:
+			return 8;
+
+		default:
+			return 4;
+	}
+}
+
+template<typename T>
+void checkStreamSize(const std::vector<T>& values, const size_t vertexCount, const char* streamName)
+{
+	if (!values.empty() && values.size() != vertexCount)
+	{
+		throw InvalidArgumentException(detail::format("Mesh has %s %s for %s vertices.", values.size(), streamName, vertexCount));
+	}
+}
+
+template<typename T>
+void writeValue(byte* destination, const T& value)
+{
+	std::memcpy(destination, &value, sizeof(T));
+}
+}
+
+float32 averageCacheMissRatio(const std::vector<uint32>& indices, const uint32 vertexCount, const uint32 cacheSize)
+{
+	validateIndices(indices, vertexCount);
+
+	if (indices.empty()) return 0.0f;
+
+	CacheSimulation cache(vertexCount, cacheSize);
+	uint32 misses = 0;
+
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		misses += cache.triangleMisses(&indices[i]);
+	}
+
+	return static_cast<float32>(misses) / static_cast<float32>(indices.size() / 3);
+}
+
+void optimizeVertexCache(std::vector<uint32>& indices, const uint32 vertexCount)
+{
+	validateIndices(indices, vertexCount);
+
+	const auto triangleCount = static_cast<uint32>(indices.size() / 3);
+
+	if (triangleCount == 0) return;
+
+	static const VertexScoreTable scoreTable;
+
+	// The triangles of each vertex, with the ones not drawn yet at the front of each list
+	std::vector<uint32> remainingTriangles(vertexCount, 0);
+	for (const auto index : indices) ++remainingTriangles[index];
+
+	std::vector<uint32> triangleOffsets(vertexCount + 1, 0);
+	std::partial_sum(remainingTriangles.begin(), remainingTriangles.end(), triangleOffsets.begin() + 1);
+
+	std::vector<uint32> vertexTriangles(indices.size());
+	{
+		std::vector<uint32> fill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+		for (uint32 i = 0; i < indices.size(); ++i)
+		{
+			vertexTriangles[fill[indices[i]]++] = i / 3;
+		}
+	}
+
+	std::vector<float32> vertexScores(vertexCount);
+	for (uint32 i = 0; i < vertexCount; ++i)
+	{
+		vertexScores[i] = scoreTable.score(-1, remainingTriangles[i]);
+	}
+
+	std::vector<float32> triangleScores(triangleCount);
+	for (uint32 i = 0; i < triangleCount; ++i)
+	{
+		triangleScores[i] = vertexScores[indices[i * 3]] + vertexScores[indices[i * 3 + 1]] + vertexScores[indices[i * 3 + 2]];
+	}
+
+	std::vector<bool> drawn(triangleCount, false);
+
+	std::vector<uint32> cache;
+	std::vector<uint32> newCache;
+	cache.reserve(CACHE_SIZE + 3);
+	newCache.reserve(CACHE_SIZE + 3);
+
+	std::vector<uint32> result;
+	result.reserve(indices.size());
+
+	uint32 bestTriangle = static_cast<uint32>(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+
+	// Where to look for a triangle to start again from when nothing in the cache has triangles left
+	uint32 nextUndrawnTriangle = 0;
+
+	for (uint32 drawnCount = 0; drawnCount < triangleCount; ++drawnCount)
+	{
+		if (bestTriangle == INVALID_TRIANGLE)
+		{
+			while (drawn[nextUndrawnTriangle]) ++nextUndrawnTriangle;
+			bestTriangle = nextUndrawnTriangle;
+		}
+
+		const uint32* triangle = &indices[bestTriangle * 3];
+		result.insert(result.end(), triangle, triangle + 3);
+		drawn[bestTriangle] = true;
+
+		for (uint32 i = 0; i < 3; ++i)
+		{
+			const uint32 vertex = triangle[i];
+
+			// Move the triangle behind the vertex's remaining triangles
+			auto begin = vertexTriangles.begin() + triangleOffsets[vertex];
+			auto end = begin + remainingTriangles[vertex];
+			std::iter_swap(std::find(begin, end, bestTriangle), end - 1);
+
+			--remainingTriangles[vertex];
+		}
+
+		// The triangle's vertices go to the front of the cache, ahead of everything else that was in it
+		newCache.assign(triangle, triangle + 3);
+		for (const auto vertex : cache)
+		{
+			if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2]) newCache.push_back(vertex);
+		}
+		std::swap(cache, newCache);
+
+		bestTriangle = INVALID_TRIANGLE;
+		float32 bestScore = -1.0f;
+
+		for (uint32 i = 0; i < cache.size(); ++i)
+		{
+			const uint32 vertex = cache[i];
+			const int32 cachePosition = (i < CACHE_SIZE ? static_cast<int32>(i) : -1);
+
+			const float32 score = scoreTable.score(cachePosition, remainingTriangles[vertex]);
+			const float32 scoreChange = score - vertexScores[vertex];
+			vertexScores[vertex] = score;
+
+			const auto begin = vertexTriangles.begin() + triangleOffsets[vertex];
+			const auto end = begin + remainingTriangles[vertex];
+
+			for (auto it = begin; it != end; ++it)
+			{
+				triangleScores[*it] += scoreChange;
+			}
+		}
+
+		// Only triangles that use a cached vertex are worth considering, the rest all score lower
+		for (uint32 i = 0; i < std::min<uint32>(static_cast<uint32>(cache.size()), CACHE_SIZE); ++i)
+		{
+			const uint32 vertex = cache[i];
+			const auto begin = vertexTriangles.begin() + triangleOffsets[vertex];
+			const auto end = begin + remainingTriangles[vertex];
+
+			for (auto it = begin; it != end; ++it)
+			{
+				if (triangleScores[*it] > bestScore)
+				{
+					bestScore = triangleScores[*it];
+					bestTriangle = *it;
+				}
+			}
+		}
+
+		if (cache.size() > CACHE_SIZE) cache.resize(CACHE_SIZE);
+	}
+
+	indices = std::move(result);
+}
+
+void optimizeOverdraw(std::vector<uint32>& indices, const std::vector<glm::vec3>& vertices, const float32 threshold)
+{
+	validateIndices(indices, static_cast<uint32>(vertices.size()));
+
+	const auto triangleCount = static_cast<uint32>(indices.size() / 3);
+
+	if (triangleCount == 0) return;
+
+	CacheSimulation cache(static_cast<uint32>(vertices.size()), SIMULATED_CACHE_SIZE);
+
+	// A triangle that shares no vertex with the cache starts a new cluster without costing anything
+	std::vector<uint32> hardBoundaries;
+	for (uint32 i = 0; i < triangleCount; ++i)
+	{
+		if (cache.triangleMisses(&indices[i * 3]) == 3) hardBoundaries.push_back(i);
+	}
+	hardBoundaries.push_back(triangleCount);
+
+	// Within each of those, split wherever the cluster so far misses no more than threshold times what the whole does,
+	// so clusters can start with a cold cache and still be about as cheap to draw
+	std::vector<uint32> clusters;
+
+	for (size_t i = 0; i + 1 < hardBoundaries.size(); ++i)
+	{
+		const uint32 begin = hardBoundaries[i];
+		const uint32 end = hardBoundaries[i + 1];
+
+		cache.clear();
+
+		uint32 misses = 0;
+		for (uint32 j = begin; j < end; ++j)
+		{
+			misses += cache.triangleMisses(&indices[j * 3]);
+		}
+
+		const float32 limit = threshold * static_cast<float32>(misses) / static_cast<float32>(end - begin);
+
+		cache.clear();
+		clusters.push_back(begin);
+
+		uint32 clusterMisses = 0;
+		for (uint32 j = begin; j < end; ++j)
+		{
+			clusterMisses += cache.triangleMisses(&indices[j * 3]);
+
+			const uint32 clusterSize = j - clusters.back() + 1;
+
+			if (j + 1 < end && static_cast<float32>(clusterMisses) <= limit * static_cast<float32>(clusterSize))
+			{
+				clusters.push_back(j + 1);
+				clusterMisses = 0;
+				cache.clear();
+			}
+		}
+	}
+	clusters.push_back(triangleCount);
+
+	const auto clusterCount = clusters.size() - 1;
+
+	// Area weighted centroids and normals
+	std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3(0.0f));
+	std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3(0.0f));
+	std::vector<float32> clusterAreas(clusterCount, 0.0f);
+
+	glm::vec3 meshCentroid = glm::vec3(0.0f);
+	float32 meshArea = 0.0f;
+
+	for (size_t i = 0; i < clusterCount; ++i)
+	{
+		for (uint32 j = clusters[i]; j < clusters[i + 1]; ++j)
+		{
+			const auto& a = vertices[indices[j * 3]];
+			const auto& b = vertices[indices[j * 3 + 1]];
+			const auto& c = vertices[indices[j * 3 + 2]];
+
+			const auto normal = glm::cross(b - a, c - a);
+			const float32 area = glm::length(normal);
+
+			clusterCentroids[i] += (a + b + c) * (area / 3.0f);
+			clusterNormals[i] += normal;
+			clusterAreas[i] += area;
+		}
+
+		meshCentroid += clusterCentroids[i];
+		meshArea += clusterAreas[i];
+
+		if (clusterAreas[i] > 0.0f) clusterCentroids[i] /= clusterAreas[i];
+	}
+
+	if (meshArea > 0.0f) meshCentroid /= meshArea;
+
+	std::vector<float32> sortKeys(clusterCount, 0.0f);
+	for (size_t i = 0; i < clusterCount; ++i)
+	{
+		const float32 length = glm::length(clusterNormals[i]);
+
+		if (length > 0.0f) sortKeys[i] = glm::dot(clusterCentroids[i] - meshCentroid, clusterNormals[i] / length);
+	}
+
+	std::vector<uint32> order(clusterCount);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&sortKeys](const uint32 a, const uint32 b) {
+		return sortKeys[a] > sortKeys[b];
+	});
+
+	std::vector<uint32> result;
+	result.reserve(indices.size());
+
+	for (const auto cluster : order)
+	{
+		result.insert(result.end(), indices.begin() + clusters[cluster] * 3, indices.begin() + clusters[cluster + 1] * 3);
+	}
+
+	indices = std::move(result);
+}
+
+std::vector<uint32> optimizeVertexFetch(std::vector<uint32>& indices, const uint32 vertexCount)
+{
+	validateIndices(indices, vertexCount);
+
+	std::vector<uint32> remap(vertexCount, INVALID_VERTEX);
+	uint32 nextVertex = 0;
+
+	for (auto& index : indices)
+	{
+		if (remap[index] == INVALID_VERTEX) remap[index] = nextVertex++;
+
+		index = remap[index];
+	}
+
+	return remap;
+}
+
+graphics::VertexLayout createVertexLayout(const Mesh& mesh, const bool splitPositions)
+{
+	const auto vertexCount = mesh.vertices().size();
+	const auto& boneIds = mesh.vertexBoneData().boneIds();
+	const auto& boneWeights = mesh.vertexBoneData().boneWeights();
+
+	checkStreamSize(mesh.normals(), vertexCount, "normals");
+	checkStreamSize(mesh.textureCoordinates(), vertexCount, "texture coordinates");
+	checkStreamSize(mesh.colors(), vertexCount, "colors");
+	checkStreamSize(boneIds, vertexCount, "bone ids");
+	checkStreamSize(boneWeights, vertexCount, "bone weights");
+
+	graphics::VertexLayout layout;
+	layout.strides.resize(splitPositions ? 2 : 1, 0);
+
+	const auto addAttribute = [&layout](const graphics::VertexAttribute attribute, const graphics::VertexAttributeFormat format, const uint32 stream) {
+		graphics::VertexAttributeLayout attributeLayout;
+		attributeLayout.attribute = attribute;
+		attributeLayout.format = format;
+		attributeLayout.stream = stream;
+		attributeLayout.offset = layout.strides[stream];
+
+		layout.attributes.push_back(attributeLayout);
+		layout.strides[stream] += attributeSize(format);
+	};
+
+	const uint32 attributeStream = (splitPositions ? 1 : 0);
+
+	addAttribute(graphics::VertexAttribute::POSITION, graphics::VertexAttributeFormat::FLOAT32_3, 0);
+
+	if (!mesh.normals().empty())
+	{
+		addAttribute(graphics::VertexAttribute::NORMAL, graphics::VertexAttributeFormat::SNORM8_4, attributeStream);
+	}
+	if (!mesh.textureCoordinates().empty())
+	{
+		addAttribute(graphics::VertexAttribute::TEXTURE_COORDINATE, graphics::VertexAttributeFormat::FLOAT16_2, attributeStream);
+	}
+	if (!mesh.colors().empty())
+	{
+		addAttribute(graphics::VertexAttribute::COLOR, graphics::VertexAttributeFormat::UNORM8_4, attributeStream);
+	}
+	if (!boneIds.empty() && !boneWeights.empty())
+	{
+		int32 largestBoneId = 0;
+		for (const auto& ids : boneIds)
+		{
+			for (uint32 i = 0; i < 4; ++i)
+			{
+				if (ids[i] < 0 || ids[i] > 0xFFFF)
+				{
+					throw InvalidArgumentException(detail::format("Bone id %s is out of range.", ids[i]));
+				}
+
+				largestBoneId = std::max(largestBoneId, ids[i]);
+			}
+		}
+
+		addAttribute(graphics::VertexAttribute::BONE_IDS, (largestBoneId <= 0xFF ? graphics::VertexAttributeFormat::UINT8_4 : graphics::VertexAttributeFormat::UINT16_4), attributeStream);
+		addAttribute(graphics::VertexAttribute::BONE_WEIGHTS, graphics::VertexAttributeFormat::UNORM8_4, attributeStream);
+	}
+
+	// A stream of positions on its own is left as it is, but everything else is kept 4 byte aligned
+	if (splitPositions && layout.strides[1] == 0) layout.strides.pop_back();
+
+	layout.indexFormat = (vertexCount <= 0x10000 ? graphics::IndexFormat::UINT16 : graphics::IndexFormat::UINT32);
+
+	return layout;
+}
+
+void packVertices(const Mesh& mesh, const graphics::VertexLayout& layout, std::vector< std::vector<byte> >& result)
+{
+	const auto vertexCount = mesh.vertices().size();
+
+	result.resize(layout.strides.size());
+	for (size_t i = 0; i < layout.strides.size(); ++i)
+	{
+		result[i].assign(vertexCount * layout.strides[i], 0);
+	}
+
+	for (const auto& attribute : layout.attributes)
+	{
+		if (attribute.stream >= layout.strides.size() || attribute.offset + attributeSize(attribute.format) > layout.strides[attribute.stream])
+		{
+			throw InvalidArgumentException(detail::format("Vertex attribute %s does not fit in its stream.", static_cast<uint32>(attribute.attribute)));
+		}
+
+		const uint32 stride = layout.strides[attribute.stream];
+		byte* destination = result[attribute.stream].data() + attribute.offset;
+
+		const auto checkFormat = [&attribute](const graphics::VertexAttributeFormat format) {
+			if (attribute.format != format)
+			{
+				throw InvalidArgumentException(detail::format("Vertex attribute %s can't be packed in format %s.", static_cast<uint32>(attribute.attribute), static_cast<uint32>(attribute.format)));
+			}
+		};
+
+		switch (attribute.attribute)
+		{
+			case graphics::VertexAttribute::POSITION:
+				checkFormat(graphics::VertexAttributeFormat::FLOAT32_3);
+				for (size_t i = 0; i < vertexCount; ++i, destination += stride)
+				{
+					writeValue(destination, mesh.vertices()[i]);
+				}
+				break;
+
+			case graphics::VertexAttribute::NORMAL:
+				checkFormat(graphics::VertexAttributeFormat::SNORM8_4);
+				checkStreamSize(mesh.normals(), vertexCount, "normals");
+				for (size_t i = 0; i < mesh.normals().size(); ++i, destination += stride)
+				{
+					const auto normal = glm::length(mesh.normals()[i]) > 0.0f ? glm::normalize(mesh.normals()[i]) : mesh.normals()[i];
+					const int8 value[4] = {toSnorm8(normal.x), toSnorm8(normal.y), toSnorm8(normal.z), 0};
+					writeValue(destination, value);
+				}
+				break;
+
+			case graphics::VertexAttribute::TEXTURE_COORDINATE:
+				checkFormat(graphics::VertexAttributeFormat::FLOAT16_2);
+				checkStreamSize(mesh.textureCoordinates(), vertexCount, "texture coordinates");
+				for (size_t i = 0; i < mesh.textureCoordinates().size(); ++i, destination += stride)
+				{
+					const uint16 value[2] = {toFloat16(mesh.textureCoordinates()[i].x), toFloat16(mesh.textureCoordinates()[i].y)};
+					writeValue(destination, value);
+				}
+				break;
+
+			case graphics::VertexAttribute::COLOR:
+				checkFormat(graphics::VertexAttributeFormat::UNORM8_4);
+				checkStreamSize(mesh.colors(), vertexCount, "colors");
+				for (size_t i = 0; i < mesh.colors().size(); ++i, destination += stride)
+				{
+					for (uint32 c = 0; c < 4; ++c)
+					{
+						destination[c] = toUnorm8(mesh.colors()[i][c]);
+					}
+				}
+				break;
+
+			case graphics::VertexAttribute::BONE_IDS:
+			{
+				const auto& boneIds = mesh.vertexBoneData().boneIds();
+				checkStreamSize(boneIds, vertexCount, "bone ids");
+
+				if (attribute.format == graphics::VertexAttributeFormat::UINT8_4)
+				{
+					for (size_t i = 0; i < boneIds.size(); ++i, destination += stride)
+					{
+						const byte value[4] = {static_cast<byte>(boneIds[i][0]), static_cast<byte>(boneIds[i][1]), static_cast<byte>(boneIds[i][2]), static_cast<byte>(boneIds[i][3])};
+						writeValue(destination, value);
+					}
+				}
+				else
+				{
+					checkFormat(graphics::VertexAttributeFormat::UINT16_4);
+					for (size_t i = 0; i < boneIds.size(); ++i, destination += stride)
+					{
+						const uint16 value[4] = {static_cast<uint16>(boneIds[i][0]), static_cast<uint16>(boneIds[i][1]), static_cast<uint16>(boneIds[i][2]), static_cast<uint16>(boneIds[i][3])};
+						writeValue(destination, value);
+					}
+				}
+				break;
+			}
+
+			case graphics::VertexAttribute::BONE_WEIGHTS:
+			{
+				const auto& boneWeights = mesh.vertexBoneData().boneWeights();
+				checkFormat(graphics::VertexAttributeFormat::UNORM8_4);
+				checkStreamSize(boneWeights, vertexCount, "bone weights");
+				for (size_t i = 0; i < boneWeights.size(); ++i, destination += stride)
+				{
+					quantizeBoneWeights(boneWeights[i], destination);
+				}
+				break;
+			}
+		}
+	}
+}
+
+void packIndices(const std::vector<uint32>& indices, const graphics::IndexFormat indexFormat, std::vector<byte>& result)
+{
+	if (indexFormat == graphics::IndexFormat::UINT32)
+	{
+		result.resize(indices.size() * sizeof(uint32));
+		std::memcpy(result.data(), indices.data(), result.size());
+
+		return;
+	}
+
+	std::vector<uint16> shortIndices(indices.size());
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		if (indices[i] > 0xFFFF)
+		{
+			throw InvalidArgumentException(detail::format("Index %s does not fit in 16 bits.", indices[i]));
+		}
+
+		shortIndices[i] = static_cast<uint16>(indices[i]);
+	}
+
+	result.resize(shortIndices.size() * sizeof(uint16));
+	std::memcpy(result.data(), shortIndices.data(), result.size());
+}
+
+Mesh optimize(const Mesh& mesh, const MeshOptimizationOptions& options)
+{
+	if (mesh.vertices().empty()) return mesh;
+
+	const auto vertexCount = static_cast<uint32>(mesh.vertices().size());
+
+	auto indices = mesh.indices();
+	optimizeVertexCache(indices, vertexCount);
+	optimizeOverdraw(indices, mesh.vertices(), options.overdrawThreshold);
+
+	const auto remap = optimizeVertexFetch(indices, vertexCount);
+	const auto usedVertexCount = static_cast<uint32>(std::count_if(remap.begin(), remap.end(), [](const uint32 vertex) { return vertex != INVALID_VERTEX; }));
+
+	Mesh remapped(
+		mesh.name(),
+		remapVertices(mesh.vertices(), remap, usedVertexCount),
+		indices,
+		remapVertices(mesh.colors(), remap, usedVertexCount),
+		remapVertices(mesh.normals(), remap, usedVertexCount),
+		remapVertices(mesh.textureCoordinates(), remap, usedVertexCount),
+		VertexBoneData(
+			remapVertices(mesh.vertexBoneData().boneIds(), remap, usedVertexCount),
+			remapVertices(mesh.vertexBoneData().boneWeights(), remap, usedVertexCount)
+		),
+		mesh.boneData()
+	);
+
+	auto layout = createVertexLayout(remapped, options.splitPositions);
+
+	std::vector< std::vector<byte> > vertexStreams;
+	std::vector<byte> indexData;
+	packVertices(remapped, layout, vertexStreams);
+	packIndices(indices, layout.indexFormat, indexData);
+
+	if (options.keepVertexStreams == VertexStreams::ALL)
+	{
+		return Mesh(
+			remapped.name(),
+			remapped.vertices(),
+			remapped.indices(),
+			remapped.colors(),
+			remapped.normals(),
+			remapped.textureCoordinates(),
+			remapped.vertexBoneData(),
+			remapped.boneData(),
+			std::move(layout),
+			std::move(vertexStreams),
+			std::move(indexData)
+		);
+	}
+
+	if (options.keepVertexStreams == VertexStreams::POSITIONS)
+	{
+		return Mesh(remapped.name(), remapped.vertices(), remapped.indices(), {}, {}, {}, VertexBoneData(), remapped.boneData(), std::move(layout), std::move(vertexStreams), std::move(indexData));
+	}
+
+	return Mesh(mesh.name(), {}, {}, {}, {}, {}, VertexBoneData(), mesh.boneData(), std::move(layout), std::move(vertexStreams), std::move(indexData));
+}
+
+}
+}
@@ -0,0 +1,373 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "mesh/MeshSimplification.hpp"
+
+#include "detail/Format.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+namespace ice_engine
+{
+namespace mesh
+{
+
+namespace
+{
+
+void validateIndices(const std::vector<uint32>& indices, const uint32 vertexCount)
+{
+	if (indices.size() % 3 != 0)
+	{
+		throw InvalidArgumentException(detail::format("Number of indices (%s) is not a multiple of 3.", indices.size()));
+	}
+
+	for (const auto index : indices)
+	{
+		if (index >= vertexCount)
+		{
+			throw InvalidArgumentException(detail::format("Index %s is out of range for %s vertices.", index, vertexCount));
+		}
+	}
+}
+
+/**
+ * Sum of the squared distances to a set of planes, weighted by the area of the triangles they came from.
+ */
+class Quadric
+{
+public:
+	void addPlane(const glm::vec3& normal, const float32 distance, const float32 weight)
+	{
+		a00_ += weight * normal[0] * normal[0];
+		a01_ += weight * normal[0] * normal[1];
+		a02_ += weight * normal[0] * normal[2];
+		a11_ += weight * normal[1] * normal[1];
+		a12_ += weight * normal[1] * normal[2];
+		a22_ += weight * normal[2] * normal[2];
+		b0_ += weight * normal[0] * distance;
+		b1_ += weight * normal[1] * distance;
+		b2_ += weight * normal[2] * distance;
+		c_ += weight * distance * distance;
+		weight_ += weight;
+	}
+
+	void add(const Quadric& other)
+	{
+		a00_ += other.a00_;
+		a01_ += other.a01_;
+		a02_ += other.a02_;
+		a11_ += other.a11_;
+		a12_ += other.a12_;
+		a22_ += other.a22_;
+		b0_ += other.b0_;
+		b1_ += other.b1_;
+		b2_ += other.b2_;
+		c_ += other.c_;
+		weight_ += other.weight_;
+	}
+
+	/**
+	 * The weighted mean of the squared distances from position to the planes.
+	 */
+	float64 error(const Quadric& other, const glm::vec3& position) const
+	{
+		const float64 x = position[0];
+		const float64 y = position[1];
+		const float64 z = position[2];
+
+		const float64 weight = weight_ + other.weight_;
+		if (weight <= 0.0) return 0.0;
+
+		const float64 error =
+			(a00_ + other.a00_) * x * x + (a11_ + other.a11_) * y * y + (a22_ + other.a22_) * z * z
+			+ 2.0 * ((a01_ + other.a01_) * x * y + (a02_ + other.a02_) * x * z + (a12_ + other.a12_) * y * z)
+			+ 2.0 * ((b0_ + other.b0_) * x + (b1_ + other.b1_) * y + (b2_ + other.b2_) * z)
+			+ (c_ + other.c_);
+
+		// Rounding can take it just below zero
+		return std::max(error / weight, 0.0);
+	}
+
+private:
+	float64 a00_ = 0.0;
+	float64 a01_ = 0.0;
+	float64 a02_ = 0.0;
+	float64 a11_ = 0.0;
+	float64 a12_ = 0.0;
+	float64 a22_ = 0.0;
+	float64 b0_ = 0.0;
+	float64 b1_ = 0.0;
+	float64 b2_ = 0.0;
+	float64 c_ = 0.0;
+	float64 weight_ = 0.0;
+};
+
+struct Collapse
+{
+	uint32 from;
+	uint32 to;
+	float64 error;
+};
+
+uint64 edgeKey(const uint32 a, const uint32 b)
+{
+	return (static_cast<uint64>(std::min(a, b)) << 32) | std::max(a, b);
+}
+
+/**
+ * Every edge of the triangles in indices once, sorted.
+ */
+void collectEdges(const std::vector<uint32>& indices, std::vector<uint64>& edges, std::vector<uint32>& edgeCounts)
+{
+	std::vector<uint64> allEdges;
+	allEdges.reserve(indices.size());
+
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		allEdges.push_back(edgeKey(indices[i], indices[i + 1]));
+		allEdges.push_back(edgeKey(indices[i + 1], indices[i + 2]));
+		allEdges.push_back(edgeKey(indices[i + 2], indices[i]));
+	}
+
+	std::sort(allEdges.begin(), allEdges.end());
+
+	edges.clear();
+	edgeCounts.clear();
+
+	for (const auto edge : allEdges)
+	{
+		if (!edges.empty() && edges.back() == edge)
+		{
+			++edgeCounts.back();
+			continue;
+		}
+
+		edges.push_back(edge);
+		edgeCounts.push_back(1);
+	}
+}
+
+/**
+ * The triangles using each vertex, as offsets into one array.
+ */
+void buildAdjacency(const std::vector<uint32>& indices, const uint32 vertexCount, std::vector<uint32>& offsets, std::vector<uint32>& triangles)
+{
+	offsets.assign(vertexCount + 1, 0);
+
+	for (const auto index : indices)
+	{
+		++offsets[index + 1];
+	}
+
+	std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+	std::vector<uint32> next(offsets.begin(), offsets.end() - 1);
+	triangles.resize(indices.size());
+
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		triangles[next[indices[i]]++] = static_cast<uint32>(i / 3);
+	}
+}
+
+glm::vec3 triangleNormal(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+	return glm::cross(b - a, c - a);
+}
+
+}
+
+std::vector<uint32> simplify(
+	const std::vector<uint32>& indices,
+	const std::vector<glm::vec3>& vertices,
+	const size_t targetIndexCount,
+	const float32 targetError,
+	float32* resultError
+)
+{
+	const auto vertexCount = static_cast<uint32>(vertices.size());
+
+	validateIndices(indices, vertexCount);
+
+	if (resultError) *resultError = 0.0f;
+
+	std::vector<uint32> result = indices;
+
+	if (result.size() <= targetIndexCount) return result;
+
+	glm::vec3 minimum = vertices[result[0]];
+	glm::vec3 maximum = minimum;
+	for (const auto index : result)
+	{
+		for (uint32 i = 0; i < 3; ++i)
+		{
+			minimum[i] = std::min(minimum[i], vertices[index][i]);
+			maximum[i] = std::max(maximum[i], vertices[index][i]);
+		}
+	}
+
+	const float64 extent = glm::length(maximum - minimum);
+	const float64 maximumError = static_cast<float64>(targetError) * extent;
+	const float64 maximumSquaredError = maximumError * maximumError;
+
+	std::vector<uint64> edges;
+	std::vector<uint32> edgeCounts;
+	collectEdges(result, edges, edgeCounts);
+
+	// Vertices on borders, seams and non manifold edges stay where they are
+	std::vector<bool> locked(vertexCount, false);
+	for (size_t i = 0; i < edges.size(); ++i)
+	{
+		if (edgeCounts[i] != 2)
+		{
+			locked[static_cast<uint32>(edges[i] >> 32)] = true;
+			locked[static_cast<uint32>(edges[i])] = true;
+		}
+	}
+
+	std::vector<Quadric> quadrics(vertexCount);
+	for (size_t i = 0; i < result.size(); i += 3)
+	{
+		const auto& a = vertices[result[i]];
+		const auto normal = triangleNormal(a, vertices[result[i + 1]], vertices[result[i + 2]]);
+		const auto length = glm::length(normal);
+
+		if (length <= 0.0f) continue;
+
+		Quadric quadric;
+		quadric.addPlane(normal / length, -glm::dot(normal / length, a), length * 0.5f);
+
+		for (uint32 j = 0; j < 3; ++j)
+		{
+			quadrics[result[i + j]].add(quadric);
+		}
+	}
+
+	const size_t targetTriangleCount = targetIndexCount / 3;
+	float64 largestSquaredError = 0.0;
+
+	std::vector<Collapse> collapses;
+	std::vector<uint32> adjacencyOffsets;
+	std::vector<uint32> adjacency;
+	std::vector<uint32> remap(vertexCount);
+	std::vector<bool> collapsed(vertexCount);
+
+	// Each pass makes the cheapest collapses that don't touch a vertex another collapse in the pass has touched, so the
+	// costs computed at the start of the pass stay exact
+	while (result.size() / 3 > targetTriangleCount)
+	{
+		collapses.clear();
+
+		for (const auto edge : edges)
+		{
+			const auto a = static_cast<uint32>(edge >> 32);
+			const auto b = static_cast<uint32>(edge);
+
+			if (locked[a] && locked[b]) continue;
+
+			const auto errorToB = locked[a] ? maximumSquaredError + 1.0 : quadrics[a].error(quadrics[b], vertices[b]);
+			const auto errorToA = locked[b] ? maximumSquaredError + 1.0 : quadrics[b].error(quadrics[a], vertices[a]);
+
+			if (errorToB <= errorToA)
+			{
+				if (errorToB <= maximumSquaredError) collapses.push_back({a, b, errorToB});
+			}
+			else
+			{
+				if (errorToA <= maximumSquaredError) collapses.push_back({b, a, errorToA});
+			}
+		}
+
+		if (collapses.empty()) break;
+
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+			if (a.error != b.error) return a.error < b.error;
+			if (a.from != b.from) return a.from < b.from;
+			return a.to < b.to;
+		});
+
+		buildAdjacency(result, vertexCount, adjacencyOffsets, adjacency);
+
+		std::iota(remap.begin(), remap.end(), 0);
+		std::fill(collapsed.begin(), collapsed.end(), false);
+
+		size_t triangleCount = result.size() / 3;
+		bool changed = false;
+
+		for (const auto& collapse : collapses)
+		{
+			if (triangleCount <= targetTriangleCount) break;
+			if (collapsed[collapse.from] || collapsed[collapse.to]) continue;
+
+			uint32 removedTriangles = 0;
+			bool flipped = false;
+
+			for (uint32 i = adjacencyOffsets[collapse.from]; i < adjacencyOffsets[collapse.from + 1] && !flipped; ++i)
+			{
+				const uint32* triangle = &result[adjacency[i] * 3];
+				const uint32 corners[3] = {remap[triangle[0]], remap[triangle[1]], remap[triangle[2]]};
+
+				if (corners[0] == corners[1] || corners[1] == corners[2] || corners[2] == corners[0]) continue;
+
+				if (corners[0] == collapse.to || corners[1] == collapse.to || corners[2] == collapse.to)
+				{
+					++removedTriangles;
+					continue;
+				}
+
+				glm::vec3 positions[3] = {vertices[corners[0]], vertices[corners[1]], vertices[corners[2]]};
+				const auto before = triangleNormal(positions[0], positions[1], positions[2]);
+
+				for (uint32 j = 0; j < 3; ++j)
+				{
+					if (corners[j] == collapse.from) positions[j] = vertices[collapse.to];
+				}
+
+				const auto after = triangleNormal(positions[0], positions[1], positions[2]);
+
+				flipped = glm::dot(before, after) <= 0.0f;
+			}
+
+			if (flipped) continue;
+
+			remap[collapse.from] = collapse.to;
+			quadrics[collapse.to].add(quadrics[collapse.from]);
+			collapsed[collapse.from] = true;
+			collapsed[collapse.to] = true;
+
+			triangleCount -= std::min<size_t>(removedTriangles, triangleCount);
+			largestSquaredError = std::max(largestSquaredError, collapse.error);
+			changed = true;
+		}
+
+		if (!changed) break;
+
+		size_t size = 0;
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			const uint32 corners[3] = {remap[result[i]], remap[result[i + 1]], remap[result[i + 2]]};
+
+			if (corners[0] == corners[1] || corners[1] == corners[2] || corners[2] == corners[0]) continue;
+
+			result[size++] = corners[0];
+			result[size++] = corners[1];
+			result[size++] = corners[2];
+		}
+
+		result.resize(size);
+
+		collectEdges(result, edges, edgeCounts);
+	}
+
+	if (resultError && extent > 0.0)
+	{
+		*resultError = static_cast<float32>(std::sqrt(largestSquaredError) / extent);
+	}
+
+	return result;
+}
+
+}
+}
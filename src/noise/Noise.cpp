@@ -0,0 +1,104 @@
+#include <algorithm>
+
+#include "noise/Noise.hpp"
+
+#include "detail/ForEachChunk.hpp"
+
+namespace ice_engine
+{
+namespace noise
+{
+
+namespace
+{
+// Enough samples per task that handing it to a worker is worth it
+constexpr size_t SAMPLES_PER_CHUNK = 4096;
+
+size_t rowsPerChunk(const uint32 width)
+{
+	return std::max<size_t>(1, SAMPLES_PER_CHUNK / std::max<uint32>(1, width));
+}
+}
+
+void Noise::getNoise(
+	const float32 x,
+	const float32 y,
+	const uint32 width,
+	const uint32 height,
+	const float32 step,
+	std::vector<float32>& values,
+	IThreadPool* threadPool
+) const
+{
+	values.resize(static_cast<size_t>(width) * height);
+
+	detail::forEachChunk(threadPool, height, rowsPerChunk(width), [this, x, y, width, step, &values](const size_t chunk, const size_t begin, const size_t end) {
+		for (size_t j = begin; j < end; ++j)
+		{
+			const float32 sampleY = y + static_cast<float32>(j) * step;
+			auto rowValues = values.data() + j * width;
+
+			for (uint32 i = 0; i < width; ++i)
+			{
+				rowValues[i] = noise_.GetNoise(x + static_cast<float32>(i) * step, sampleY);
+			}
+		}
+	});
+}
+
+void Noise::getNoise(
+	const float32 x,
+	const float32 y,
+	const float32 z,
+	const uint32 width,
+	const uint32 height,
+	const uint32 depth,
+	const float32 step,
+	std::vector<float32>& values,
+	IThreadPool* threadPool
+) const
+{
+	values.resize(static_cast<size_t>(width) * height * depth);
+
+	// Rows from every slice are shared out together, so thin volumes still spread across the workers
+	detail::forEachChunk(threadPool, static_cast<size_t>(height) * depth, rowsPerChunk(width), [this, x, y, z, width, height, step, &values](const size_t chunk, const size_t begin, const size_t end) {
+		for (size_t row = begin; row < end; ++row)
+		{
+			const float32 sampleY = y + static_cast<float32>(row % height) * step;
+			const float32 sampleZ = z + static_cast<float32>(row / height) * step;
+			auto rowValues = values.data() + row * width;
+
+			for (uint32 i = 0; i < width; ++i)
+			{
+				rowValues[i] = noise_.GetNoise(x + static_cast<float32>(i) * step, sampleY, sampleZ);
+			}
+		}
+	});
+}
+
+void Noise::getNoise(const std::vector<glm::vec2>& positions, std::vector<float32>& values, IThreadPool* threadPool) const
+{
+	values.resize(positions.size());
+
+	detail::forEachChunk(threadPool, positions.size(), SAMPLES_PER_CHUNK, [this, &positions, &values](const size_t chunk, const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			values[i] = noise_.GetNoise(positions[i].x, positions[i].y);
+		}
+	});
+}
+
+void Noise::getNoise(const std::vector<glm::vec3>& positions, std::vector<float32>& values, IThreadPool* threadPool) const
+{
+	values.resize(positions.size());
+
+	detail::forEachChunk(threadPool, positions.size(), SAMPLES_PER_CHUNK, [this, &positions, &values](const size_t chunk, const size_t begin, const size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			values[i] = noise_.GetNoise(positions[i].x, positions[i].y, positions[i].z);
+		}
+	});
+}
+
+}
+}
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cmath>
+
+#include "replication/InterestGrid.hpp"
+#include "replication/Quantization.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+InterestGrid::InterestGrid(const float32 cellSize) : cellSize_(cellSize > 0.0f ? cellSize : 32.0f)
+{
+}
+
+float32 InterestGrid::cellSize() const
+{
+	return cellSize_;
+}
+
+int32 InterestGrid::cellCoordinate(const float32 value) const
+{
+	return static_cast<int32>(std::floor(value / cellSize_));
+}
+
+uint64 InterestGrid::cellKey(const int32 x, const int32 y, const int32 z)
+{
+	// 21 bits per axis is over two million cells in each direction
+	return (static_cast<uint64>(x & 0x1FFFFF) << 42) | (static_cast<uint64>(y & 0x1FFFFF) << 21) | static_cast<uint64>(z & 0x1FFFFF);
+}
+
+void InterestGrid::clear()
+{
+	// Keep the cell vectors around, the same cells tend to be occupied from one snapshot to the next
+	for (auto& kv : cells_)
+	{
+		kv.second.clear();
+	}
+
+	positions_.clear();
+	unpositioned_.clear();
+}
+
+void InterestGrid::build(const ReplicationSnapshot& snapshot)
+{
+	clear();
+
+	// Don't let cells that entities have moved out of pile up
+	if (cells_.size() > 2 * snapshot.entities.size() + 64) cells_.clear();
+
+	positions_.resize(snapshot.entities.size());
+
+	for (uint32 i = 0; i < snapshot.entities.size(); ++i)
+	{
+		const auto& state = snapshot.entities[i];
+
+		if (!(state.fields & REPLICATED_POSITION))
+		{
+			unpositioned_.push_back(i);
+			continue;
+		}
+
+		const auto position = dequantizePosition(state.position, snapshot.positionPrecision);
+		positions_[i] = position;
+
+		cells_[cellKey(cellCoordinate(position.x), cellCoordinate(position.y), cellCoordinate(position.z))].push_back(i);
+	}
+}
+
+void InterestGrid::query(const glm::vec3& position, const float32 radius, std::vector<InterestGridResult>& results) const
+{
+	const size_t start = results.size();
+
+	for (const auto index : unpositioned_)
+	{
+		results.push_back({index, 0.0f});
+	}
+
+	const float32 radiusSquared = radius * radius;
+
+	const int32 minimumX = cellCoordinate(position.x - radius);
+	const int32 minimumY = cellCoordinate(position.y - radius);
+	const int32 minimumZ = cellCoordinate(position.z - radius);
+	const int32 maximumX = cellCoordinate(position.x + radius);
+	const int32 maximumY = cellCoordinate(position.y + radius);
+	const int32 maximumZ = cellCoordinate(position.z + radius);
+
+	auto addCell = [this, &position, radiusSquared, &results](const std::vector<uint32>& cell) {
+		for (const auto index : cell)
+		{
+			const auto& p = positions_[index];
+			const float32 dx = p.x - position.x;
+			const float32 dy = p.y - position.y;
+			const float32 dz = p.z - position.z;
+			const float32 distanceSquared = dx * dx + dy * dy + dz * dz;
+
+			if (distanceSquared <= radiusSquared) results.push_back({index, distanceSquared});
+		}
+	};
+
+	const uint64 numberOfCellsInRange = static_cast<uint64>(maximumX - minimumX + 1) * static_cast<uint64>(maximumY - minimumY + 1) * static_cast<uint64>(maximumZ - minimumZ + 1);
+
+	if (numberOfCellsInRange > cells_.size())
+	{
+		// The radius covers more cells than are occupied, so it is cheaper to visit the occupied ones
+		for (const auto& kv : cells_)
+		{
+			addCell(kv.second);
+		}
+	}
+	else
+	{
+		for (int32 x = minimumX; x <= maximumX; ++x)
+		{
+			for (int32 y = minimumY; y <= maximumY; ++y)
+			{
+				for (int32 z = minimumZ; z <= maximumZ; ++z)
+				{
+					const auto it = cells_.find(cellKey(x, y, z));
+					if (it != cells_.end()) addCell(it->second);
+				}
+			}
+		}
+	}
+
+	std::sort(results.begin() + start, results.end(), [](const InterestGridResult& a, const InterestGridResult& b) {
+		return a.index < b.index;
+	});
+}
+
+}
+}
@@ -0,0 +1,294 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "replication/ReplicationClient.hpp"
+#include "replication/Quantization.hpp"
+
+#include "Scene.hpp"
+#include "GameEngine.hpp"
+
+#include "ecs/ReplicatedComponent.hpp"
+#include "ecs/PropertiesComponent.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+void readReplicationState(
+	scripting::IScriptingEngine* scriptingEngine,
+	const scripting::ScriptObjectHandle& scriptObjectHandle,
+	const std::vector<uint8>& scriptState,
+	const scripting::ExecutionContextHandle& executionContextHandle
+)
+{
+	// The script type MessageBufferReader is a SharedMessageBufferReader, so that is what has to be passed by value
+	scripting::ParameterList params;
+	params.add(networking::SharedMessageBufferReader(ArrayView<const uint8>(scriptState.data(), scriptState.size())));
+
+	scriptingEngine->execute(scriptObjectHandle, std::string("void readReplicationState(MessageBufferReader)"), params, executionContextHandle);
+}
+
+ReplicationClient::ReplicationClient(
+		Scene* scene,
+		GameEngine* gameEngine,
+		const networking::ClientHandle& clientHandle,
+		utilities::Properties* properties,
+		logger::ILogger* logger
+	)
+	:
+		scene_(scene),
+		gameEngine_(gameEngine),
+		clientHandle_(clientHandle),
+		logger_(logger)
+{
+	snapshotHistorySize_ = static_cast<uint32>(std::max(1, properties->getIntValue("replication.snapshothistory", 32)));
+
+	executionContextHandle_ = gameEngine_->scriptingEngine()->createExecutionContext();
+
+	gameEngine_->addMessageEventListener(this);
+}
+
+ReplicationClient::~ReplicationClient()
+{
+	gameEngine_->removeMessageEventListener(this);
+	gameEngine_->scriptingEngine()->destroyExecutionContext(executionContextHandle_);
+}
+
+const networking::ClientHandle& ReplicationClient::clientHandle() const
+{
+	return clientHandle_;
+}
+
+ecs::Entity ReplicationClient::entity(const uint32 networkId) const
+{
+	const auto it = entities_.find(networkId);
+
+	return it != entities_.end() ? it->second : ecs::Entity();
+}
+
+bool ReplicationClient::processEvent(const networking::MessageEvent& event)
+{
+	networking::MessageEventView messageEventView;
+	static_cast<networking::GenericEvent&>(messageEventView) = event;
+	messageEventView.message = event.message.view();
+
+	return processEvent(networking::MessageEventBatch(&messageEventView, 1));
+}
+
+bool ReplicationClient::processEvent(const networking::MessageEventBatch& messageEventBatch)
+{
+	bool processed = false;
+
+	for (const auto& messageEvent : messageEventBatch)
+	{
+		if (messageEvent.clientHandle != clientHandle_) continue;
+
+		try
+		{
+			receive(messageEvent.message);
+			processed = true;
+		}
+		catch (const std::exception& e)
+		{
+			// Anything in a message can be wrong, so every decode error drops the message rather than the process
+			LOG_WARN(logger_, "Received malformed replication message: %s", e.what());
+		}
+	}
+
+	return processed;
+}
+
+void ReplicationClient::receive(const ArrayView<const uint8>& message)
+{
+	networking::MessageBufferReader reader(message);
+
+	if (readMessageType(reader) != ReplicationMessageType::SNAPSHOT) return;
+
+	const auto header = readSnapshotHeader(reader);
+
+	{
+		std::lock_guard<std::mutex> lock(snapshotsMutex_);
+
+		// Drop duplicates and snapshots that arrive after a newer one
+		if (!baselines_.empty() && header.sequence <= baselines_.back().sequence) return;
+
+		const ReplicationSnapshot* baseline = nullptr;
+
+		if (header.baselineSequence != 0)
+		{
+			const auto it = std::find_if(baselines_.begin(), baselines_.end(), [&header](const ReplicationSnapshot& snapshot) {
+				return snapshot.sequence == header.baselineSequence;
+			});
+
+			if (it == baselines_.end())
+			{
+				LOG_WARN(logger_, "Dropping replication snapshot %s, baseline %s is not available.", header.sequence, header.baselineSequence);
+				return;
+			}
+
+			baseline = &*it;
+		}
+
+		auto snapshot = readSnapshot(reader, header, baseline);
+
+		// The server only ever moves a client's baseline forward, so older snapshots are no longer needed
+		while (!baselines_.empty() && baselines_.front().sequence < header.baselineSequence) baselines_.pop_front();
+
+		baselines_.push_back(snapshot);
+
+		if (baselines_.size() > snapshotHistorySize_) baselines_.pop_front();
+
+		pendingSnapshot_ = std::make_unique<ReplicationSnapshot>(std::move(snapshot));
+	}
+
+	auto builder = gameEngine_->createMessageBufferBuilder();
+	writeAcknowledge(builder, header.sequence);
+
+	gameEngine_->networkingEngine()->send(clientHandle_, builder.build());
+}
+
+void ReplicationClient::tick()
+{
+	std::unique_ptr<ReplicationSnapshot> snapshot;
+
+	{
+		std::lock_guard<std::mutex> lock(snapshotsMutex_);
+		snapshot = std::move(pendingSnapshot_);
+	}
+
+	if (snapshot) apply(*snapshot);
+}
+
+void ReplicationClient::apply(const ReplicationSnapshot& snapshot)
+{
+	positionEntities_.clear();
+	positions_.clear();
+	orientationEntities_.clear();
+	orientations_.clear();
+
+	auto currentIt = snapshot.entities.begin();
+	auto previousIt = appliedSnapshot_.entities.begin();
+
+	while (currentIt != snapshot.entities.end() || previousIt != appliedSnapshot_.entities.end())
+	{
+		if (previousIt == appliedSnapshot_.entities.end() || (currentIt != snapshot.entities.end() && currentIt->networkId < previousIt->networkId))
+		{
+			create(*currentIt, snapshot.positionPrecision);
+			++currentIt;
+		}
+		else if (currentIt == snapshot.entities.end() || previousIt->networkId < currentIt->networkId)
+		{
+			destroy(previousIt->networkId);
+			++previousIt;
+		}
+		else
+		{
+			const uint8 fields = changedFields(*currentIt, *previousIt);
+
+			if (fields != REPLICATED_NONE)
+			{
+				auto it = entities_.find(currentIt->networkId);
+				if (it != entities_.end()) update(it->second, *currentIt, fields, snapshot.positionPrecision);
+			}
+
+			++currentIt;
+			++previousIt;
+		}
+	}
+
+	// Push the transforms through the batch setters so they are propagated like any other script change
+	if (!positionEntities_.empty()) scene_->setPositions(ArrayView<ecs::Entity>(positionEntities_), positions_);
+	if (!orientationEntities_.empty()) scene_->setOrientations(ArrayView<ecs::Entity>(orientationEntities_), ArrayView<glm::quat>(orientations_));
+
+	appliedSnapshot_ = snapshot;
+}
+
+void ReplicationClient::create(const ReplicatedEntityState& state, const float32 positionPrecision)
+{
+	auto entity = scene_->createEntity();
+
+	entity.assign<ecs::ReplicatedComponent>(state.networkId, (state.fields & REPLICATED_SCRIPT_STATE) != 0);
+
+	if (state.fields & REPLICATED_POSITION)
+	{
+		entity.assign<ecs::PositionComponent>(dequantizePosition(state.position, positionPrecision));
+	}
+
+	if (state.fields & REPLICATED_ORIENTATION)
+	{
+		entity.assign<ecs::OrientationComponent>(dequantizeOrientation(state.orientation));
+	}
+
+	entities_[state.networkId] = entity;
+
+	// Position and orientation are already set
+	update(entity, state, state.fields & (REPLICATED_PROPERTIES | REPLICATED_SCRIPT_STATE), positionPrecision);
+}
+
+void ReplicationClient::update(ecs::Entity& entity, const ReplicatedEntityState& state, const uint8 fields, const float32 positionPrecision)
+{
+	if (fields & REPLICATED_POSITION)
+	{
+		if (entity.hasComponent<ecs::PositionComponent>())
+		{
+			positionEntities_.push_back(entity);
+			positions_.push_back(dequantizePosition(state.position, positionPrecision));
+		}
+		else
+		{
+			entity.assign<ecs::PositionComponent>(dequantizePosition(state.position, positionPrecision));
+		}
+	}
+
+	if (fields & REPLICATED_ORIENTATION)
+	{
+		if (entity.hasComponent<ecs::OrientationComponent>())
+		{
+			orientationEntities_.push_back(entity);
+			orientations_.push_back(dequantizeOrientation(state.orientation));
+		}
+		else
+		{
+			entity.assign<ecs::OrientationComponent>(dequantizeOrientation(state.orientation));
+		}
+	}
+
+	if (fields & REPLICATED_PROPERTIES)
+	{
+		std::unordered_map<std::string, std::string> properties(state.properties.begin(), state.properties.end());
+
+		if (entity.hasComponent<ecs::PropertiesComponent>())
+		{
+			entity.component<ecs::PropertiesComponent>()->properties = std::move(properties);
+		}
+		else
+		{
+			entity.assign<ecs::PropertiesComponent>(std::move(properties));
+		}
+	}
+
+	// Script state can only be applied once the game has attached a script object to the entity
+	if ((fields & REPLICATED_SCRIPT_STATE) && entity.hasComponent<ecs::ScriptObjectComponent>())
+	{
+		auto scriptObjectComponent = entity.component<ecs::ScriptObjectComponent>();
+
+		if (scriptObjectComponent->scriptObjectHandle)
+		{
+			readReplicationState(gameEngine_->scriptingEngine(), scriptObjectComponent->scriptObjectHandle, state.scriptState, executionContextHandle_);
+		}
+	}
+}
+
+void ReplicationClient::destroy(const uint32 networkId)
+{
+	auto it = entities_.find(networkId);
+	if (it == entities_.end()) return;
+
+	if (it->second) scene_->destroy(it->second);
+
+	entities_.erase(it);
+}
+
+}
+}
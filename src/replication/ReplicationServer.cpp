@@ -0,0 +1,446 @@
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+#include "replication/ReplicationServer.hpp"
+#include "replication/Quantization.hpp"
+
+#include "Scene.hpp"
+#include "GameEngine.hpp"
+
+#include "ecs/ReplicatedComponent.hpp"
+#include "ecs/PropertiesComponent.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+ReplicationServer::ReplicationServer(
+		Scene* scene,
+		GameEngine* gameEngine,
+		const networking::ServerHandle& serverHandle,
+		utilities::Properties* properties,
+		logger::ILogger* logger
+	)
+	:
+		scene_(scene),
+		gameEngine_(gameEngine),
+		serverHandle_(serverHandle),
+		logger_(logger),
+		interestGrid_(properties->getFloatValue("replication.interestcellsize", 32.0f))
+{
+	ticksPerSnapshot_ = static_cast<uint32>(std::max(1, properties->getIntValue("replication.tickspersnapshot", 3)));
+	snapshotHistorySize_ = static_cast<uint32>(std::max(1, properties->getIntValue("replication.snapshothistory", 32)));
+	positionPrecision_ = properties->getFloatValue("replication.positionprecision", 0.01f);
+	midTierRate_ = static_cast<uint32>(std::max(1, properties->getIntValue("replication.midtierrate", 2)));
+	farTierRate_ = static_cast<uint32>(std::max(1, properties->getIntValue("replication.fartierrate", 4)));
+
+	if (positionPrecision_ <= 0.0f)
+	{
+		LOG_WARN(logger_, "Invalid replication position precision %s, using 0.01.", positionPrecision_);
+		positionPrecision_ = 0.01f;
+	}
+
+	executionContextHandle_ = gameEngine_->scriptingEngine()->createExecutionContext();
+
+	gameEngine_->addMessageEventListener(this);
+}
+
+ReplicationServer::~ReplicationServer()
+{
+	gameEngine_->removeMessageEventListener(this);
+	gameEngine_->scriptingEngine()->destroyExecutionContext(executionContextHandle_);
+}
+
+void ReplicationServer::addClient(const networking::RemoteConnectionHandle& remoteConnectionHandle)
+{
+	std::lock_guard<std::mutex> lock(clientsMutex_);
+
+	// Sequence 0 means the client has nothing yet and gets full snapshots until it acknowledges one
+	acknowledgements_[remoteConnectionHandle] = Acknowledgement();
+}
+
+void ReplicationServer::removeClient(const networking::RemoteConnectionHandle& remoteConnectionHandle)
+{
+	{
+		std::lock_guard<std::mutex> lock(clientsMutex_);
+		acknowledgements_.erase(remoteConnectionHandle);
+	}
+
+	std::lock_guard<std::mutex> lock(interestsMutex_);
+	interests_.erase(remoteConnectionHandle);
+}
+
+void ReplicationServer::setInterest(const networking::RemoteConnectionHandle& remoteConnectionHandle, const glm::vec3& position, const float32 radius)
+{
+	setInterest(remoteConnectionHandle, position, ecs::Entity(), radius);
+}
+
+void ReplicationServer::setInterest(const networking::RemoteConnectionHandle& remoteConnectionHandle, const ecs::Entity& entity, const float32 radius)
+{
+	setInterest(remoteConnectionHandle, glm::vec3(0.0f), entity, radius);
+}
+
+void ReplicationServer::setInterest(const networking::RemoteConnectionHandle& remoteConnectionHandle, const glm::vec3& position, const ecs::Entity& entity, const float32 radius)
+{
+	std::lock_guard<std::mutex> lock(interestsMutex_);
+
+	auto it = interests_.find(remoteConnectionHandle);
+
+	if (it == interests_.end())
+	{
+		it = interests_.emplace(remoteConnectionHandle, Interest()).first;
+		resetAcknowledgement(remoteConnectionHandle);
+	}
+
+	it->second.position = position;
+	it->second.entity = entity;
+	it->second.radius = radius;
+}
+
+void ReplicationServer::clearInterest(const networking::RemoteConnectionHandle& remoteConnectionHandle)
+{
+	std::lock_guard<std::mutex> lock(interestsMutex_);
+
+	if (interests_.erase(remoteConnectionHandle) > 0) resetAcknowledgement(remoteConnectionHandle);
+}
+
+void ReplicationServer::resetAcknowledgement(const networking::RemoteConnectionHandle& remoteConnectionHandle)
+{
+	std::lock_guard<std::mutex> lock(clientsMutex_);
+
+	auto it = acknowledgements_.find(remoteConnectionHandle);
+	if (it != acknowledgements_.end())
+	{
+		it->second.sequence = 0;
+		it->second.minimumSequence = sequence_ + 1;
+	}
+}
+
+const networking::ServerHandle& ReplicationServer::serverHandle() const
+{
+	return serverHandle_;
+}
+
+void ReplicationServer::tick()
+{
+	if (++ticks_ < ticksPerSnapshot_) return;
+
+	ticks_ = 0;
+
+	history_.push_back(capture());
+
+	if (history_.size() > snapshotHistorySize_) history_.pop_front();
+
+	send(history_.back());
+}
+
+ReplicationSnapshot ReplicationServer::capture()
+{
+	auto scriptingEngine = gameEngine_->scriptingEngine();
+
+	ReplicationSnapshot snapshot;
+	snapshot.sequence = ++sequence_;
+	snapshot.positionPrecision = positionPrecision_;
+
+	// Copy the view, script callbacks below are free to ask the scene for views of their own
+	const auto view = scene_->entitiesWithComponentsView<ecs::ReplicatedComponent>();
+	entities_.assign(view.begin(), view.end());
+
+	snapshot.entities.reserve(entities_.size());
+
+	// Network ids are saved with the scene, so after a load (or when entities are copied in from another scene) new
+	// ids have to start above every id already in use
+	for (const auto& entity : entities_)
+	{
+		const auto networkId = entity.component<ecs::ReplicatedComponent>()->networkId;
+
+		if (networkId >= nextNetworkId_) nextNetworkId_ = networkId + 1;
+	}
+
+	for (auto& entity : entities_)
+	{
+		auto replicatedComponent = entity.component<ecs::ReplicatedComponent>();
+
+		if (replicatedComponent->networkId == 0) replicatedComponent->networkId = nextNetworkId_++;
+
+		ReplicatedEntityState state;
+		state.networkId = replicatedComponent->networkId;
+		state.priority = replicatedComponent->priority;
+
+		if (entity.hasComponent<ecs::PositionComponent>())
+		{
+			state.fields |= REPLICATED_POSITION;
+			state.position = quantizePosition(entity.component<ecs::PositionComponent>()->position, positionPrecision_);
+		}
+
+		if (entity.hasComponent<ecs::OrientationComponent>())
+		{
+			state.fields |= REPLICATED_ORIENTATION;
+			state.orientation = quantizeOrientation(entity.component<ecs::OrientationComponent>()->orientation);
+		}
+
+		if (entity.hasComponent<ecs::PropertiesComponent>())
+		{
+			const auto& properties = entity.component<ecs::PropertiesComponent>()->properties;
+
+			state.fields |= REPLICATED_PROPERTIES;
+			state.properties.assign(properties.begin(), properties.end());
+
+			// Unordered map iteration order is not stable, so sort to make the states comparable
+			std::sort(state.properties.begin(), state.properties.end());
+		}
+
+		if (replicatedComponent->scriptState && entity.hasComponent<ecs::ScriptObjectComponent>())
+		{
+			auto scriptObjectComponent = entity.component<ecs::ScriptObjectComponent>();
+
+			if (scriptObjectComponent->scriptObjectHandle)
+			{
+				auto builder = gameEngine_->createMessageBufferBuilder();
+
+				scripting::ParameterList params;
+				params.addRef(builder);
+
+				scriptingEngine->execute(scriptObjectComponent->scriptObjectHandle, std::string("void writeReplicationState(MessageBufferBuilder& out)"), params, executionContextHandle_);
+
+				const auto buffer = builder.build();
+
+				state.fields |= REPLICATED_SCRIPT_STATE;
+				state.scriptState.assign(buffer.data(), buffer.data() + buffer.size());
+			}
+		}
+
+		snapshot.entities.push_back(std::move(state));
+	}
+
+	std::sort(snapshot.entities.begin(), snapshot.entities.end(), [](const ReplicatedEntityState& a, const ReplicatedEntityState& b) {
+		return a.networkId < b.networkId;
+	});
+
+	return snapshot;
+}
+
+const ReplicationSnapshot* ReplicationServer::findSnapshot(const std::deque<ReplicationSnapshot>& history, const uint32 sequence) const
+{
+	if (sequence == 0) return nullptr;
+
+	const auto it = std::lower_bound(history.begin(), history.end(), sequence, [](const ReplicationSnapshot& snapshot, const uint32 sequence) {
+		return snapshot.sequence < sequence;
+	});
+
+	return (it != history.end() && it->sequence == sequence) ? &*it : nullptr;
+}
+
+uint32 ReplicationServer::updateRate(const float32 distanceSquared, const float32 radius, const uint8 priority) const
+{
+	const float32 third = radius / 3.0f;
+
+	int32 tier = 0;
+	if (distanceSquared > (2.0f * third) * (2.0f * third)) tier = 2;
+	else if (distanceSquared > third * third) tier = 1;
+
+	tier = std::max(0, tier - static_cast<int32>(priority));
+
+	switch (tier)
+	{
+		case 0:
+			return 1;
+
+		case 1:
+			return midTierRate_;
+
+		default:
+			return farTierRate_;
+	}
+}
+
+ReplicationSnapshot ReplicationServer::filter(const ReplicationSnapshot& snapshot, const Interest& interest)
+{
+	ReplicationSnapshot filtered;
+	filtered.sequence = snapshot.sequence;
+	filtered.positionPrecision = snapshot.positionPrecision;
+
+	auto position = interest.position;
+
+	if (interest.entity && interest.entity.hasComponent<ecs::PositionComponent>())
+	{
+		position = interest.entity.component<ecs::PositionComponent>()->position;
+	}
+
+	interestGridResults_.clear();
+	interestGrid_.query(position, interest.radius, interestGridResults_);
+
+	filtered.entities.reserve(interestGridResults_.size());
+
+	// What the client was last sent, entities that are not due an update keep that state
+	const ReplicationSnapshot* previous = interest.history.empty() ? nullptr : &interest.history.back();
+	auto previousIt = previous ? previous->entities.begin() : std::vector<ReplicatedEntityState>::const_iterator();
+
+	for (const auto& result : interestGridResults_)
+	{
+		const auto& state = snapshot.entities[result.index];
+
+		const uint32 rate = updateRate(result.distanceSquared, interest.radius, state.priority);
+
+		if (rate > 1 && snapshot.sequence % rate != 0 && previous)
+		{
+			while (previousIt != previous->entities.end() && previousIt->networkId < state.networkId) ++previousIt;
+
+			if (previousIt != previous->entities.end() && previousIt->networkId == state.networkId)
+			{
+				filtered.entities.push_back(*previousIt);
+				continue;
+			}
+		}
+
+		filtered.entities.push_back(state);
+	}
+
+	return filtered;
+}
+
+void ReplicationServer::send(const ReplicationSnapshot& snapshot)
+{
+	PROFILER_SCOPE(gameEngine_->profiler(), "ReplicationServer::send");
+
+	std::vector<std::pair<networking::RemoteConnectionHandle, uint32>> clients;
+
+	{
+		std::lock_guard<std::mutex> lock(clientsMutex_);
+
+		clients.reserve(acknowledgements_.size());
+
+		for (const auto& kv : acknowledgements_)
+		{
+			const uint32 sequence = kv.second.sequence >= kv.second.minimumSequence ? kv.second.sequence : 0;
+
+			clients.emplace_back(kv.first, sequence);
+		}
+	}
+
+	auto networkingEngine = gameEngine_->networkingEngine();
+
+	// Group the clients without an area of interest by the baseline they will be sent, every client in a group gets
+	// the same bytes
+	std::map<uint32, std::vector<networking::RemoteConnectionHandle>> clientsByBaseline;
+
+	bool interestGridBuilt = false;
+	uint64 bytesSent = 0;
+	uint64 relevantEntities = 0;
+
+	std::unique_lock<std::mutex> interestsLock(interestsMutex_);
+
+	for (const auto& client : clients)
+	{
+		auto it = interests_.find(client.first);
+
+		if (it == interests_.end())
+		{
+			// Fall back to a full snapshot if the acknowledged one has dropped out of our history
+			const uint32 baselineSequence = findSnapshot(history_, client.second) ? client.second : 0;
+
+			clientsByBaseline[baselineSequence].push_back(client.first);
+			continue;
+		}
+
+		if (!interestGridBuilt)
+		{
+			PROFILER_SCOPE(gameEngine_->profiler(), "ReplicationServer::buildInterestGrid");
+			interestGrid_.build(snapshot);
+			interestGridBuilt = true;
+		}
+
+		auto& interest = it->second;
+
+		auto filtered = filter(snapshot, interest);
+
+		auto builder = gameEngine_->createMessageBufferBuilder();
+		writeSnapshot(builder, filtered, findSnapshot(interest.history, client.second));
+
+		const auto buffer = builder.build();
+
+		networkingEngine->send(serverHandle_, client.first, buffer);
+
+		bytesSent += buffer.size();
+		relevantEntities += filtered.entities.size();
+
+		interest.history.push_back(std::move(filtered));
+
+		if (interest.history.size() > snapshotHistorySize_) interest.history.pop_front();
+	}
+
+	interestsLock.unlock();
+
+	for (const auto& kv : clientsByBaseline)
+	{
+		auto builder = gameEngine_->createMessageBufferBuilder();
+
+		writeSnapshot(builder, snapshot, findSnapshot(history_, kv.first));
+
+		const auto buffer = builder.build();
+
+		LOG_TRACE(logger_, "Sending replication snapshot %s with baseline %s (%s bytes) to %s clients.", snapshot.sequence, kv.first, buffer.size(), kv.second.size());
+
+		networkingEngine->send(serverHandle_, kv.second, buffer);
+
+		bytesSent += buffer.size();
+		relevantEntities += snapshot.entities.size() * kv.second.size();
+	}
+
+	if (auto profiler = gameEngine_->profiler())
+	{
+		profiler->counter("ReplicationServer::bytesSent", static_cast<int64>(bytesSent));
+		profiler->counter("ReplicationServer::relevantEntities", static_cast<int64>(relevantEntities));
+	}
+}
+
+bool ReplicationServer::processEvent(const networking::MessageEvent& event)
+{
+	networking::MessageEventView messageEventView;
+	static_cast<networking::GenericEvent&>(messageEventView) = event;
+	messageEventView.message = event.message.view();
+
+	return processEvent(networking::MessageEventBatch(&messageEventView, 1));
+}
+
+bool ReplicationServer::processEvent(const networking::MessageEventBatch& messageEventBatch)
+{
+	bool processed = false;
+
+	for (const auto& messageEvent : messageEventBatch)
+	{
+		if (messageEvent.serverHandle != serverHandle_) continue;
+
+		networking::MessageBufferReader reader(messageEvent.message);
+
+		try
+		{
+			if (readMessageType(reader) != ReplicationMessageType::ACKNOWLEDGE) continue;
+
+			const uint32 sequence = readAcknowledge(reader);
+
+			std::lock_guard<std::mutex> lock(clientsMutex_);
+
+			auto it = acknowledgements_.find(messageEvent.remoteConnectionHandle);
+			if (it != acknowledgements_.end() && sequence >= it->second.minimumSequence)
+			{
+				// Acknowledgements can arrive out of order, only ever move forward
+				it->second.sequence = std::max(it->second.sequence, sequence);
+			}
+
+			processed = true;
+		}
+		catch (const std::exception& e)
+		{
+			// Anything in a message can be wrong, so every decode error drops the message rather than the process
+			LOG_WARN(logger_, "Received malformed replication message: %s", e.what());
+		}
+	}
+
+	return processed;
+}
+
+}
+}
@@ -0,0 +1,274 @@
+#include <stdexcept>
+
+#include "replication/ReplicationSnapshot.hpp"
+
+namespace ice_engine
+{
+namespace replication
+{
+
+namespace
+{
+/**
+ * Throws std::out_of_range if count items of at least minimumSize bytes each can't fit in the rest of the message.
+ *
+ * Counts come straight from the network, so they are checked before anything is allocated for them.
+ */
+void requireCount(const networking::MessageBufferReader& reader, const uint32 count, const size_t minimumSize)
+{
+	if (static_cast<uint64>(count) * minimumSize > reader.remaining())
+	{
+		throw std::out_of_range("Replication message count exceeds the size of the message.");
+	}
+}
+
+void writeFields(networking::MessageBufferBuilder& builder, const ReplicatedEntityState& state, const uint8 fields)
+{
+	builder.writeUInt32(state.networkId);
+	builder.writeUInt8(fields);
+
+	if (fields & REPLICATED_POSITION)
+	{
+		builder.writeInt32(state.position.x);
+		builder.writeInt32(state.position.y);
+		builder.writeInt32(state.position.z);
+	}
+
+	if (fields & REPLICATED_ORIENTATION)
+	{
+		builder.writeUInt32(state.orientation);
+	}
+
+	if (fields & REPLICATED_PROPERTIES)
+	{
+		builder.writeUInt32(static_cast<uint32>(state.properties.size()));
+
+		for (const auto& property : state.properties)
+		{
+			builder.writeString(property.first);
+			builder.writeString(property.second);
+		}
+	}
+
+	if (fields & REPLICATED_SCRIPT_STATE)
+	{
+		builder.writeUInt32(static_cast<uint32>(state.scriptState.size()));
+		builder.writeBytes(state.scriptState.data(), state.scriptState.size());
+	}
+}
+
+void readFields(networking::MessageBufferReader& reader, ReplicatedEntityState& state, const uint8 fields)
+{
+	if (fields & REPLICATED_POSITION)
+	{
+		state.position.x = reader.readInt32();
+		state.position.y = reader.readInt32();
+		state.position.z = reader.readInt32();
+	}
+
+	if (fields & REPLICATED_ORIENTATION)
+	{
+		state.orientation = reader.readUInt32();
+	}
+
+	if (fields & REPLICATED_PROPERTIES)
+	{
+		const uint32 numberOfProperties = reader.readUInt32();
+
+		// A key and a value, each at least a string length
+		requireCount(reader, numberOfProperties, 2 * sizeof(uint32));
+
+		state.properties.clear();
+
+		for (uint32 i = 0; i < numberOfProperties; ++i)
+		{
+			auto key = reader.readString();
+			auto value = reader.readString();
+
+			state.properties.emplace_back(std::move(key), std::move(value));
+		}
+	}
+
+	if (fields & REPLICATED_SCRIPT_STATE)
+	{
+		const uint32 size = reader.readUInt32();
+
+		requireCount(reader, size, sizeof(uint8));
+
+		state.scriptState.resize(size);
+		reader.readBytes(state.scriptState.data(), size);
+	}
+
+	state.fields |= fields;
+}
+}
+
+uint8 changedFields(const ReplicatedEntityState& current, const ReplicatedEntityState& baseline)
+{
+	uint8 fields = current.fields & ~baseline.fields;
+
+	const uint8 common = current.fields & baseline.fields;
+
+	if ((common & REPLICATED_POSITION) && current.position != baseline.position) fields |= REPLICATED_POSITION;
+	if ((common & REPLICATED_ORIENTATION) && current.orientation != baseline.orientation) fields |= REPLICATED_ORIENTATION;
+	if ((common & REPLICATED_PROPERTIES) && current.properties != baseline.properties) fields |= REPLICATED_PROPERTIES;
+	if ((common & REPLICATED_SCRIPT_STATE) && current.scriptState != baseline.scriptState) fields |= REPLICATED_SCRIPT_STATE;
+
+	return fields;
+}
+
+ReplicationMessageType readMessageType(networking::MessageBufferReader& reader)
+{
+	if (reader.remaining() < sizeof(uint32) + sizeof(uint8)) return ReplicationMessageType::UNKNOWN;
+	if (reader.readUInt32() != REPLICATION_MESSAGE_MAGIC) return ReplicationMessageType::UNKNOWN;
+
+	const auto type = static_cast<ReplicationMessageType>(reader.readUInt8());
+
+	switch (type)
+	{
+		case ReplicationMessageType::SNAPSHOT:
+		case ReplicationMessageType::ACKNOWLEDGE:
+			return type;
+
+		default:
+			return ReplicationMessageType::UNKNOWN;
+	}
+}
+
+void writeSnapshot(networking::MessageBufferBuilder& builder, const ReplicationSnapshot& snapshot, const ReplicationSnapshot* baseline)
+{
+	static const ReplicationSnapshot emptySnapshot;
+
+	const auto& previous = baseline ? *baseline : emptySnapshot;
+
+	// Work out what changed first so the entity count can go in the header
+	std::vector<std::pair<const ReplicatedEntityState*, uint8>> entries;
+	entries.reserve(snapshot.entities.size());
+
+	auto currentIt = snapshot.entities.begin();
+	auto previousIt = previous.entities.begin();
+
+	while (currentIt != snapshot.entities.end() || previousIt != previous.entities.end())
+	{
+		if (previousIt == previous.entities.end() || (currentIt != snapshot.entities.end() && currentIt->networkId < previousIt->networkId))
+		{
+			entries.emplace_back(&*currentIt, currentIt->fields);
+			++currentIt;
+		}
+		else if (currentIt == snapshot.entities.end() || previousIt->networkId < currentIt->networkId)
+		{
+			entries.emplace_back(&*previousIt, REPLICATED_REMOVED);
+			++previousIt;
+		}
+		else
+		{
+			const uint8 fields = changedFields(*currentIt, *previousIt);
+			if (fields != REPLICATED_NONE) entries.emplace_back(&*currentIt, fields);
+
+			++currentIt;
+			++previousIt;
+		}
+	}
+
+	builder.writeUInt32(REPLICATION_MESSAGE_MAGIC);
+	builder.writeUInt8(static_cast<uint8>(ReplicationMessageType::SNAPSHOT));
+	builder.writeUInt32(snapshot.sequence);
+	builder.writeUInt32(baseline ? baseline->sequence : 0);
+	builder.writeFloat(snapshot.positionPrecision);
+	builder.writeUInt32(static_cast<uint32>(entries.size()));
+
+	for (const auto& entry : entries)
+	{
+		if (entry.second & REPLICATED_REMOVED)
+		{
+			builder.writeUInt32(entry.first->networkId);
+			builder.writeUInt8(REPLICATED_REMOVED);
+		}
+		else
+		{
+			writeFields(builder, *entry.first, entry.second);
+		}
+	}
+}
+
+ReplicationSnapshotHeader readSnapshotHeader(networking::MessageBufferReader& reader)
+{
+	ReplicationSnapshotHeader header;
+	header.sequence = reader.readUInt32();
+	header.baselineSequence = reader.readUInt32();
+	header.positionPrecision = reader.readFloat();
+	header.numberOfEntities = reader.readUInt32();
+
+	return header;
+}
+
+ReplicationSnapshot readSnapshot(networking::MessageBufferReader& reader, const ReplicationSnapshotHeader& header, const ReplicationSnapshot* baseline)
+{
+	static const ReplicationSnapshot emptySnapshot;
+
+	const auto& previous = baseline ? *baseline : emptySnapshot;
+
+	ReplicationSnapshot snapshot;
+	snapshot.sequence = header.sequence;
+	snapshot.positionPrecision = header.positionPrecision;
+
+	// Each entity is at least a network id and its fields
+	requireCount(reader, header.numberOfEntities, sizeof(uint32) + sizeof(uint8));
+
+	snapshot.entities.reserve(previous.entities.size() + header.numberOfEntities);
+
+	auto previousIt = previous.entities.begin();
+
+	// Entries are written in network id order, so we can merge them with the baseline in a single pass
+	for (uint32 i = 0; i < header.numberOfEntities; ++i)
+	{
+		const uint32 networkId = reader.readUInt32();
+		const uint8 fields = reader.readUInt8();
+
+		while (previousIt != previous.entities.end() && previousIt->networkId < networkId)
+		{
+			snapshot.entities.push_back(*previousIt);
+			++previousIt;
+		}
+
+		const bool inBaseline = previousIt != previous.entities.end() && previousIt->networkId == networkId;
+
+		if (fields & REPLICATED_REMOVED)
+		{
+			if (inBaseline) ++previousIt;
+			continue;
+		}
+
+		if (inBaseline)
+		{
+			snapshot.entities.push_back(*previousIt);
+			++previousIt;
+		}
+		else
+		{
+			snapshot.entities.push_back(ReplicatedEntityState());
+			snapshot.entities.back().networkId = networkId;
+		}
+
+		readFields(reader, snapshot.entities.back(), fields);
+	}
+
+	snapshot.entities.insert(snapshot.entities.end(), previousIt, previous.entities.end());
+
+	return snapshot;
+}
+
+void writeAcknowledge(networking::MessageBufferBuilder& builder, const uint32 sequence)
+{
+	builder.writeUInt32(REPLICATION_MESSAGE_MAGIC);
+	builder.writeUInt8(static_cast<uint8>(ReplicationMessageType::ACKNOWLEDGE));
+	builder.writeUInt32(sequence);
+}
+
+uint32 readAcknowledge(networking::MessageBufferReader& reader)
+{
+	return reader.readUInt32();
+}
+
+}
+}
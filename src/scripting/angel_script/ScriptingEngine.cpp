@@ -270,6 +270,14 @@ void ScriptingEngine::initialize()
 	engine_ = asCreateScriptEngine(ANGELSCRIPT_VERSION);
 	engine_->SetEngineProperty(asEP_AUTO_GARBAGE_COLLECT, false);
 
+	// Lets bindings take value types such as vectorRaycast as &inout, so batch calls fill the script's own buffers in
+	// place instead of filling a temporary and copying it back
+	engine_->SetEngineProperty(asEP_ALLOW_UNSAFE_REFERENCES, true);
+
+	garbageCollectorStepsPerTick_ = static_cast<uint32>(properties_->getIntValue("scripting.gcstepspertick", 1));
+	garbageCollectorMaximumSize_ = static_cast<uint32>(properties_->getIntValue("scripting.gcmaximumsize", 0));
+	maximumPooledScriptObjectsPerType_ = static_cast<uint32>(properties_->getIntValue("scripting.maximumpooledobjectspertype", 1024));
+
     engine_->SetTranslateAppExceptionCallback(asFUNCTION(translateException), 0, asCALL_CDECL);
 
 	// Set the message callback to receive information on errors in human readable form.
@@ -368,6 +376,50 @@ void ScriptingEngine::initialize()
         asCALL_THISCALL_ASGLOBAL,
         this
     );
+    registerGlobalFunction(
+        "ref@ acquireScriptObject(const ModuleHandle& in, const string& in, const string& in, const ExecutionContextHandle& in =  ExecutionContextHandle(0))",
+        asMETHOD(ScriptingEngine, acquireScriptObject),
+        asCALL_THISCALL_ASGLOBAL,
+        this
+    );
+    registerGlobalFunction(
+        "void recycleScriptObject(ref@)",
+        asMETHOD(ScriptingEngine, recycleScriptObject),
+        asCALL_THISCALL_ASGLOBAL,
+        this
+    );
+    registerGlobalFunction(
+        "void clearScriptObjectPool(const ModuleHandle& in)",
+        asMETHOD(ScriptingEngine, clearScriptObjectPool),
+        asCALL_THISCALL_ASGLOBAL,
+        this
+    );
+
+    registerObjectType("GarbageCollectorStatistics", sizeof(GarbageCollectorStatistics), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS_ALLINTS | asGetTypeTraits<GarbageCollectorStatistics>());
+    registerObjectProperty("GarbageCollectorStatistics", "uint32 currentSize", asOFFSET(GarbageCollectorStatistics, currentSize));
+    registerObjectProperty("GarbageCollectorStatistics", "uint32 totalDestroyed", asOFFSET(GarbageCollectorStatistics, totalDestroyed));
+    registerObjectProperty("GarbageCollectorStatistics", "uint32 totalDetected", asOFFSET(GarbageCollectorStatistics, totalDetected));
+    registerObjectProperty("GarbageCollectorStatistics", "uint32 newObjects", asOFFSET(GarbageCollectorStatistics, newObjects));
+    registerObjectProperty("GarbageCollectorStatistics", "uint32 totalNewDestroyed", asOFFSET(GarbageCollectorStatistics, totalNewDestroyed));
+
+    registerGlobalFunction(
+        "void garbageCollect(const uint32)",
+        asMETHOD(ScriptingEngine, garbageCollect),
+        asCALL_THISCALL_ASGLOBAL,
+        this
+    );
+    registerGlobalFunction(
+        "void garbageCollectFullCycle()",
+        asMETHOD(ScriptingEngine, garbageCollectFullCycle),
+        asCALL_THISCALL_ASGLOBAL,
+        this
+    );
+    registerGlobalFunction(
+        "GarbageCollectorStatistics getGarbageCollectorStatistics()",
+        asMETHOD(ScriptingEngine, getGarbageCollectorStatistics),
+        asCALL_THISCALL_ASGLOBAL,
+        this
+    );
 
 	// initialize default context
 	auto handle = contextData_.create();
@@ -530,18 +582,13 @@ CScriptHandle ScriptingEngine::createScriptObjectReturnAsScriptHandle(const Modu
 
 asIScriptObject* ScriptingEngine::createScriptObject(const ModuleHandle& moduleHandle, const std::string& objectName, const std::string& factoryName, const ExecutionContextHandle& executionContextHandle)
 {
-    auto module = moduleData_[moduleHandle].module;
+    asIScriptFunction* factory = nullptr;
 
-    asITypeInfo* type = module->GetTypeInfoByDecl(objectName.c_str());
-    if (type == nullptr)
     {
-        throw InvalidArgumentException(std::string("Object type with name '") + objectName + "' doesn't exist.");
-    }
+        std::lock_guard<std::mutex> lock(scriptObjectPoolMutex_);
 
-    asIScriptFunction* factory = type->GetFactoryByDecl(factoryName.c_str());
-    if (type == nullptr)
-    {
-        throw InvalidArgumentException(std::string("Factory with name '") + factoryName + "' doesn't exist for object type with name '" + objectName + "'.");
+        auto& scriptTypeData = getScriptTypeData(moduleData_[moduleHandle], objectName);
+        factory = getFactory(scriptTypeData, objectName, factoryName);
     }
 
     auto context = getContext(executionContextHandle);
@@ -551,6 +598,146 @@ asIScriptObject* ScriptingEngine::createScriptObject(const ModuleHandle& moduleH
     return obj;
 }
 
+CScriptHandle ScriptingEngine::acquireScriptObject(const ModuleHandle& moduleHandle, const std::string& objectName, const std::string& factoryName, const ExecutionContextHandle& executionContextHandle)
+{
+    asIScriptObject* object = nullptr;
+    asIScriptFunction* reset = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(scriptObjectPoolMutex_);
+
+        auto& moduleData = moduleData_[moduleHandle];
+        auto& pool = moduleData.pools[getScriptTypeData(moduleData, objectName).type];
+
+        if (!pool.objects.empty())
+        {
+            object = pool.objects.back();
+            pool.objects.pop_back();
+            reset = pool.reset;
+        }
+    }
+
+    if (object == nullptr)
+    {
+        object = createScriptObject(moduleHandle, objectName, factoryName, executionContextHandle);
+    }
+    else if (reset != nullptr)
+    {
+        try
+        {
+            callFunction(getContext(executionContextHandle), reset, object);
+        }
+        catch (...)
+        {
+            object->Release();
+            throw;
+        }
+    }
+
+    CScriptHandle handle = CScriptHandle();
+
+    handle.Set(object, object->GetObjectType());
+
+    // The handle holds its own reference now
+    object->Release();
+
+    return handle;
+}
+
+void ScriptingEngine::recycleScriptObject(CScriptHandle handle)
+{
+    auto type = handle.GetType();
+
+    if (type == nullptr || !(type->GetFlags() & asOBJ_SCRIPT_OBJECT))
+    {
+        throw InvalidArgumentException("Only script objects can be recycled.");
+    }
+
+    auto object = static_cast<asIScriptObject*>(handle.GetRef());
+
+    std::lock_guard<std::mutex> lock(scriptObjectPoolMutex_);
+
+    for (auto& moduleData : moduleData_)
+    {
+        if (moduleData.module != type->GetModule())
+        {
+            continue;
+        }
+
+        auto& pool = moduleData.pools[type];
+
+        if (pool.objects.size() < maximumPooledScriptObjectsPerType_)
+        {
+            if (pool.objects.empty()) pool.reset = type->GetMethodByDecl("void reset()");
+
+            object->AddRef();
+            pool.objects.push_back(object);
+        }
+
+        return;
+    }
+
+    LOG_WARN(logger_, "Unable to recycle script object of type '%s' - module not found.", type->GetName());
+}
+
+void ScriptingEngine::clearScriptObjectPool(const ModuleHandle& moduleHandle)
+{
+    std::lock_guard<std::mutex> lock(scriptObjectPoolMutex_);
+
+    releaseScriptObjectPool(moduleData_[moduleHandle]);
+}
+
+ScriptTypeData& ScriptingEngine::getScriptTypeData(ScriptModuleData& moduleData, const std::string& objectName)
+{
+    auto& scriptTypeData = moduleData.types[objectName];
+
+    if (scriptTypeData.type == nullptr)
+    {
+        scriptTypeData.type = moduleData.module->GetTypeInfoByDecl(objectName.c_str());
+
+        if (scriptTypeData.type == nullptr)
+        {
+            moduleData.types.erase(objectName);
+            throw InvalidArgumentException(std::string("Object type with name '") + objectName + "' doesn't exist.");
+        }
+    }
+
+    return scriptTypeData;
+}
+
+asIScriptFunction* ScriptingEngine::getFactory(ScriptTypeData& scriptTypeData, const std::string& objectName, const std::string& factoryName)
+{
+    auto it = scriptTypeData.factories.find(factoryName);
+
+    if (it != scriptTypeData.factories.end())
+    {
+        return it->second;
+    }
+
+    asIScriptFunction* factory = scriptTypeData.type->GetFactoryByDecl(factoryName.c_str());
+    if (factory == nullptr)
+    {
+        throw InvalidArgumentException(std::string("Factory with name '") + factoryName + "' doesn't exist for object type with name '" + objectName + "'.");
+    }
+
+    scriptTypeData.factories[factoryName] = factory;
+
+    return factory;
+}
+
+void ScriptingEngine::releaseScriptObjectPool(ScriptModuleData& moduleData)
+{
+    for (auto& kv : moduleData.pools)
+    {
+        for (auto object : kv.second.objects)
+        {
+            object->Release();
+        }
+    }
+
+    moduleData.pools.clear();
+}
+
 void ScriptingEngine::setArguments(asIScriptContext* context, ParameterList& arguments) const
 {
 	int32 r = 0;
@@ -1870,6 +2057,7 @@ ModuleHandle ScriptingEngine::createModule(const std::string& name, const std::v
     auto handle = moduleData_.create();
     auto& moduleData = moduleData_[handle];
     moduleData.module = module;
+    moduleData.types.clear();
 
 	return handle;
 }
@@ -1914,6 +2102,12 @@ void ScriptingEngine::destroyModule(const ModuleHandle& moduleHandle)
 
 	LOG_TRACE(logger_, "Releasing module: %s", moduleData.module->GetName());
 
+	{
+		std::lock_guard<std::mutex> lock(scriptObjectPoolMutex_);
+		releaseScriptObjectPool(moduleData);
+		moduleData.types.clear();
+	}
+
 	moduleData.module->Discard();
 
 	moduleData_.destroy(moduleHandle);
@@ -1961,7 +2155,57 @@ void ScriptingEngine::releaseAllScriptFunctions()
 
 void ScriptingEngine::tick(const float32 delta)
 {
-    engine_->GarbageCollect();
+    garbageCollect(garbageCollectorStepsPerTick_);
+}
+
+void ScriptingEngine::garbageCollect(const uint32 numberOfSteps)
+{
+    if (numberOfSteps == 0)
+    {
+        return;
+    }
+
+    engine_->GarbageCollect(asGC_ONE_STEP, numberOfSteps);
+
+    // Incremental collection can fall behind if scripts produce garbage faster than we collect it
+    if (garbageCollectorMaximumSize_ > 0)
+    {
+        asUINT currentSize = 0;
+        engine_->GetGCStatistics(&currentSize);
+
+        if (currentSize > garbageCollectorMaximumSize_)
+        {
+            LOG_DEBUG(logger_, "Garbage collector size %s exceeds maximum of %s - running full cycle", currentSize, garbageCollectorMaximumSize_);
+
+            garbageCollectFullCycle();
+        }
+    }
+}
+
+void ScriptingEngine::garbageCollectFullCycle()
+{
+    engine_->GarbageCollect(asGC_FULL_CYCLE);
+}
+
+GarbageCollectorStatistics ScriptingEngine::getGarbageCollectorStatistics() const
+{
+    GarbageCollectorStatistics statistics;
+
+    asUINT currentSize = 0;
+    asUINT totalDestroyed = 0;
+    asUINT totalDetected = 0;
+    asUINT newObjects = 0;
+    asUINT totalNewDestroyed = 0;
+
+    engine_->GetGCStatistics(&currentSize, &totalDestroyed, &totalDetected, &newObjects, &totalNewDestroyed);
+
+    statistics.currentSize = static_cast<uint32>(currentSize);
+    statistics.totalDestroyed = static_cast<uint32>(totalDestroyed);
+    statistics.totalDetected = static_cast<uint32>(totalDetected);
+    statistics.newObjects = static_cast<uint32>(newObjects);
+    statistics.totalNewDestroyed = static_cast<uint32>(totalNewDestroyed);
+
+    return statistics;
 }
 
 void ScriptingEngine::registerGlobalFunction(const std::string& name, const asSFuncPtr& funcPointer, asDWORD callConv, void* objForThiscall)
@@ -2124,6 +2368,7 @@ void ScriptingEngine::destroyAllModules()
 	for ( auto& m : moduleData_ )
 	{
 		LOG_TRACE(logger_, "Destroying module with name '%s'", m.module->GetName())
+		releaseScriptObjectPool(m);
 		m.module->Discard();
 	}
 
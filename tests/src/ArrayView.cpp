@@ -0,0 +1,56 @@
+#include <stdexcept>
+#include <vector>
+
+#define BOOST_TEST_MODULE ArrayView
+#include <boost/test/unit_test.hpp>
+
+#include "ArrayView.hpp"
+
+#include "BindingDelegateUtilities.hpp"
+
+using namespace ice_engine;
+
+typedef ArrayViewRegisterHelper<ArrayView<int>, int> ArrayViewBase;
+
+BOOST_AUTO_TEST_SUITE(ArrayView)
+
+BOOST_AUTO_TEST_CASE(scriptAccessorsAreBoundsChecked)
+{
+	std::vector<int> data = {1, 2, 3};
+	ice_engine::ArrayView<int> view(data);
+
+	BOOST_CHECK_EQUAL(ArrayViewBase::index(2, &view), 3);
+	BOOST_CHECK_THROW(ArrayViewBase::index(3, &view), std::out_of_range);
+	BOOST_CHECK_EQUAL(ArrayViewBase::front(&view), 1);
+	BOOST_CHECK_EQUAL(ArrayViewBase::back(&view), 3);
+
+	ice_engine::ArrayView<int> empty;
+
+	BOOST_CHECK_THROW(ArrayViewBase::front(&empty), std::out_of_range);
+	BOOST_CHECK_THROW(ArrayViewBase::back(&empty), std::out_of_range);
+	BOOST_CHECK_THROW(ArrayViewBase::index(0, &empty), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(viewsOfRefilledStorageAreStale)
+{
+	std::vector<int> data = {1, 2, 3};
+	uint32 generation = 0;
+
+	ice_engine::ArrayView<int> view(data, &generation);
+	BOOST_CHECK(!view.stale());
+	BOOST_CHECK_EQUAL(ArrayViewBase::size(&view), 3u);
+
+	data.assign(100, 0);
+	++generation;
+
+	BOOST_CHECK(view.stale());
+	BOOST_CHECK_THROW(ArrayViewBase::size(&view), std::logic_error);
+	BOOST_CHECK_THROW(ArrayViewBase::index(0, &view), std::logic_error);
+	BOOST_CHECK_THROW(ArrayViewBase::front(&view), std::logic_error);
+	BOOST_CHECK_THROW(view.requireCurrent(), std::logic_error);
+
+	ice_engine::ArrayView<int> current(data, &generation);
+	BOOST_CHECK_EQUAL(ArrayViewBase::size(&current), 100u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
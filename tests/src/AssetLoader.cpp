@@ -0,0 +1,189 @@
+#include <deque>
+#include <stdexcept>
+
+#define BOOST_TEST_MODULE AssetLoader
+#include <boost/test/unit_test.hpp>
+
+#include "AssetLoader.hpp"
+#include "OpenGlLoader.hpp"
+
+#include "logger/Logger.hpp"
+
+using namespace ice_engine;
+
+/**
+ * Runs posted work only when asked to, so tests control when decoding happens.
+ */
+class ManualThreadPool : public IThreadPool
+{
+public:
+	std::future<void> postWork(const std::function<void()>& work) override
+	{
+		work_.push_back(std::packaged_task<void()>(work));
+		return work_.back().get_future();
+	}
+
+	std::future<void> postWork(std::function<void()>&& work) override
+	{
+		work_.push_back(std::packaged_task<void()>(std::move(work)));
+		return work_.back().get_future();
+	}
+
+	void waitAll() override {}
+	void joinAll() override {}
+
+	uint32 getActiveWorkerCount() const override { return 0; }
+	uint32 getInactiveWorkerCount() const override { return 1; }
+	uint32 getWorkQueueCount() const override { return static_cast<uint32>(work_.size()); }
+	uint32 getWorkQueueSize() const override { return static_cast<uint32>(work_.size()); }
+	void increaseWorkerCountBy(uint32 n) override {}
+	void decreaseWorkerCountBy(uint32 n) override {}
+
+	void runAll()
+	{
+		while (!work_.empty())
+		{
+			auto work = std::move(work_.front());
+			work_.pop_front();
+			work();
+		}
+	}
+
+private:
+	std::deque<std::packaged_task<void()>> work_;
+};
+
+struct Fixture
+{
+	Fixture() : assetLoader(&threadPool, &openGlLoader, &logger)
+	{
+	}
+
+	void runFrames()
+	{
+		while (threadPool.getWorkQueueCount() != 0u || openGlLoader.getWorkQueueCount() != 0u)
+		{
+			threadPool.runAll();
+			while (openGlLoader.getWorkQueueCount() != 0u) openGlLoader.tick();
+		}
+	}
+
+	AssetLoadRequest request(const std::string& name, const std::vector<std::string>& dependencies = {})
+	{
+		AssetLoadRequest request;
+		request.name = name;
+		request.dependencies = dependencies;
+		request.decode = [this, name]() { events.push_back("decode " + name); };
+		request.upload = [this, name]() { events.push_back("upload " + name); };
+
+		return request;
+	}
+
+	ManualThreadPool threadPool;
+	OpenGlLoader openGlLoader;
+	ice_engine::logger::Logger logger;
+	AssetLoader assetLoader;
+
+	std::vector<std::string> events;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AssetLoaderTests, Fixture)
+
+BOOST_AUTO_TEST_CASE(dependenciesLoadFirst)
+{
+	std::vector<std::string> loaded;
+	const auto callback = [&loaded](const std::string& name, const std::exception_ptr& error) {
+		BOOST_CHECK(!error);
+		loaded.push_back(name);
+	};
+
+	assetLoader.load(request("model", {"texture0", "texture1"}), callback);
+	assetLoader.load(request("texture0"), callback);
+	assetLoader.load(request("texture1"), callback);
+
+	BOOST_CHECK(assetLoader.state("model") == AssetLoadState::WAITING);
+	BOOST_CHECK_EQUAL(assetLoader.pendingCount(), 3u);
+
+	runFrames();
+
+	const std::vector<std::string> expectedEvents = {"decode texture0", "decode texture1", "upload texture0", "upload texture1", "decode model", "upload model"};
+	BOOST_CHECK(events == expectedEvents);
+
+	const std::vector<std::string> expectedLoaded = {"texture0", "texture1", "model"};
+	BOOST_CHECK(loaded == expectedLoaded);
+
+	BOOST_CHECK(assetLoader.state("model") == AssetLoadState::LOADED);
+	BOOST_CHECK_EQUAL(assetLoader.pendingCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(independentAssetsDecodeTogether)
+{
+	assetLoader.load(request("a"));
+	assetLoader.load(request("b"));
+
+	BOOST_CHECK_EQUAL(threadPool.getWorkQueueCount(), 2u);
+	BOOST_CHECK(assetLoader.state("a") == AssetLoadState::DECODING);
+}
+
+BOOST_AUTO_TEST_CASE(requestingTwiceLoadsOnce)
+{
+	int callbacks = 0;
+	const auto callback = [&callbacks](const std::string&, const std::exception_ptr&) { ++callbacks; };
+
+	assetLoader.load(request("a"), callback);
+	assetLoader.load(request("a"), callback);
+	runFrames();
+
+	assetLoader.load(request("a"), callback);
+	assetLoader.onLoaded("a", callback);
+	runFrames();
+
+	BOOST_CHECK_EQUAL(events.size(), 2u);
+	BOOST_CHECK_EQUAL(callbacks, 4);
+}
+
+BOOST_AUTO_TEST_CASE(failurePropagatesToDependents)
+{
+	auto failing = request("texture");
+	failing.decode = []() { throw std::runtime_error("corrupt image"); };
+
+	std::exception_ptr modelError;
+	assetLoader.load(request("model", {"texture"}), [&modelError](const std::string&, const std::exception_ptr& error) { modelError = error; });
+	assetLoader.load(std::move(failing));
+	runFrames();
+
+	BOOST_CHECK(assetLoader.state("texture") == AssetLoadState::FAILED);
+	BOOST_CHECK(assetLoader.state("model") == AssetLoadState::FAILED);
+	BOOST_REQUIRE(modelError);
+	BOOST_CHECK_THROW(std::rethrow_exception(modelError), std::runtime_error);
+	BOOST_CHECK(events.empty());
+
+	// A request that depends on an asset that already failed fails straight away
+	bool failed = false;
+	assetLoader.load(request("other", {"texture"}), [&failed](const std::string&, const std::exception_ptr& error) { failed = static_cast<bool>(error); });
+	runFrames();
+
+	BOOST_CHECK(failed);
+	BOOST_CHECK_EQUAL(assetLoader.pendingCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(forget)
+{
+	assetLoader.load(request("a"));
+	runFrames();
+
+	assetLoader.forget("a");
+	BOOST_CHECK(assetLoader.state("a") == AssetLoadState::UNKNOWN);
+
+	assetLoader.load(request("a"));
+	runFrames();
+
+	BOOST_CHECK_EQUAL(events.size(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(selfDependency)
+{
+	BOOST_CHECK_THROW(assetLoader.load(request("a", {"a"})), std::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
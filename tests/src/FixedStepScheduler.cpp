@@ -0,0 +1,89 @@
+#include <chrono>
+
+#define BOOST_TEST_MODULE FixedStepScheduler
+#include <boost/test/unit_test.hpp>
+
+#include "FixedStepScheduler.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+using namespace ice_engine;
+
+BOOST_AUTO_TEST_SUITE(FixedStepScheduler)
+
+BOOST_AUTO_TEST_CASE(accumulatesPartialSteps)
+{
+	ice_engine::FixedStepScheduler scheduler(100.0);
+
+	BOOST_CHECK_EQUAL(scheduler.step().count(), 10000000);
+
+	BOOST_CHECK_EQUAL(scheduler.advance(std::chrono::milliseconds(4)), 0u);
+	BOOST_CHECK_CLOSE(scheduler.alpha(), 0.4f, 0.001f);
+	BOOST_CHECK_EQUAL(scheduler.timeUntilNextTick().count(), 6000000);
+
+	BOOST_CHECK_EQUAL(scheduler.advance(std::chrono::milliseconds(7)), 1u);
+	BOOST_CHECK_CLOSE(scheduler.alpha(), 0.1f, 0.001f);
+
+	BOOST_CHECK_EQUAL(scheduler.advance(std::chrono::milliseconds(29)), 3u);
+	BOOST_CHECK_SMALL(scheduler.alpha(), 0.0001f);
+
+	BOOST_CHECK_EQUAL(scheduler.ticks(), 4u);
+	BOOST_CHECK_EQUAL(scheduler.droppedTicks(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(tickCountIsIndependentOfFrameTimes)
+{
+	ice_engine::FixedStepScheduler a(60.0, 1000, std::chrono::seconds(10));
+	ice_engine::FixedStepScheduler b(60.0, 1000, std::chrono::seconds(10));
+
+	for (int i = 0; i < 600; ++i) a.advance(std::chrono::microseconds(16667));
+	for (int i = 0; i < 144; ++i) b.advance(std::chrono::microseconds(69446));
+
+	BOOST_CHECK_EQUAL(a.ticks(), b.ticks());
+}
+
+BOOST_AUTO_TEST_CASE(limitsTicksPerFrame)
+{
+	ice_engine::FixedStepScheduler scheduler(100.0, 5, std::chrono::seconds(1));
+
+	BOOST_CHECK_EQUAL(scheduler.advance(std::chrono::milliseconds(85)), 5u);
+	BOOST_CHECK_EQUAL(scheduler.droppedTicks(), 3u);
+	BOOST_CHECK_EQUAL(scheduler.droppedTime().count(), 30000000);
+	BOOST_CHECK_CLOSE(scheduler.alpha(), 0.5f, 0.001f);
+}
+
+BOOST_AUTO_TEST_CASE(clampsFrameTime)
+{
+	ice_engine::FixedStepScheduler scheduler(100.0, 100, std::chrono::milliseconds(250));
+
+	BOOST_CHECK_EQUAL(scheduler.advance(std::chrono::seconds(2)), 25u);
+	BOOST_CHECK_EQUAL(scheduler.droppedTicks(), 175u);
+	BOOST_CHECK_EQUAL(scheduler.droppedTime().count(), 1750000000);
+}
+
+BOOST_AUTO_TEST_CASE(skipPolicyRunsOneTick)
+{
+	ice_engine::FixedStepScheduler scheduler(100.0, 5, std::chrono::seconds(1), CatchUpPolicy::SKIP);
+
+	BOOST_CHECK_EQUAL(scheduler.advance(std::chrono::milliseconds(35)), 1u);
+	BOOST_CHECK_EQUAL(scheduler.droppedTicks(), 2u);
+	BOOST_CHECK_CLOSE(scheduler.alpha(), 0.5f, 0.001f);
+}
+
+BOOST_AUTO_TEST_CASE(catchUpPolicyFromString)
+{
+	BOOST_CHECK(ice_engine::FixedStepScheduler::catchUpPolicyFromString("catchup") == CatchUpPolicy::CATCH_UP);
+	BOOST_CHECK(ice_engine::FixedStepScheduler::catchUpPolicyFromString("skip") == CatchUpPolicy::SKIP);
+	BOOST_CHECK_THROW(ice_engine::FixedStepScheduler::catchUpPolicyFromString("sometimes"), ice_engine::InvalidArgumentException);
+}
+
+BOOST_AUTO_TEST_CASE(sleepPrecisely)
+{
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(5);
+
+	ice_engine::sleepPrecisely(deadline);
+
+	BOOST_CHECK(std::chrono::steady_clock::now() >= deadline);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
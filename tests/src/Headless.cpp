@@ -0,0 +1,86 @@
+#include <memory>
+
+#define BOOST_TEST_MODULE Headless
+#include <boost/test/unit_test.hpp>
+
+#include "fs/FileSystem.hpp"
+#include "logger/Logger.hpp"
+#include "utilities/Properties.hpp"
+
+#include "PluginManager.hpp"
+#include "EngineStatistics.hpp"
+
+struct Fixture
+{
+    Fixture()
+    {
+        logger = std::make_unique<ice_engine::logger::Logger>();
+        properties = std::make_unique<ice_engine::utilities::Properties>(std::string(R"END(
+[engine]
+headless=true
+
+[plugins]
+guiplugins=missing
+graphicsplugin=missing
+audioplugin=missing
+pathfindingplugin=null
+physicsplugin=null
+networkingplugin=null
+)END"));
+    }
+
+    ice_engine::fs::FileSystem fileSystem;
+    std::unique_ptr<ice_engine::logger::ILogger> logger;
+    std::unique_ptr<ice_engine::utilities::Properties> properties;
+};
+
+BOOST_FIXTURE_TEST_SUITE(Headless, Fixture)
+
+BOOST_AUTO_TEST_CASE(headlessUsesNullGraphicsAndAudioPlugins)
+{
+    const ice_engine::PluginManager pluginManager(properties.get(), &fileSystem, logger.get());
+
+    BOOST_REQUIRE(pluginManager.getGraphicsPlugin());
+    BOOST_REQUIRE(pluginManager.getAudioPlugin());
+
+    BOOST_CHECK_EQUAL(pluginManager.getGraphicsPlugin()->getName(), "null");
+    BOOST_CHECK_EQUAL(pluginManager.getAudioPlugin()->getName(), "null");
+    BOOST_CHECK(pluginManager.getGuiPlugins().empty());
+}
+
+BOOST_AUTO_TEST_CASE(commandLineOverridesSettings)
+{
+    ice_engine::utilities::Properties commandLineProperties(std::string(R"END(
+[engine]
+tickrate=60
+)END"));
+
+    const char* argv[] = {"ice_engine", "--engine.tickrate=30", "--headless", "--scene.name=a=b", "--=empty", "unknown"};
+    const auto unknownArguments = commandLineProperties.applyCommandLine(6, argv);
+
+    BOOST_CHECK_EQUAL(commandLineProperties.getIntValue("engine.tickrate"), 30);
+    BOOST_CHECK(commandLineProperties.getBoolValue("engine.headless"));
+    BOOST_CHECK_EQUAL(commandLineProperties.getStringValue("scene.name"), "a=b");
+
+    BOOST_REQUIRE_EQUAL(unknownArguments.size(), 2u);
+    BOOST_CHECK_EQUAL(unknownArguments[0], "--=empty");
+    BOOST_CHECK_EQUAL(unknownArguments[1], "unknown");
+}
+
+BOOST_AUTO_TEST_CASE(engineStatisticsStartZeroed)
+{
+    const ice_engine::EngineStatistics engineStatistics;
+
+    BOOST_CHECK_EQUAL(engineStatistics.fps, 0.0f);
+    BOOST_CHECK_EQUAL(engineStatistics.renderTime.count(), 0.0f);
+    BOOST_CHECK_EQUAL(engineStatistics.tickTime.count(), 0.0f);
+    BOOST_CHECK_EQUAL(engineStatistics.frameTime.count(), 0.0f);
+    BOOST_CHECK_EQUAL(engineStatistics.ticksPerFrame, 0u);
+    BOOST_CHECK_EQUAL(engineStatistics.droppedTicks, 0u);
+    BOOST_CHECK_EQUAL(engineStatistics.interpolationAlpha, 0.0f);
+    BOOST_CHECK_EQUAL(engineStatistics.allocationsPerFrame, 0u);
+    BOOST_CHECK_EQUAL(engineStatistics.scriptGarbageCollectionTime.count(), 0.0f);
+    BOOST_CHECK_EQUAL(engineStatistics.scriptObjectsCollected, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
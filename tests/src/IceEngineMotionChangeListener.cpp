@@ -0,0 +1,86 @@
+#define BOOST_TEST_MODULE IceEngineMotionChangeListener
+#include <boost/test/unit_test.hpp>
+
+#include "IceEngineMotionChangeListener.hpp"
+
+#include "ecs/EntityComponentSystem.hpp"
+
+using namespace ice_engine;
+
+struct Fixture
+{
+	Fixture() : entityComponentSystem(nullptr)
+	{
+	}
+
+	ecs::EntityComponentSystem entityComponentSystem;
+};
+
+BOOST_FIXTURE_TEST_SUITE(IceEngineMotionChangeListener, Fixture)
+
+BOOST_AUTO_TEST_CASE(motionChangeMovesTheEntityAndMarksItDirty)
+{
+	const auto entity = entityComponentSystem.create();
+	entityComponentSystem.assign<ecs::PositionComponent>(entity.id(), glm::vec3(0.0f));
+	entityComponentSystem.assign<ecs::OrientationComponent>(entity.id(), glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+
+	BOOST_CHECK(applyMotionChange(entityComponentSystem, entity.id(), glm::vec3(1.0f, 2.0f, 3.0f), glm::quat(2.0f, 0.0f, 0.0f, 0.0f)));
+
+	BOOST_CHECK(entityComponentSystem.component<ecs::PositionComponent>(entity.id())->position == glm::vec3(1.0f, 2.0f, 3.0f));
+	BOOST_CHECK(entityComponentSystem.component<ecs::OrientationComponent>(entity.id())->orientation == glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+
+	const auto dirtyComponent = entityComponentSystem.component<ecs::DirtyComponent>(entity.id());
+	BOOST_REQUIRE(dirtyComponent);
+	BOOST_CHECK(dirtyComponent->dirty & ecs::DirtyFlags::DIRTY_SOURCE_PHYSICS);
+	BOOST_CHECK(dirtyComponent->dirty & ecs::DirtyFlags::DIRTY_POSITION);
+	BOOST_CHECK(dirtyComponent->dirty & ecs::DirtyFlags::DIRTY_ORIENTATION);
+}
+
+BOOST_AUTO_TEST_CASE(motionChangeKeepsExistingDirtyFlags)
+{
+	const auto entity = entityComponentSystem.create();
+	entityComponentSystem.assign<ecs::PositionComponent>(entity.id(), glm::vec3(0.0f));
+	entityComponentSystem.assign<ecs::OrientationComponent>(entity.id(), glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+	entityComponentSystem.assign<ecs::DirtyComponent>(entity.id(), static_cast<uint16>(ecs::DirtyFlags::DIRTY_RIGID_BODY_OBJECT));
+
+	BOOST_CHECK(applyMotionChange(entityComponentSystem, entity.id(), glm::vec3(1.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f)));
+
+	const auto dirtyComponent = entityComponentSystem.component<ecs::DirtyComponent>(entity.id());
+	BOOST_CHECK(dirtyComponent->dirty & ecs::DirtyFlags::DIRTY_RIGID_BODY_OBJECT);
+	BOOST_CHECK(dirtyComponent->dirty & ecs::DirtyFlags::DIRTY_POSITION);
+}
+
+BOOST_AUTO_TEST_CASE(motionChangeSkipsEntitiesWithoutATransform)
+{
+	const auto entity = entityComponentSystem.create();
+	entityComponentSystem.assign<ecs::PositionComponent>(entity.id(), glm::vec3(0.0f));
+
+	BOOST_CHECK(!applyMotionChange(entityComponentSystem, entity.id(), glm::vec3(1.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f)));
+
+	BOOST_CHECK(entityComponentSystem.component<ecs::PositionComponent>(entity.id())->position == glm::vec3(0.0f));
+	BOOST_CHECK(!entityComponentSystem.component<ecs::DirtyComponent>(entity.id()));
+}
+
+BOOST_AUTO_TEST_CASE(motionChangeSkipsDestroyedEntities)
+{
+	auto entity = entityComponentSystem.create();
+	const auto id = entity.id();
+	entityComponentSystem.destroy(entity);
+
+	BOOST_CHECK(!applyMotionChange(entityComponentSystem, id, glm::vec3(1.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f)));
+}
+
+BOOST_AUTO_TEST_CASE(listenerAppliesMotionChanges)
+{
+	const auto entity = entityComponentSystem.create();
+	entityComponentSystem.assign<ecs::PositionComponent>(entity.id(), glm::vec3(0.0f));
+	entityComponentSystem.assign<ecs::OrientationComponent>(entity.id(), glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+
+	ice_engine::IceEngineMotionChangeListener listener(entity, &entityComponentSystem);
+	listener.update(glm::vec3(4.0f, 5.0f, 6.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+
+	BOOST_CHECK(entityComponentSystem.component<ecs::PositionComponent>(entity.id())->position == glm::vec3(4.0f, 5.0f, 6.0f));
+	BOOST_CHECK(entityComponentSystem.component<ecs::DirtyComponent>(entity.id()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
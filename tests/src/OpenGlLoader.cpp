@@ -0,0 +1,132 @@
+#include <thread>
+#include <vector>
+#include <string>
+
+#define BOOST_TEST_MODULE OpenGlLoader
+#include <boost/test/unit_test.hpp>
+
+#include "OpenGlLoader.hpp"
+
+using namespace ice_engine;
+
+BOOST_AUTO_TEST_SUITE(OpenGlLoaderTests)
+
+BOOST_AUTO_TEST_CASE(runsWorkInPriorityOrder)
+{
+	OpenGlLoader openGlLoader;
+	std::vector<std::string> order;
+
+	openGlLoader.postWork([&order]() { order.push_back("texture"); }, WorkPriority::LOW);
+	openGlLoader.postWork([&order]() { order.push_back("shader"); });
+	openGlLoader.postWork([&order]() { order.push_back("bones"); }, WorkPriority::HIGH);
+	openGlLoader.postWork([&order]() { order.push_back("mesh"); });
+
+	BOOST_CHECK_EQUAL(openGlLoader.getWorkQueueCount(), 4u);
+	BOOST_CHECK_EQUAL(openGlLoader.tick(std::chrono::seconds(10)), 4u);
+
+	const std::vector<std::string> expected = {"bones", "shader", "mesh", "texture"};
+	BOOST_CHECK(order == expected);
+	BOOST_CHECK_EQUAL(openGlLoader.getWorkQueueCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(budgetLimitsWorkButHighPriorityAlwaysRuns)
+{
+	OpenGlLoader openGlLoader;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		openGlLoader.postWork([]() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); }, WorkPriority::LOW);
+	}
+	bool bonesUploaded = false;
+	openGlLoader.postWork([&bonesUploaded]() { bonesUploaded = true; }, WorkPriority::HIGH);
+
+	// A zero budget still runs one task, so work always makes progress
+	BOOST_CHECK_EQUAL(openGlLoader.tick(std::chrono::nanoseconds::zero()), 1u);
+	BOOST_CHECK(bonesUploaded);
+
+	openGlLoader.postWork([&bonesUploaded]() { bonesUploaded = false; }, WorkPriority::HIGH);
+
+	const auto tasksRun = openGlLoader.tick(std::chrono::milliseconds(3));
+	BOOST_CHECK_GE(tasksRun, 2u);
+	BOOST_CHECK_LT(tasksRun, 11u);
+	BOOST_CHECK(!bonesUploaded);
+	BOOST_CHECK_EQUAL(openGlLoader.statistics().tasksRemaining, 10u - (tasksRun - 1u));
+}
+
+BOOST_AUTO_TEST_CASE(highPriorityWorkPostingMoreDoesNotStarveTheTick)
+{
+	OpenGlLoader openGlLoader;
+	int runs = 0;
+
+	std::function<void()> work = [&openGlLoader, &runs, &work]() {
+		++runs;
+		openGlLoader.postWork(std::function<void()>(work), WorkPriority::HIGH);
+	};
+	openGlLoader.postWork(std::function<void()>(work), WorkPriority::HIGH);
+
+	BOOST_CHECK_EQUAL(openGlLoader.tick(std::chrono::nanoseconds::zero()), 2u);
+	BOOST_CHECK_EQUAL(openGlLoader.getWorkQueueCount(), 1u);
+
+	BOOST_CHECK_EQUAL(openGlLoader.tick(std::chrono::nanoseconds::zero()), 2u);
+	BOOST_CHECK_EQUAL(runs, 4);
+}
+
+BOOST_AUTO_TEST_CASE(workCanPostWork)
+{
+	OpenGlLoader openGlLoader;
+	bool chained = false;
+
+	openGlLoader.postWork([&openGlLoader, &chained]() {
+		openGlLoader.postWork([&chained]() { chained = true; });
+	});
+
+	openGlLoader.tick(std::chrono::seconds(10));
+
+	BOOST_CHECK(chained);
+}
+
+BOOST_AUTO_TEST_CASE(postFromManyThreads)
+{
+	OpenGlLoader openGlLoader;
+	std::atomic<int> count(0);
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; ++i)
+	{
+		threads.emplace_back([&openGlLoader, &count]() {
+			for (int j = 0; j < 1000; ++j) openGlLoader.postWork([&count]() { ++count; });
+		});
+	}
+	for (auto& thread : threads) thread.join();
+
+	while (openGlLoader.getWorkQueueCount() != 0u) openGlLoader.tick(std::chrono::seconds(10));
+
+	BOOST_CHECK_EQUAL(count.load(), 4000);
+}
+
+BOOST_AUTO_TEST_CASE(queueLatency)
+{
+	OpenGlLoader openGlLoader;
+
+	auto future = openGlLoader.postWork([]() {});
+	std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	openGlLoader.tick(std::chrono::seconds(10));
+
+	BOOST_CHECK(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+	BOOST_CHECK_GE(openGlLoader.statistics().maximumQueueLatency.count(), 5000000);
+	BOOST_CHECK_EQUAL(openGlLoader.statistics().tasksRun, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(block)
+{
+	OpenGlLoader openGlLoader;
+	openGlLoader.postWork([]() {});
+
+	openGlLoader.block();
+	BOOST_CHECK_EQUAL(openGlLoader.tick(std::chrono::seconds(10)), 0u);
+
+	openGlLoader.unblock();
+	BOOST_CHECK_EQUAL(openGlLoader.tick(std::chrono::seconds(10)), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
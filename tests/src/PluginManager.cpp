@@ -0,0 +1,110 @@
+#include <memory>
+
+#define BOOST_TEST_MODULE PluginManager
+#include <boost/test/unit_test.hpp>
+
+#include "fs/FileSystem.hpp"
+#include "logger/Logger.hpp"
+#include "utilities/Properties.hpp"
+
+#include "PluginManager.hpp"
+
+#include "graphics/NullGraphicsEngine.hpp"
+#include "physics/NullPhysicsEngine.hpp"
+#include "networking/NullNetworkingEngine.hpp"
+
+struct Fixture
+{
+    Fixture()
+    {
+        logger = std::make_unique<ice_engine::logger::Logger>();
+        properties = std::make_unique<ice_engine::utilities::Properties>(std::string(R"END(
+[plugins]
+graphicsplugin=null
+audioplugin=null
+pathfindingplugin=null
+physicsplugin=null
+networkingplugin=null
+)END"));
+        pluginManager = std::make_unique<ice_engine::PluginManager>(properties.get(), &fileSystem, logger.get());
+    }
+
+    ice_engine::fs::FileSystem fileSystem;
+    std::unique_ptr<ice_engine::logger::ILogger> logger;
+    std::unique_ptr<ice_engine::utilities::Properties> properties;
+    std::unique_ptr<ice_engine::PluginManager> pluginManager;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PluginManager, Fixture)
+
+BOOST_AUTO_TEST_CASE(nullPluginsSelected)
+{
+    BOOST_REQUIRE(pluginManager->getGraphicsPlugin());
+    BOOST_REQUIRE(pluginManager->getAudioPlugin());
+    BOOST_REQUIRE(pluginManager->getPathfindingPlugin());
+    BOOST_REQUIRE(pluginManager->getPhysicsPlugin());
+    BOOST_REQUIRE(pluginManager->getNetworkingPlugin());
+
+    BOOST_CHECK_EQUAL(pluginManager->getGraphicsPlugin()->getName(), "null");
+    BOOST_CHECK_EQUAL(pluginManager->getNetworkingPlugin()->getName(), "null");
+}
+
+BOOST_AUTO_TEST_CASE(nullGraphicsEngineRecordsCalls)
+{
+    auto graphicsEngine = pluginManager->getGraphicsPlugin()->createFactory()->create(properties.get(), &fileSystem, logger.get());
+    auto nullGraphicsEngine = dynamic_cast<ice_engine::graphics::NullGraphicsEngine*>(graphicsEngine.get());
+
+    BOOST_REQUIRE(nullGraphicsEngine != nullptr);
+
+    const auto renderSceneHandle = graphicsEngine->createRenderScene();
+
+    graphicsEngine->beginRender();
+    graphicsEngine->render(renderSceneHandle);
+    graphicsEngine->renderLines({
+        std::make_tuple(glm::vec3(0.0f), glm::vec3(1.0f), glm::vec3(1.0f)),
+        std::make_tuple(glm::vec3(0.0f), glm::vec3(2.0f), glm::vec3(1.0f))
+    });
+    graphicsEngine->endRender();
+
+    BOOST_CHECK(renderSceneHandle.valid());
+    BOOST_CHECK_EQUAL(nullGraphicsEngine->statistics().frames.load(), 1u);
+    BOOST_CHECK_EQUAL(nullGraphicsEngine->statistics().renderSceneCalls.load(), 1u);
+    BOOST_CHECK_EQUAL(nullGraphicsEngine->statistics().linesRendered.load(), 2u);
+
+    nullGraphicsEngine->resetStatistics();
+
+    BOOST_CHECK_EQUAL(nullGraphicsEngine->statistics().frames.load(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(nullPhysicsEngineKeepsState)
+{
+    auto physicsEngine = pluginManager->getPhysicsPlugin()->createFactory()->create(properties.get(), &fileSystem, logger.get());
+
+    const auto physicsSceneHandle = physicsEngine->createPhysicsScene();
+    const auto collisionShapeHandle = physicsEngine->createStaticSphereShape(1.0f);
+    const auto rigidBodyObjectHandle = physicsEngine->createRigidBodyObject(physicsSceneHandle, collisionShapeHandle, nullptr, std::string("test"));
+
+    physicsEngine->position(physicsSceneHandle, rigidBodyObjectHandle, glm::vec3(1.0f, 2.0f, 3.0f));
+
+    BOOST_CHECK(physicsEngine->position(physicsSceneHandle, rigidBodyObjectHandle) == glm::vec3(1.0f, 2.0f, 3.0f));
+    BOOST_CHECK_EQUAL(boost::any_cast<std::string>(physicsEngine->getUserData(physicsSceneHandle, rigidBodyObjectHandle)), "test");
+
+    physicsEngine->destroy(physicsSceneHandle, rigidBodyObjectHandle);
+}
+
+BOOST_AUTO_TEST_CASE(nullNetworkingEngineRecordsBytesSent)
+{
+    auto networkingEngine = pluginManager->getNetworkingPlugin()->createFactory()->create(properties.get(), &fileSystem, logger.get());
+    auto nullNetworkingEngine = dynamic_cast<ice_engine::networking::NullNetworkingEngine*>(networkingEngine.get());
+
+    BOOST_REQUIRE(nullNetworkingEngine != nullptr);
+
+    const auto clientHandle = networkingEngine->createClient();
+    networkingEngine->send(clientHandle, std::vector<ice_engine::uint8>(16));
+    networkingEngine->send(clientHandle, std::vector<ice_engine::uint8>(4));
+
+    BOOST_CHECK_EQUAL(nullNetworkingEngine->statistics().messagesSent.load(), 2u);
+    BOOST_CHECK_EQUAL(nullNetworkingEngine->statistics().bytesSent.load(), 20u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
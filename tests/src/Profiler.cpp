@@ -0,0 +1,165 @@
+#include <sstream>
+#include <thread>
+
+#define BOOST_TEST_MODULE Profiler
+#include <boost/test/unit_test.hpp>
+
+#include "Profiler.hpp"
+
+BOOST_AUTO_TEST_SUITE(Profiler)
+
+BOOST_AUTO_TEST_CASE(recordsNestedMarkers)
+{
+	ice_engine::Profiler profiler;
+
+	profiler.beginFrame();
+	{
+		PROFILER_SCOPE(&profiler, "outer");
+		{
+			PROFILER_SCOPE(&profiler, "inner", "detail");
+		}
+	}
+	profiler.counter("queue", 5);
+	profiler.endFrame();
+
+	const auto history = profiler.history();
+
+	BOOST_REQUIRE_EQUAL(history.size(), 1u);
+	BOOST_REQUIRE_EQUAL(history[0].markers.size(), 2u);
+
+	// Markers are recorded when the scope closes, so the inner one comes first
+	BOOST_CHECK_EQUAL(history[0].markers[0].name, "inner");
+	BOOST_CHECK_EQUAL(history[0].markers[0].depth, 1u);
+	BOOST_CHECK_EQUAL(history[0].markers[0].detail, "detail");
+	BOOST_CHECK_EQUAL(history[0].markers[1].name, "outer");
+	BOOST_CHECK_EQUAL(history[0].markers[1].depth, 0u);
+	BOOST_CHECK(history[0].markers[1].duration >= history[0].markers[0].duration);
+
+	BOOST_REQUIRE_EQUAL(history[0].counters.size(), 1u);
+	BOOST_CHECK_EQUAL(history[0].counters[0].value, 5);
+}
+
+BOOST_AUTO_TEST_CASE(recordsMarkersFromOtherThreads)
+{
+	ice_engine::Profiler profiler;
+
+	profiler.beginFrame();
+	{
+		PROFILER_SCOPE(&profiler, "main");
+
+		std::thread thread([&profiler]() {
+			PROFILER_SCOPE(&profiler, "worker");
+		});
+		thread.join();
+	}
+	profiler.endFrame();
+
+	const auto history = profiler.history();
+
+	BOOST_REQUIRE_EQUAL(history[0].markers.size(), 2u);
+	BOOST_CHECK_EQUAL(history[0].markers[0].depth, 0u);
+	BOOST_CHECK_NE(history[0].markers[0].threadId, history[0].markers[1].threadId);
+}
+
+BOOST_AUTO_TEST_CASE(ignoresMarkersOutsideFrames)
+{
+	ice_engine::Profiler profiler;
+
+	{
+		PROFILER_SCOPE(&profiler, "ignored");
+	}
+
+	profiler.beginFrame();
+	profiler.endFrame();
+
+	{
+		PROFILER_SCOPE(&profiler, "ignored");
+	}
+
+	const auto history = profiler.history();
+
+	BOOST_REQUIRE_EQUAL(history.size(), 1u);
+	BOOST_CHECK(history[0].markers.empty());
+}
+
+BOOST_AUTO_TEST_CASE(historyIsRingBuffered)
+{
+	ice_engine::Profiler profiler(4);
+
+	for (int i = 0; i < 10; ++i)
+	{
+		profiler.beginFrame();
+		profiler.endFrame();
+	}
+
+	const auto history = profiler.history();
+
+	BOOST_REQUIRE_EQUAL(history.size(), 4u);
+	BOOST_CHECK_EQUAL(history.front().frameNumber, 7u);
+	BOOST_CHECK_EQUAL(history.back().frameNumber, 10u);
+}
+
+BOOST_AUTO_TEST_CASE(disabledProfilerRecordsNothing)
+{
+	ice_engine::Profiler profiler;
+	profiler.setEnabled(false);
+
+	profiler.beginFrame();
+	{
+		PROFILER_SCOPE(&profiler, "ignored");
+	}
+	profiler.endFrame();
+
+	BOOST_CHECK(profiler.history().empty());
+}
+
+BOOST_AUTO_TEST_CASE(detailIsOnlyEvaluatedWhenEnabled)
+{
+	ice_engine::Profiler profiler;
+	int evaluations = 0;
+	const auto detail = [&evaluations]() { ++evaluations; return std::string("detail"); };
+
+	profiler.beginFrame();
+	profiler.setEnabled(false);
+	{
+		PROFILER_SCOPE(&profiler, "disabled", detail());
+	}
+	profiler.setEnabled(true);
+	{
+		PROFILER_SCOPE(&profiler, "enabled", detail());
+	}
+	profiler.endFrame();
+
+	const auto history = profiler.history();
+
+	BOOST_CHECK_EQUAL(evaluations, 1);
+	BOOST_REQUIRE_EQUAL(history.size(), 1u);
+	BOOST_REQUIRE_EQUAL(history[0].markers.size(), 1u);
+	BOOST_CHECK_EQUAL(history[0].markers[0].detail, "detail");
+}
+
+BOOST_AUTO_TEST_CASE(exportChromeTrace)
+{
+	ice_engine::Profiler profiler;
+
+	profiler.beginFrame();
+	{
+		PROFILER_SCOPE(&profiler, "scope", "a \"quoted\" detail");
+	}
+	profiler.counter("queue", 3);
+	profiler.endFrame();
+
+	std::stringstream ss;
+	profiler.exportChromeTrace(ss);
+
+	const auto trace = ss.str();
+
+	BOOST_CHECK_EQUAL(trace.find("{\"traceEvents\":["), 0u);
+	BOOST_CHECK(trace.find("\"name\":\"Frame\"") != std::string::npos);
+	BOOST_CHECK(trace.find("\"name\":\"scope\"") != std::string::npos);
+	BOOST_CHECK(trace.find("a \\\"quoted\\\" detail") != std::string::npos);
+	BOOST_CHECK(trace.find("\"ph\":\"C\"") != std::string::npos);
+	BOOST_CHECK(trace.find("\"value\":3") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
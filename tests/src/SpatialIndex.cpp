@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#define BOOST_TEST_MODULE SpatialIndex
+#include <boost/test/unit_test.hpp>
+
+#include "SpatialIndex.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+std::vector<glm::vec3> randomPositions(const size_t count, const float32 extent)
+{
+	std::mt19937 generator(1234);
+	std::uniform_real_distribution<float32> distribution(-extent, extent);
+
+	std::vector<glm::vec3> positions;
+	for (size_t i = 0; i < count; ++i)
+	{
+		positions.push_back(glm::vec3(distribution(generator), distribution(generator), distribution(generator)));
+	}
+
+	return positions;
+}
+
+float32 distance2(const glm::vec3& a, const glm::vec3& b)
+{
+	return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) + (a.z - b.z) * (a.z - b.z);
+}
+
+template<typename Predicate>
+std::vector<uint64> bruteForce(const std::vector<glm::vec3>& positions, const Predicate& predicate)
+{
+	std::vector<uint64> results;
+	for (size_t i = 0; i < positions.size(); ++i)
+	{
+		if (predicate(positions[i])) results.push_back(i);
+	}
+
+	return results;
+}
+
+std::vector<uint64> sorted(std::vector<uint64> ids)
+{
+	std::sort(ids.begin(), ids.end());
+	return ids;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(SpatialIndexTests)
+
+BOOST_AUTO_TEST_CASE(radiusAndBoxQueriesMatchBruteForce)
+{
+	const auto positions = randomPositions(2000, 500.0f);
+
+	SpatialIndex spatialIndex(4.0f, 8);
+	for (size_t i = 0; i < positions.size(); ++i)
+	{
+		spatialIndex.set(i, positions[i]);
+	}
+
+	BOOST_CHECK_EQUAL(spatialIndex.size(), positions.size());
+
+	std::vector<uint64> results;
+
+	const glm::vec3 center(10.0f, -20.0f, 30.0f);
+	spatialIndex.queryRadius(center, 120.0f, results);
+	BOOST_CHECK(sorted(results) == bruteForce(positions, [&center](const glm::vec3& p) { return distance2(p, center) <= 120.0f * 120.0f; }));
+	BOOST_CHECK(!results.empty());
+
+	const glm::vec3 minimum(-100.0f, 0.0f, -50.0f);
+	const glm::vec3 maximum(200.0f, 150.0f, 50.0f);
+	spatialIndex.queryBox(minimum, maximum, results);
+	BOOST_CHECK(sorted(results) == bruteForce(positions, [&minimum, &maximum](const glm::vec3& p) {
+		return p.x >= minimum.x && p.x <= maximum.x && p.y >= minimum.y && p.y <= maximum.y && p.z >= minimum.z && p.z <= maximum.z;
+	}));
+	BOOST_CHECK(!results.empty());
+}
+
+BOOST_AUTO_TEST_CASE(frustumQuery)
+{
+	const auto positions = randomPositions(1000, 50.0f);
+
+	SpatialIndex spatialIndex;
+	for (size_t i = 0; i < positions.size(); ++i)
+	{
+		spatialIndex.set(i, positions[i]);
+	}
+
+	// An orthographic projection of the box from -20 to 20 on every axis
+	glm::mat4 viewProjection(1.0f / 20.0f);
+	viewProjection[3][3] = 1.0f;
+
+	std::vector<uint64> results;
+	spatialIndex.queryFrustum(viewProjection, results);
+
+	BOOST_CHECK(sorted(results) == bruteForce(positions, [](const glm::vec3& p) {
+		return std::abs(p.x) <= 20.0f && std::abs(p.y) <= 20.0f && std::abs(p.z) <= 20.0f;
+	}));
+	BOOST_CHECK(!results.empty());
+}
+
+BOOST_AUTO_TEST_CASE(nearestQueryIsOrderedByDistance)
+{
+	const auto positions = randomPositions(1500, 200.0f);
+
+	SpatialIndex spatialIndex(2.0f, 4);
+	for (size_t i = 0; i < positions.size(); ++i)
+	{
+		spatialIndex.set(i, positions[i]);
+	}
+
+	const glm::vec3 position(5.0f, 5.0f, 5.0f);
+
+	std::vector<uint64> expected(positions.size());
+	for (size_t i = 0; i < expected.size(); ++i) expected[i] = i;
+	std::sort(expected.begin(), expected.end(), [&positions, &position](const uint64 a, const uint64 b) {
+		return distance2(positions[a], position) < distance2(positions[b], position);
+	});
+	expected.resize(10);
+
+	std::vector<uint64> results;
+	spatialIndex.queryNearest(position, 10, results);
+	BOOST_CHECK(results == expected);
+
+	spatialIndex.queryNearest(position, 5000, results);
+	BOOST_CHECK_EQUAL(results.size(), positions.size());
+}
+
+BOOST_AUTO_TEST_CASE(movingAndRemovingPoints)
+{
+	auto positions = randomPositions(500, 100.0f);
+
+	SpatialIndex spatialIndex(1.0f, 4);
+	for (size_t i = 0; i < positions.size(); ++i)
+	{
+		spatialIndex.set(i, positions[i]);
+	}
+
+	// Small moves stay in their leaf, large ones move between leaves and grow the tree
+	for (size_t i = 0; i < positions.size(); ++i)
+	{
+		positions[i] = (i % 2 == 0) ? positions[i] + glm::vec3(0.01f, 0.0f, 0.0f) : positions[i] * 7.0f;
+		spatialIndex.set(i, positions[i]);
+	}
+
+	for (size_t i = 0; i < positions.size(); i += 3)
+	{
+		spatialIndex.remove(i);
+	}
+
+	auto remaining = positions;
+	for (size_t i = 0; i < remaining.size(); i += 3)
+	{
+		remaining[i] = glm::vec3(1.0e6f);
+	}
+
+	BOOST_CHECK(!spatialIndex.contains(0));
+	BOOST_CHECK(spatialIndex.contains(1));
+
+	std::vector<uint64> results;
+	spatialIndex.queryRadius(glm::vec3(0.0f), 300.0f, results);
+	BOOST_CHECK(sorted(results) == bruteForce(remaining, [](const glm::vec3& p) { return distance2(p, glm::vec3(0.0f)) <= 300.0f * 300.0f; }));
+
+	BOOST_CHECK(std::none_of(results.begin(), results.end(), [](const uint64 id) { return id % 3 == 0; }));
+
+	for (size_t i = 0; i < positions.size(); ++i)
+	{
+		spatialIndex.remove(i);
+	}
+
+	BOOST_CHECK_EQUAL(spatialIndex.size(), 0u);
+	spatialIndex.queryRadius(glm::vec3(0.0f), 1000.0f, results);
+	BOOST_CHECK(results.empty());
+}
+
+BOOST_AUTO_TEST_CASE(rejectsInvalidInput)
+{
+	SpatialIndex spatialIndex;
+
+	BOOST_CHECK_THROW(spatialIndex.set(1, glm::vec3(std::numeric_limits<float32>::infinity(), 0.0f, 0.0f)), InvalidArgumentException);
+	BOOST_CHECK_THROW(SpatialIndex(0.0f), InvalidArgumentException);
+	BOOST_CHECK_THROW(SpatialIndex(1.0f, 0), InvalidArgumentException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
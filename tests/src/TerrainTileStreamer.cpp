@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <vector>
+
+#define BOOST_TEST_MODULE TerrainTileStreamer
+#include <boost/test/unit_test.hpp>
+
+#include "TerrainTileStreamer.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+bool containsRequest(const std::vector<TerrainTileRequest>& requests, const int32 x, const int32 z)
+{
+	return std::any_of(requests.begin(), requests.end(), [x, z](const TerrainTileRequest& request) {
+		return request.coordinate == TerrainTileCoordinate(x, z);
+	});
+}
+
+void loadAll(TerrainTileStreamer& streamer, const std::vector<TerrainTileRequest>& requests, const uint64 memorySize)
+{
+	for (const auto& request : requests)
+	{
+		streamer.loaded(request.coordinate, request.lod, memorySize, request.collision);
+	}
+}
+}
+
+BOOST_AUTO_TEST_SUITE(TerrainTileStreamerTests)
+
+BOOST_AUTO_TEST_CASE(requestsTilesAroundViewersNearestFirst)
+{
+	TerrainTileStreamer streamer(10.0f, 6.0f, {}, 1024);
+
+	std::vector<TerrainTileRequest> requests;
+	std::vector<TerrainTileCoordinate> unloads;
+
+	streamer.update({glm::vec3(5.0f, 100.0f, 5.0f)}, requests, unloads);
+
+	// The viewer's tile and its 4 neighbours, the diagonal ones are too far
+	BOOST_CHECK_EQUAL(requests.size(), 5u);
+	BOOST_CHECK(containsRequest(requests, -1, 0));
+	BOOST_CHECK(containsRequest(requests, 0, 1));
+	BOOST_CHECK(!containsRequest(requests, 1, 1));
+	BOOST_CHECK(unloads.empty());
+
+	BOOST_CHECK(requests.front().coordinate == TerrainTileCoordinate(0, 0));
+	BOOST_CHECK(std::is_sorted(requests.begin(), requests.end(), [](const TerrainTileRequest& a, const TerrainTileRequest& b) {
+		return a.distance < b.distance;
+	}));
+
+	BOOST_CHECK_EQUAL(streamer.pendingCount(), requests.size());
+
+	// Pending tiles aren't requested again
+	std::vector<TerrainTileRequest> secondRequests;
+	streamer.update({glm::vec3(5.0f, 0.0f, 5.0f)}, secondRequests, unloads);
+	BOOST_CHECK(secondRequests.empty());
+
+	loadAll(streamer, requests, 1);
+	BOOST_CHECK_EQUAL(streamer.pendingCount(), 0u);
+	BOOST_CHECK_EQUAL(streamer.residentCount(), requests.size());
+	BOOST_CHECK_EQUAL(streamer.memoryUsed(), requests.size());
+
+	streamer.update({glm::vec3(5.0f, 0.0f, 5.0f)}, secondRequests, unloads);
+	BOOST_CHECK(secondRequests.empty());
+}
+
+BOOST_AUTO_TEST_CASE(levelOfDetailFollowsDistance)
+{
+	TerrainTileStreamer streamer(10.0f, 100.0f, {20.0f, 40.0f}, 1024 * 1024);
+
+	BOOST_CHECK_EQUAL(streamer.lodCount(), 3u);
+	BOOST_CHECK_EQUAL(streamer.lod(0.0f), 0u);
+	BOOST_CHECK_EQUAL(streamer.lod(19.0f), 0u);
+	BOOST_CHECK_EQUAL(streamer.lod(20.0f), 1u);
+	BOOST_CHECK_EQUAL(streamer.lod(1000.0f), 2u);
+
+	std::vector<TerrainTileRequest> requests;
+	std::vector<TerrainTileCoordinate> unloads;
+
+	streamer.update({glm::vec3(5.0f, 0.0f, 5.0f)}, requests, unloads);
+
+	for (const auto& request : requests)
+	{
+		BOOST_CHECK_EQUAL(request.lod, streamer.lod(request.distance));
+	}
+
+	loadAll(streamer, requests, 1);
+
+	// Moving the viewer re-requests the tiles whose level of detail changed, and only those
+	streamer.update({glm::vec3(45.0f, 0.0f, 5.0f)}, requests, unloads);
+
+	BOOST_CHECK(!requests.empty());
+	for (const auto& request : requests)
+	{
+		BOOST_CHECK_EQUAL(request.lod, streamer.lod(request.distance));
+	}
+
+	const auto origin = std::find_if(requests.begin(), requests.end(), [](const TerrainTileRequest& request) {
+		return request.coordinate == TerrainTileCoordinate(4, 0);
+	});
+	BOOST_REQUIRE(origin != requests.end());
+	BOOST_CHECK_EQUAL(origin->lod, 0u);
+
+	// Tile (0, 0) was at level of detail 0 and is still resident while its replacement loads
+	BOOST_CHECK(streamer.resident(TerrainTileCoordinate(0, 0)));
+	BOOST_CHECK(streamer.pending(TerrainTileCoordinate(0, 0)));
+}
+
+BOOST_AUTO_TEST_CASE(evictsUnwantedTilesOverBudget)
+{
+	// Room for 7 tiles of 10 bytes each
+	TerrainTileStreamer streamer(10.0f, 6.0f, {}, 70);
+
+	std::vector<TerrainTileRequest> requests;
+	std::vector<TerrainTileCoordinate> unloads;
+
+	streamer.update({glm::vec3(5.0f, 0.0f, 5.0f)}, requests, unloads);
+	loadAll(streamer, requests, 10);
+	BOOST_CHECK_EQUAL(streamer.memoryUsed(), 50u);
+
+	// Move far enough away that none of the old tiles are wanted, they stay cached while there is room
+	streamer.update({glm::vec3(1005.0f, 0.0f, 5.0f)}, requests, unloads);
+	BOOST_CHECK(unloads.empty());
+	loadAll(streamer, requests, 10);
+	BOOST_CHECK_EQUAL(streamer.memoryUsed(), 100u);
+
+	streamer.update({glm::vec3(1005.0f, 0.0f, 5.0f)}, requests, unloads);
+	BOOST_CHECK(requests.empty());
+	BOOST_CHECK_EQUAL(unloads.size(), 3u);
+	BOOST_CHECK_EQUAL(streamer.memoryUsed(), 70u);
+
+	// Only the old tiles are unloaded
+	for (const auto& coordinate : unloads)
+	{
+		BOOST_CHECK(coordinate.x <= 1);
+		BOOST_CHECK(!streamer.resident(coordinate));
+	}
+
+	BOOST_CHECK(streamer.resident(TerrainTileCoordinate(100, 0)));
+
+	// Wanted tiles are never unloaded, even over budget
+	TerrainTileStreamer smallStreamer(10.0f, 6.0f, {}, 0);
+	smallStreamer.update({glm::vec3(5.0f, 0.0f, 5.0f)}, requests, unloads);
+	loadAll(smallStreamer, requests, 10);
+	smallStreamer.update({glm::vec3(5.0f, 0.0f, 5.0f)}, requests, unloads);
+	BOOST_CHECK(unloads.empty());
+	BOOST_CHECK_EQUAL(smallStreamer.residentCount(), 5u);
+}
+
+BOOST_AUTO_TEST_CASE(failedTilesAreRequestedAgain)
+{
+	TerrainTileStreamer streamer(10.0f, 0.0f, {}, 1024);
+
+	std::vector<TerrainTileRequest> requests;
+	std::vector<TerrainTileCoordinate> unloads;
+
+	streamer.update({glm::vec3(-5.0f, 0.0f, -5.0f)}, requests, unloads);
+	BOOST_REQUIRE_EQUAL(requests.size(), 1u);
+	BOOST_CHECK(requests[0].coordinate == TerrainTileCoordinate(-1, -1));
+
+	streamer.failed(requests[0].coordinate);
+	BOOST_CHECK_EQUAL(streamer.pendingCount(), 0u);
+	BOOST_CHECK(!streamer.resident(TerrainTileCoordinate(-1, -1)));
+
+	streamer.update({glm::vec3(-5.0f, 0.0f, -5.0f)}, requests, unloads);
+	BOOST_REQUIRE_EQUAL(requests.size(), 1u);
+	BOOST_CHECK(requests[0].coordinate == TerrainTileCoordinate(-1, -1));
+
+	// A failed tile that is no longer wanted is forgotten without being unloaded
+	streamer.failed(requests[0].coordinate);
+	streamer.update({}, requests, unloads);
+	BOOST_CHECK(requests.empty());
+	BOOST_CHECK(unloads.empty());
+	BOOST_CHECK(!streamer.pending(TerrainTileCoordinate(-1, -1)));
+}
+
+BOOST_AUTO_TEST_CASE(repeatedlyFailingTilesBackOff)
+{
+	TerrainTileStreamer streamer(10.0f, 0.0f, {}, 1024);
+
+	std::vector<TerrainTileRequest> requests;
+	std::vector<TerrainTileCoordinate> unloads;
+	const std::vector<glm::vec3> viewers = {glm::vec3(5.0f, 0.0f, 5.0f)};
+
+	std::vector<uint32> attempts;
+
+	for (uint32 i = 0; i < 1000; ++i)
+	{
+		streamer.update(viewers, requests, unloads);
+
+		if (!requests.empty())
+		{
+			attempts.push_back(i);
+			streamer.failed(requests[0].coordinate);
+		}
+	}
+
+	BOOST_REQUIRE_GE(attempts.size(), 4u);
+	BOOST_CHECK_EQUAL(attempts[1] - attempts[0], 1u);
+	BOOST_CHECK_EQUAL(attempts[2] - attempts[1], 2u);
+	BOOST_CHECK_EQUAL(attempts[3] - attempts[2], 4u);
+	BOOST_CHECK_EQUAL(attempts.back() - attempts[attempts.size() - 2], TerrainTileStreamer::MAX_RETRY_DELAY);
+	BOOST_CHECK_LT(attempts.size(), 20u);
+
+	// It is still requested again once the longest delay has passed
+	streamer.update(viewers, requests, unloads);
+	for (uint32 i = 0; requests.empty() && i < TerrainTileStreamer::MAX_RETRY_DELAY; ++i) streamer.update(viewers, requests, unloads);
+	BOOST_REQUIRE_EQUAL(requests.size(), 1u);
+	streamer.loaded(requests[0].coordinate, requests[0].lod, 1, requests[0].collision);
+	BOOST_CHECK(streamer.resident(TerrainTileCoordinate(0, 0)));
+}
+
+BOOST_AUTO_TEST_CASE(collisionFollowsItsOwnRadius)
+{
+	TerrainTileStreamer streamer(10.0f, 100.0f, {20.0f, 40.0f}, 1024 * 1024, 30.0f);
+
+	std::vector<TerrainTileRequest> requests;
+	std::vector<TerrainTileCoordinate> unloads;
+
+	streamer.update({glm::vec3(5.0f, 0.0f, 5.0f)}, requests, unloads);
+
+	for (const auto& request : requests)
+	{
+		BOOST_CHECK_EQUAL(request.collision, request.distance <= 30.0f);
+	}
+
+	// Tile (3, 0) is 25 away, past level of detail 0 but still within the collision radius
+	const auto tile = std::find_if(requests.begin(), requests.end(), [](const TerrainTileRequest& request) {
+		return request.coordinate == TerrainTileCoordinate(3, 0);
+	});
+	BOOST_REQUIRE(tile != requests.end());
+	BOOST_CHECK_EQUAL(tile->lod, 1u);
+	BOOST_CHECK(tile->collision);
+
+	loadAll(streamer, requests, 1);
+
+	// Moving it to 31 away keeps its level of detail, so it is only requested again to drop its collision
+	streamer.update({glm::vec3(-1.0f, 0.0f, 5.0f)}, requests, unloads);
+
+	const auto reloaded = std::find_if(requests.begin(), requests.end(), [](const TerrainTileRequest& request) {
+		return request.coordinate == TerrainTileCoordinate(3, 0);
+	});
+	BOOST_REQUIRE(reloaded != requests.end());
+	BOOST_CHECK_EQUAL(reloaded->lod, 1u);
+	BOOST_CHECK(!reloaded->collision);
+
+	BOOST_CHECK(!containsRequest(requests, 0, 0));
+}
+
+BOOST_AUTO_TEST_CASE(rejectsInvalidConfiguration)
+{
+	BOOST_CHECK_THROW(TerrainTileStreamer(0.0f, 10.0f, {}, 0), InvalidArgumentException);
+	BOOST_CHECK_THROW(TerrainTileStreamer(10.0f, -1.0f, {}, 0), InvalidArgumentException);
+	BOOST_CHECK_THROW(TerrainTileStreamer(10.0f, 10.0f, {20.0f, 10.0f}, 0), InvalidArgumentException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,282 @@
+#include <cstring>
+
+#define BOOST_TEST_MODULE CookedAsset
+#include <boost/test/unit_test.hpp>
+
+#include "cooking/CookedAsset.hpp"
+#include "mesh/MeshOptimization.hpp"
+
+#include "exceptions/RuntimeException.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+Model createModel(IImage* image)
+{
+	BoneData boneData;
+	boneData.boneIndexMap["root"] = 0;
+	boneData.boneIndexMap["arm"] = 1;
+	boneData.boneTransform.push_back({"root", glm::mat4(1.0f)});
+	boneData.boneTransform.push_back({"arm", glm::mat4(2.0f)});
+
+	Mesh mesh(
+		"body",
+		{glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f)},
+		{0, 1, 2},
+		{glm::vec4(1.0f), glm::vec4(1.0f), glm::vec4(1.0f)},
+		{glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 1.0f)},
+		{glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 1.0f)},
+		VertexBoneData({glm::ivec4(0, 1, 0, 0), glm::ivec4(1, 0, 0, 0), glm::ivec4(0)}, {glm::vec4(0.5f, 0.5f, 0.0f, 0.0f), glm::vec4(1.0f, 0.0f, 0.0f, 0.0f), glm::vec4(1.0f, 0.0f, 0.0f, 0.0f)}),
+		boneData
+	);
+
+	BoneNode rootBoneNode;
+	rootBoneNode.name = "root";
+	rootBoneNode.children.push_back({"arm", glm::mat4(3.0f), {}});
+
+	AnimatedBoneNode animatedBoneNode(
+		"arm",
+		{KeyFrame<glm::vec3>(std::chrono::duration<float32>(0.0f), glm::vec3(0.0f, 0.0f, 0.0f)), KeyFrame<glm::vec3>(std::chrono::duration<float32>(1.0f), glm::vec3(0.0f, 2.0f, 0.0f))},
+		{KeyFrame<glm::quat>(std::chrono::duration<float32>(0.0f), glm::quat(1.0f, 0.0f, 0.0f, 0.0f))},
+		{}
+	);
+
+	std::unordered_map<std::string, Animation> animations;
+	animations["wave"] = Animation("wave", std::chrono::duration<float32>(1.0f), 24.0f, {{"arm", animatedBoneNode}});
+
+	return Model("robot", {mesh}, {Texture("robot_texture", image)}, Skeleton("robot", rootBoneNode, glm::mat4(1.0f)), animations);
+}
+}
+
+BOOST_AUTO_TEST_SUITE(CookedAsset)
+
+BOOST_AUTO_TEST_CASE(imageRoundTrip)
+{
+	const Image image({1, 2, 3, 4, 5, 6, 7, 8}, 2, 1, IImage::Format::FORMAT_RGBA);
+
+	const auto data = cooking::cookImage(image);
+
+	BOOST_CHECK(cooking::cookedAssetType(data.data(), data.size()) == cooking::CookedAssetType::IMAGE);
+
+	const auto result = cooking::loadImage(data.data(), data.size());
+
+	BOOST_CHECK_EQUAL(result->width(), 2u);
+	BOOST_CHECK_EQUAL(result->height(), 1u);
+	BOOST_CHECK_EQUAL(result->format(), IImage::Format::FORMAT_RGBA);
+	BOOST_CHECK(result->data() == image.data());
+}
+
+BOOST_AUTO_TEST_CASE(imageKeepsMipLevels)
+{
+	const Image image({1, 2, 3, 4, 5, 6, 7, 8}, 4, 4, IImage::Format::FORMAT_BC1, {{17, 18, 19, 20, 21, 22, 23, 24}, {25, 26, 27, 28, 29, 30, 31, 32}});
+
+	const auto data = cooking::cookImage(image);
+	const auto result = cooking::loadImage(data.data(), data.size());
+
+	BOOST_CHECK_EQUAL(result->format(), IImage::Format::FORMAT_BC1);
+	BOOST_REQUIRE_EQUAL(result->mipLevelCount(), 3u);
+
+	for (uint32 i = 0; i < 3; ++i)
+	{
+		BOOST_CHECK(result->mipLevel(i) == image.mipLevel(i));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(heightMapKeepsBakedNormals)
+{
+	std::vector<byte> pixels;
+	for (int i = 0; i < 16; ++i)
+	{
+		const byte value = static_cast<byte>(i * 16);
+		pixels.insert(pixels.end(), {value, value, value});
+	}
+
+	const HeightMap heightMap(Image(pixels, 4, 4, IImage::Format::FORMAT_RGB));
+
+	const auto data = cooking::cookHeightMap(heightMap);
+	const auto result = cooking::loadHeightMap(data.data(), data.size());
+
+	BOOST_REQUIRE(result.image() != nullptr);
+	BOOST_CHECK(result.image()->data() == heightMap.image()->data());
+	BOOST_CHECK_EQUAL(result.height(3, 2), heightMap.height(3, 2));
+}
+
+BOOST_AUTO_TEST_CASE(modelRoundTrip)
+{
+	Image image({255, 0, 0, 255}, 1, 1, IImage::Format::FORMAT_RGBA);
+	const auto model = createModel(&image);
+
+	const auto data = cooking::cookModel(model, {"robot_texture.cooked"});
+
+	std::string resolvedPath;
+	const auto result = cooking::loadModel(data.data(), data.size(), [&image, &resolvedPath](const std::string& path) -> IImage* {
+		resolvedPath = path;
+		return &image;
+	});
+
+	BOOST_CHECK_EQUAL(result->name(), "robot");
+	BOOST_CHECK_EQUAL(resolvedPath, "robot_texture.cooked");
+
+	BOOST_REQUIRE_EQUAL(result->meshes().size(), 1u);
+	const auto& mesh = result->meshes()[0];
+	BOOST_CHECK_EQUAL(mesh.name(), "body");
+	BOOST_CHECK(mesh.vertices() == model.meshes()[0].vertices());
+	BOOST_CHECK(mesh.indices() == model.meshes()[0].indices());
+	BOOST_CHECK(mesh.normals() == model.meshes()[0].normals());
+	BOOST_CHECK(mesh.textureCoordinates() == model.meshes()[0].textureCoordinates());
+	BOOST_CHECK(mesh.vertexBoneData().boneIds() == model.meshes()[0].vertexBoneData().boneIds());
+	BOOST_CHECK(mesh.vertexBoneData().boneWeights() == model.meshes()[0].vertexBoneData().boneWeights());
+	BOOST_CHECK_EQUAL(mesh.boneData().boneIndexMap.at("arm"), 1u);
+	BOOST_CHECK(mesh.boneData().boneTransform[1].inverseModelSpacePoseTransform == glm::mat4(2.0f));
+
+	BOOST_REQUIRE_EQUAL(result->textures().size(), 1u);
+	BOOST_CHECK_EQUAL(result->textures()[0].name(), "robot_texture");
+	BOOST_CHECK(result->textures()[0].image() == &image);
+
+	BOOST_CHECK_EQUAL(result->skeleton().rootBoneNode().children.size(), 1u);
+	BOOST_CHECK_EQUAL(result->skeleton().rootBoneNode().children[0].name, "arm");
+	BOOST_CHECK(result->skeleton().rootBoneNode().children[0].transformation == glm::mat4(3.0f));
+
+	const auto& animation = result->animations().at("wave");
+	BOOST_CHECK_EQUAL(animation.ticksPerSecond(), 24.0f);
+	BOOST_CHECK_EQUAL(animation.animatedBoneNodes().at("arm").positionKeyFrames.size(), 2u);
+	BOOST_CHECK_EQUAL(animation.animatedBoneNodes().at("arm").positionKeyFrames[1].transformation.y, 2.0f);
+}
+
+BOOST_AUTO_TEST_CASE(packedMeshRoundTrip)
+{
+	Image image({255, 0, 0, 255}, 1, 1, IImage::Format::FORMAT_RGBA);
+	const auto model = createModel(&image);
+
+	mesh::MeshOptimizationOptions options;
+	options.splitPositions = true;
+	options.keepVertexStreams = mesh::VertexStreams::NONE;
+
+	const auto packedMesh = mesh::optimize(model.meshes()[0], options);
+	const Model packedModel(model.name(), {packedMesh}, model.textures(), model.skeleton(), model.animations());
+
+	const auto data = cooking::cookModel(packedModel, {"robot_texture.cooked"});
+	const auto result = cooking::loadModel(data.data(), data.size(), [&image](const std::string& path) -> IImage* {
+		return &image;
+	});
+
+	BOOST_REQUIRE_EQUAL(result->meshes().size(), 1u);
+	const auto& mesh = result->meshes()[0];
+	BOOST_CHECK(mesh.vertices().empty());
+
+	const auto& layout = mesh.vertexLayout();
+	BOOST_REQUIRE_EQUAL(layout.attributes.size(), packedMesh.vertexLayout().attributes.size());
+	for (size_t i = 0; i < layout.attributes.size(); ++i)
+	{
+		BOOST_CHECK(layout.attributes[i].attribute == packedMesh.vertexLayout().attributes[i].attribute);
+		BOOST_CHECK(layout.attributes[i].format == packedMesh.vertexLayout().attributes[i].format);
+		BOOST_CHECK_EQUAL(layout.attributes[i].stream, packedMesh.vertexLayout().attributes[i].stream);
+		BOOST_CHECK_EQUAL(layout.attributes[i].offset, packedMesh.vertexLayout().attributes[i].offset);
+	}
+	BOOST_CHECK(layout.strides == packedMesh.vertexLayout().strides);
+	BOOST_CHECK(layout.indexFormat == graphics::IndexFormat::UINT16);
+
+	BOOST_CHECK(mesh.vertexStreams() == packedMesh.vertexStreams());
+	BOOST_CHECK(mesh.indexData() == packedMesh.indexData());
+	BOOST_CHECK_EQUAL(mesh.boneData().boneIndexMap.at("arm"), 1u);
+
+	BOOST_CHECK(cooking::cookedModelTexturePaths(data.data(), data.size()) == std::vector<std::string>{"robot_texture.cooked"});
+}
+
+BOOST_AUTO_TEST_CASE(levelsOfDetailRoundTrip)
+{
+	Image image({255, 0, 0, 255}, 1, 1, IImage::Format::FORMAT_RGBA);
+	const auto model = createModel(&image);
+
+	const auto& body = model.meshes()[0];
+	const Mesh levelOfDetail("body", {glm::vec3(0.0f), glm::vec3(2.0f), glm::vec3(3.0f)}, {2, 1, 0}, {}, {}, {});
+	const Model modelWithLevelsOfDetail(model.name(), {body, body}, model.textures(), model.skeleton(), model.animations(), {{levelOfDetail, levelOfDetail}});
+
+	const auto data = cooking::cookModel(modelWithLevelsOfDetail, {"robot_texture.cooked"});
+	const auto result = cooking::loadModel(data.data(), data.size(), [&image](const std::string& path) -> IImage* {
+		return &image;
+	});
+
+	BOOST_REQUIRE_EQUAL(result->meshes().size(), 2u);
+	BOOST_REQUIRE_EQUAL(result->levelsOfDetail().size(), 2u);
+	BOOST_REQUIRE_EQUAL(result->levelsOfDetail()[0].size(), 2u);
+	BOOST_CHECK(result->levelsOfDetail()[1].empty());
+
+	BOOST_CHECK(result->levelsOfDetail()[0][1].indices() == levelOfDetail.indices());
+	BOOST_CHECK(result->levelsOfDetail()[0][1].vertices() == levelOfDetail.vertices());
+	BOOST_CHECK(result->meshes()[1].indices() == body.indices());
+
+	BOOST_CHECK(cooking::cookedModelTexturePaths(data.data(), data.size()) == std::vector<std::string>{"robot_texture.cooked"});
+}
+
+BOOST_AUTO_TEST_CASE(texturePathsWithoutLoading)
+{
+	Image image({255, 0, 0, 255}, 1, 1, IImage::Format::FORMAT_RGBA);
+
+	const auto data = cooking::cookModel(createModel(&image), {"robot_texture.cooked"});
+
+	BOOST_CHECK(cooking::cookedModelTexturePaths(data.data(), data.size()) == std::vector<std::string>{"robot_texture.cooked"});
+}
+
+BOOST_AUTO_TEST_CASE(cookingIsDeterministic)
+{
+	Image image({255, 0, 0, 255}, 1, 1, IImage::Format::FORMAT_RGBA);
+
+	BOOST_CHECK(cooking::cookModel(createModel(&image), {""}) == cooking::cookModel(createModel(&image), {""}));
+}
+
+BOOST_AUTO_TEST_CASE(rejectsOtherData)
+{
+	const Image image({1, 2, 3}, 1, 1, IImage::Format::FORMAT_RGB);
+	auto data = cooking::cookImage(image);
+
+	BOOST_CHECK_THROW(cooking::loadHeightMap(data.data(), data.size()), RuntimeException);
+	BOOST_CHECK_THROW(cooking::loadImage(data.data(), data.size() - 2), RuntimeException);
+
+	// Pixels that don't add up to the image's size
+	const Image shortImage({1, 2, 3}, 2, 1, IImage::Format::FORMAT_RGB);
+	data = cooking::cookImage(shortImage);
+	BOOST_CHECK_THROW(cooking::loadImage(data.data(), data.size()), RuntimeException);
+
+	const Image shortMipLevel({1, 2, 3, 4, 5, 6, 7, 8}, 4, 4, IImage::Format::FORMAT_BC1, {{1, 2, 3, 4}, {1, 2, 3, 4, 5, 6, 7, 8}});
+	data = cooking::cookImage(shortMipLevel);
+	BOOST_CHECK_THROW(cooking::loadImage(data.data(), data.size()), RuntimeException);
+
+	const std::string text = "not a cooked asset";
+	BOOST_CHECK(cooking::cookedAssetType(reinterpret_cast<const byte*>(text.data()), text.size()) == cooking::CookedAssetType::UNKNOWN);
+	BOOST_CHECK_THROW(cooking::loadImage(reinterpret_cast<const byte*>(text.data()), text.size()), RuntimeException);
+}
+
+BOOST_AUTO_TEST_CASE(rejectsCountsLargerThanTheData)
+{
+	Image image({255, 0, 0, 255}, 1, 1, IImage::Format::FORMAT_RGBA);
+	auto data = cooking::cookModel(createModel(&image), {""});
+
+	// The mesh count follows the 16 byte header and the model name
+	const size_t meshCountOffset = 4 * sizeof(uint32) + sizeof(uint32) + std::string("robot").size();
+	const uint32 meshCount = 0xFFFFFFFF;
+	std::memcpy(&data[meshCountOffset], &meshCount, sizeof(meshCount));
+
+	BOOST_CHECK_THROW(cooking::loadModel(data.data(), data.size(), [](const std::string&) -> IImage* { return nullptr; }), RuntimeException);
+}
+
+BOOST_AUTO_TEST_CASE(rejectsTooDeepSkeletons)
+{
+	BoneNode rootBoneNode;
+	rootBoneNode.name = "0";
+
+	auto boneNode = &rootBoneNode;
+	for (int i = 1; i < 1000; ++i)
+	{
+		boneNode->children.push_back({std::to_string(i), glm::mat4(1.0f), {}});
+		boneNode = &boneNode->children[0];
+	}
+
+	const Model model("deep", {}, {}, Skeleton("deep", rootBoneNode, glm::mat4(1.0f)), {});
+	const auto data = cooking::cookModel(model, {});
+
+	BOOST_CHECK_THROW(cooking::loadModel(data.data(), data.size(), [](const std::string&) -> IImage* { return nullptr; }), RuntimeException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,86 @@
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#define BOOST_TEST_MODULE ForEachChunk
+#include <boost/test/unit_test.hpp>
+
+#include "detail/ForEachChunk.hpp"
+
+#include "ThreadPool.hpp"
+
+using namespace ice_engine;
+
+BOOST_AUTO_TEST_SUITE(ForEachChunk)
+
+BOOST_AUTO_TEST_CASE(runsEveryChunkOnce)
+{
+	ThreadPool threadPool(4);
+	std::vector<std::atomic<int>> visits(1000);
+
+	for (auto& visit : visits) visit = 0;
+
+	detail::forEachChunk(&threadPool, visits.size(), 64, [&visits](const size_t chunk, const size_t begin, const size_t end) {
+		BOOST_REQUIRE_EQUAL(begin, chunk * 64);
+
+		for (size_t i = begin; i < end; ++i) ++visits[i];
+	});
+
+	for (const auto& visit : visits) BOOST_CHECK_EQUAL(visit.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(runsFromTheThreadPoolsOwnWorkers)
+{
+	// Every worker is busy running a caller, so the chunks can only get done if the callers run them themselves
+	ThreadPool threadPool(2);
+	std::atomic<size_t> total(0);
+
+	std::vector<std::future<void>> futures;
+	for (int i = 0; i < 2; ++i)
+	{
+		futures.push_back(threadPool.postWork([&threadPool, &total]() {
+			detail::forEachChunk(&threadPool, 100, 10, [&total](const size_t chunk, const size_t begin, const size_t end) {
+				total += end - begin;
+			});
+		}));
+	}
+
+	for (auto& future : futures)
+	{
+		BOOST_REQUIRE(future.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+		future.get();
+	}
+
+	BOOST_CHECK_EQUAL(total.load(), 200u);
+}
+
+BOOST_AUTO_TEST_CASE(rethrowsAfterEveryChunkIsDone)
+{
+	ThreadPool threadPool(4);
+	std::atomic<int> chunksRun(0);
+
+	BOOST_CHECK_THROW(
+		detail::forEachChunk(&threadPool, 100, 10, [&chunksRun](const size_t chunk, const size_t begin, const size_t end) {
+			++chunksRun;
+			if (chunk == 3) throw std::runtime_error("chunk failed");
+		}),
+		std::runtime_error
+	);
+
+	BOOST_CHECK_EQUAL(chunksRun.load(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(runsOnTheCallingThreadWithoutAThreadPool)
+{
+	const auto callingThread = std::this_thread::get_id();
+	size_t total = 0;
+
+	detail::forEachChunk(nullptr, 100, 10, [&total, callingThread](const size_t chunk, const size_t begin, const size_t end) {
+		BOOST_CHECK(std::this_thread::get_id() == callingThread);
+		total += end - begin;
+	});
+
+	BOOST_CHECK_EQUAL(total, 100u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,166 @@
+#include <fstream>
+
+#define BOOST_TEST_MODULE PackArchive
+#include <boost/test/unit_test.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include "fs/PackArchive.hpp"
+#include "fs/FileSystem.hpp"
+
+#include "exceptions/FileNotFoundException.hpp"
+#include "exceptions/InvalidArgumentException.hpp"
+#include "exceptions/RuntimeException.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+std::vector<byte> bytes(const std::string& value)
+{
+	return std::vector<byte>(value.begin(), value.end());
+}
+
+std::string string(const fs::IMappedFile& mappedFile)
+{
+	return std::string(reinterpret_cast<const char*>(mappedFile.data()), mappedFile.size());
+}
+}
+
+struct Fixture
+{
+	Fixture()
+	{
+		filename = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+		patchFilename = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+
+		fs::PackArchiveWriter writer;
+		writer.add("models/robot.cooked", bytes("robot"));
+		writer.add("/scripts\\\\main.as", bytes("void main() {}"));
+		writer.add("textures/grass.cooked", std::vector<byte>(4096, 7), true);
+		writer.add("empty.txt", {});
+		writer.write(filename);
+
+		fs::PackArchiveWriter patchWriter;
+		patchWriter.add("models/robot.cooked", bytes("patched robot"));
+		patchWriter.write(patchFilename);
+	}
+
+	~Fixture()
+	{
+		boost::filesystem::remove(filename);
+		boost::filesystem::remove(patchFilename);
+	}
+
+	std::string filename;
+	std::string patchFilename;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PackArchive, Fixture)
+
+BOOST_AUTO_TEST_CASE(normalizePath)
+{
+	BOOST_CHECK_EQUAL(fs::normalizePackArchivePath("/a//b\\c"), "a/b/c");
+	BOOST_CHECK_EQUAL(fs::normalizePackArchivePath("./a/./b"), "a/b");
+	BOOST_CHECK_EQUAL(fs::normalizePackArchivePath(""), "");
+}
+
+BOOST_AUTO_TEST_CASE(lookup)
+{
+	const fs::PackArchive archive(filename);
+
+	BOOST_CHECK_EQUAL(archive.size(), 4u);
+	BOOST_CHECK(archive.contains("models/robot.cooked"));
+	BOOST_CHECK(archive.contains("./scripts/main.as"));
+	BOOST_CHECK(!archive.contains("models/robot"));
+	BOOST_CHECK(!archive.contains("DOES_NOT_EXIST"));
+
+	const std::vector<std::string> expected = {"models/robot.cooked", "scripts/main.as", "textures/grass.cooked", "empty.txt"};
+	BOOST_CHECK(archive.paths() == expected);
+}
+
+BOOST_AUTO_TEST_CASE(map)
+{
+	const fs::PackArchive archive(filename);
+
+	BOOST_CHECK_EQUAL(string(*archive.map("models/robot.cooked")), "robot");
+	BOOST_CHECK_EQUAL(archive.map("empty.txt")->size(), 0u);
+	BOOST_CHECK_THROW(archive.map("DOES_NOT_EXIST"), FileNotFoundException);
+
+	const auto mappedFile = archive.map("scripts/main.as");
+	BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(mappedFile->data()) % fs::PACK_ARCHIVE_ALIGNMENT, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(compressedEntry)
+{
+	const fs::PackArchive archive(filename);
+
+	const auto entry = archive.find("textures/grass.cooked");
+	BOOST_REQUIRE(entry != nullptr);
+	BOOST_CHECK(entry->compression == fs::PackArchiveCompression::ZLIB);
+	BOOST_CHECK_LT(entry->storedSize, entry->size);
+
+	const auto mappedFile = archive.map("textures/grass.cooked");
+	BOOST_CHECK(std::vector<byte>(mappedFile->data(), mappedFile->data() + mappedFile->size()) == std::vector<byte>(4096, 7));
+}
+
+BOOST_AUTO_TEST_CASE(mappingOutlivesArchive)
+{
+	std::unique_ptr<fs::IMappedFile> mappedFile;
+
+	{
+		const fs::PackArchive archive(filename);
+		mappedFile = archive.map("models/robot.cooked");
+	}
+
+	BOOST_CHECK_EQUAL(string(*mappedFile), "robot");
+}
+
+BOOST_AUTO_TEST_CASE(duplicatePath)
+{
+	fs::PackArchiveWriter writer;
+	writer.add("a.txt", bytes("a"));
+
+	BOOST_CHECK_THROW(writer.add("/a.txt", bytes("b")), InvalidArgumentException);
+	BOOST_CHECK_THROW(writer.add("", bytes("b")), InvalidArgumentException);
+}
+
+BOOST_AUTO_TEST_CASE(notAnArchive)
+{
+	{
+		std::ofstream outputStream(patchFilename, std::ios::binary | std::ios::trunc);
+		outputStream << std::string(128, 'x');
+	}
+
+	BOOST_CHECK_THROW(fs::PackArchive archive(patchFilename), RuntimeException);
+}
+
+BOOST_AUTO_TEST_CASE(mountArchive)
+{
+	fs::FileSystem fileSystem;
+	fileSystem.mountArchive(filename, "data");
+
+	BOOST_CHECK(fileSystem.exists("data/models/robot.cooked"));
+	BOOST_CHECK(!fileSystem.exists("models/robot.cooked"));
+	BOOST_CHECK_EQUAL(fileSystem.readAll("data/scripts/main.as"), "void main() {}");
+	BOOST_CHECK_EQUAL(string(*fileSystem.map("data/models/robot.cooked")), "robot");
+
+	BOOST_CHECK_THROW(fileSystem.mountArchive(filename), InvalidArgumentException);
+	BOOST_CHECK_THROW(fileSystem.open("data/models/robot.cooked", fs::FileFlags::READ | fs::FileFlags::WRITE), InvalidArgumentException);
+
+	fileSystem.unmountArchive(filename);
+
+	BOOST_CHECK(!fileSystem.exists("data/models/robot.cooked"));
+}
+
+BOOST_AUTO_TEST_CASE(patchArchiveOverrides)
+{
+	fs::FileSystem fileSystem;
+	fileSystem.mountArchive(filename);
+	fileSystem.mountArchive(patchFilename);
+
+	BOOST_CHECK_EQUAL(fileSystem.readAll("models/robot.cooked"), "patched robot");
+	BOOST_CHECK_EQUAL(fileSystem.readAll("scripts/main.as"), "void main() {}");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
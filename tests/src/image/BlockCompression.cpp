@@ -0,0 +1,243 @@
+#include <cstdlib>
+#include <vector>
+
+#define BOOST_TEST_MODULE BlockCompression
+#include <boost/test/unit_test.hpp>
+
+#include "image/BlockCompression.hpp"
+
+#include "ThreadPool.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+uint64 readLittleEndian(const byte* source, const uint32 bytes)
+{
+	uint64 value = 0;
+	for (uint32 i = 0; i < bytes; ++i) value |= static_cast<uint64>(source[i]) << (8 * i);
+
+	return value;
+}
+
+void decodeColour565(const uint32 colour, int32 (&rgb)[3])
+{
+	rgb[0] = ((colour >> 11) & 31) * 255 / 31;
+	rgb[1] = ((colour >> 5) & 63) * 255 / 63;
+	rgb[2] = (colour & 31) * 255 / 31;
+}
+
+// Decoders written from the format descriptions, to check the encoder against
+void decodeColourBlock(const byte* source, std::vector<std::vector<int32>>& pixels)
+{
+	const auto colour0 = static_cast<uint32>(readLittleEndian(source, 2));
+	const auto colour1 = static_cast<uint32>(readLittleEndian(source + 2, 2));
+	const auto indices = readLittleEndian(source + 4, 4);
+
+	int32 palette[4][3];
+	decodeColour565(colour0, palette[0]);
+	decodeColour565(colour1, palette[1]);
+
+	for (uint32 c = 0; c < 3; ++c)
+	{
+		if (colour0 > colour1)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+		else
+		{
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+			palette[3][c] = 0;
+		}
+	}
+
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		const auto index = (indices >> (2 * i)) & 3;
+		pixels[i].assign(palette[index], palette[index] + 3);
+	}
+}
+
+void decodeChannelBlock(const byte* source, std::vector<int32>& values)
+{
+	const int32 value0 = source[0];
+	const int32 value1 = source[1];
+	const auto indices = readLittleEndian(source + 2, 6);
+
+	int32 palette[8] = {value0, value1};
+	if (value0 > value1)
+	{
+		for (int32 i = 1; i < 7; ++i) palette[i + 1] = ((7 - i) * value0 + i * value1) / 7;
+	}
+	else
+	{
+		for (int32 i = 1; i < 5; ++i) palette[i + 1] = ((5 - i) * value0 + i * value1) / 5;
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	values.resize(16);
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		values[i] = palette[(indices >> (3 * i)) & 7];
+	}
+}
+
+/**
+ * Largest difference between any channel of the first block of pixels and the same channel decoded from compressed.
+ */
+int32 largestBlockError(const std::vector<byte>& rgba, const uint32 width, const std::vector<byte>& compressed, const IImage::Format format)
+{
+	std::vector<std::vector<int32>> colours(16);
+	std::vector<int32> channel0;
+	std::vector<int32> channel1;
+
+	switch (format)
+	{
+		case IImage::Format::FORMAT_BC1:
+			decodeColourBlock(compressed.data(), colours);
+			break;
+
+		case IImage::Format::FORMAT_BC3:
+			decodeChannelBlock(compressed.data(), channel0);
+			decodeColourBlock(compressed.data() + 8, colours);
+			break;
+
+		default:
+			decodeChannelBlock(compressed.data(), channel0);
+			decodeChannelBlock(compressed.data() + 8, channel1);
+			break;
+	}
+
+	int32 error = 0;
+
+	for (uint32 i = 0; i < 16; ++i)
+	{
+		const byte* pixel = rgba.data() + ((i / 4) * width + i % 4) * 4;
+
+		if (format == IImage::Format::FORMAT_BC5)
+		{
+			error = std::max(error, std::abs(pixel[0] - channel0[i]));
+			error = std::max(error, std::abs(pixel[1] - channel1[i]));
+			continue;
+		}
+
+		for (uint32 c = 0; c < 3; ++c) error = std::max(error, std::abs(pixel[c] - colours[i][c]));
+		if (format == IImage::Format::FORMAT_BC3) error = std::max(error, std::abs(pixel[3] - channel0[i]));
+	}
+
+	return error;
+}
+
+/**
+ * A smooth gradient along one direction in colour space, with a separate gradient in alpha.
+ */
+std::vector<byte> gradient(const uint32 width, const uint32 height)
+{
+	std::vector<byte> rgba;
+
+	for (uint32 y = 0; y < height; ++y)
+	{
+		for (uint32 x = 0; x < width; ++x)
+		{
+			const byte value = static_cast<byte>((x * 255) / (width - 1));
+			rgba.insert(rgba.end(), {value, static_cast<byte>(value / 2), static_cast<byte>(255 - value), static_cast<byte>((y * 255) / (height - 1))});
+		}
+	}
+
+	return rgba;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(BlockCompressionTests)
+
+BOOST_AUTO_TEST_CASE(sizes)
+{
+	BOOST_CHECK_EQUAL(image::imageSize(IImage::Format::FORMAT_RGB, 5, 3), 45u);
+	BOOST_CHECK_EQUAL(image::imageSize(IImage::Format::FORMAT_RGBA, 5, 3), 60u);
+	BOOST_CHECK_EQUAL(image::imageSize(IImage::Format::FORMAT_BC1, 5, 3), 16u);
+	BOOST_CHECK_EQUAL(image::imageSize(IImage::Format::FORMAT_BC3, 5, 3), 32u);
+	BOOST_CHECK_EQUAL(image::imageSize(IImage::Format::FORMAT_BC5, 1, 1), 16u);
+	BOOST_CHECK_EQUAL(image::imageSize(IImage::Format::FORMAT_BC1, 256, 256), 256u * 256u / 2u);
+
+	BOOST_CHECK(image::formatFromString("bc5") == IImage::Format::FORMAT_BC5);
+	BOOST_CHECK_THROW(image::formatFromString("bc7"), InvalidArgumentException);
+}
+
+BOOST_AUTO_TEST_CASE(blocksDecodeCloseToTheirPixels)
+{
+	// A 4x4 gradient lies on a line in colour space, so it should come back almost exactly
+	const auto rgba = gradient(4, 4);
+
+	for (const auto format : {IImage::Format::FORMAT_BC1, IImage::Format::FORMAT_BC3, IImage::Format::FORMAT_BC5})
+	{
+		std::vector<byte> compressed;
+		image::compress(rgba.data(), 4, 4, format, compressed);
+
+		BOOST_REQUIRE_EQUAL(compressed.size(), image::imageSize(format, 4, 4));
+		BOOST_CHECK_LE(largestBlockError(rgba, 4, compressed, format), 24);
+	}
+
+	// A single colour is exact up to 565 rounding
+	const std::vector<byte> solid(16 * 4, 200);
+	std::vector<byte> compressed;
+	image::compress(solid.data(), 4, 4, IImage::Format::FORMAT_BC3, compressed);
+	BOOST_CHECK_LE(largestBlockError(solid, 4, compressed, IImage::Format::FORMAT_BC3), 4);
+
+	image::compress(solid.data(), 4, 4, IImage::Format::FORMAT_BC5, compressed);
+	BOOST_CHECK_EQUAL(largestBlockError(solid, 4, compressed, IImage::Format::FORMAT_BC5), 0);
+}
+
+BOOST_AUTO_TEST_CASE(threadedCompressionMatches)
+{
+	ThreadPool threadPool(4);
+
+	// Not a multiple of 4, so the edge blocks are padded
+	const uint32 width = 517;
+	const uint32 height = 263;
+	const auto rgba = gradient(width, height);
+
+	std::vector<byte> compressed;
+	std::vector<byte> threadedCompressed;
+	image::compress(rgba.data(), width, height, IImage::Format::FORMAT_BC3, compressed);
+	image::compress(rgba.data(), width, height, IImage::Format::FORMAT_BC3, threadedCompressed, &threadPool);
+
+	BOOST_CHECK_EQUAL(compressed.size(), 130u * 66u * 16u);
+	BOOST_CHECK(compressed == threadedCompressed);
+
+	BOOST_CHECK_THROW(image::compress(rgba.data(), width, height, IImage::Format::FORMAT_RGBA, compressed), InvalidArgumentException);
+}
+
+BOOST_AUTO_TEST_CASE(textureImageHasFullMipChain)
+{
+	const Image source(std::vector<byte>(40 * 12 * 3, 128), 40, 12, IImage::Format::FORMAT_RGB);
+
+	const auto texture = image::createTextureImage(source, IImage::Format::FORMAT_BC1);
+
+	BOOST_CHECK_EQUAL(texture->format(), IImage::Format::FORMAT_BC1);
+	BOOST_CHECK_EQUAL(texture->width(), 40u);
+	BOOST_CHECK_EQUAL(texture->height(), 12u);
+
+	// 40x12, 20x6, 10x3, 5x1, 2x1 and 1x1
+	BOOST_REQUIRE_EQUAL(texture->mipLevelCount(), 6u);
+	BOOST_CHECK(texture->mipLevel(0) == texture->data());
+
+	for (uint32 i = 0; i < texture->mipLevelCount(); ++i)
+	{
+		BOOST_CHECK_EQUAL(texture->mipLevel(i).size(), image::imageSize(IImage::Format::FORMAT_BC1, std::max(1u, 40u >> i), std::max(1u, 12u >> i)));
+	}
+
+	BOOST_CHECK_THROW(texture->mipLevel(6), InvalidArgumentException);
+
+	// Uncompressed textures get mips too, in the requested layout
+	const auto rgbaTexture = image::createTextureImage(source, IImage::Format::FORMAT_RGBA);
+	BOOST_CHECK_EQUAL(rgbaTexture->mipLevelCount(), 6u);
+	BOOST_CHECK(rgbaTexture->mipLevel(5) == std::vector<byte>({128, 128, 128, 255}));
+
+	BOOST_CHECK_THROW(image::createTextureImage(*texture, IImage::Format::FORMAT_BC3), InvalidArgumentException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
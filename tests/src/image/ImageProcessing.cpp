@@ -0,0 +1,207 @@
+#include <cmath>
+#include <vector>
+
+#define BOOST_TEST_MODULE ImageProcessing
+#include <boost/test/unit_test.hpp>
+
+#include "image/ImageProcessing.hpp"
+
+#include "ThreadPool.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+std::vector<byte> pattern(const size_t size)
+{
+	std::vector<byte> data(size);
+
+	for (size_t i = 0; i < size; ++i)
+	{
+		data[i] = static_cast<byte>((i * 37 + (i / 7) * 11) % 256);
+	}
+
+	return data;
+}
+
+// The filter height maps used before, one pixel at a time
+float32 height(const std::vector<byte>& data, const uint32 width, const uint32 height, const uint32 x, const uint32 z)
+{
+	return static_cast<float32>(data[(z % height) * width * 4 + (x % width) * 4 + 3]) / 255.0f;
+}
+
+std::vector<byte> referenceSobelNormals(std::vector<byte> data, const uint32 width, const uint32 height)
+{
+	const std::vector<byte> heights = data;
+
+	for (uint32 x = 0; x < width; ++x)
+	{
+		for (uint32 z = 0; z < height; ++z)
+		{
+			const float32 tl = ::height(heights, width, height, x + width - 1, z + 1);
+			const float32  l = ::height(heights, width, height, x + width - 1, z);
+			const float32 bl = ::height(heights, width, height, x + width - 1, z + height - 1);
+			const float32  t = ::height(heights, width, height, x, z + 1);
+			const float32  b = ::height(heights, width, height, x, z + height - 1);
+			const float32 tr = ::height(heights, width, height, x + 1, z + 1);
+			const float32  r = ::height(heights, width, height, x + 1, z);
+			const float32 br = ::height(heights, width, height, x + 1, z + height - 1);
+
+			const float32 dX = (tr + 2.0f * r + br) - (tl + 2.0f * l + bl);
+			const float32 dY = (bl + 2.0f * b + br) - (tl + 2.0f * t + tr);
+			const float32 dZ = 1.0f / 8.0f;
+			const float32 inverseLength = 1.0f / std::sqrt(dX * dX + dY * dY + dZ * dZ);
+
+			data[z * width * 4 + x * 4 + 0] = static_cast<byte>((dX * inverseLength + 1.0f) * (255.0f / 2.0f));
+			data[z * width * 4 + x * 4 + 1] = static_cast<byte>((dY * inverseLength + 1.0f) * (255.0f / 2.0f));
+			data[z * width * 4 + x * 4 + 2] = static_cast<byte>((dZ * inverseLength + 1.0f) * (255.0f / 2.0f));
+		}
+	}
+
+	return data;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(ImageProcessingTests)
+
+BOOST_AUTO_TEST_CASE(swapRedAndBlue)
+{
+	ThreadPool threadPool(4);
+
+	for (const uint32 pixelSize : {3u, 4u})
+	{
+		const size_t pixelCount = 100000;
+		const auto original = pattern(pixelCount * pixelSize);
+
+		auto pixels = original;
+		image::swapRedAndBlue(pixels.data(), pixelCount, pixelSize, &threadPool);
+
+		for (size_t i = 0; i < pixelCount; ++i)
+		{
+			BOOST_REQUIRE_EQUAL(pixels[i * pixelSize + 0], original[i * pixelSize + 2]);
+			BOOST_REQUIRE_EQUAL(pixels[i * pixelSize + 1], original[i * pixelSize + 1]);
+			BOOST_REQUIRE_EQUAL(pixels[i * pixelSize + 2], original[i * pixelSize + 0]);
+			if (pixelSize == 4) BOOST_REQUIRE_EQUAL(pixels[i * 4 + 3], original[i * 4 + 3]);
+		}
+
+		image::swapRedAndBlue(pixels.data(), pixelCount, pixelSize);
+		BOOST_CHECK(pixels == original);
+	}
+
+	std::vector<byte> pixels(8);
+	BOOST_CHECK_THROW(image::swapRedAndBlue(pixels.data(), 4, 2), InvalidArgumentException);
+}
+
+BOOST_AUTO_TEST_CASE(channelConversions)
+{
+	ThreadPool threadPool(4);
+
+	const size_t pixelCount = 70000;
+	const auto rgb = pattern(pixelCount * 3);
+
+	std::vector<byte> rgba(pixelCount * 4);
+	image::rgbToRgba(rgb.data(), rgba.data(), pixelCount, &threadPool);
+
+	for (size_t i = 0; i < pixelCount; ++i)
+	{
+		BOOST_REQUIRE_EQUAL(rgba[i * 4 + 0], rgb[i * 3 + 0]);
+		BOOST_REQUIRE_EQUAL(rgba[i * 4 + 1], rgb[i * 3 + 1]);
+		BOOST_REQUIRE_EQUAL(rgba[i * 4 + 2], rgb[i * 3 + 2]);
+		BOOST_REQUIRE_EQUAL(rgba[i * 4 + 3], 255);
+	}
+
+	image::luminanceToAlpha(rgba.data(), pixelCount, &threadPool);
+
+	for (size_t i = 0; i < pixelCount; ++i)
+	{
+		BOOST_REQUIRE_EQUAL(rgba[i * 4 + 3], (rgb[i * 3 + 0] + rgb[i * 3 + 1] + rgb[i * 3 + 2]) / 3);
+	}
+
+	std::vector<byte> result(pixelCount * 3);
+	image::rgbaToRgb(rgba.data(), result.data(), pixelCount);
+	BOOST_CHECK(result == rgb);
+}
+
+BOOST_AUTO_TEST_CASE(sobelNormalsMatchPerPixelFilter)
+{
+	ThreadPool threadPool(4);
+
+	// Sizes that don't split evenly into chunks, and a single row
+	const std::vector<std::pair<uint32, uint32>> sizes = {{64, 64}, {257, 300}, {1000, 3}, {16, 1}};
+
+	for (const auto& size : sizes)
+	{
+		const auto data = pattern(size.first * size.second * 4);
+		const auto expected = referenceSobelNormals(data, size.first, size.second);
+
+		auto normals = data;
+		image::sobelNormals(normals.data(), size.first, size.second, 8.0f);
+		BOOST_CHECK(normals == expected);
+
+		normals = data;
+		image::sobelNormals(normals.data(), size.first, size.second, 8.0f, &threadPool);
+		BOOST_CHECK(normals == expected);
+	}
+
+	// A flat height map points straight up everywhere
+	std::vector<byte> flat(8 * 8 * 4, 100);
+	image::sobelNormals(flat.data(), 8, 8, 8.0f);
+	for (size_t i = 0; i < flat.size(); i += 4)
+	{
+		BOOST_REQUIRE_EQUAL(flat[i + 0], 127);
+		BOOST_REQUIRE_EQUAL(flat[i + 1], 127);
+		BOOST_REQUIRE_EQUAL(flat[i + 2], 255);
+		BOOST_REQUIRE_EQUAL(flat[i + 3], 100);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(downsampleAveragesBlocks)
+{
+	ThreadPool threadPool(4);
+
+	for (const uint32 pixelSize : {1u, 2u, 3u, 4u})
+	{
+		const uint32 width = 513;
+		const uint32 height = 301;
+		const auto pixels = pattern(width * height * pixelSize);
+
+		std::vector<byte> result;
+		image::downsample(pixels.data(), width, height, pixelSize, result, &threadPool);
+		BOOST_REQUIRE_EQUAL(result.size(), (width / 2) * (height / 2) * pixelSize);
+
+		for (uint32 j = 0; j < height / 2; ++j)
+		{
+			for (uint32 i = 0; i < width / 2; ++i)
+			{
+				for (uint32 c = 0; c < pixelSize; ++c)
+				{
+					const auto sample = [&](const uint32 x, const uint32 z) {
+						return static_cast<uint32>(pixels[(z * width + x) * pixelSize + c]);
+					};
+
+					const uint32 sum = sample(i * 2, j * 2) + sample(i * 2 + 1, j * 2) + sample(i * 2, j * 2 + 1) + sample(i * 2 + 1, j * 2 + 1);
+					BOOST_REQUIRE_EQUAL(result[(j * (width / 2) + i) * pixelSize + c], (sum + 2) / 4);
+				}
+			}
+		}
+	}
+
+	// Down to a single pixel, one side at a time
+	const std::vector<byte> column = {10, 20, 30, 40};
+	std::vector<byte> result;
+	image::downsample(column.data(), 1, 4, 1, result);
+	BOOST_CHECK(result == std::vector<byte>({15, 35}));
+
+	std::vector<byte> smallerResult;
+	image::downsample(result.data(), 1, 2, 1, smallerResult);
+	BOOST_CHECK(smallerResult == std::vector<byte>({25}));
+
+	image::downsample(smallerResult.data(), 1, 1, 1, result);
+	BOOST_CHECK(result == std::vector<byte>({25}));
+
+	BOOST_CHECK_THROW(image::downsample(column.data(), 0, 4, 1, result), InvalidArgumentException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
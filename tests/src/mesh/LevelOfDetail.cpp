@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <vector>
+
+#define BOOST_TEST_MODULE LevelOfDetail
+#include <boost/test/unit_test.hpp>
+
+#include "mesh/LevelOfDetail.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+/**
+ * A closed unit sphere with normals and texture coordinates, from an octahedron with each triangle split into four
+ * subdivisions times.
+ */
+Mesh createSphere(const uint32 subdivisions)
+{
+	std::vector<glm::vec3> vertices = {
+		glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f),
+		glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+		glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f)
+	};
+	std::vector<uint32> indices = {0, 2, 4, 2, 1, 4, 1, 3, 4, 3, 0, 4, 2, 0, 5, 1, 2, 5, 3, 1, 5, 0, 3, 5};
+
+	for (uint32 i = 0; i < subdivisions; ++i)
+	{
+		std::map<std::pair<uint32, uint32>, uint32> midpoints;
+		const auto midpoint = [&vertices, &midpoints](const uint32 a, const uint32 b) {
+			const auto key = std::make_pair(std::min(a, b), std::max(a, b));
+			const auto it = midpoints.find(key);
+			if (it != midpoints.end()) return it->second;
+
+			vertices.push_back(glm::normalize(vertices[a] + vertices[b]));
+			midpoints[key] = static_cast<uint32>(vertices.size() - 1);
+
+			return static_cast<uint32>(vertices.size() - 1);
+		};
+
+		std::vector<uint32> subdivided;
+		for (size_t j = 0; j < indices.size(); j += 3)
+		{
+			const uint32 a = indices[j];
+			const uint32 b = indices[j + 1];
+			const uint32 c = indices[j + 2];
+			const uint32 ab = midpoint(a, b);
+			const uint32 bc = midpoint(b, c);
+			const uint32 ca = midpoint(c, a);
+
+			subdivided.insert(subdivided.end(), {a, ab, ca, ab, b, bc, ca, bc, c, ab, bc, ca});
+		}
+
+		indices = std::move(subdivided);
+	}
+
+	std::vector<glm::vec2> textureCoordinates;
+	for (const auto& vertex : vertices) textureCoordinates.push_back(glm::vec2(vertex[0], vertex[1]));
+
+	return Mesh("sphere", vertices, indices, {}, vertices, textureCoordinates);
+}
+
+const float32 PI = 3.14159265f;
+}
+
+BOOST_AUTO_TEST_SUITE(LevelOfDetailTests)
+
+BOOST_AUTO_TEST_CASE(eachLevelHalvesTriangles)
+{
+	const auto mesh = createSphere(4);
+
+	mesh::LevelOfDetailOptions options;
+	options.levelCount = 3;
+
+	const auto levelsOfDetail = mesh::generateLevelsOfDetail(mesh, options);
+
+	BOOST_REQUIRE_EQUAL(levelsOfDetail.size(), 3u);
+
+	auto previousTriangleCount = mesh.indices().size() / 3;
+	for (const auto& levelOfDetail : levelsOfDetail)
+	{
+		const auto triangleCount = levelOfDetail.indices().size() / 3;
+
+		BOOST_CHECK_LE(triangleCount, previousTriangleCount / 2);
+		BOOST_CHECK_GT(triangleCount, previousTriangleCount / 4);
+
+		// Same vertices, fewer of them used
+		BOOST_CHECK_EQUAL(levelOfDetail.vertices().size(), mesh.vertices().size());
+		BOOST_CHECK_EQUAL(levelOfDetail.textureCoordinates().size(), mesh.textureCoordinates().size());
+		BOOST_CHECK_EQUAL(levelOfDetail.name(), mesh.name());
+
+		previousTriangleCount = triangleCount;
+	}
+}
+
+BOOST_AUTO_TEST_CASE(stopsWhenNothingIsLeftToSimplify)
+{
+	// Every vertex of a lone quad is on its border
+	const Mesh quad(
+		"quad",
+		{glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(1.0f, 0.0f, 1.0f)},
+		{0, 2, 1, 1, 2, 3},
+		{},
+		{},
+		{}
+	);
+
+	BOOST_CHECK(mesh::generateLevelsOfDetail(quad).empty());
+	BOOST_CHECK(mesh::generateLevelsOfDetail(Mesh()).empty());
+}
+
+BOOST_AUTO_TEST_CASE(invalidReductionThrows)
+{
+	mesh::LevelOfDetailOptions options;
+	options.reduction = 1.0f;
+
+	BOOST_CHECK_THROW(mesh::generateLevelsOfDetail(createSphere(1), options), InvalidArgumentException);
+}
+
+BOOST_AUTO_TEST_CASE(screenSizeOfSphere)
+{
+	BOOST_CHECK_CLOSE(mesh::screenSize(1.0f, 10.0f, PI * 0.5f), 0.1f, 0.01f);
+	BOOST_CHECK_CLOSE(mesh::screenSize(2.0f, 10.0f, PI * 0.5f), 0.2f, 0.01f);
+	BOOST_CHECK_EQUAL(mesh::screenSize(1.0f, 0.5f, PI * 0.5f), std::numeric_limits<float32>::max());
+}
+
+BOOST_AUTO_TEST_CASE(selectsLevelByScreenSize)
+{
+	const std::vector<float32> screenSizes = {0.5f, 0.25f, 0.125f};
+
+	BOOST_CHECK_EQUAL(mesh::selectLevelOfDetail(screenSizes, 4, 1.0f, 0, 0.0f), 0u);
+	BOOST_CHECK_EQUAL(mesh::selectLevelOfDetail(screenSizes, 4, 0.3f, 0, 0.0f), 1u);
+	BOOST_CHECK_EQUAL(mesh::selectLevelOfDetail(screenSizes, 4, 0.2f, 0, 0.0f), 2u);
+	BOOST_CHECK_EQUAL(mesh::selectLevelOfDetail(screenSizes, 4, 0.01f, 0, 0.0f), 3u);
+	BOOST_CHECK_EQUAL(mesh::selectLevelOfDetail(screenSizes, 4, 1.0f, 3, 0.0f), 0u);
+
+	// Renderables with fewer levels stop at their last
+	BOOST_CHECK_EQUAL(mesh::selectLevelOfDetail(screenSizes, 2, 0.01f, 0, 0.0f), 1u);
+	BOOST_CHECK_EQUAL(mesh::selectLevelOfDetail(screenSizes, 1, 0.01f, 0, 0.0f), 0u);
+	BOOST_CHECK_EQUAL(mesh::selectLevelOfDetail(screenSizes, 2, 0.01f, 5, 0.0f), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(hysteresisKeepsLevelNearThreshold)
+{
+	const std::vector<float32> screenSizes = {0.5f, 0.25f, 0.125f};
+
+	// Shrinking past 0.25 only switches once below 0.225
+	BOOST_CHECK_EQUAL(mesh::selectLevelOfDetail(screenSizes, 4, 0.24f, 1, 0.1f), 1u);
+	BOOST_CHECK_EQUAL(mesh::selectLevelOfDetail(screenSizes, 4, 0.22f, 1, 0.1f), 2u);
+
+	// And growing back only switches once above 0.275
+	BOOST_CHECK_EQUAL(mesh::selectLevelOfDetail(screenSizes, 4, 0.26f, 2, 0.1f), 2u);
+	BOOST_CHECK_EQUAL(mesh::selectLevelOfDetail(screenSizes, 4, 0.28f, 2, 0.1f), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
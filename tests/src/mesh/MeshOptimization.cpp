@@ -0,0 +1,329 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#define BOOST_TEST_MODULE MeshOptimization
+#include <boost/test/unit_test.hpp>
+
+#include "mesh/MeshOptimization.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+/**
+ * A size x size grid of vertices on the unit square, in a wave, with its triangles in random order.
+ */
+Mesh createGrid(const uint32 size, const bool shuffle = true)
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec2> textureCoordinates;
+	std::vector<glm::vec4> colors;
+	std::vector<glm::ivec4> boneIds;
+	std::vector<glm::vec4> boneWeights;
+
+	for (uint32 y = 0; y < size; ++y)
+	{
+		for (uint32 x = 0; x < size; ++x)
+		{
+			const float32 u = static_cast<float32>(x) / (size - 1);
+			const float32 v = static_cast<float32>(y) / (size - 1);
+
+			vertices.push_back(glm::vec3(u, std::sin(u * 6.0f) * 0.1f, v));
+			normals.push_back(glm::normalize(glm::vec3(-std::cos(u * 6.0f) * 0.6f, 1.0f, 0.0f)));
+			textureCoordinates.push_back(glm::vec2(u * 4.0f, v * 4.0f));
+			colors.push_back(glm::vec4(u, v, 0.5f, 1.0f));
+			boneIds.push_back(glm::ivec4(x % 3, y % 3 + 3, 0, 0));
+			boneWeights.push_back(glm::vec4(u * 0.7f, 1.0f - u * 0.7f, 0.0f, 0.0f));
+		}
+	}
+
+	std::vector<std::array<uint32, 3>> triangles;
+	for (uint32 y = 0; y + 1 < size; ++y)
+	{
+		for (uint32 x = 0; x + 1 < size; ++x)
+		{
+			const uint32 i = y * size + x;
+			triangles.push_back({{i, i + size, i + 1}});
+			triangles.push_back({{i + 1, i + size, i + size + 1}});
+		}
+	}
+
+	if (shuffle)
+	{
+		std::mt19937 random(42);
+		std::shuffle(triangles.begin(), triangles.end(), random);
+	}
+
+	std::vector<uint32> indices;
+	for (const auto& triangle : triangles) indices.insert(indices.end(), triangle.begin(), triangle.end());
+
+	return Mesh("grid", vertices, indices, colors, normals, textureCoordinates, VertexBoneData(boneIds, boneWeights));
+}
+
+/**
+ * The triangles of indices as vertex positions, sorted, so meshes can be compared whatever order they draw in.
+ */
+std::vector<std::array<float32, 9>> triangleSet(const std::vector<uint32>& indices, const std::vector<glm::vec3>& vertices)
+{
+	std::vector<std::array<float32, 9>> triangles;
+
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		std::array<float32, 9> triangle;
+		for (uint32 j = 0; j < 3; ++j)
+		{
+			triangle[j * 3 + 0] = vertices[indices[i + j]].x;
+			triangle[j * 3 + 1] = vertices[indices[i + j]].y;
+			triangle[j * 3 + 2] = vertices[indices[i + j]].z;
+		}
+
+		triangles.push_back(triangle);
+	}
+
+	std::sort(triangles.begin(), triangles.end());
+
+	return triangles;
+}
+
+const graphics::VertexAttributeLayout& findAttribute(const graphics::VertexLayout& layout, const graphics::VertexAttribute attribute)
+{
+	const auto it = std::find_if(layout.attributes.begin(), layout.attributes.end(), [attribute](const graphics::VertexAttributeLayout& attributeLayout) {
+		return attributeLayout.attribute == attribute;
+	});
+
+	BOOST_REQUIRE(it != layout.attributes.end());
+
+	return *it;
+}
+
+template<typename T>
+T readAttribute(const Mesh& mesh, const graphics::VertexAttribute attribute, const size_t vertex)
+{
+	const auto& attributeLayout = findAttribute(mesh.vertexLayout(), attribute);
+	const auto stride = mesh.vertexLayout().strides[attributeLayout.stream];
+
+	T value;
+	std::memcpy(&value, mesh.vertexStreams()[attributeLayout.stream].data() + vertex * stride + attributeLayout.offset, sizeof(T));
+
+	return value;
+}
+
+float32 fromFloat16(const uint16 value)
+{
+	const int32 exponent = (value >> 10) & 31;
+	const float32 mantissa = static_cast<float32>(value & 1023);
+	const float32 magnitude = (exponent == 0 ? mantissa * std::pow(2.0f, -24.0f) : (1.0f + mantissa / 1024.0f) * std::pow(2.0f, static_cast<float32>(exponent - 15)));
+
+	return (value & 0x8000 ? -magnitude : magnitude);
+}
+}
+
+BOOST_AUTO_TEST_SUITE(MeshOptimizationTests)
+
+BOOST_AUTO_TEST_CASE(vertexCacheOptimizationReusesVertices)
+{
+	const auto mesh = createGrid(64);
+	const auto vertexCount = static_cast<uint32>(mesh.vertices().size());
+
+	auto indices = mesh.indices();
+	const float32 before = mesh::averageCacheMissRatio(indices, vertexCount);
+
+	mesh::optimizeVertexCache(indices, vertexCount);
+	const float32 after = mesh::averageCacheMissRatio(indices, vertexCount);
+
+	// Shuffled triangles miss on nearly every vertex, a good order on a grid gets well under one miss per triangle
+	BOOST_CHECK_GT(before, 2.5f);
+	BOOST_CHECK_LT(after, 0.8f);
+
+	BOOST_CHECK(triangleSet(indices, mesh.vertices()) == triangleSet(mesh.indices(), mesh.vertices()));
+
+	std::vector<uint32> badIndices = {0, 1};
+	BOOST_CHECK_THROW(mesh::optimizeVertexCache(badIndices, vertexCount), InvalidArgumentException);
+	badIndices = {0, 1, vertexCount};
+	BOOST_CHECK_THROW(mesh::optimizeVertexCache(badIndices, vertexCount), InvalidArgumentException);
+}
+
+BOOST_AUTO_TEST_CASE(overdrawOptimizationKeepsCacheEfficiency)
+{
+	// Two grids facing away from each other, drawn back first
+	const auto grid = createGrid(32, false);
+	auto vertices = grid.vertices();
+	auto indices = grid.indices();
+
+	const auto vertexCount = static_cast<uint32>(vertices.size());
+	for (uint32 i = 0; i < vertexCount; ++i)
+	{
+		vertices.push_back(glm::vec3(vertices[i].x, -1.0f - vertices[i].y, vertices[i].z));
+	}
+	for (size_t i = 0; i < grid.indices().size(); i += 3)
+	{
+		indices.insert(indices.begin() + i, {grid.indices()[i] + vertexCount, grid.indices()[i + 2] + vertexCount, grid.indices()[i + 1] + vertexCount});
+	}
+
+	const auto doubleVertexCount = static_cast<uint32>(vertices.size());
+	mesh::optimizeVertexCache(indices, doubleVertexCount);
+
+	const auto optimized = indices;
+	const float32 before = mesh::averageCacheMissRatio(indices, doubleVertexCount);
+
+	mesh::optimizeOverdraw(indices, vertices, 1.05f);
+
+	BOOST_CHECK_LE(mesh::averageCacheMissRatio(indices, doubleVertexCount), before * 1.05f + 0.01f);
+	BOOST_CHECK(triangleSet(indices, vertices) == triangleSet(optimized, vertices));
+
+	// A single triangle has nowhere to go
+	std::vector<uint32> triangle = {0, 1, 2};
+	mesh::optimizeOverdraw(triangle, vertices);
+	BOOST_CHECK(triangle == std::vector<uint32>({0, 1, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(vertexFetchFollowsIndices)
+{
+	std::vector<uint32> indices = {4, 2, 0, 2, 4, 5};
+
+	const auto remap = mesh::optimizeVertexFetch(indices, 6);
+
+	BOOST_CHECK(indices == std::vector<uint32>({0, 1, 2, 1, 0, 3}));
+	BOOST_CHECK(remap == std::vector<uint32>({2, mesh::INVALID_VERTEX, 1, mesh::INVALID_VERTEX, 0, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(packedMeshMatchesOriginal)
+{
+	const auto grid = createGrid(20);
+	const auto vertexCount = grid.vertices().size();
+
+	mesh::MeshOptimizationOptions options;
+	options.keepVertexStreams = mesh::VertexStreams::ALL;
+
+	const auto optimized = mesh::optimize(grid, options);
+	const auto& layout = optimized.vertexLayout();
+
+	BOOST_REQUIRE_EQUAL(optimized.vertices().size(), vertexCount);
+	BOOST_CHECK(triangleSet(optimized.indices(), optimized.vertices()) == triangleSet(grid.indices(), grid.vertices()));
+
+	BOOST_CHECK(layout.indexFormat == graphics::IndexFormat::UINT16);
+	BOOST_REQUIRE_EQUAL(layout.strides.size(), 1u);
+	BOOST_CHECK_EQUAL(layout.strides[0], 12u + 4u + 4u + 4u + 4u + 4u);
+	BOOST_CHECK(findAttribute(layout, graphics::VertexAttribute::BONE_IDS).format == graphics::VertexAttributeFormat::UINT8_4);
+
+	BOOST_REQUIRE_EQUAL(optimized.vertexStreams().size(), 1u);
+	BOOST_CHECK_EQUAL(optimized.vertexStreams()[0].size(), vertexCount * layout.strides[0]);
+	BOOST_CHECK_EQUAL(optimized.indexData().size(), optimized.indices().size() * sizeof(uint16));
+
+	// Under half the memory of the float streams
+	const size_t unpackedSize = vertexCount * (sizeof(glm::vec3) * 2 + sizeof(glm::vec2) + sizeof(glm::vec4) * 2 + sizeof(glm::ivec4)) + grid.indices().size() * sizeof(uint32);
+	BOOST_CHECK_LT(optimized.vertexStreams()[0].size() + optimized.indexData().size(), unpackedSize / 2);
+
+	for (size_t i = 0; i < optimized.indices().size(); ++i)
+	{
+		uint16 index;
+		std::memcpy(&index, optimized.indexData().data() + i * sizeof(uint16), sizeof(uint16));
+		BOOST_REQUIRE_EQUAL(index, optimized.indices()[i]);
+	}
+
+	for (size_t i = 0; i < vertexCount; ++i)
+	{
+		BOOST_REQUIRE(readAttribute<glm::vec3>(optimized, graphics::VertexAttribute::POSITION, i) == optimized.vertices()[i]);
+
+		const auto normal = readAttribute<std::array<int8, 4>>(optimized, graphics::VertexAttribute::NORMAL, i);
+		for (uint32 c = 0; c < 3; ++c)
+		{
+			BOOST_REQUIRE_SMALL(normal[c] / 127.0f - optimized.normals()[i][c], 0.01f);
+		}
+
+		const auto textureCoordinate = readAttribute<std::array<uint16, 2>>(optimized, graphics::VertexAttribute::TEXTURE_COORDINATE, i);
+		for (uint32 c = 0; c < 2; ++c)
+		{
+			BOOST_REQUIRE_SMALL(fromFloat16(textureCoordinate[c]) - optimized.textureCoordinates()[i][c], 0.002f);
+		}
+
+		const auto color = readAttribute<std::array<byte, 4>>(optimized, graphics::VertexAttribute::COLOR, i);
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			BOOST_REQUIRE_SMALL(color[c] / 255.0f - optimized.colors()[i][c], 0.002f);
+		}
+
+		const auto boneIds = readAttribute<std::array<byte, 4>>(optimized, graphics::VertexAttribute::BONE_IDS, i);
+		const auto boneWeights = readAttribute<std::array<byte, 4>>(optimized, graphics::VertexAttribute::BONE_WEIGHTS, i);
+		BOOST_REQUIRE_EQUAL(boneWeights[0] + boneWeights[1] + boneWeights[2] + boneWeights[3], 255);
+
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			BOOST_REQUIRE_EQUAL(boneIds[c], optimized.vertexBoneData().boneIds()[i][c]);
+			BOOST_REQUIRE_SMALL(boneWeights[c] / 255.0f - optimized.vertexBoneData().boneWeights()[i][c], 0.005f);
+		}
+	}
+
+	// Without keeping them, only the packed data is left
+	options.keepVertexStreams = mesh::VertexStreams::NONE;
+	options.splitPositions = true;
+
+	const auto packed = mesh::optimize(grid, options);
+	BOOST_CHECK(packed.vertices().empty());
+	BOOST_CHECK(packed.indices().empty());
+	BOOST_CHECK(packed.vertexBoneData().boneWeights().empty());
+
+	BOOST_REQUIRE_EQUAL(packed.vertexLayout().strides.size(), 2u);
+	BOOST_CHECK_EQUAL(packed.vertexLayout().strides[0], 12u);
+	BOOST_CHECK_EQUAL(packed.vertexLayout().strides[1], 4u + 4u + 4u + 4u + 4u);
+	BOOST_CHECK(packed.vertexStreams()[0] == std::vector<byte>(reinterpret_cast<const byte*>(optimized.vertices().data()), reinterpret_cast<const byte*>(optimized.vertices().data() + vertexCount)));
+	BOOST_CHECK(packed.indexData() == optimized.indexData());
+}
+
+BOOST_AUTO_TEST_CASE(keepsVertexStreamsByDefault)
+{
+	const auto grid = createGrid(4);
+
+	const auto optimized = mesh::optimize(grid, mesh::MeshOptimizationOptions());
+
+	BOOST_CHECK_EQUAL(optimized.vertices().size(), grid.vertices().size());
+	BOOST_CHECK_EQUAL(optimized.indices().size(), grid.indices().size());
+	BOOST_CHECK_EQUAL(optimized.normals().size(), grid.normals().size());
+	BOOST_CHECK(!optimized.vertexStreams().empty());
+}
+
+BOOST_AUTO_TEST_CASE(keepsOnlyPositionsAndIndicesForCollision)
+{
+	const auto grid = createGrid(4);
+
+	mesh::MeshOptimizationOptions options;
+	options.keepVertexStreams = mesh::VertexStreams::POSITIONS;
+
+	const auto optimized = mesh::optimize(grid, options);
+
+	BOOST_CHECK_EQUAL(optimized.vertices().size(), grid.vertices().size());
+	BOOST_CHECK_EQUAL(optimized.indices().size(), grid.indices().size());
+	BOOST_CHECK(optimized.normals().empty());
+	BOOST_CHECK(optimized.textureCoordinates().empty());
+	BOOST_CHECK(optimized.vertexBoneData().boneWeights().empty());
+	BOOST_CHECK(!optimized.vertexStreams().empty());
+}
+
+BOOST_AUTO_TEST_CASE(largeMeshesUseWideFormats)
+{
+	const auto grid = createGrid(300, false);
+
+	std::vector<glm::ivec4> boneIds(grid.vertices().size(), glm::ivec4(300, 1, 0, 0));
+	const Mesh mesh("large", grid.vertices(), grid.indices(), {}, {}, {}, VertexBoneData(boneIds, grid.vertexBoneData().boneWeights()));
+
+	const auto layout = mesh::createVertexLayout(mesh);
+
+	BOOST_CHECK(layout.indexFormat == graphics::IndexFormat::UINT32);
+	BOOST_CHECK(findAttribute(layout, graphics::VertexAttribute::BONE_IDS).format == graphics::VertexAttributeFormat::UINT16_4);
+	BOOST_CHECK_EQUAL(layout.attributes.size(), 3u);
+	BOOST_CHECK_EQUAL(layout.strides[0], 12u + 8u + 4u);
+
+	std::vector<byte> indexData;
+	BOOST_CHECK_THROW(mesh::packIndices(grid.indices(), graphics::IndexFormat::UINT16, indexData), InvalidArgumentException);
+
+	const Mesh mismatched("mismatched", grid.vertices(), grid.indices(), {}, {glm::vec3(0.0f)}, {});
+	BOOST_CHECK_THROW(mesh::createVertexLayout(mismatched), InvalidArgumentException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <set>
+#include <vector>
+
+#define BOOST_TEST_MODULE MeshSimplification
+#include <boost/test/unit_test.hpp>
+
+#include "mesh/MeshSimplification.hpp"
+
+#include "exceptions/InvalidArgumentException.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+/**
+ * A size x size grid of vertices on the unit square, lifted by height.
+ */
+void createGrid(const uint32 size, const std::function<float32(float32, float32)>& height, std::vector<glm::vec3>& vertices, std::vector<uint32>& indices)
+{
+	for (uint32 y = 0; y < size; ++y)
+	{
+		for (uint32 x = 0; x < size; ++x)
+		{
+			const float32 u = static_cast<float32>(x) / (size - 1);
+			const float32 v = static_cast<float32>(y) / (size - 1);
+
+			vertices.push_back(glm::vec3(u, height(u, v), v));
+		}
+	}
+
+	for (uint32 y = 0; y + 1 < size; ++y)
+	{
+		for (uint32 x = 0; x + 1 < size; ++x)
+		{
+			const uint32 i = y * size + x;
+			indices.insert(indices.end(), {i, i + size, i + 1});
+			indices.insert(indices.end(), {i + 1, i + size, i + size + 1});
+		}
+	}
+}
+
+/**
+ * A closed unit sphere, from an octahedron with each triangle split into four subdivisions times.
+ */
+void createSphere(const uint32 subdivisions, std::vector<glm::vec3>& vertices, std::vector<uint32>& indices)
+{
+	vertices = {
+		glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f),
+		glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f),
+		glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f)
+	};
+	indices = {0, 2, 4, 2, 1, 4, 1, 3, 4, 3, 0, 4, 2, 0, 5, 1, 2, 5, 3, 1, 5, 0, 3, 5};
+
+	for (uint32 i = 0; i < subdivisions; ++i)
+	{
+		std::map<std::pair<uint32, uint32>, uint32> midpoints;
+		const auto midpoint = [&vertices, &midpoints](const uint32 a, const uint32 b) {
+			const auto key = std::make_pair(std::min(a, b), std::max(a, b));
+			const auto it = midpoints.find(key);
+			if (it != midpoints.end()) return it->second;
+
+			vertices.push_back(glm::normalize(vertices[a] + vertices[b]));
+			midpoints[key] = static_cast<uint32>(vertices.size() - 1);
+
+			return static_cast<uint32>(vertices.size() - 1);
+		};
+
+		std::vector<uint32> subdivided;
+		for (size_t j = 0; j < indices.size(); j += 3)
+		{
+			const uint32 a = indices[j];
+			const uint32 b = indices[j + 1];
+			const uint32 c = indices[j + 2];
+			const uint32 ab = midpoint(a, b);
+			const uint32 bc = midpoint(b, c);
+			const uint32 ca = midpoint(c, a);
+
+			subdivided.insert(subdivided.end(), {a, ab, ca, ab, b, bc, ca, bc, c, ab, bc, ca});
+		}
+
+		indices = std::move(subdivided);
+	}
+}
+
+std::set<uint32> usedVertices(const std::vector<uint32>& indices)
+{
+	return std::set<uint32>(indices.begin(), indices.end());
+}
+}
+
+BOOST_AUTO_TEST_SUITE(MeshSimplificationTests)
+
+BOOST_AUTO_TEST_CASE(flatGridSimplifiesWithoutError)
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<uint32> indices;
+	createGrid(32, [](float32, float32) { return 0.0f; }, vertices, indices);
+
+	float32 error = 1.0f;
+	const auto result = mesh::simplify(indices, vertices, 0, 0.001f, &error);
+
+	// Only the border has to stay
+	BOOST_CHECK_LT(result.size(), indices.size() / 4);
+	BOOST_CHECK_SMALL(error, 1e-5f);
+
+	for (const auto index : result)
+	{
+		BOOST_CHECK_LT(index, vertices.size());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(reachesTargetWithinError)
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<uint32> indices;
+	createSphere(4, vertices, indices);
+
+	const size_t target = indices.size() / 4;
+
+	float32 error = 0.0f;
+	const auto result = mesh::simplify(indices, vertices, target, 0.05f, &error);
+
+	BOOST_CHECK_LE(result.size(), target);
+	BOOST_CHECK_GT(result.size(), target / 2);
+	BOOST_CHECK_EQUAL(result.size() % 3, 0u);
+	BOOST_CHECK_GT(error, 0.0f);
+	BOOST_CHECK_LE(error, 0.05f);
+}
+
+BOOST_AUTO_TEST_CASE(stopsAtTargetError)
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<uint32> indices;
+	createSphere(4, vertices, indices);
+
+	float32 error = 0.0f;
+	const auto result = mesh::simplify(indices, vertices, 0, 0.002f, &error);
+
+	BOOST_CHECK_LE(error, 0.002f);
+	BOOST_CHECK_GT(result.size(), indices.size() / 8);
+	BOOST_CHECK_LT(result.size(), indices.size());
+}
+
+BOOST_AUTO_TEST_CASE(triangleWindingIsKept)
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<uint32> indices;
+	createSphere(4, vertices, indices);
+
+	const auto result = mesh::simplify(indices, vertices, indices.size() / 10, 0.2f);
+
+	BOOST_REQUIRE(!result.empty());
+
+	// Every triangle of the sphere faces out, so a folded over triangle faces in
+	for (size_t i = 0; i < result.size(); i += 3)
+	{
+		const auto& a = vertices[result[i]];
+		const auto& b = vertices[result[i + 1]];
+		const auto& c = vertices[result[i + 2]];
+
+		BOOST_CHECK_GT(glm::dot(glm::cross(b - a, c - a), a + b + c), 0.0f);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(bordersAndSeamsAreKept)
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<uint32> indices;
+	createGrid(33, [](float32 u, float32 v) { return std::sin(u * 3.0f) * std::cos(v * 3.0f) * 0.1f; }, vertices, indices);
+
+	// Split the vertices down the middle column, like an importer does at a texture seam
+	const uint32 size = 33;
+	std::vector<uint32> seam;
+	for (uint32 y = 0; y < size; ++y)
+	{
+		seam.push_back(y * size + size / 2);
+		vertices.push_back(vertices[seam.back()]);
+	}
+
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		const auto rightHalf = std::any_of(indices.begin() + i, indices.begin() + i + 3, [size](const uint32 index) { return index % size > size / 2; });
+		if (!rightHalf) continue;
+
+		for (size_t j = i; j < i + 3; ++j)
+		{
+			if (indices[j] % size == size / 2) indices[j] = size * size + indices[j] / size;
+		}
+	}
+
+	const auto result = mesh::simplify(indices, vertices, indices.size() / 8, 0.05f);
+	const auto used = usedVertices(result);
+
+	BOOST_CHECK_LT(result.size(), indices.size() / 2);
+
+	for (uint32 y = 0; y < size; ++y)
+	{
+		// Both sides of the seam and the border vertices at its ends are still there, so nothing tears
+		BOOST_CHECK(used.count(seam[y]) == 1);
+		BOOST_CHECK(used.count(size * size + y) == 1);
+		BOOST_CHECK(used.count(y * size) == 1);
+		BOOST_CHECK(used.count(y * size + size - 1) == 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(belowTargetIsUnchanged)
+{
+	std::vector<glm::vec3> vertices;
+	std::vector<uint32> indices;
+	createSphere(1, vertices, indices);
+
+	BOOST_CHECK(mesh::simplify(indices, vertices, indices.size()) == indices);
+}
+
+BOOST_AUTO_TEST_CASE(invalidIndicesThrow)
+{
+	const std::vector<glm::vec3> vertices(3);
+
+	BOOST_CHECK_THROW(mesh::simplify({0, 1}, vertices, 0), InvalidArgumentException);
+	BOOST_CHECK_THROW(mesh::simplify({0, 1, 3}, vertices, 0), InvalidArgumentException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
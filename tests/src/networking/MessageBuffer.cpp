@@ -0,0 +1,128 @@
+#include <vector>
+#include <stdexcept>
+
+#define BOOST_TEST_MODULE MessageBuffer
+#include <boost/test/unit_test.hpp>
+
+#include "networking/MessageBuffer.hpp"
+#include "networking/MessageBufferBuilder.hpp"
+
+using namespace ice_engine;
+
+BOOST_AUTO_TEST_SUITE(MessageBuffer)
+
+BOOST_AUTO_TEST_CASE(copiesShareStorage)
+{
+	networking::MessageBufferPool pool;
+
+	const auto messageBuffer = pool.create(std::vector<uint8>{1, 2, 3});
+	const auto copy = messageBuffer;
+
+	BOOST_CHECK_EQUAL(messageBuffer.data(), copy.data());
+	BOOST_CHECK_EQUAL(messageBuffer.useCount(), 2);
+	BOOST_CHECK_EQUAL(copy.size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(bytesAreIndexedWithBoundsChecks)
+{
+	networking::MessageBufferPool pool;
+
+	const auto messageBuffer = pool.create(std::vector<uint8>{1, 2, 3});
+
+	BOOST_CHECK_EQUAL(messageBuffer.length(), 3u);
+	BOOST_CHECK_EQUAL(messageBuffer.at(0), 1);
+	BOOST_CHECK_EQUAL(messageBuffer.at(2), 3);
+	BOOST_CHECK_THROW(messageBuffer.at(3), std::out_of_range);
+	BOOST_CHECK_THROW(networking::MessageBuffer().at(0), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(storageIsReturnedToPool)
+{
+	networking::MessageBufferPool pool;
+
+	{
+		auto messageBuffer = pool.create(std::vector<uint8>(128, 0));
+		BOOST_CHECK_EQUAL(pool.numberOfPooledBuffers(), 0u);
+	}
+
+	BOOST_CHECK_EQUAL(pool.numberOfPooledBuffers(), 1u);
+
+	auto messageBuffer = pool.create(std::vector<uint8>{4});
+
+	BOOST_CHECK_EQUAL(pool.numberOfPooledBuffers(), 0u);
+	BOOST_CHECK_EQUAL(messageBuffer.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(buffersOutlivePool)
+{
+	networking::MessageBuffer messageBuffer;
+
+	{
+		networking::MessageBufferPool pool;
+		messageBuffer = pool.create(std::vector<uint8>{5, 6});
+	}
+
+	BOOST_CHECK_EQUAL(messageBuffer.size(), 2u);
+	BOOST_CHECK_EQUAL(messageBuffer.data()[1], 6);
+}
+
+BOOST_AUTO_TEST_CASE(builderAndReaderRoundTrip)
+{
+	networking::MessageBufferPool pool;
+	networking::MessageBufferBuilder builder(&pool, 64);
+
+	builder.writeUInt32(42);
+	builder.writeFloat(1.5f);
+	builder.writeString("hello");
+	builder.writeVec3(glm::vec3(1.0f, 2.0f, 3.0f));
+	builder.writeBool(true);
+
+	const auto messageBuffer = builder.build();
+
+	BOOST_CHECK_EQUAL(builder.size(), 0u);
+
+	networking::MessageBufferReader reader(messageBuffer.view());
+
+	BOOST_CHECK_EQUAL(reader.readUInt32(), 42u);
+	BOOST_CHECK_EQUAL(reader.readFloat(), 1.5f);
+	BOOST_CHECK_EQUAL(reader.readString(), "hello");
+	BOOST_CHECK_EQUAL(reader.readVec3().z, 3.0f);
+	BOOST_CHECK(reader.readBool());
+	BOOST_CHECK(reader.eof());
+	BOOST_CHECK_THROW(reader.readUInt8(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(sharedReaderKeepsTemporaryBuffer)
+{
+	networking::MessageBufferPool pool;
+	networking::MessageBufferBuilder builder(&pool, 64);
+
+	builder.writeUInt32(42);
+	builder.writeString("hello");
+
+	networking::SharedMessageBufferReader reader(builder.build());
+
+	// Still referenced by the reader, so the storage can't be reused
+	BOOST_CHECK_EQUAL(pool.numberOfPooledBuffers(), 0u);
+
+	auto copy = reader;
+	reader = networking::SharedMessageBufferReader();
+
+	BOOST_CHECK_EQUAL(copy.readUInt32(), 42u);
+	BOOST_CHECK_EQUAL(copy.readString(), "hello");
+	BOOST_CHECK(copy.eof());
+}
+
+BOOST_AUTO_TEST_CASE(sharedReaderCopiesViews)
+{
+	networking::SharedMessageBufferReader reader;
+
+	{
+		const std::vector<uint8> data = {7, 0, 0, 0};
+		reader = networking::SharedMessageBufferReader(ArrayView<const uint8>(data.data(), data.size()));
+	}
+
+	BOOST_CHECK_EQUAL(reader.readUInt32(), 7u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
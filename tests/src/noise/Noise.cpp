@@ -0,0 +1,143 @@
+#include <vector>
+
+#define BOOST_TEST_MODULE Noise
+#include <boost/test/unit_test.hpp>
+
+#include "noise/Noise.hpp"
+
+#include "ThreadPool.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+const std::vector<noise::NoiseType> noiseTypes = {
+	noise::NoiseType::VALUE,
+	noise::NoiseType::VALUE_FRACTAL,
+	noise::NoiseType::PERLIN,
+	noise::NoiseType::PERLIN_FRACTAL,
+	noise::NoiseType::SIMPLEX,
+	noise::NoiseType::SIMPLEX_FRACTAL,
+	noise::NoiseType::CELLULAR,
+	noise::NoiseType::WHITE_NOISE,
+	noise::NoiseType::CUBIC,
+	noise::NoiseType::CUBIC_FRACTAL
+};
+}
+
+BOOST_AUTO_TEST_SUITE(NoiseTests)
+
+BOOST_AUTO_TEST_CASE(gridMatchesSingleSamples)
+{
+	ThreadPool threadPool(4);
+
+	noise::Noise noise(42);
+	noise.setFrequency(0.05f);
+
+	const float32 x = -13.5f;
+	const float32 y = 7.25f;
+	const float32 step = 0.75f;
+	const uint32 width = 97;
+	const uint32 height = 130;
+
+	for (const auto noiseType : noiseTypes)
+	{
+		noise.setNoiseType(noiseType);
+		BOOST_CHECK(noise.getNoiseType() == noiseType);
+
+		std::vector<float32> values;
+		std::vector<float32> threadedValues;
+		noise.getNoise(x, y, width, height, step, values);
+		noise.getNoise(x, y, width, height, step, threadedValues, &threadPool);
+
+		BOOST_REQUIRE_EQUAL(values.size(), width * height);
+		BOOST_CHECK(values == threadedValues);
+
+		for (uint32 j = 0; j < height; j += 7)
+		{
+			for (uint32 i = 0; i < width; i += 5)
+			{
+				BOOST_CHECK_EQUAL(values[j * width + i], noise.getNoise(x + static_cast<float32>(i) * step, y + static_cast<float32>(j) * step));
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(volumeMatchesSingleSamples)
+{
+	ThreadPool threadPool(4);
+
+	noise::Noise noise(7);
+	noise.setNoiseType(noise::NoiseType::PERLIN_FRACTAL);
+	noise.setFractalOctaves(4);
+
+	const uint32 width = 33;
+	const uint32 height = 17;
+	const uint32 depth = 9;
+
+	std::vector<float32> values;
+	std::vector<float32> threadedValues;
+	noise.getNoise(1.0f, 2.0f, 3.0f, width, height, depth, 0.5f, values);
+	noise.getNoise(1.0f, 2.0f, 3.0f, width, height, depth, 0.5f, threadedValues, &threadPool);
+
+	BOOST_REQUIRE_EQUAL(values.size(), width * height * depth);
+	BOOST_CHECK(values == threadedValues);
+
+	for (uint32 k = 0; k < depth; ++k)
+	{
+		for (uint32 j = 0; j < height; ++j)
+		{
+			for (uint32 i = 0; i < width; i += 4)
+			{
+				const float32 expected = noise.getNoise(1.0f + static_cast<float32>(i) * 0.5f, 2.0f + static_cast<float32>(j) * 0.5f, 3.0f + static_cast<float32>(k) * 0.5f);
+				BOOST_CHECK_EQUAL(values[(k * height + j) * width + i], expected);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(positionsMatchSingleSamples)
+{
+	ThreadPool threadPool(4);
+
+	noise::Noise noise(3);
+	noise.setNoiseType(noise::NoiseType::SIMPLEX);
+
+	std::vector<glm::vec2> positions2d;
+	std::vector<glm::vec3> positions3d;
+	for (uint32 i = 0; i < 10000; ++i)
+	{
+		positions2d.push_back(glm::vec2(static_cast<float32>(i) * 0.37f, static_cast<float32>(i % 101) * -1.3f));
+		positions3d.push_back(glm::vec3(static_cast<float32>(i) * 0.11f, static_cast<float32>(i % 13), static_cast<float32>(i % 71) * 2.1f));
+	}
+
+	std::vector<float32> values;
+	noise.getNoise(positions2d, values, &threadPool);
+	BOOST_REQUIRE_EQUAL(values.size(), positions2d.size());
+	for (size_t i = 0; i < positions2d.size(); i += 11)
+	{
+		BOOST_CHECK_EQUAL(values[i], noise.getNoise(positions2d[i].x, positions2d[i].y));
+	}
+
+	noise.getNoise(positions3d, values);
+	BOOST_REQUIRE_EQUAL(values.size(), positions3d.size());
+	for (size_t i = 0; i < positions3d.size(); i += 11)
+	{
+		BOOST_CHECK_EQUAL(values[i], noise.getNoise(positions3d[i].x, positions3d[i].y, positions3d[i].z));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(emptyBatches)
+{
+	noise::Noise noise;
+
+	std::vector<float32> values(10, 1.0f);
+	noise.getNoise(0.0f, 0.0f, 0, 100, 1.0f, values);
+	BOOST_CHECK(values.empty());
+
+	values.resize(10);
+	noise.getNoise(std::vector<glm::vec2>(), values);
+	BOOST_CHECK(values.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,113 @@
+#define BOOST_TEST_MODULE InterestGrid
+#include <boost/test/unit_test.hpp>
+
+#include "replication/InterestGrid.hpp"
+#include "replication/Quantization.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+replication::ReplicationSnapshot createSnapshot(const std::vector<glm::vec3>& positions)
+{
+	replication::ReplicationSnapshot snapshot;
+	snapshot.positionPrecision = 0.01f;
+
+	for (uint32 i = 0; i < positions.size(); ++i)
+	{
+		replication::ReplicatedEntityState state;
+		state.networkId = i + 1;
+		state.fields = replication::REPLICATED_POSITION;
+		state.position = replication::quantizePosition(positions[i], snapshot.positionPrecision);
+
+		snapshot.entities.push_back(state);
+	}
+
+	return snapshot;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(InterestGrid)
+
+BOOST_AUTO_TEST_CASE(findsEntitiesWithinRadius)
+{
+	const auto snapshot = createSnapshot({
+		glm::vec3(0.0f, 0.0f, 0.0f),
+		glm::vec3(10.0f, 0.0f, 0.0f),
+		glm::vec3(-40.0f, 0.0f, 0.0f),
+		glm::vec3(0.0f, 0.0f, 200.0f),
+		glm::vec3(-10.0f, 5.0f, -5.0f)
+	});
+
+	replication::InterestGrid interestGrid(16.0f);
+	interestGrid.build(snapshot);
+
+	std::vector<replication::InterestGridResult> results;
+	interestGrid.query(glm::vec3(0.0f), 15.0f, results);
+
+	BOOST_REQUIRE_EQUAL(results.size(), 3u);
+	BOOST_CHECK_EQUAL(results[0].index, 0u);
+	BOOST_CHECK_EQUAL(results[1].index, 1u);
+	BOOST_CHECK_EQUAL(results[2].index, 4u);
+	BOOST_CHECK_CLOSE(results[1].distanceSquared, 100.0f, 0.1f);
+}
+
+BOOST_AUTO_TEST_CASE(entitiesWithoutPositionAreAlwaysRelevant)
+{
+	auto snapshot = createSnapshot({glm::vec3(1000.0f, 0.0f, 0.0f)});
+
+	replication::ReplicatedEntityState state;
+	state.networkId = 2;
+	state.fields = replication::REPLICATED_PROPERTIES;
+	snapshot.entities.push_back(state);
+
+	replication::InterestGrid interestGrid;
+	interestGrid.build(snapshot);
+
+	std::vector<replication::InterestGridResult> results;
+	interestGrid.query(glm::vec3(0.0f), 10.0f, results);
+
+	BOOST_REQUIRE_EQUAL(results.size(), 1u);
+	BOOST_CHECK_EQUAL(results[0].index, 1u);
+}
+
+BOOST_AUTO_TEST_CASE(largeRadiusMatchesEverything)
+{
+	std::vector<glm::vec3> positions;
+	for (int32 i = -50; i < 50; ++i)
+	{
+		positions.push_back(glm::vec3(i * 7.0f, i * -3.0f, i * 11.0f));
+	}
+
+	replication::InterestGrid interestGrid(1.0f);
+	interestGrid.build(createSnapshot(positions));
+
+	std::vector<replication::InterestGridResult> results;
+	interestGrid.query(glm::vec3(0.0f), 100000.0f, results);
+
+	BOOST_REQUIRE_EQUAL(results.size(), positions.size());
+
+	for (uint32 i = 0; i < results.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(results[i].index, i);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(rebuildReplacesPreviousSnapshot)
+{
+	replication::InterestGrid interestGrid(8.0f);
+	interestGrid.build(createSnapshot({glm::vec3(0.0f), glm::vec3(1.0f)}));
+	interestGrid.build(createSnapshot({glm::vec3(100.0f)}));
+
+	std::vector<replication::InterestGridResult> results;
+	interestGrid.query(glm::vec3(0.0f), 10.0f, results);
+
+	BOOST_CHECK(results.empty());
+
+	interestGrid.query(glm::vec3(100.0f), 1.0f, results);
+
+	BOOST_REQUIRE_EQUAL(results.size(), 1u);
+	BOOST_CHECK_EQUAL(results[0].index, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,75 @@
+#include <memory>
+#include <vector>
+
+#define BOOST_TEST_MODULE ReplicationClient
+#include <boost/test/unit_test.hpp>
+
+#include "fs/FileSystem.hpp"
+#include "utilities/Properties.hpp"
+#include "logger/Logger.hpp"
+
+#include "scripting/angel_script/ScriptingEngine.hpp"
+
+#include "replication/ReplicationClient.hpp"
+
+#include "networking/MessageBufferBuilder.hpp"
+
+#include "BindingDelegateUtilities.hpp"
+
+using namespace ice_engine;
+
+struct Fixture
+{
+	Fixture()
+	{
+		logger = std::make_unique<logger::Logger>();
+		scriptingEngine = std::make_unique<scripting::angel_script::ScriptingEngine>(&properties, &fileSystem, logger.get());
+
+		// Registered the same way as NetworkingEngineBindingDelegate registers it
+		scriptingEngine->registerObjectType("MessageBufferReader", sizeof(networking::SharedMessageBufferReader), asOBJ_VALUE | asOBJ_APP_CLASS_CDAK | asGetTypeTraits<networking::SharedMessageBufferReader>());
+		scriptingEngine->registerObjectBehaviour("MessageBufferReader", asBEHAVE_CONSTRUCT, "void f()", asFUNCTION(DefaultConstructor<networking::SharedMessageBufferReader>), asCALL_CDECL_OBJLAST);
+		scriptingEngine->registerObjectBehaviour("MessageBufferReader", asBEHAVE_CONSTRUCT, "void f(const MessageBufferReader& in)", asFUNCTION(CopyConstructor<networking::SharedMessageBufferReader>), asCALL_CDECL_OBJFIRST);
+		scriptingEngine->registerObjectBehaviour("MessageBufferReader", asBEHAVE_DESTRUCT, "void f()", asFUNCTION(DefaultDestructor<networking::SharedMessageBufferReader>), asCALL_CDECL_OBJLAST);
+		scriptingEngine->registerClassMethod("MessageBufferReader", "MessageBufferReader& opAssign(const MessageBufferReader& in)", asMETHODPR(networking::SharedMessageBufferReader, operator=, (const networking::SharedMessageBufferReader&), networking::SharedMessageBufferReader&));
+		scriptingEngine->registerClassMethod("MessageBufferReader", "uint32 readUInt32()", asMETHODPR(networking::MessageBufferReader, readUInt32, (), uint32));
+	}
+
+	fs::FileSystem fileSystem;
+	utilities::Properties properties;
+	std::unique_ptr<logger::ILogger> logger;
+
+	std::unique_ptr<scripting::angel_script::ScriptingEngine> scriptingEngine;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ReplicationClient, Fixture)
+
+BOOST_AUTO_TEST_CASE(scriptsReadTheirReplicationState)
+{
+	const std::string script =
+		"int32 value = 0;"
+		"MessageBufferReader kept;"
+		"class Replicated { void readReplicationState(MessageBufferReader reader) { value = reader.readUInt32(); kept = reader; } }"
+		"int32 main() { return value + int32(kept.readUInt32()); }";
+
+	auto moduleHandle = scriptingEngine->createModule("replicationClient", {script});
+	auto scriptObjectHandle = scriptingEngine->createUninitializedScriptObject(moduleHandle, "Replicated");
+
+	networking::MessageBufferBuilder builder;
+	builder.writeUInt32(40);
+	builder.writeUInt32(2);
+	const auto message = builder.build();
+
+	auto scriptState = std::make_unique<std::vector<uint8>>(message.data(), message.data() + message.size());
+	BOOST_REQUIRE_NO_THROW(replication::readReplicationState(scriptingEngine.get(), scriptObjectHandle, *scriptState));
+
+	// The reader the script kept holds its own copy of the state
+	scriptState.reset();
+
+	int32 returnValue = 0;
+	BOOST_REQUIRE_NO_THROW(scriptingEngine->execute(moduleHandle, std::string("int32 main()"), returnValue));
+	BOOST_CHECK_EQUAL(returnValue, 42);
+
+	scriptingEngine->releaseScriptObject(scriptObjectHandle);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,246 @@
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#define BOOST_TEST_MODULE ReplicationSnapshot
+#include <boost/test/unit_test.hpp>
+
+#include "replication/ReplicationSnapshot.hpp"
+#include "replication/Quantization.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+replication::ReplicatedEntityState createState(const uint32 networkId, const glm::ivec3& position)
+{
+	replication::ReplicatedEntityState state;
+	state.networkId = networkId;
+	state.fields = replication::REPLICATED_POSITION | replication::REPLICATED_ORIENTATION;
+	state.position = position;
+	state.orientation = replication::quantizeOrientation(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+
+	return state;
+}
+
+replication::ReplicationSnapshot roundTrip(const replication::ReplicationSnapshot& snapshot, const replication::ReplicationSnapshot* baseline, size_t* size = nullptr)
+{
+	networking::MessageBufferBuilder builder;
+	replication::writeSnapshot(builder, snapshot, baseline);
+
+	const auto buffer = builder.build();
+	if (size) *size = buffer.size();
+
+	networking::MessageBufferReader reader(buffer.view());
+
+	BOOST_REQUIRE(replication::readMessageType(reader) == replication::ReplicationMessageType::SNAPSHOT);
+
+	const auto header = replication::readSnapshotHeader(reader);
+
+	BOOST_CHECK_EQUAL(header.sequence, snapshot.sequence);
+	BOOST_CHECK_EQUAL(header.baselineSequence, baseline ? baseline->sequence : 0u);
+
+	auto result = replication::readSnapshot(reader, header, baseline);
+
+	BOOST_CHECK(reader.eof());
+
+	return result;
+}
+
+void checkEqual(const replication::ReplicationSnapshot& a, const replication::ReplicationSnapshot& b)
+{
+	BOOST_REQUIRE_EQUAL(a.entities.size(), b.entities.size());
+
+	for (size_t i = 0; i < a.entities.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(a.entities[i].networkId, b.entities[i].networkId);
+		BOOST_CHECK_EQUAL(a.entities[i].fields, b.entities[i].fields);
+		BOOST_CHECK_EQUAL(replication::changedFields(a.entities[i], b.entities[i]), replication::REPLICATED_NONE);
+	}
+}
+}
+
+BOOST_AUTO_TEST_SUITE(ReplicationSnapshot)
+
+BOOST_AUTO_TEST_CASE(quantizePosition)
+{
+	const glm::vec3 position(12.345f, -0.004f, 1000.0f);
+
+	const auto quantized = replication::quantizePosition(position, 0.01f);
+	const auto dequantized = replication::dequantizePosition(quantized, 0.01f);
+
+	BOOST_CHECK_EQUAL(quantized.x, 1235);
+	BOOST_CHECK_EQUAL(quantized.y, 0);
+	BOOST_CHECK_EQUAL(quantized.z, 100000);
+	BOOST_CHECK_SMALL(dequantized.x - position.x, 0.005f);
+	BOOST_CHECK_SMALL(dequantized.z - position.z, 0.005f);
+}
+
+BOOST_AUTO_TEST_CASE(quantizePositionNonFiniteAndOutOfRange)
+{
+	const float32 nan = std::numeric_limits<float32>::quiet_NaN();
+	const float32 infinity = std::numeric_limits<float32>::infinity();
+
+	const auto quantized = replication::quantizePosition(glm::vec3(nan, infinity, -1.0e30f), 0.01f);
+
+	BOOST_CHECK_EQUAL(quantized.x, 0);
+	BOOST_CHECK_EQUAL(quantized.y, std::numeric_limits<int32>::max());
+	BOOST_CHECK_EQUAL(quantized.z, std::numeric_limits<int32>::min());
+}
+
+BOOST_AUTO_TEST_CASE(quantizeOrientation)
+{
+	const glm::quat orientations[] = {
+		glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+		glm::normalize(glm::quat(0.5f, -0.5f, 0.5f, 0.1f)),
+		glm::normalize(glm::quat(-0.2f, 0.1f, 0.9f, -0.3f)),
+		glm::normalize(glm::quat(0.0f, 0.0f, 0.0f, -1.0f))
+	};
+
+	for (const auto& orientation : orientations)
+	{
+		const auto dequantized = replication::dequantizeOrientation(replication::quantizeOrientation(orientation));
+
+		// q and -q are the same rotation
+		BOOST_CHECK_CLOSE(std::abs(glm::dot(orientation, dequantized)), 1.0f, 0.1f);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(fullSnapshotRoundTrip)
+{
+	replication::ReplicationSnapshot snapshot;
+	snapshot.sequence = 1;
+	snapshot.entities.push_back(createState(1, glm::ivec3(1, 2, 3)));
+	snapshot.entities.push_back(createState(4, glm::ivec3(-4, 5, -6)));
+
+	snapshot.entities[1].fields |= replication::REPLICATED_PROPERTIES | replication::REPLICATED_SCRIPT_STATE;
+	snapshot.entities[1].properties = {{"name", "crate"}, {"team", "red"}};
+	snapshot.entities[1].scriptState = {1, 2, 3, 4};
+
+	const auto result = roundTrip(snapshot, nullptr);
+
+	checkEqual(result, snapshot);
+	BOOST_CHECK_EQUAL(result.entities[1].properties[1].second, "red");
+}
+
+BOOST_AUTO_TEST_CASE(deltaOnlyContainsChanges)
+{
+	replication::ReplicationSnapshot baseline;
+	baseline.sequence = 1;
+
+	for (uint32 i = 1; i <= 100; ++i)
+	{
+		baseline.entities.push_back(createState(i, glm::ivec3(i, 0, 0)));
+	}
+
+	auto snapshot = baseline;
+	snapshot.sequence = 2;
+	snapshot.entities[10].position.y = 7;
+
+	size_t fullSize = 0;
+	size_t deltaSize = 0;
+
+	roundTrip(snapshot, nullptr, &fullSize);
+	const auto result = roundTrip(snapshot, &baseline, &deltaSize);
+
+	checkEqual(result, snapshot);
+	BOOST_CHECK_EQUAL(result.entities[10].position.y, 7);
+
+	// Header, plus one entity with only its position
+	BOOST_CHECK_EQUAL(deltaSize, 21u + 5u + 12u);
+	BOOST_CHECK(deltaSize * 10 < fullSize);
+}
+
+BOOST_AUTO_TEST_CASE(deltaAddsAndRemovesEntities)
+{
+	replication::ReplicationSnapshot baseline;
+	baseline.sequence = 5;
+	baseline.entities.push_back(createState(1, glm::ivec3(1)));
+	baseline.entities.push_back(createState(2, glm::ivec3(2)));
+	baseline.entities.push_back(createState(3, glm::ivec3(3)));
+
+	replication::ReplicationSnapshot snapshot;
+	snapshot.sequence = 8;
+	snapshot.entities.push_back(createState(2, glm::ivec3(2)));
+	snapshot.entities.push_back(createState(3, glm::ivec3(30)));
+	snapshot.entities.push_back(createState(9, glm::ivec3(9)));
+
+	const auto result = roundTrip(snapshot, &baseline);
+
+	BOOST_CHECK_EQUAL(result.sequence, 8u);
+	checkEqual(result, snapshot);
+}
+
+BOOST_AUTO_TEST_CASE(acknowledgeRoundTrip)
+{
+	networking::MessageBufferBuilder builder;
+	replication::writeAcknowledge(builder, 42);
+
+	const auto buffer = builder.build();
+	networking::MessageBufferReader reader(buffer.view());
+
+	BOOST_REQUIRE(replication::readMessageType(reader) == replication::ReplicationMessageType::ACKNOWLEDGE);
+	BOOST_CHECK_EQUAL(replication::readAcknowledge(reader), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(ignoresOtherMessages)
+{
+	networking::MessageBufferBuilder builder;
+	builder.writeString("hello world");
+
+	const auto buffer = builder.build();
+	networking::MessageBufferReader reader(buffer.view());
+
+	BOOST_CHECK(replication::readMessageType(reader) == replication::ReplicationMessageType::UNKNOWN);
+}
+
+BOOST_AUTO_TEST_CASE(oversizedCountsThrowBeforeAllocating)
+{
+	const auto writeHeader = [](networking::MessageBufferBuilder& builder, const uint32 numberOfEntities) {
+		builder.writeUInt32(replication::REPLICATION_MESSAGE_MAGIC);
+		builder.writeUInt8(static_cast<uint8>(replication::ReplicationMessageType::SNAPSHOT));
+		builder.writeUInt32(1);
+		builder.writeUInt32(0);
+		builder.writeFloat(0.01f);
+		builder.writeUInt32(numberOfEntities);
+	};
+
+	const auto read = [](const networking::MessageBuffer& buffer) {
+		networking::MessageBufferReader reader(buffer.view());
+		replication::readMessageType(reader);
+		const auto header = replication::readSnapshotHeader(reader);
+		replication::readSnapshot(reader, header, nullptr);
+	};
+
+	// Far more entities than the message could hold
+	{
+		networking::MessageBufferBuilder builder;
+		writeHeader(builder, 0xFFFFFFFF);
+
+		BOOST_CHECK_THROW(read(builder.build()), std::out_of_range);
+	}
+
+	// A script state far larger than the message
+	{
+		networking::MessageBufferBuilder builder;
+		writeHeader(builder, 1);
+		builder.writeUInt32(1);
+		builder.writeUInt8(replication::REPLICATED_SCRIPT_STATE);
+		builder.writeUInt32(0xFFFFFFFF);
+
+		BOOST_CHECK_THROW(read(builder.build()), std::out_of_range);
+	}
+
+	// More properties than the message could hold
+	{
+		networking::MessageBufferBuilder builder;
+		writeHeader(builder, 1);
+		builder.writeUInt32(1);
+		builder.writeUInt8(replication::REPLICATED_PROPERTIES);
+		builder.writeUInt32(0xFFFFFFFF);
+
+		BOOST_CHECK_THROW(read(builder.build()), std::out_of_range);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,6 +1,8 @@
 #define BOOST_TEST_MODULE Parameter
 #include <boost/test/unit_test.hpp>
 
+#include <memory>
+
 #include "scripting/Parameter.hpp"
 
 struct Fixture
@@ -172,4 +174,25 @@ BOOST_AUTO_TEST_CASE(copyConstructorWithRefObject)
 	BOOST_CHECK_EQUAL(ref.d, 3.0f);
 }
 
+BOOST_AUTO_TEST_CASE(copiesOfValueObjectsUseTheirCopyConstructor)
+{
+	// An object that owns a reference, like a reader holding on to its message
+	auto shared = std::make_shared<int>(1);
+	parameter.value(shared);
+
+	{
+		auto p2 = ice_engine::scripting::Parameter(parameter);
+		BOOST_CHECK_EQUAL(shared.use_count(), 3);
+
+		ice_engine::scripting::Parameter p3;
+		p3 = p2;
+		BOOST_CHECK_EQUAL(shared.use_count(), 4);
+	}
+
+	BOOST_CHECK_EQUAL(shared.use_count(), 2);
+
+	parameter = ice_engine::scripting::Parameter();
+	BOOST_CHECK_EQUAL(shared.use_count(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
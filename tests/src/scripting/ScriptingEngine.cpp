@@ -339,6 +339,42 @@ BOOST_AUTO_TEST_CASE(vectorIntParameterByValue)
 	BOOST_CHECK_EQUAL(returnObject.value[0], 1);
 }
 
+BOOST_AUTO_TEST_CASE(recycledScriptObjectIsReused)
+{
+	const std::string script = "class Foo {} int32 main() { ModuleHandle m = getModule(\"pool\"); ref@ a = acquireScriptObject(m, \"Foo\", \"Foo@ Foo()\"); recycleScriptObject(a); ref@ b = acquireScriptObject(m, \"Foo\", \"Foo@ Foo()\"); return a is b ? 1 : 0; }";
+	auto moduleHandle = scriptingEngine->createModule("pool", {script});
+	ice_engine::int32 returnValue = 0;
+	BOOST_CHECK_NO_THROW( scriptingEngine->execute(moduleHandle, std::string("int32 main()"), returnValue); );
+	BOOST_CHECK_EQUAL(returnValue, 1);
+}
+
+BOOST_AUTO_TEST_CASE(recycledNamespacedScriptObjectIsReused)
+{
+	const std::string script = "namespace game { class Foo {} } int32 main() { ModuleHandle m = getModule(\"namespacedPool\"); ref@ a = acquireScriptObject(m, \"game::Foo\", \"game::Foo@ Foo()\"); recycleScriptObject(a); ref@ b = acquireScriptObject(m, \"game::Foo\", \"game::Foo@ Foo()\"); return a is b ? 1 : 0; }";
+	auto moduleHandle = scriptingEngine->createModule("namespacedPool", {script});
+	ice_engine::int32 returnValue = 0;
+	BOOST_CHECK_NO_THROW( scriptingEngine->execute(moduleHandle, std::string("int32 main()"), returnValue); );
+	BOOST_CHECK_EQUAL(returnValue, 1);
+}
+
+BOOST_AUTO_TEST_CASE(recycledScriptObjectIsReset)
+{
+	const std::string script = "class Foo { int32 value = 0; void reset() { value = 0; } } int32 main() { ModuleHandle m = getModule(\"resetPool\"); ref@ a = acquireScriptObject(m, \"Foo\", \"Foo@ Foo()\"); cast<Foo>(a).value = 5; recycleScriptObject(a); ref@ b = acquireScriptObject(m, \"Foo\", \"Foo@ Foo()\"); return a is b ? cast<Foo>(b).value : -1; }";
+	auto moduleHandle = scriptingEngine->createModule("resetPool", {script});
+	ice_engine::int32 returnValue = -1;
+	BOOST_CHECK_NO_THROW( scriptingEngine->execute(moduleHandle, std::string("int32 main()"), returnValue); );
+	BOOST_CHECK_EQUAL(returnValue, 0);
+}
+
+BOOST_AUTO_TEST_CASE(garbageCollectIncremental)
+{
+	const auto totalDestroyed = scriptingEngine->getGarbageCollectorStatistics().totalDestroyed;
+	BOOST_CHECK_NO_THROW( scriptingEngine->execute(std::string("class Foo { Foo@ f; } void main() { Foo a; @a.f = a; }"), std::string("void main()")); );
+	BOOST_CHECK_NO_THROW( scriptingEngine->garbageCollect(1); );
+	BOOST_CHECK_NO_THROW( scriptingEngine->garbageCollectFullCycle(); );
+	BOOST_CHECK_GT(scriptingEngine->getGarbageCollectorStatistics().totalDestroyed, totalDestroyed);
+}
+
 /*
 BOOST_AUTO_TEST_CASE(vectorIntParameterByReference)
 {
@@ -0,0 +1,255 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+#include <boost/exception/diagnostic_information.hpp>
+
+#include "cooking/CookedAsset.hpp"
+
+#include "image/BlockCompression.hpp"
+#include "mesh/MeshOptimization.hpp"
+#include "mesh/LevelOfDetail.hpp"
+
+#include "fs/FileSystem.hpp"
+#include "logger/Logger.hpp"
+#include "ResourceCache.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+
+const std::vector<std::string> IMAGE_EXTENSIONS = {"png", "jpg", "jpeg", "bmp", "tga", "tif", "tiff", "gif", "dds"};
+
+void printUsage()
+{
+	std::cerr << "Usage: ice_engine_cooker [--heightmap] [--format <format>] [--split-positions] [--vertex-streams <streams>] [--lod-count <count>] <input> <output>" << std::endl;
+	std::cerr << std::endl;
+	std::cerr << "Cooks an image, height map or model into the engine's binary format." << std::endl;
+	std::cerr << "  Images are recognized by their extension, anything else is imported as a model." << std::endl;
+	std::cerr << "  --heightmap cooks an image as a height map, with its normals baked in." << std::endl;
+	std::cerr << "  --format is the texture format images are cooked in, with a full mip chain: rgb, rgba (the default), bc1," << std::endl;
+	std::cerr << "  bc3 or bc5.  Block compressed images can only be used as textures.  Height maps are always cooked as RGBA." << std::endl;
+	std::cerr << "  The images used by a model are cooked next to the output as '<output name>_texture_<n>.cooked'." << std::endl;
+	std::cerr << "  Model meshes are reordered for the vertex cache and overdraw and packed into quantized vertex data." << std::endl;
+	std::cerr << "  --split-positions packs positions in a stream of their own, for meshes drawn in depth or shadow passes." << std::endl;
+	std::cerr << "  --vertex-streams is which float vertex data is kept next to the packed data, for use on the CPU: all (the" << std::endl;
+	std::cerr << "  default), positions, which is positions and indices for models used for physics or pathfinding, or none for" << std::endl;
+	std::cerr << "  models that are only drawn.  Keeping all of it roughly doubles the size of a cooked model." << std::endl;
+	std::cerr << "  --lod-count is how many levels of detail are generated for each model mesh, each with about half the" << std::endl;
+	std::cerr << "  triangles of the one before (default 3, 0 for none)." << std::endl;
+}
+
+bool takeFlag(std::vector<std::string>& arguments, const std::string& flag)
+{
+	const auto it = std::find(arguments.begin(), arguments.end(), flag);
+	if (it == arguments.end()) return false;
+
+	arguments.erase(it);
+
+	return true;
+}
+
+/**
+ * Removes option and the value after it from arguments and returns the value, or defaultValue if option isn't there.
+ */
+std::string takeOption(std::vector<std::string>& arguments, const std::string& option, const std::string& defaultValue)
+{
+	const auto it = std::find(arguments.begin(), arguments.end(), option);
+	if (it == arguments.end()) return defaultValue;
+
+	if (it + 1 == arguments.end()) throw std::invalid_argument(option + " needs a value");
+
+	const auto value = *(it + 1);
+	arguments.erase(it, it + 2);
+
+	return value;
+}
+
+mesh::VertexStreams vertexStreamsFromString(const std::string& vertexStreams)
+{
+	if (vertexStreams == "all") return mesh::VertexStreams::ALL;
+	if (vertexStreams == "positions") return mesh::VertexStreams::POSITIONS;
+	if (vertexStreams == "none") return mesh::VertexStreams::NONE;
+
+	throw std::invalid_argument("unknown vertex streams '" + vertexStreams + "'");
+}
+
+bool isImage(const std::string& filename)
+{
+	const auto position = filename.rfind('.');
+	if (position == std::string::npos) return false;
+
+	auto extension = filename.substr(position + 1);
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+
+	return std::find(IMAGE_EXTENSIONS.begin(), IMAGE_EXTENSIONS.end(), extension) != IMAGE_EXTENSIONS.end();
+}
+
+void writeFile(fs::IFileSystem& fileSystem, const std::string& filename, const std::vector<byte>& data)
+{
+	auto file = fileSystem.open(filename, fs::FileFlags::WRITE | fs::FileFlags::BINARY);
+	file->getOutputStream().write(reinterpret_cast<const char*>(data.data()), data.size());
+	file->close();
+}
+
+Image importImage(fs::IFileSystem& fileSystem, const std::string& filename)
+{
+	auto file = fileSystem.open(filename, fs::FileFlags::READ | fs::FileFlags::BINARY);
+
+	return Image(*file);
+}
+
+std::vector<byte> cookTexture(const graphics::IImage& image, const IImage::Format format)
+{
+	return cooking::cookImage(*image::createTextureImage(image, format));
+}
+
+size_t vertexStreamsSize(const Mesh& mesh)
+{
+	return mesh.vertices().size() * sizeof(glm::vec3)
+		+ mesh.indices().size() * sizeof(uint32)
+		+ mesh.colors().size() * sizeof(glm::vec4)
+		+ mesh.normals().size() * sizeof(glm::vec3)
+		+ mesh.textureCoordinates().size() * sizeof(glm::vec2)
+		+ mesh.vertexBoneData().boneIds().size() * sizeof(glm::ivec4)
+		+ mesh.vertexBoneData().boneWeights().size() * sizeof(glm::vec4);
+}
+
+size_t packedSize(const Mesh& mesh)
+{
+	size_t size = mesh.indexData().size();
+	for (const auto& vertexStream : mesh.vertexStreams())
+	{
+		size += vertexStream.size();
+	}
+
+	return size;
+}
+
+void cookModel(
+	fs::IFileSystem& fileSystem,
+	ice_engine::logger::ILogger& logger,
+	const std::string& input,
+	const std::string& output,
+	const IImage::Format format,
+	const mesh::MeshOptimizationOptions& meshOptimizationOptions,
+	const mesh::LevelOfDetailOptions& levelOfDetailOptions
+)
+{
+	ResourceCache resourceCache;
+	const Model importedModel(input, &resourceCache, &logger, &fileSystem);
+
+	std::vector<Mesh> meshes;
+	std::vector<std::vector<Mesh>> levelsOfDetail;
+	for (const auto& importedMesh : importedModel.meshes())
+	{
+		meshes.push_back(mesh::optimize(importedMesh, meshOptimizationOptions));
+
+		std::cout << "Packed mesh '" << importedMesh.name() << "' from " << vertexStreamsSize(importedMesh) << " to " << packedSize(meshes.back()) << " bytes" << std::endl;
+
+		// Levels are simplified from the float data, which optimize may have dropped
+		levelsOfDetail.push_back(std::vector<Mesh>());
+		if (levelOfDetailOptions.levelCount == 0) continue;
+
+		for (const auto& levelOfDetail : mesh::generateLevelsOfDetail(importedMesh, levelOfDetailOptions))
+		{
+			levelsOfDetail.back().push_back(mesh::optimize(levelOfDetail, meshOptimizationOptions));
+
+			std::cout << "Generated level of detail " << levelsOfDetail.back().size() << " of mesh '" << importedMesh.name() << "' with " << levelOfDetail.indices().size() / 3 << " triangles (from " << importedMesh.indices().size() / 3 << ")" << std::endl;
+		}
+	}
+
+	const Model model(importedModel.name(), std::move(meshes), importedModel.textures(), importedModel.skeleton(), importedModel.animations(), std::move(levelsOfDetail));
+
+	const auto basePath = fileSystem.getBasePath(output);
+	const auto name = fileSystem.getFilenameWithoutExtension(output);
+
+	std::vector<std::string> texturePaths;
+	for (size_t i = 0; i < model.textures().size(); ++i)
+	{
+		const auto image = model.textures()[i].image();
+
+		if (!image)
+		{
+			texturePaths.push_back(std::string());
+			continue;
+		}
+
+		texturePaths.push_back(name + "_texture_" + std::to_string(i) + ".cooked");
+
+		const auto textureFilename = basePath.empty() ? texturePaths.back() : basePath + fileSystem.getDirectorySeperator() + texturePaths.back();
+		writeFile(fileSystem, textureFilename, cookTexture(*image, format));
+
+		std::cout << "Cooked texture '" << model.textures()[i].name() << "' to '" << textureFilename << "'" << std::endl;
+	}
+
+	writeFile(fileSystem, output, cooking::cookModel(model, texturePaths));
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> arguments(argv + 1, argv + argc);
+
+	const bool heightMap = takeFlag(arguments, "--heightmap");
+
+	mesh::MeshOptimizationOptions meshOptimizationOptions;
+	meshOptimizationOptions.splitPositions = takeFlag(arguments, "--split-positions");
+
+	std::string format;
+	mesh::LevelOfDetailOptions levelOfDetailOptions;
+
+	try
+	{
+		format = takeOption(arguments, "--format", "rgba");
+		meshOptimizationOptions.keepVertexStreams = vertexStreamsFromString(takeOption(arguments, "--vertex-streams", "all"));
+		levelOfDetailOptions.levelCount = static_cast<uint32>(std::stoul(takeOption(arguments, "--lod-count", "3")));
+	}
+	catch (const std::exception&)
+	{
+		printUsage();
+		return 1;
+	}
+
+	if (arguments.size() != 2)
+	{
+		printUsage();
+		return 1;
+	}
+
+	const auto& input = arguments[0];
+	const auto& output = arguments[1];
+
+	fs::FileSystem fileSystem;
+	ice_engine::logger::Logger logger("ice_engine_cooker.log");
+
+	try
+	{
+		if (heightMap)
+		{
+			writeFile(fileSystem, output, cooking::cookHeightMap(HeightMap(importImage(fileSystem, input))));
+		}
+		else if (isImage(input))
+		{
+			writeFile(fileSystem, output, cookTexture(importImage(fileSystem, input), image::formatFromString(format)));
+		}
+		else
+		{
+			cookModel(fileSystem, logger, input, output, image::formatFromString(format), meshOptimizationOptions, levelOfDetailOptions);
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Unable to cook '" << input << "': " << boost::diagnostic_information(e) << std::endl;
+		return 1;
+	}
+
+	std::cout << "Cooked '" << input << "' to '" << output << "'" << std::endl;
+
+	return 0;
+}
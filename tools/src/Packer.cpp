@@ -0,0 +1,83 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+
+#include "fs/PackArchive.hpp"
+
+using namespace ice_engine;
+
+namespace
+{
+
+void printUsage()
+{
+	std::cerr << "Usage: ice_engine_packer [--compress] <output> <directory>" << std::endl;
+	std::cerr << std::endl;
+	std::cerr << "Packs every file under directory into a pack archive, with paths relative to directory." << std::endl;
+	std::cerr << "  --compress stores files compressed when that makes them smaller." << std::endl;
+}
+
+std::vector<byte> readFile(const boost::filesystem::path& path)
+{
+	boost::filesystem::ifstream inputStream(path, std::ios::in | std::ios::binary);
+
+	return std::vector<byte>(std::istreambuf_iterator<char>(inputStream), std::istreambuf_iterator<char>());
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> arguments(argv + 1, argv + argc);
+
+	bool compress = false;
+	const auto it = std::find(arguments.begin(), arguments.end(), "--compress");
+	if (it != arguments.end())
+	{
+		compress = true;
+		arguments.erase(it);
+	}
+
+	if (arguments.size() != 2)
+	{
+		printUsage();
+		return 1;
+	}
+
+	const auto& output = arguments[0];
+	const auto directory = boost::filesystem::path(arguments[1]);
+
+	try
+	{
+		std::vector<boost::filesystem::path> paths;
+		for (const auto& entry : boost::filesystem::recursive_directory_iterator(directory))
+		{
+			if (boost::filesystem::is_regular_file(entry.path())) paths.push_back(entry.path());
+		}
+
+		// Sort so packing the same directory twice gives the same archive
+		std::sort(paths.begin(), paths.end());
+
+		fs::PackArchiveWriter writer;
+		for (const auto& path : paths)
+		{
+			writer.add(boost::filesystem::relative(path, directory).generic_string(), readFile(path), compress);
+		}
+
+		writer.write(output);
+
+		std::cout << "Packed " << paths.size() << " files from '" << directory.string() << "' to '" << output << "'" << std::endl;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "Unable to pack '" << directory.string() << "': " << boost::diagnostic_information(e) << std::endl;
+		return 1;
+	}
+
+	return 0;
+}